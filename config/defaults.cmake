@@ -53,6 +53,10 @@ option(MFEM_USE_UMPIRE "Enable Umpire" OFF)
 option(MFEM_USE_SIMD "Enable use of SIMD intrinsics" ON)
 option(MFEM_USE_ADIOS2 "Enable ADIOS2" OFF)
 
+# Additional specializations of the partial assembly kernels, given as a list
+# of dim:D1D:Q1D entries, e.g. "3:11:12;3:13:14".
+set(MFEM_PA_KERNELS "" CACHE STRING "Additional PA kernel specializations")
+
 set(MFEM_MPI_NP 4 CACHE STRING "Number of processes used for MPI tests")
 
 # Allow a user to disable testing, examples, and/or miniapps at CONFIGURE TIME
@@ -141,6 +141,10 @@ MFEM_USE_UMPIRE        = NO
 MFEM_USE_SIMD          = YES
 MFEM_USE_ADIOS2        = NO
 
+# Additional specializations of the partial assembly kernels, given as a
+# space-separated list of dim:D1D:Q1D entries, e.g. "3:11:12 3:13:14".
+MFEM_PA_KERNELS =
+
 # Compile and link options for zlib.
 ZLIB_DIR =
 ZLIB_OPT = $(if $(ZLIB_DIR),-I$(ZLIB_DIR)/include)
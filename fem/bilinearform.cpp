@@ -141,6 +141,15 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
    }
 }
 
+void BilinearForm::UseLVectorKernels(bool use)
+{
+   PABilinearFormExtension *pa_ext =
+      dynamic_cast<PABilinearFormExtension*>(ext);
+   MFEM_VERIFY(assembly == AssemblyLevel::PARTIAL && pa_ext,
+               "UseLVectorKernels requires AssemblyLevel::PARTIAL");
+   pa_ext->UseLVectorKernels(use);
+}
+
 void BilinearForm::EnableStaticCondensation()
 {
    delete static_cond;
@@ -585,6 +594,13 @@ void BilinearForm::Assemble(int skip_zeros)
 #endif
 }
 
+void BilinearForm::UpdateGeometry()
+{
+   MFEM_VERIFY(ext, "UpdateGeometry() is not supported with legacy full "
+               "assembly, use Assemble() instead.");
+   ext->UpdateGeometry();
+}
+
 void BilinearForm::ConformingAssemble()
 {
    // Do not remove zero entries to preserve the symmetric structure of the
@@ -848,7 +864,8 @@ void BilinearForm::ComputeElementMatrices()
       dbfi[0]->AssembleElementMatrix(fe, eltrans, elmat);
       for (int k = 1; k < dbfi.Size(); k++)
       {
-         // note: some integrators may not be thread-safe
+         // note: with MFEM_THREAD_SAFE, the standard integrators keep no
+         // work arrays in the object; user-defined ones may not be thread-safe
          dbfi[k]->AssembleElementMatrix(fe, eltrans, tmp);
          elmat += tmp;
       }
@@ -168,6 +168,12 @@ public:
    /// Returns the assembly level
    AssemblyLevel GetAssemblyLevel() const { return assembly; }
 
+   /** @brief With AssemblyLevel::PARTIAL, apply the domain integrators
+       directly to L-vectors, without E-vectors, when possible. */
+   /** See PABilinearFormExtension::UseLVectorKernels(). This method should be
+       called after SetAssemblyLevel() and before assembly. */
+   void UseLVectorKernels(bool use = true);
+
    /** @brief Enable the use of static condensation. For details see the
        description for class StaticCondensation in fem/staticcond.hpp This method
        should be called before assembly. If the number of unknowns after static
@@ -358,6 +364,16 @@ public:
    /// Assembles the form i.e. sums over all domain/bdr integrators.
    void Assemble(int skip_zeros = 1);
 
+   /** @brief Update the assembled form after the mesh nodes have moved, e.g.
+       with Mesh::MoveNodes() or Mesh::NodesUpdated(). */
+   /** With partial assembly, only the quadrature point data of the integrators
+       is recomputed, reusing the restriction operators and the work vectors
+       of the form, and nothing is done if the nodes did not change since the
+       last assembly. The coefficients are evaluated at the moved quadrature
+       points. This method is not supported with legacy full assembly, where
+       the matrix has to be reassembled with Update() and Assemble(). */
+   void UpdateGeometry();
+
    /** @brief Assemble the diagonal of the bilinear form into diag
 
        For adaptively refined meshes, this returns P^T d_e, where d_e is the
@@ -46,6 +46,29 @@ PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
    elem_restrict = NULL;
    int_face_restrict_lex = NULL;
    bdr_face_restrict_lex = NULL;
+   int_face_dn_restrict = NULL;
+   bdr_face_dn_restrict = NULL;
+   use_lvector = false;
+   lvector_restrict = NULL;
+   nodes_sequence = -1;
+}
+
+PABilinearFormExtension::~PABilinearFormExtension()
+{
+   for (int i = 0; i < fused_integrators.Size(); i++)
+   {
+      delete fused_integrators[i];
+   }
+}
+
+static bool RequireFaceNormalDerivatives(
+   const Array<BilinearFormIntegrator*> &integrators)
+{
+   for (int i = 0; i < integrators.Size(); i++)
+   {
+      if (integrators[i]->RequiresFaceNormalDerivatives()) { return true; }
+   }
+   return false;
 }
 
 void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
@@ -54,12 +77,7 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
                                  ElementDofOrdering::LEXICOGRAPHIC:
                                  ElementDofOrdering::NATIVE;
    elem_restrict = trialFes->GetElementRestriction(ordering);
-   if (elem_restrict)
-   {
-      localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
-      localY.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
-      localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
-   }
+   SetupEVectors();
 
    // Construct face restriction operators only if the bilinear form has
    // interior or boundary face integrators
@@ -83,12 +101,61 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
       faceBdrY.SetSize(bdr_face_restrict_lex->Height(), Device::GetMemoryType());
       faceBdrY.UseDevice(true); // ensure 'faceBoundY = 0.0' is done on device
    }
+
+   // Construct face normal derivative restriction operators only if a face
+   // integrator uses them
+   if (int_face_dn_restrict == NULL &&
+       RequireFaceNormalDerivatives(*a->GetFBFI()))
+   {
+      int_face_dn_restrict =
+         trialFes->GetFaceNormalDerivativeRestriction(FaceType::Interior);
+      faceIntDnX.SetSize(int_face_dn_restrict->Height(),
+                         Device::GetMemoryType());
+      faceIntDnY.SetSize(int_face_dn_restrict->Height(),
+                         Device::GetMemoryType());
+      faceIntDnY.UseDevice(true);
+   }
+
+   if (bdr_face_dn_restrict == NULL &&
+       RequireFaceNormalDerivatives(*a->GetBFBFI()))
+   {
+      bdr_face_dn_restrict =
+         trialFes->GetFaceNormalDerivativeRestriction(FaceType::Boundary);
+      faceBdrDnX.SetSize(bdr_face_dn_restrict->Height(),
+                         Device::GetMemoryType());
+      faceBdrDnY.SetSize(bdr_face_dn_restrict->Height(),
+                         Device::GetMemoryType());
+      faceBdrDnY.UseDevice(true);
+   }
+}
+
+void PABilinearFormExtension::SetupEVectors() const
+{
+   if (elem_restrict && localX.Size() != elem_restrict->Height())
+   {
+      localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
+   }
 }
 
 void PABilinearFormExtension::Assemble()
 {
    SetupRestrictionOperators(L2FaceValues::DoubleValued);
+   AssembleIntegrators();
+   SetupFusedIntegrators();
+}
 
+void PABilinearFormExtension::UpdateGeometry()
+{
+   if (trialFes->GetMesh()->GetNodesSequence() == nodes_sequence) { return; }
+   // The combined integrators read the quadrature point data of the
+   // integrators when they are applied, so they do not need to be rebuilt.
+   AssembleIntegrators();
+}
+
+void PABilinearFormExtension::AssembleIntegrators()
+{
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int integratorCount = integrators.Size();
    for (int i = 0; i < integratorCount; ++i)
@@ -109,6 +176,77 @@ void PABilinearFormExtension::Assemble()
    {
       bdrFaceIntegrators[i]->AssemblePABoundaryFaces(*a->FESpace());
    }
+
+   nodes_sequence = trialFes->GetMesh()->GetNodesSequence();
+}
+
+void PABilinearFormExtension::SetupFusedIntegrators()
+{
+   for (int i = 0; i < fused_integrators.Size(); i++)
+   {
+      delete fused_integrators[i];
+   }
+   fused_integrators.SetSize(0);
+   pa_integrators.SetSize(0);
+
+   // The L-vector kernels scatter-add with atomics, which are not supported
+   // with the OpenMP backends.
+   const ElementRestriction *R =
+      dynamic_cast<const ElementRestriction*>(elem_restrict);
+   lvector_restrict =
+      (use_lvector && R && R->Height() == R->GetGatherMap().Size() &&
+       !Device::Allows(Backend::OMP_MASK)) ? R : NULL;
+
+   // Add each integrator to the first group it can be combined with, in the
+   // order of the integrators of the form.
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   Array<FusedPAIntegrator*> groups;
+   Array<BilinearFormIntegrator*> first;
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      bool added = false;
+      for (int g = 0; g < groups.Size() && !added; g++)
+      {
+         added = groups[g]->Add(integrators[i]);
+      }
+      if (added) { continue; }
+      FusedPAIntegrator *group = new FusedPAIntegrator;
+      if (group->Add(integrators[i]))
+      {
+         groups.Append(group);
+         first.Append(integrators[i]);
+      }
+      else
+      {
+         delete group;
+         pa_integrators.Append(integrators[i]);
+      }
+   }
+   for (int g = 0; g < groups.Size(); g++)
+   {
+      if (lvector_restrict)
+      {
+         // single integrators also use the L-vector kernel
+         fused_integrators.Append(groups[g]);
+      }
+      else if (groups[g]->GetNumIntegrators() > 1)
+      {
+         fused_integrators.Append(groups[g]);
+         pa_integrators.Append(groups[g]);
+      }
+      else
+      {
+         delete groups[g];
+         pa_integrators.Append(first[g]);
+      }
+   }
+
+   if (lvector_restrict && pa_integrators.Size() == 0)
+   {
+      // the E-vectors are only needed by AssembleDiagonal()
+      localX.Destroy();
+      localY.Destroy();
+   }
 }
 
 void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
@@ -118,6 +256,7 @@ void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
    const int iSz = integrators.Size();
    if (elem_restrict)
    {
+      SetupEVectors();
       localY = 0.0;
       for (int i = 0; i < iSz; ++i)
       {
@@ -155,6 +294,8 @@ void PABilinearFormExtension::Update()
    elem_restrict = nullptr;
    int_face_restrict_lex = nullptr;
    bdr_face_restrict_lex = nullptr;
+   int_face_dn_restrict = nullptr;
+   bdr_face_dn_restrict = nullptr;
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
@@ -178,7 +319,7 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
 
 void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
-   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const Array<BilinearFormIntegrator*> &integrators = pa_integrators;
 
    const int iSz = integrators.Size();
    if (DeviceCanUseCeed() || !elem_restrict)
@@ -192,13 +333,25 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
    else
    {
-      elem_restrict->Mult(x, localX);
-      localY = 0.0;
-      for (int i = 0; i < iSz; ++i)
+      if (iSz > 0 || !lvector_restrict)
       {
-         integrators[i]->AddMultPA(localX, localY);
+         elem_restrict->Mult(x, localX);
+         localY = 0.0;
+         for (int i = 0; i < iSz; ++i)
+         {
+            integrators[i]->AddMultPA(localX, localY);
+         }
+         elem_restrict->MultTranspose(localY, y);
+      }
+      else
+      {
+         y.UseDevice(true);
+         y = 0.0;
+      }
+      for (int i = 0; lvector_restrict && i < fused_integrators.Size(); ++i)
+      {
+         fused_integrators[i]->AddMultLVector(*lvector_restrict, x, y);
       }
-      elem_restrict->MultTranspose(localY, y);
    }
 
    Array<BilinearFormIntegrator*> &intFaceIntegrators = *a->GetFBFI();
@@ -209,11 +362,28 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
       if (faceIntX.Size()>0)
       {
          faceIntY = 0.0;
+         if (int_face_dn_restrict)
+         {
+            int_face_dn_restrict->Mult(x, faceIntDnX);
+            faceIntDnY = 0.0;
+         }
          for (int i = 0; i < iFISz; ++i)
          {
-            intFaceIntegrators[i]->AddMultPA(faceIntX, faceIntY);
+            if (intFaceIntegrators[i]->RequiresFaceNormalDerivatives())
+            {
+               intFaceIntegrators[i]->AddMultPAFaceNormalDerivatives(
+                  faceIntX, faceIntDnX, faceIntY, faceIntDnY);
+            }
+            else
+            {
+               intFaceIntegrators[i]->AddMultPA(faceIntX, faceIntY);
+            }
          }
          int_face_restrict_lex->MultTranspose(faceIntY, y);
+         if (int_face_dn_restrict)
+         {
+            int_face_dn_restrict->MultTranspose(faceIntDnY, y);
+         }
       }
    }
 
@@ -225,28 +395,57 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
       if (faceBdrX.Size()>0)
       {
          faceBdrY = 0.0;
+         if (bdr_face_dn_restrict)
+         {
+            bdr_face_dn_restrict->Mult(x, faceBdrDnX);
+            faceBdrDnY = 0.0;
+         }
          for (int i = 0; i < bFISz; ++i)
          {
-            bdrFaceIntegrators[i]->AddMultPA(faceBdrX, faceBdrY);
+            if (bdrFaceIntegrators[i]->RequiresFaceNormalDerivatives())
+            {
+               bdrFaceIntegrators[i]->AddMultPAFaceNormalDerivatives(
+                  faceBdrX, faceBdrDnX, faceBdrY, faceBdrDnY);
+            }
+            else
+            {
+               bdrFaceIntegrators[i]->AddMultPA(faceBdrX, faceBdrY);
+            }
          }
          bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
+         if (bdr_face_dn_restrict)
+         {
+            bdr_face_dn_restrict->MultTranspose(faceBdrDnY, y);
+         }
       }
    }
 }
 
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
-   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const Array<BilinearFormIntegrator*> &integrators = pa_integrators;
    const int iSz = integrators.Size();
    if (elem_restrict)
    {
-      elem_restrict->Mult(x, localX);
-      localY = 0.0;
-      for (int i = 0; i < iSz; ++i)
+      if (iSz > 0 || !lvector_restrict)
       {
-         integrators[i]->AddMultTransposePA(localX, localY);
+         elem_restrict->Mult(x, localX);
+         localY = 0.0;
+         for (int i = 0; i < iSz; ++i)
+         {
+            integrators[i]->AddMultTransposePA(localX, localY);
+         }
+         elem_restrict->MultTranspose(localY, y);
+      }
+      else
+      {
+         y.UseDevice(true);
+         y = 0.0;
+      }
+      for (int i = 0; lvector_restrict && i < fused_integrators.Size(); ++i)
+      {
+         fused_integrators[i]->AddMultTransposeLVector(*lvector_restrict, x, y);
       }
-      elem_restrict->MultTranspose(localY, y);
    }
    else
    {
@@ -266,11 +465,28 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
       if (faceIntX.Size()>0)
       {
          faceIntY = 0.0;
+         if (int_face_dn_restrict)
+         {
+            int_face_dn_restrict->Mult(x, faceIntDnX);
+            faceIntDnY = 0.0;
+         }
          for (int i = 0; i < iFISz; ++i)
          {
-            intFaceIntegrators[i]->AddMultTransposePA(faceIntX, faceIntY);
+            if (intFaceIntegrators[i]->RequiresFaceNormalDerivatives())
+            {
+               intFaceIntegrators[i]->AddMultTransposePAFaceNormalDerivatives(
+                  faceIntX, faceIntDnX, faceIntY, faceIntDnY);
+            }
+            else
+            {
+               intFaceIntegrators[i]->AddMultTransposePA(faceIntX, faceIntY);
+            }
          }
          int_face_restrict_lex->MultTranspose(faceIntY, y);
+         if (int_face_dn_restrict)
+         {
+            int_face_dn_restrict->MultTranspose(faceIntDnY, y);
+         }
       }
    }
 
@@ -282,15 +498,189 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
       if (faceBdrX.Size()>0)
       {
          faceBdrY = 0.0;
+         if (bdr_face_dn_restrict)
+         {
+            bdr_face_dn_restrict->Mult(x, faceBdrDnX);
+            faceBdrDnY = 0.0;
+         }
          for (int i = 0; i < bFISz; ++i)
          {
-            bdrFaceIntegrators[i]->AddMultTransposePA(faceBdrX, faceBdrY);
+            if (bdrFaceIntegrators[i]->RequiresFaceNormalDerivatives())
+            {
+               bdrFaceIntegrators[i]->AddMultTransposePAFaceNormalDerivatives(
+                  faceBdrX, faceBdrDnX, faceBdrY, faceBdrDnY);
+            }
+            else
+            {
+               bdrFaceIntegrators[i]->AddMultTransposePA(faceBdrX, faceBdrY);
+            }
          }
          bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
+         if (bdr_face_dn_restrict)
+         {
+            bdr_face_dn_restrict->MultTranspose(faceBdrDnY, y);
+         }
       }
    }
 }
 
+bool PABilinearFormExtension::SupportsOverlap() const
+{
+   if (!dynamic_cast<const ElementRestriction*>(elem_restrict) ||
+       lvector_restrict || DeviceCanUseCeed() ||
+       a->GetFBFI()->Size() > 0 || a->GetBFBFI()->Size() > 0)
+   {
+      return false;
+   }
+   for (int i = 0; i < pa_integrators.Size(); ++i)
+   {
+      if (!pa_integrators[i]->SupportsPAElementRange()) { return false; }
+   }
+   return pa_integrators.Size() > 0;
+}
+
+Operator *PABilinearFormExtension::SetupRAP(const Operator *Pi,
+                                            const Operator *Po)
+{
+#ifdef MFEM_USE_MPI
+   const ConformingProlongationOperator *P =
+      dynamic_cast<const ConformingProlongationOperator*>(Pi);
+   if (P && Pi == Po && SupportsOverlap())
+   {
+      return new ParPAOverlapOperator(*this, *P);
+   }
+#endif
+   return Operator::SetupRAP(Pi, Po);
+}
+
+#ifdef MFEM_USE_MPI
+// Append the element range [b, e) to 'ranges', merging adjacent ranges.
+static void AppendElementRange(Array<int> &ranges, int b, int e)
+{
+   if (b == e) { return; }
+   const int n = ranges.Size();
+   if (n > 0 && ranges[n-1] == b) { ranges[n-1] = e; return; }
+   ranges.Append(b);
+   ranges.Append(e);
+}
+
+ParPAOverlapOperator::ParPAOverlapOperator(
+   const PABilinearFormExtension &ext_,
+   const ConformingProlongationOperator &P_)
+   : Operator(P_.Width()),
+     ext(ext_),
+     P(P_),
+     R(static_cast<const ElementRestriction&>(*ext_.elem_restrict)),
+     num_bdr_elements(0)
+{
+   const ParFiniteElementSpace *pfes =
+      dynamic_cast<const ParFiniteElementSpace*>(ext.trialFes);
+   MFEM_VERIFY(pfes && pfes->Conforming(), "invalid FE space");
+   MFEM_VERIFY(P.Height() == pfes->GetVSize() && R.Width() == P.Height(),
+               "incompatible operators");
+
+   // Classify the (scalar) dofs: all components of a dof are either owned
+   // or external.
+   const int ndofs = pfes->GetNDofs();
+   Array<bool> external(ndofs);
+   for (int j = 0; j < ndofs; j++)
+   {
+      external[j] = (pfes->GetLocalTDofNumber(pfes->DofToVDof(j, 0)) < 0);
+      (external[j] ? ext_dofs : own_dofs).Append(j);
+   }
+
+   // Classify the elements and split them into contiguous ranges.
+   const int ne = pfes->GetNE();
+   const Table &el_dof = pfes->GetElementToDofTable();
+   Array<bool> boundary(ne);
+   for (int e = 0; e < ne; e++)
+   {
+      boundary[e] = false;
+      const int *dofs = el_dof.GetRow(e);
+      for (int k = 0; k < el_dof.RowSize(e); k++)
+      {
+         const int j = (dofs[k] >= 0) ? dofs[k] : -1-dofs[k];
+         if (external[j]) { boundary[e] = true; break; }
+      }
+      if (boundary[e]) { num_bdr_elements++; }
+   }
+   // The first half of the interior elements overlaps the exchange in P, the
+   // second half the exchange in P^T.
+   const int num_int_1 = (ne - num_bdr_elements + 1)/2;
+   int num_int = 0;
+   for (int e = 0; e < ne; e++)
+   {
+      if (boundary[e])
+      {
+         AppendElementRange(bdr_ranges, e, e+1);
+      }
+      else
+      {
+         AppendElementRange((num_int++ < num_int_1) ? int_ranges_1 :
+                            int_ranges_2, e, e+1);
+      }
+   }
+
+   xL.SetSize(P.Height(), Device::GetDeviceMemoryType());
+   yL.SetSize(P.Height(), Device::GetDeviceMemoryType());
+   xL.UseDevice(true);
+   yL.UseDevice(true);
+}
+
+void ParPAOverlapOperator::GatherElements(const Array<int> &ranges) const
+{
+   for (int r = 0; r < ranges.Size(); r += 2)
+   {
+      R.MultElements(xL, ext.localX, ranges[r], ranges[r+1]);
+   }
+}
+
+void ParPAOverlapOperator::ApplyElements(const Array<int> &ranges,
+                                         bool transpose) const
+{
+   const Array<BilinearFormIntegrator*> &integrators = ext.pa_integrators;
+   for (int r = 0; r < ranges.Size(); r += 2)
+   {
+      for (int i = 0; i < integrators.Size(); ++i)
+      {
+         if (transpose)
+         {
+            integrators[i]->AddMultTransposePAElements(
+               ext.localX, ext.localY, ranges[r], ranges[r+1]);
+         }
+         else
+         {
+            integrators[i]->AddMultPAElements(
+               ext.localX, ext.localY, ranges[r], ranges[r+1]);
+         }
+      }
+   }
+}
+
+void ParPAOverlapOperator::Apply(const Vector &x, Vector &y,
+                                 bool transpose) const
+{
+   // Start the exchange of the external dofs and work on the interior
+   // elements, which only have owned dofs.
+   P.BcastBegin(x, xL);
+   ext.localY = 0.0;
+   GatherElements(int_ranges_1);
+   GatherElements(int_ranges_2);
+   ApplyElements(int_ranges_1, transpose);
+   P.BcastEnd(xL);
+
+   // The external dofs only get contributions from the boundary elements.
+   GatherElements(bdr_ranges);
+   ApplyElements(bdr_ranges, transpose);
+   R.MultTransposeDofs(ext_dofs, ext.localY, yL);
+   P.ReduceBegin(yL);
+
+   ApplyElements(int_ranges_2, transpose);
+   R.MultTransposeDofs(own_dofs, ext.localY, yL);
+   P.ReduceEnd(yL, y);
+}
+#endif // MFEM_USE_MPI
+
 // Data and methods for element-assembled bilinear forms
 EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
    : PABilinearFormExtension(form),
@@ -303,7 +693,9 @@ void EABilinearFormExtension::Assemble()
    SetupRestrictionOperators(L2FaceValues::SingleValued);
 
    ne = trialFes->GetMesh()->GetNE();
-   elemDofs = trialFes->GetFE(0)->GetDof();
+   // The element matrices couple all vector components, consistent with the
+   // layout (dofs, components) of the E-vectors.
+   elemDofs = trialFes->GetFE(0)->GetDof() * trialFes->GetVDim();
 
    ea_data.SetSize(ne*elemDofs*elemDofs, Device::GetMemoryType());
    ea_data.UseDevice(true);
@@ -360,6 +752,14 @@ void EABilinearFormExtension::Assemble()
       auto restFbdr = dynamic_cast<const L2FaceRestriction&>(*bdr_face_restrict_lex);
       restFbdr.AddFaceMatricesToElementMatrices(ea_data_bdr, ea_data);
    }
+
+   nodes_sequence = trialFes->GetMesh()->GetNodesSequence();
+}
+
+void EABilinearFormExtension::UpdateGeometry()
+{
+   if (trialFes->GetMesh()->GetNodesSequence() == nodes_sequence) { return; }
+   Assemble();
 }
 
 void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
@@ -637,8 +1037,10 @@ FABilinearFormExtension::FABilinearFormExtension(BilinearForm *form)
 
 void FABilinearFormExtension::Assemble()
 {
-   EABilinearFormExtension::Assemble();
    FiniteElementSpace &fes = *a->FESpace();
+   MFEM_VERIFY(fes.GetVDim() == 1, "FULL assembly of vector spaces is not"
+               " supported");
+   EABilinearFormExtension::Assemble();
    if (fes.IsDGSpace())
    {
       const L2ElementRestriction *restE =
@@ -21,6 +21,12 @@ namespace mfem
 
 class BilinearForm;
 class MixedBilinearForm;
+class BilinearFormIntegrator;
+class FusedPAIntegrator;
+#ifdef MFEM_USE_MPI
+class ConformingProlongationOperator;
+class ParPAOverlapOperator;
+#endif
 
 /// Class extending the BilinearForm class to support different AssemblyLevels.
 /**  FA - Full Assembly
@@ -60,6 +66,10 @@ public:
                                  OperatorHandle &A, Vector &X, Vector &B,
                                  int copy_interior = 0) = 0;
    virtual void Update() = 0;
+
+   /** @brief Update the assembled data after the mesh nodes have moved, see
+       BilinearForm::UpdateGeometry(). */
+   virtual void UpdateGeometry() { Assemble(); }
 };
 
 /// Data and methods for partially-assembled bilinear forms
@@ -73,9 +83,30 @@ protected:
    const Operator *elem_restrict; // Not owned
    const Operator *int_face_restrict_lex; // Not owned
    const Operator *bdr_face_restrict_lex; // Not owned
+   /** The face normal derivative restrictions, used only when a face
+       integrator requires them, see
+       BilinearFormIntegrator::RequiresFaceNormalDerivatives(). */
+   const Operator *int_face_dn_restrict; // Not owned
+   const Operator *bdr_face_dn_restrict; // Not owned
+   mutable Vector faceIntDnX, faceIntDnY;
+   mutable Vector faceBdrDnX, faceBdrDnY;
+   /** The domain integrators applied to E-vectors in Mult() and
+       MultTranspose(): the integrators of the form, with the ones that can be
+       combined replaced by the FusedPAIntegrator%s in #fused_integrators. With
+       #lvector_restrict, the FusedPAIntegrator%s are not included. */
+   Array<BilinearFormIntegrator*> pa_integrators; // Not owned
+   Array<FusedPAIntegrator*> fused_integrators; // Owned
+   /// Set by UseLVectorKernels().
+   bool use_lvector;
+   /** When not NULL, the #fused_integrators are applied directly to the
+       L-vectors using the gather map of this restriction. */
+   const ElementRestriction *lvector_restrict; // Not owned
+   /// Value of Mesh::GetNodesSequence() at the last assembly.
+   long nodes_sequence;
 
 public:
    PABilinearFormExtension(BilinearForm*);
+   virtual ~PABilinearFormExtension();
 
    void Assemble();
    void AssembleDiagonal(Vector &diag) const;
@@ -88,10 +119,103 @@ public:
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
 
+   /** @brief Recompute the quadrature point data of the integrators if the
+       mesh nodes have moved since the last assembly. */
+   /** The restriction operators, the work vectors and the combined
+       integrators are reused, and the integrators overwrite their quadrature
+       point data in place when its size is unchanged. */
+   void UpdateGeometry();
+
+   /** @brief Apply the domain integrators directly to the L-vectors, without
+       E-vectors, when possible. */
+   /** The mass, diffusion and convection integrators then read the element
+       dofs from the input L-vector and scatter-add the results to the output
+       L-vector inside their kernels, see FusedPAIntegrator::AddMultLVector().
+       This removes the storage of the E-vectors and the two memory sweeps of
+       the element restriction, at the cost of atomic additions on devices.
+       The option is ignored with libCEED, with the OpenMP backends and for
+       vector spaces. The other domain integrators still use E-vectors. This
+       method should be called before assembly. */
+   void UseLVectorKernels(bool use = true) { use_lvector = use; }
+
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
+
+   /// Call AssemblePA() for the domain and face integrators of the form.
+   void AssembleIntegrators();
+
+   /// Allocate #localX and #localY, if they were released.
+   void SetupEVectors() const;
+
+   /** @brief Setup #pa_integrators, combining the assembled domain
+       integrators on the same quadrature rule into FusedPAIntegrator%s, and
+       #lvector_restrict. */
+   void SetupFusedIntegrators();
+
+   /** @brief Return true if the parallel action P^T A P can overlap the
+       exchange of shared dofs with element work, see ParPAOverlapOperator. */
+   virtual bool SupportsOverlap() const;
+
+   /** Returns a ParPAOverlapOperator when SupportsOverlap() is true and @a Pi
+       and @a Po are the same ConformingProlongationOperator. */
+   virtual Operator *SetupRAP(const Operator *Pi, const Operator *Po);
+
+#ifdef MFEM_USE_MPI
+   friend class ParPAOverlapOperator;
+#endif
 };
 
+#ifdef MFEM_USE_MPI
+/** @brief The operator P^T A P for a partially assembled A on a conforming
+    parallel space, overlapping the exchange of shared dofs in P and P^T with
+    element work. */
+/** The elements are split into boundary elements, which have external (not
+    owned) dofs, and interior elements. Mult() starts the exchange of the
+    external dofs in P, applies half of the interior elements, finishes the
+    exchange and applies the boundary elements. The contributions to the
+    external dofs are then sent to their owners in P^T while the remaining
+    interior elements are applied. MultTranspose() does the same with the
+    transposed element action. The result is the same as that of the
+    RAPOperator with the same P and A.
+
+    Objects of this type are created by ParBilinearForm::FormSystemMatrix() and
+    ParBilinearForm::FormLinearSystem() with AssemblyLevel::PARTIAL when all
+    domain integrators support element ranges, see
+    BilinearFormIntegrator::SupportsPAElementRange(), and there are no face
+    integrators. */
+class ParPAOverlapOperator : public Operator
+{
+protected:
+   const PABilinearFormExtension &ext;
+   const ConformingProlongationOperator &P;
+   const ElementRestriction &R;
+   /// Element ranges [b, e), stored as pairs b, e.
+   Array<int> int_ranges_1, int_ranges_2, bdr_ranges;
+   /// External (scalar) dofs and all other dofs.
+   Array<int> ext_dofs, own_dofs;
+   int num_bdr_elements;
+   mutable Vector xL, yL;
+
+   void GatherElements(const Array<int> &ranges) const;
+   void ApplyElements(const Array<int> &ranges, bool transpose) const;
+   void Apply(const Vector &x, Vector &y, bool transpose) const;
+
+public:
+   ParPAOverlapOperator(const PABilinearFormExtension &ext,
+                        const ConformingProlongationOperator &P);
+
+   /// Return the number of elements with external dofs.
+   int GetNumBoundaryElements() const { return num_bdr_elements; }
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   { Apply(x, y, false); }
+
+   virtual void MultTranspose(const Vector &x, Vector &y) const
+   { Apply(x, y, true); }
+};
+#endif
+
+
 /// Data and methods for element-assembled bilinear forms
 class EABilinearFormExtension : public PABilinearFormExtension
 {
@@ -109,8 +233,13 @@ public:
    EABilinearFormExtension(BilinearForm *form);
 
    void Assemble();
+   /// Reassemble if the mesh nodes have moved since the last assembly.
+   void UpdateGeometry();
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+
+protected:
+   virtual bool SupportsOverlap() const { return false; }
 };
 
 /// Data and methods for fully-assembled bilinear forms
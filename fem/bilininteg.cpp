@@ -93,6 +93,50 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPAElements(const Vector &, Vector &,
+                                               int, int) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::AddMultPAElements(...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposePAElements(const Vector &,
+                                                        Vector &,
+                                                        int, int) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::AddMultTransposePAElements(...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultPAFaceNormalDerivatives(const Vector &,
+                                                            const Vector &,
+                                                            Vector &,
+                                                            Vector &) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::AddMultPAFaceNormalDerivatives(...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposePAFaceNormalDerivatives(
+   const Vector &, const Vector &, Vector &, Vector &) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::"
+              "AddMultTransposePAFaceNormalDerivatives(...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::MakeElementRangeRef(const Vector &v, int ne,
+                                                 int e_begin, int e_end,
+                                                 Vector &v_range)
+{
+   MFEM_ASSERT(0 <= e_begin && e_begin <= e_end && e_end <= ne,
+               "invalid element range");
+   MFEM_ASSERT(v.Size() % ne == 0, "invalid E-vector size");
+   const int size = v.Size()/ne;
+   v_range.MakeRef(const_cast<Vector&>(v), e_begin*size,
+                   (e_end - e_begin)*size);
+}
+
 void BilinearFormIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans,
    DenseMatrix &elmat )
@@ -138,6 +182,9 @@ void BilinearFormIntegrator::AssembleElementVector(
 void TransposeIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans, DenseMatrix &elmat)
 {
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix bfi_elmat;
+#endif
    bfi -> AssembleElementMatrix (el, Trans, bfi_elmat);
    // elmat = bfi_elmat^t
    elmat.Transpose (bfi_elmat);
@@ -147,6 +194,9 @@ void TransposeIntegrator::AssembleElementMatrix2 (
    const FiniteElement &trial_fe, const FiniteElement &test_fe,
    ElementTransformation &Trans, DenseMatrix &elmat)
 {
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix bfi_elmat;
+#endif
    bfi -> AssembleElementMatrix2 (test_fe, trial_fe, Trans, bfi_elmat);
    // elmat = bfi_elmat^t
    elmat.Transpose (bfi_elmat);
@@ -156,6 +206,9 @@ void TransposeIntegrator::AssembleFaceMatrix (
    const FiniteElement &el1, const FiniteElement &el2,
    FaceElementTransformations &Trans, DenseMatrix &elmat)
 {
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix bfi_elmat;
+#endif
    bfi -> AssembleFaceMatrix (el1, el2, Trans, bfi_elmat);
    // elmat = bfi_elmat^t
    elmat.Transpose (bfi_elmat);
@@ -180,6 +233,9 @@ void SumIntegrator::AssembleElementMatrix(
 {
    MFEM_ASSERT(integrators.Size() > 0, "empty SumIntegrator.");
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix elem_mat;
+#endif
    integrators[0]->AssembleElementMatrix(el, Trans, elmat);
    for (int i = 1; i < integrators.Size(); i++)
    {
@@ -445,6 +501,10 @@ void GradientIntegrator::AssembleElementMatrix2(
    double c;
    Vector d_col;
 
+#ifdef MFEM_THREAD_SAFE
+   Vector shape;
+   DenseMatrix dshape, gshape, Jadj, elmat_comp;
+#endif
    dshape.SetSize(trial_dof, dim);
    gshape.SetSize(trial_dof, dim);
    Jadj.SetSize(dim);
@@ -522,6 +582,13 @@ void DiffusionIntegrator::AssembleElementMatrix
 
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
 
+   const DofToQuad *d2q = el.GetShapeTable(*ir);
+   if (d2q)
+   {
+      AssembleTabulated(*d2q, Trans, elmat);
+      return;
+   }
+
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
@@ -552,6 +619,84 @@ void DiffusionIntegrator::AssembleElementMatrix
    }
 }
 
+void DiffusionIntegrator::AssembleTabulated(const DofToQuad &d2q,
+                                            ElementTransformation &Trans,
+                                            DenseMatrix &elmat)
+{
+   const IntegrationRule &ir = *d2q.IntRule;
+   const int nd = d2q.ndof;
+   const int nq = d2q.nqpt;
+   const int dim = d2q.FE->GetDim();
+   const int spaceDim = Trans.GetSpaceDim();
+   const bool square = (dim == spaceDim);
+   const double *G = d2q.G.HostRead();
+
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix pgrad, wpgrad, mq;
+#endif
+   // Row q+nq*k of pgrad holds the physical derivatives along x_k of all the
+   // shape functions at point q, wpgrad is pgrad scaled by the weights and the
+   // coefficient, so that elmat = pgrad^t wpgrad.
+   pgrad.SetSize(nq*spaceDim, nd);
+   wpgrad.SetSize(nq*spaceDim, nd);
+   if (MQ) { mq.SetSize(spaceDim); }
+
+   for (int i = 0; i < nq; i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      Trans.SetIntPoint(&ip);
+      double w = Trans.Weight();
+      w = ip.weight / (square ? w : w*w*w);
+      // AdjugateJacobian = / adj(J),         if J is square
+      //                    \ adj(J^t.J).J^t, otherwise
+      const DenseMatrix &adjJ = Trans.AdjugateJacobian();
+      for (int j = 0; j < nd; j++)
+      {
+         for (int k = 0; k < spaceDim; k++)
+         {
+            double g = 0.0;
+            for (int d = 0; d < dim; d++)
+            {
+               g += G[i+nq*(d+dim*j)]*adjJ(d,k);
+            }
+            pgrad(i+nq*k,j) = g;
+         }
+      }
+      if (!MQ)
+      {
+         if (Q) { w *= Q->Eval(Trans, ip); }
+         for (int j = 0; j < nd; j++)
+         {
+            for (int k = 0; k < spaceDim; k++)
+            {
+               wpgrad(i+nq*k,j) = w*pgrad(i+nq*k,j);
+            }
+         }
+      }
+      else
+      {
+         MQ->Eval(mq, Trans, ip);
+         for (int j = 0; j < nd; j++)
+         {
+            for (int k = 0; k < spaceDim; k++)
+            {
+               double g = 0.0;
+               for (int l = 0; l < spaceDim; l++)
+               {
+                  g += mq(k,l)*pgrad(i+nq*l,j);
+               }
+               wpgrad(i+nq*k,j) = w*g;
+            }
+         }
+      }
+   }
+   elmat.SetSize(nd);
+   MultAtB(pgrad, wpgrad, elmat);
+   // The rank-1 updates give exactly symmetric matrices, e.g. with the same
+   // zero entries above and below the diagonal, the product may not.
+   if (!MQ) { elmat.Symmetrize(); }
+}
+
 void DiffusionIntegrator::AssembleElementMatrix2(
    const FiniteElement &trial_fe, const FiniteElement &test_fe,
    ElementTransformation &Trans, DenseMatrix &elmat)
@@ -621,13 +766,14 @@ void DiffusionIntegrator::AssembleElementVector(
 
 #ifdef MFEM_THREAD_SAFE
    DenseMatrix dshape(nd,dim), invdfdx(dim), mq(dim);
+   Vector vec(dim), pointflux(dim);
 #else
    dshape.SetSize(nd,dim);
    invdfdx.SetSize(dim);
    mq.SetSize(dim);
-#endif
    vec.SetSize(dim);
    pointflux.SetSize(dim);
+#endif
 
    elvect.SetSize(nd);
 
@@ -678,12 +824,13 @@ void DiffusionIntegrator::ComputeElementFlux
 
 #ifdef MFEM_THREAD_SAFE
    DenseMatrix dshape(nd,dim), invdfdx(dim, spaceDim);
+   Vector vec(dim), pointflux(spaceDim);
 #else
    dshape.SetSize(nd,dim);
    invdfdx.SetSize(dim, spaceDim);
-#endif
    vec.SetSize(dim);
    pointflux.SetSize(spaceDim);
+#endif
 
    const IntegrationRule &ir = fluxelem.GetNodes();
    fnd = ir.GetNPoints();
@@ -734,6 +881,7 @@ double DiffusionIntegrator::ComputeFluxEnergy
 
 #ifdef MFEM_THREAD_SAFE
    DenseMatrix mq;
+   Vector shape, pointflux, vec;
 #endif
 
    shape.SetSize(nd);
@@ -829,6 +977,13 @@ void MassIntegrator::AssembleElementMatrix
 
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, Trans);
 
+   const DofToQuad *d2q = el.GetShapeTable(*ir);
+   if (d2q)
+   {
+      AssembleTabulated(*d2q, Trans, elmat);
+      return;
+   }
+
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
@@ -846,6 +1001,39 @@ void MassIntegrator::AssembleElementMatrix
    }
 }
 
+void MassIntegrator::AssembleTabulated(const DofToQuad &d2q,
+                                       ElementTransformation &Trans,
+                                       DenseMatrix &elmat)
+{
+   const IntegrationRule &ir = *d2q.IntRule;
+   const int nd = d2q.ndof;
+   const int nq = d2q.nqpt;
+   const DenseMatrix B(const_cast<double*>(d2q.B.HostRead()), nq, nd);
+
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix wshape;
+#endif
+   // wshape = D B, where D holds the weights at the points: elmat = B^t D B
+   wshape.SetSize(nq, nd);
+   for (int i = 0; i < nq; i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      Trans.SetIntPoint(&ip);
+      double w = Trans.Weight() * ip.weight;
+      if (Q)
+      {
+         w *= Q->Eval(Trans, ip);
+      }
+      for (int j = 0; j < nd; j++)
+      {
+         wshape(i,j) = w*B(i,j);
+      }
+   }
+   elmat.SetSize(nd);
+   MultAtB(B, wshape, elmat);
+   elmat.Symmetrize();
+}
+
 void MassIntegrator::AssembleElementMatrix2(
    const FiniteElement &trial_fe, const FiniteElement &test_fe,
    ElementTransformation &Trans, DenseMatrix &elmat)
@@ -998,6 +1186,10 @@ void GroupConvectionIntegrator::AssembleElementMatrix(
    int nd = el.GetDof();
    int dim = el.GetDim();
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix dshape, adjJ, Q_nodal, grad;
+   Vector shape;
+#endif
    elmat.SetSize(nd);
    dshape.SetSize(nd,dim);
    adjJ.SetSize(dim);
@@ -1073,6 +1265,10 @@ void VectorMassIntegrator::AssembleElementMatrix
    vdim = (vdim == -1) ? spaceDim : vdim;
 
    elmat.SetSize(nd*vdim);
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, vec;
+   DenseMatrix partelmat, mcoeff;
+#endif
    shape.SetSize(nd);
    partelmat.SetSize(nd);
    if (VQ)
@@ -1155,6 +1351,10 @@ void VectorMassIntegrator::AssembleElementMatrix2(
    vdim = (vdim == -1) ? Trans.GetSpaceDim() : vdim;
 
    elmat.SetSize(te_nd*vdim, tr_nd*vdim);
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, te_shape, vec;
+   DenseMatrix partelmat, mcoeff;
+#endif
    shape.SetSize(tr_nd);
    te_shape.SetSize(te_nd);
    partelmat.SetSize(te_nd, tr_nd);
@@ -1458,6 +1658,10 @@ void DerivativeIntegrator::AssembleElementMatrix2 (
    int i, l;
    double det;
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix dshape, dshapedxt, invdfdx;
+   Vector shape, dshapedxi;
+#endif
    elmat.SetSize (test_nd,trial_nd);
    dshape.SetSize (trial_nd,dim);
    dshapedxt.SetSize(trial_nd,dim);
@@ -2070,6 +2274,10 @@ void VectorDivergenceIntegrator::AssembleElementMatrix2(
    int test_dof = test_fe.GetDof();
    double c;
 
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, divshape;
+   DenseMatrix dshape, gshape, Jadj;
+#endif
    dshape.SetSize (trial_dof, dim);
    gshape.SetSize (trial_dof, dim);
    Jadj.SetSize (dim);
@@ -2176,9 +2384,13 @@ void VectorDiffusionIntegrator::AssembleElementMatrix(
 
    elmat.SetSize(sdim * dof);
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix dshape(dof, dim), dshapedxt(dof, sdim), pelmat(dof);
+#else
    dshape.SetSize(dof, dim);
    dshapedxt.SetSize(dof, sdim);
    pelmat.SetSize(dof);
+#endif
 
    const IntegrationRule *ir = IntRule;
    if (ir == NULL)
@@ -2231,10 +2443,14 @@ void VectorDiffusionIntegrator::AssembleElementVector(
    int dof = el.GetDof();
    double w;
 
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix Jinv(dim), dshape(dof, dim), pelmat(dim), gshape(dim);
+#else
    Jinv.SetSize(dim);
    dshape.SetSize(dof, dim);
    pelmat.SetSize(dim);
    gshape.SetSize(dim);
+#endif
 
    elvect.SetSize(dim*dof);
    DenseMatrix mat_in(elfun.GetData(), dof, dim);
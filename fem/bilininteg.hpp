@@ -27,6 +27,12 @@ protected:
    BilinearFormIntegrator(const IntegrationRule *ir = NULL)
       : NonlinearFormIntegrator(ir) { }
 
+   /** @brief Make @a v_range an alias of the entries of the elements with
+       indices in [@a e_begin, @a e_end) in @a v, which holds the data of @a ne
+       elements of equal size, stored element by element. */
+   static void MakeElementRangeRef(const Vector &v, int ne, int e_begin,
+                                   int e_end, Vector &v_range);
+
 public:
    // TODO: add support for other assembly levels (in addition to PA) and their
    // actions.
@@ -78,6 +84,47 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /** @brief Return true if the methods AddMultPAElements() and
+       AddMultTransposePAElements() are supported. */
+   virtual bool SupportsPAElementRange() const { return false; }
+
+   /// Method for partially assembled action on a range of elements.
+   /** Same as AddMultPA(), restricted to the elements with indices in
+       [@a e_begin, @a e_end). The E-vectors @a x and @a y hold all elements,
+       only the entries of the elements in the range are accessed. */
+   virtual void AddMultPAElements(const Vector &x, Vector &y,
+                                  int e_begin, int e_end) const;
+
+   /** @brief Method for partially assembled transposed action on a range of
+       elements, see AddMultPAElements(). */
+   virtual void AddMultTransposePAElements(const Vector &x, Vector &y,
+                                           int e_begin, int e_end) const;
+
+   /** @brief Return true if the partially assembled face terms of the
+       integrator also need the normal derivatives of the traces, see
+       AddMultPAFaceNormalDerivatives(). */
+   virtual bool RequiresFaceNormalDerivatives() const { return false; }
+
+   /// Method for partially assembled face action using normal derivatives.
+   /** Perform the action of the face terms on the traces @a x and on their
+       reference normal derivatives @a dxdn, and add the results to @a y and
+       @a dydn, respectively. The layout of all vectors is the one of the
+       double-valued L2FaceRestriction, and the normal derivatives are the ones
+       computed by FiniteElementSpace::GetFaceNormalDerivativeRestriction().
+
+       This method is used instead of AddMultPA() when
+       RequiresFaceNormalDerivatives() returns true. */
+   virtual void AddMultPAFaceNormalDerivatives(const Vector &x,
+                                               const Vector &dxdn,
+                                               Vector &y, Vector &dydn) const;
+
+   /** @brief Method for partially assembled transposed face action using
+       normal derivatives, see AddMultPAFaceNormalDerivatives(). */
+   virtual void AddMultTransposePAFaceNormalDerivatives(const Vector &x,
+                                                        const Vector &dxdn,
+                                                        Vector &y,
+                                                        Vector &dydn) const;
+
    /// Method defining element assembly.
    /** The result of the element assembly is added and stored in the @a emat
        Vector. */
@@ -207,7 +254,9 @@ private:
    int own_bfi;
    BilinearFormIntegrator *bfi;
 
+#ifndef MFEM_THREAD_SAFE
    DenseMatrix bfi_elmat;
+#endif
 
 public:
    TransposeIntegrator (BilinearFormIntegrator *_bfi, int _own_bfi = 1)
@@ -255,6 +304,26 @@ public:
       bfi->AddMultTransposePA(x, y);
    }
 
+   virtual bool RequiresFaceNormalDerivatives() const
+   {
+      return bfi->RequiresFaceNormalDerivatives();
+   }
+
+   virtual void AddMultPAFaceNormalDerivatives(const Vector &x,
+                                               const Vector &dxdn,
+                                               Vector &y, Vector &dydn) const
+   {
+      bfi->AddMultTransposePAFaceNormalDerivatives(x, dxdn, y, dydn);
+   }
+
+   virtual void AddMultTransposePAFaceNormalDerivatives(const Vector &x,
+                                                        const Vector &dxdn,
+                                                        Vector &y,
+                                                        Vector &dydn) const
+   {
+      bfi->AddMultPAFaceNormalDerivatives(x, dxdn, y, dydn);
+   }
+
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
 
    virtual void AssembleEAInteriorFaces(const FiniteElementSpace &fes,
@@ -307,7 +376,9 @@ class SumIntegrator : public BilinearFormIntegrator
 {
 private:
    int own_integrators;
+#ifndef MFEM_THREAD_SAFE
    DenseMatrix elem_mat;
+#endif
    Array<BilinearFormIntegrator*> integrators;
 
 public:
@@ -1804,11 +1875,13 @@ protected:
    Coefficient *Q;
 
 private:
+#ifndef MFEM_THREAD_SAFE
    Vector shape;
    DenseMatrix dshape;
    DenseMatrix gshape;
    DenseMatrix Jadj;
    DenseMatrix elmat_comp;
+#endif
    // PA extension
    Vector pa_data;
    const DofToQuad *trial_maps, *test_maps; ///< Not owned
@@ -1853,10 +1926,11 @@ protected:
    MatrixCoefficient *MQ;
 
 private:
-   Vector vec, pointflux, shape;
 #ifndef MFEM_THREAD_SAFE
+   Vector vec, pointflux, shape;
    DenseMatrix dshape, dshapedxt, invdfdx, mq;
    DenseMatrix te_dshape, te_dshapedxt;
+   DenseMatrix pgrad, wpgrad;
 #endif
 
    // PA extension
@@ -1871,6 +1945,12 @@ private:
    CeedData* ceedDataPtr;
 #endif
 
+   friend class FusedPAIntegrator;
+
+   /// Assemble the element matrix using the tabulated derivatives in @a d2q.
+   void AssembleTabulated(const DofToQuad &d2q, ElementTransformation &Trans,
+                          DenseMatrix &elmat);
+
 public:
    /// Construct a diffusion integrator with coefficient Q = 1
    DiffusionIntegrator()
@@ -1951,6 +2031,16 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsPAElementRange() const;
+
+   virtual void AddMultPAElements(const Vector &x, Vector &y,
+                                  int e_begin, int e_end) const;
+
+   /// The integrator is symmetric: same as AddMultPAElements().
+   virtual void AddMultTransposePAElements(const Vector &x, Vector &y,
+                                           int e_begin, int e_end) const
+   { AddMultPAElements(x, y, e_begin, e_end); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 
@@ -1963,6 +2053,7 @@ class MassIntegrator: public BilinearFormIntegrator
 protected:
 #ifndef MFEM_THREAD_SAFE
    Vector shape, te_shape;
+   DenseMatrix wshape;
 #endif
    Coefficient *Q;
    // PA extension
@@ -1977,6 +2068,12 @@ protected:
    CeedData* ceedDataPtr;
 #endif
 
+   friend class FusedPAIntegrator;
+
+   /// Assemble the element matrix using the tabulated shapes in @a d2q.
+   void AssembleTabulated(const DofToQuad &d2q, ElementTransformation &Trans,
+                          DenseMatrix &elmat);
+
 public:
    MassIntegrator(const IntegrationRule *ir = NULL)
       : BilinearFormIntegrator(ir)
@@ -2026,6 +2123,16 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsPAElementRange() const;
+
+   virtual void AddMultPAElements(const Vector &x, Vector &y,
+                                  int e_begin, int e_end) const;
+
+   /// The integrator is symmetric: same as AddMultPAElements().
+   virtual void AddMultTransposePAElements(const Vector &x, Vector &y,
+                                           int e_begin, int e_end) const
+   { AddMultPAElements(x, y, e_begin, e_end); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
@@ -2059,6 +2166,8 @@ protected:
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
 
+   friend class FusedPAIntegrator;
+
 private:
 #ifndef MFEM_THREAD_SAFE
    DenseMatrix dshape, adjJ, Q_ir;
@@ -2067,7 +2176,7 @@ private:
 
 public:
    ConvectionIntegrator(VectorCoefficient &q, double a = 1.0)
-      : Q(&q) { alpha = a; }
+      : Q(&q), maps(NULL) { alpha = a; }
    virtual void AssembleElementMatrix(const FiniteElement &,
                                       ElementTransformation &,
                                       DenseMatrix &);
@@ -2088,6 +2197,81 @@ public:
                                          ElementTransformation &Trans);
 };
 
+/** @brief Combined partial assembly action of a MassIntegrator, a
+    DiffusionIntegrator and a ConvectionIntegrator on the same space and
+    quadrature rule. */
+/** Instead of applying each integrator separately, the combined kernel reads
+    the E-vector once, interpolates the values and the reference gradients to
+    the quadrature points with one sum-factorized pass, combines the
+    quadrature point data of all the integrators and applies the transposed
+    basis once. Any two or all three of the integrators can be combined. The
+    integrators are not owned and must be assembled with AssemblePA() before
+    they are added with Add().
+
+    Objects of this type are created by PABilinearFormExtension::Assemble()
+    for the domain integrators of the form that can be combined. */
+class FusedPAIntegrator : public BilinearFormIntegrator
+{
+protected:
+   const MassIntegrator *mass;             ///< Not owned
+   const DiffusionIntegrator *diffusion;   ///< Not owned
+   const ConvectionIntegrator *convection; ///< Not owned
+   const DofToQuad *maps;                  ///< Not owned
+   int dim, ne, dofs1D, quad1D;
+
+   void AddMult(const Vector &x, Vector &y, int e_begin, int e_end,
+                bool transpose, const Array<int> *gather_map = NULL) const;
+
+public:
+   FusedPAIntegrator()
+      : mass(NULL), diffusion(NULL), convection(NULL), maps(NULL),
+        dim(0), ne(0), dofs1D(0), quad1D(0) { }
+
+   /** @brief Add the partially assembled integrator @a integ to the combined
+       action. */
+   /** Returns false, without adding it, if @a integ is not a MassIntegrator,
+       a DiffusionIntegrator or a ConvectionIntegrator, if an integrator of
+       the same type was already added, if its quadrature data is not
+       compatible with the one of the already added integrators, or if the
+       device backend does not support the combined kernel. */
+   bool Add(const BilinearFormIntegrator *integ);
+
+   /// Return the number of integrators in the combined action.
+   int GetNumIntegrators() const
+   { return (mass != NULL) + (diffusion != NULL) + (convection != NULL); }
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const
+   { AddMult(x, y, 0, ne, false); }
+
+   virtual void AddMultTransposePA(const Vector &x, Vector &y) const
+   { AddMult(x, y, 0, ne, true); }
+
+   virtual bool SupportsPAElementRange() const { return true; }
+
+   virtual void AddMultPAElements(const Vector &x, Vector &y,
+                                  int e_begin, int e_end) const
+   { AddMult(x, y, e_begin, e_end, false); }
+
+   virtual void AddMultTransposePAElements(const Vector &x, Vector &y,
+                                           int e_begin, int e_end) const
+   { AddMult(x, y, e_begin, e_end, true); }
+
+   /** @brief Add the action on the L-vector @a x to the L-vector @a y without
+       E-vectors. */
+   /** The element dofs are read from @a x and scatter-added to @a y inside
+       the kernel, using the gather map of the (lexicographic, scalar)
+       ElementRestriction @a R, see ElementRestriction::GetGatherMap(). The
+       result is the same as adding R^T A_E R x to @a y. */
+   void AddMultLVector(const ElementRestriction &R,
+                       const Vector &x, Vector &y) const
+   { AddMult(x, y, 0, ne, false, &R.GetGatherMap()); }
+
+   /// Transposed version of AddMultLVector().
+   void AddMultTransposeLVector(const ElementRestriction &R,
+                                const Vector &x, Vector &y) const
+   { AddMult(x, y, 0, ne, true, &R.GetGatherMap()); }
+};
+
 /// alpha (q . grad u, v) using the "group" FE discretization
 class GroupConvectionIntegrator : public BilinearFormIntegrator
 {
@@ -2096,8 +2280,10 @@ protected:
    double alpha;
 
 private:
+#ifndef MFEM_THREAD_SAFE
    DenseMatrix dshape, adjJ, Q_nodal, grad;
    Vector shape;
+#endif
 
 public:
    GroupConvectionIntegrator(VectorCoefficient &q, double a = 1.0)
@@ -2114,9 +2300,11 @@ class VectorMassIntegrator: public BilinearFormIntegrator
 {
 private:
    int vdim;
+#ifndef MFEM_THREAD_SAFE
    Vector shape, te_shape, vec;
    DenseMatrix partelmat;
    DenseMatrix mcoeff;
+#endif
    int Q_order;
 
 protected:
@@ -2272,8 +2460,10 @@ protected:
 
 private:
    int xi;
+#ifndef MFEM_THREAD_SAFE
    DenseMatrix dshape, dshapedxt, invdfdx;
    Vector shape, dshapedxi;
+#endif
 
 public:
    DerivativeIntegrator(Coefficient &q, int i) : Q(&q), xi(i) { }
@@ -2424,11 +2614,13 @@ protected:
    Coefficient *Q;
 
 private:
+#ifndef MFEM_THREAD_SAFE
    Vector shape;
    Vector divshape;
    DenseMatrix dshape;
    DenseMatrix gshape;
    DenseMatrix Jadj;
+#endif
    // PA extension
    Vector pa_data;
    const DofToQuad *trial_maps, *test_maps; ///< Not owned
@@ -2514,8 +2706,10 @@ protected:
    Vector pa_data;
 
 private:
+#ifndef MFEM_THREAD_SAFE
    DenseMatrix dshape, dshapedxt, pelmat;
    DenseMatrix Jinv, gshape;
+#endif
 
 public:
    VectorDiffusionIntegrator() { Q = NULL; }
@@ -2544,6 +2738,14 @@ protected:
    double q_lambda, q_mu;
    Coefficient *lambda, *mu;
 
+   // PA extension
+   const DofToQuad *maps;         ///< Not owned
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, ne, nq, dofs1D, quad1D;
+   /** At each quadrature point: the inverse Jacobian followed by lambda and mu
+       scaled by the quadrature weight and the Jacobian determinant. */
+   Vector pa_data;
+
 private:
 #ifndef MFEM_THREAD_SAFE
    Vector shape;
@@ -2563,6 +2765,33 @@ public:
                                       ElementTransformation &,
                                       DenseMatrix &);
 
+   /** @brief Partial assembly on tensor-product elements; lambda and mu can be
+       ConstantCoefficient%s, QuadratureFunctionCoefficient%s (on the rule used
+       by the integrator) or general Coefficient%s, evaluated at the quadrature
+       points. The space must have vdim equal to the mesh dimension. */
+   using BilinearFormIntegrator::AssemblePA;
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
+
+   virtual void AssembleDiagonalPA(Vector &diag);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   /// The integrator is symmetric: same as AddMultPA().
+   virtual void AddMultTransposePA(const Vector &x, Vector &y) const
+   { AddMultPA(x, y); }
+
+   virtual bool SupportsPAElementRange() const { return true; }
+
+   virtual void AddMultPAElements(const Vector &x, Vector &y,
+                                  int e_begin, int e_end) const;
+
+   /// The integrator is symmetric: same as AddMultPAElements().
+   virtual void AddMultTransposePAElements(const Vector &x, Vector &y,
+                                           int e_begin, int e_end) const
+   { AddMultPAElements(x, y, e_begin, e_end); }
+
    /** Compute the stress corresponding to the local displacement @a u and
        interpolate it at the nodes of the given @a fluxelem. Only the symmetric
        part of the stress is stored, so that the size of @a flux is equal to
@@ -2664,7 +2893,13 @@ private:
     DiffusionIntegrator):
     * sigma = -1, kappa >= kappa0: symm. interior penalty (IP or SIPG) method,
     * sigma = +1, kappa > 0: non-symmetric interior penalty (NIPG) method,
-    * sigma = +1, kappa = 0: the method of Baumann and Oden. */
+    * sigma = +1, kappa = 0: the method of Baumann and Oden.
+
+    With partial assembly, the face terms act on the traces and on the
+    reference normal derivatives of the traces, see
+    FiniteElementSpace::GetFaceNormalDerivativeRestriction(). This requires
+    tensor-product elements with Gauss-Lobatto or Bernstein bases and is not
+    supported for faces shared between processors. */
 class DGDiffusionIntegrator : public BilinearFormIntegrator
 {
 protected:
@@ -2676,18 +2911,41 @@ protected:
    Vector shape1, shape2, dshape1dn, dshape2dn, nor, nh, ni;
    DenseMatrix jmat, dshape1, dshape2, mq, adjJ;
 
+   // PA extension
+   Vector pa_data;
+   const DofToQuad *maps;             ///< Not owned
+   int dim, nf, nq, dofs1D, quad1D;
+
 public:
    DGDiffusionIntegrator(const double s, const double k)
-      : Q(NULL), MQ(NULL), sigma(s), kappa(k) { }
+      : Q(NULL), MQ(NULL), sigma(s), kappa(k), maps(NULL), nf(0) { }
    DGDiffusionIntegrator(Coefficient &q, const double s, const double k)
-      : Q(&q), MQ(NULL), sigma(s), kappa(k) { }
+      : Q(&q), MQ(NULL), sigma(s), kappa(k), maps(NULL), nf(0) { }
    DGDiffusionIntegrator(MatrixCoefficient &q, const double s, const double k)
-      : Q(NULL), MQ(&q), sigma(s), kappa(k) { }
+      : Q(NULL), MQ(&q), sigma(s), kappa(k), maps(NULL), nf(0) { }
    using BilinearFormIntegrator::AssembleFaceMatrix;
    virtual void AssembleFaceMatrix(const FiniteElement &el1,
                                    const FiniteElement &el2,
                                    FaceElementTransformations &Trans,
                                    DenseMatrix &elmat);
+
+   virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes);
+
+   virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
+
+   virtual bool RequiresFaceNormalDerivatives() const { return true; }
+
+   virtual void AddMultPAFaceNormalDerivatives(const Vector &x,
+                                               const Vector &dxdn,
+                                               Vector &y, Vector &dydn) const;
+
+   virtual void AddMultTransposePAFaceNormalDerivatives(const Vector &x,
+                                                        const Vector &dxdn,
+                                                        Vector &y,
+                                                        Vector &dydn) const;
+
+private:
+   void SetupPA(const FiniteElementSpace &fes, FaceType type);
 };
 
 /** Integrator for the DG elasticity form, for the formulations see:
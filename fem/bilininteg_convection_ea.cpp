@@ -205,6 +205,8 @@ void ConvectionIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                       Vector &ea_data)
 {
    AssemblePA(fes);
+   MFEM_VERIFY(maps->mode == DofToQuad::TENSOR,
+               "EA requires tensor-product elements.");
    const int ne = fes.GetMesh()->GetNE();
    const Array<double> &B = maps->B;
    const Array<double> &G = maps->G;
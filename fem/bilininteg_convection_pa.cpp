@@ -21,7 +21,7 @@ namespace mfem
 // PA Convection Integrator
 
 // PA Convection Assemble 2D kernel
-static void PAConvectionSetup2D(const int Q1D,
+static void PAConvectionSetup2D(const int NQ,
                                 const int ne,
                                 const Array<double> &w,
                                 const Vector &j,
@@ -30,7 +30,6 @@ static void PAConvectionSetup2D(const int Q1D,
                                 Vector &op)
 {
    const int NE = ne;
-   const int NQ = Q1D*Q1D;
    auto W = w.Read();
 
    auto J = Reshape(j.Read(), NQ, 2, 2, NE);
@@ -60,7 +59,7 @@ static void PAConvectionSetup2D(const int Q1D,
 }
 
 // PA Convection Assemble 3D kernel
-static void PAConvectionSetup3D(const int Q1D,
+static void PAConvectionSetup3D(const int NQ,
                                 const int NE,
                                 const Array<double> &w,
                                 const Vector &j,
@@ -68,7 +67,6 @@ static void PAConvectionSetup3D(const int Q1D,
                                 const double alpha,
                                 Vector &op)
 {
-   const int NQ = Q1D*Q1D*Q1D;
    auto W = w.Read();
    auto J = Reshape(j.Read(), NQ, 3, 3, NE);
    const bool const_v = vel.Size() == 3;
@@ -126,11 +124,11 @@ static void PAConvectionSetup(const int dim,
    if (dim == 1) { MFEM_ABORT("dim==1 not supported in PAConvectionSetup"); }
    if (dim == 2)
    {
-      PAConvectionSetup2D(Q1D, NE, W, J, coeff, alpha, op);
+      PAConvectionSetup2D(W.Size(), NE, W, J, coeff, alpha, op);
    }
    if (dim == 3)
    {
-      PAConvectionSetup3D(Q1D, NE, W, J, coeff, alpha, op);
+      PAConvectionSetup3D(W.Size(), NE, W, J, coeff, alpha, op);
    }
 }
 
@@ -768,7 +766,6 @@ void SmemPAConvectionApply3D(const int ne,
 
 void ConvectionIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
-   // Assumes tensor-product elements
    Mesh *mesh = fes.GetMesh();
    const FiniteElement &el = *fes.GetFE(0);
    ElementTransformation &Trans = *fes.GetElementTransformation(0);
@@ -779,7 +776,10 @@ void ConvectionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    dim = mesh->Dimension();
    ne = fes.GetNE();
    geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   // With non-tensor elements, e.g. triangles and tetrahedra, dofs1D and
+   // quad1D are the total numbers of dofs and quadrature points
+   maps = &el.GetDofToQuad(*ir, UsesTensorBasis(fes) ? DofToQuad::TENSOR :
+                           DofToQuad::FULL);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    pa_data.SetSize(symmDims * nq * ne, Device::GetMemoryType());
@@ -868,9 +868,89 @@ static void PAConvectionApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Convection Apply kernel for non-tensor elements, e.g. triangles and
+// tetrahedra, using the full NQ x ND matrix B and NQ x DIM x ND matrix G
+template<int DIM, int T_ND = 0> static
+void NonTensorPAConvectionApply(const int NE,
+                                const int NQ,
+                                const Array<double> &b,
+                                const Array<double> &g,
+                                const Vector &_op,
+                                const Vector &x,
+                                Vector &y,
+                                const int nd = 0)
+{
+   const int ND = T_ND ? T_ND : nd;
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto op = Reshape(_op.Read(), NQ, DIM, NE);
+   auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int ND = T_ND ? T_ND : nd;
+      for (int q = 0; q < NQ; ++q)
+      {
+         double grad[DIM];
+         for (int i = 0; i < DIM; ++i) { grad[i] = 0.0; }
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            const double u = X(dof,e);
+            for (int i = 0; i < DIM; ++i) { grad[i] += G(q,i,dof)*u; }
+         }
+         double vgrad = 0.0;
+         for (int i = 0; i < DIM; ++i) { vgrad += op(q,i,e)*grad[i]; }
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            Y(dof,e) += B(q,dof)*vgrad;
+         }
+      }
+   });
+}
+
+static void PAConvectionApplyNonTensor(const int dim,
+                                       const int ND,
+                                       const int NQ,
+                                       const int NE,
+                                       const Array<double> &B,
+                                       const Array<double> &G,
+                                       const Vector &op,
+                                       const Vector &x,
+                                       Vector &y)
+{
+   if (dim == 2)
+   {
+      switch (ND)
+      {
+         case 3:  return NonTensorPAConvectionApply<2,3>(NE,NQ,B,G,op,x,y);
+         case 6:  return NonTensorPAConvectionApply<2,6>(NE,NQ,B,G,op,x,y);
+         case 10: return NonTensorPAConvectionApply<2,10>(NE,NQ,B,G,op,x,y);
+         case 15: return NonTensorPAConvectionApply<2,15>(NE,NQ,B,G,op,x,y);
+         default: return NonTensorPAConvectionApply<2>(NE,NQ,B,G,op,x,y,ND);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch (ND)
+      {
+         case 4:  return NonTensorPAConvectionApply<3,4>(NE,NQ,B,G,op,x,y);
+         case 10: return NonTensorPAConvectionApply<3,10>(NE,NQ,B,G,op,x,y);
+         case 20: return NonTensorPAConvectionApply<3,20>(NE,NQ,B,G,op,x,y);
+         default: return NonTensorPAConvectionApply<3>(NE,NQ,B,G,op,x,y,ND);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
 // PA Convection Apply kernel
 void ConvectionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PAConvectionApplyNonTensor(dim, dofs1D, quad1D, ne, maps->B, maps->G,
+                                 pa_data, x, y);
+      return;
+   }
    PAConvectionApply(dim, dofs1D, quad1D, ne,
                      maps->B, maps->G, maps->Bt, maps->Gt,
                      pa_data, x, y);
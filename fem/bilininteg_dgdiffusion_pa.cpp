@@ -0,0 +1,444 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+#include "restriction.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA DG Diffusion Integrator
+
+// The face terms are written in terms of the traces u1, u2 of both sides and
+// of the derivatives of the traces along the reference axes of the face and
+// along the reference axes of the elements normal to the face. At each
+// quadrature point, the flux {(Q grad(u)).n} is expanded as
+//
+//    sum_s ( c_s,n du_s/dxi_n + sum_a c_s,a du_s/dt_a ),
+//
+// where the coefficients c_s solve [V_s | T_0 | T_1] c_s = w Q_s^T nor. Here
+// V_s is the column of the Jacobian of element s along its reference axis
+// normal to the face, and T_a are the columns of the Jacobian of element 1
+// along the axes of the face dofs, see GetFaceDofs(). The quadrature data
+// holds (c_1, c_2, kappa h^{-1}) at each point, i.e. 2*dim+1 values.
+void DGDiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
+                                    FaceType type)
+{
+   nf = fes.GetNFbyType(type);
+   if (nf==0) { return; }
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "PA DGDiffusionIntegrator requires a "
+               "2D or 3D mesh.");
+   MFEM_VERIFY(fes.GetVDim() == 1, "PA DGDiffusionIntegrator requires a "
+               "scalar space.");
+   const FiniteElement &el = *fes.GetFE(0);
+   const FiniteElement &face_el =
+      *fes.GetTraceElement(0, mesh->GetFaceBaseGeometry(0));
+   // Same integration order as in AssembleFaceMatrix()
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(face_el.GetGeomType(),
+                                             2*el.GetOrder());
+   maps = &face_el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   nq = ir->GetNPoints();
+   const int S = 2*dim + 1;
+   pa_data.SetSize(S * nq * nf, Device::GetMemoryType());
+   auto D = Reshape(pa_data.HostWrite(), nq, S, nf);
+
+   DenseMatrix A(dim), Ainv(dim), mq_s(dim);
+   Vector nor_f(dim), m(dim), c(dim);
+   int f_ind = 0;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      int e1, e2;
+      int inf1, inf2;
+      mesh->GetFaceElements(f, &e1, &e2);
+      mesh->GetFaceInfos(f, &inf1, &inf2);
+      MFEM_VERIFY(e2 >= 0 || inf2 < 0, "Shared faces are not supported with "
+                  "PA DGDiffusionIntegrator.");
+      if ((type==FaceType::Interior && e2<0) ||
+          (type==FaceType::Boundary && e2>=0))
+      {
+         continue;
+      }
+      const int nsides = (e2 >= 0) ? 2 : 1;
+      const int face_id[2] = { inf1 / 64, inf2 / 64 };
+      // The reference axes of element 1 along the face dofs
+      int kn, end, kt[2];
+      GetFaceNormalAxis(dim, face_id[0], kn, end);
+      for (int k = 0, a = 0; k < dim; k++)
+      {
+         if (k != kn) { kt[a++] = k; }
+      }
+      FaceElementTransformations &Tr = *mesh->GetFaceElementTransformations(f);
+      for (int q = 0; q < nq; ++q)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(q);
+         Tr.SetAllIntPoints(&ip);
+         // Convert to lexicographic ordering
+         const int iq = ToLexOrdering(dim, face_id[0], quad1D, q);
+         CalcOrtho(Tr.Jacobian(), nor_f);
+         double wq = 0.0;
+         for (int s = 0; s < 2; s++)
+         {
+            if (s == nsides)
+            {
+               for (int i = 0; i < dim; i++) { D(iq, s*dim + i, f_ind) = 0.0; }
+               continue;
+            }
+            ElementTransformation &T = (s == 0) ? *Tr.Elem1 : *Tr.Elem2;
+            const IntegrationPoint &eip = (s == 0) ? Tr.GetElement1IntPoint() :
+                                          Tr.GetElement2IntPoint();
+            GetFaceNormalAxis(dim, face_id[s], kn, end);
+            for (int i = 0; i < dim; i++)
+            {
+               A(i, 0) = T.Jacobian()(i, kn);
+               for (int a = 0; a < dim-1; a++)
+               {
+                  A(i, a+1) = Tr.Elem1->Jacobian()(i, kt[a]);
+               }
+            }
+            const double detJ = T.Weight();
+            const double w = ip.weight / nsides;
+            if (!MQ)
+            {
+               m.Set(Q ? w*Q->Eval(T, eip) : w, nor_f);
+            }
+            else
+            {
+               MQ->Eval(mq_s, T, eip);
+               mq_s.MultTranspose(nor_f, m);
+               m *= w;
+            }
+            wq += (m * nor_f) / detJ;
+            CalcInverse(A, Ainv);
+            Ainv.Mult(m, c);
+            for (int i = 0; i < dim; i++) { D(iq, s*dim + i, f_ind) = c(i); }
+         }
+         D(iq, 2*dim, f_ind) = kappa * wq;
+      }
+      f_ind++;
+   }
+   MFEM_VERIFY(f_ind==nf, "Incorrect number of faces.");
+}
+
+void DGDiffusionIntegrator::AssemblePAInteriorFaces(
+   const FiniteElementSpace& fes)
+{
+   SetupPA(fes, FaceType::Interior);
+}
+
+void DGDiffusionIntegrator::AssemblePABoundaryFaces(
+   const FiniteElementSpace& fes)
+{
+   SetupPA(fes, FaceType::Boundary);
+}
+
+// PA DGDiffusion Apply 2D kernel for Gauss-Lobatto/Bernstein. The action is
+// a_u < {(Q grad(u)).n}, [v] > + a_v < [u], {(Q grad(v)).n} > + the penalty.
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADGDiffusionApply2D(const int NF,
+                          const Array<double> &b,
+                          const Array<double> &g,
+                          const Vector &_op,
+                          const Vector &_x,
+                          const Vector &_dxdn,
+                          Vector &_y,
+                          Vector &_dydn,
+                          const double a_u,
+                          const double a_v,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto op = Reshape(_op.Read(), Q1D, 5, NF);
+   auto x = Reshape(_x.Read(), D1D, 2, NF);
+   auto dxdn = Reshape(_dxdn.Read(), D1D, 2, NF);
+   auto y = Reshape(_y.ReadWrite(), D1D, 2, NF);
+   auto dydn = Reshape(_dydn.ReadWrite(), D1D, 2, NF);
+
+   MFEM_FORALL(f, NF,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // values, tangential and normal derivatives of both sides
+      double u[2][max_Q1D], du[2][max_Q1D], dn[2][max_Q1D];
+      for (int s = 0; s < 2; s++)
+      {
+         for (int q = 0; q < Q1D; ++q)
+         {
+            double u_q = 0.0, du_q = 0.0, dn_q = 0.0;
+            for (int d = 0; d < D1D; ++d)
+            {
+               u_q += B(q,d)*x(d,s,f);
+               du_q += G(q,d)*x(d,s,f);
+               dn_q += B(q,d)*dxdn(d,s,f);
+            }
+            u[s][q] = u_q;
+            du[s][q] = du_q;
+            dn[s][q] = dn_q;
+         }
+      }
+      for (int q = 0; q < Q1D; ++q)
+      {
+         const double jump = u[0][q] - u[1][q];
+         double flux = 0.0;
+         for (int s = 0; s < 2; s++)
+         {
+            flux += op(q,2*s,f)*dn[s][q] + op(q,2*s+1,f)*du[s][q];
+         }
+         const double val = a_u*flux + op(q,4,f)*jump;
+         u[0][q] = val;
+         u[1][q] = -val;
+         for (int s = 0; s < 2; s++)
+         {
+            dn[s][q] = a_v*jump*op(q,2*s,f);
+            du[s][q] = a_v*jump*op(q,2*s+1,f);
+         }
+      }
+      for (int s = 0; s < 2; s++)
+      {
+         for (int d = 0; d < D1D; ++d)
+         {
+            double y_d = 0.0, dydn_d = 0.0;
+            for (int q = 0; q < Q1D; ++q)
+            {
+               y_d += B(q,d)*u[s][q] + G(q,d)*du[s][q];
+               dydn_d += B(q,d)*dn[s][q];
+            }
+            y(d,s,f) += y_d;
+            dydn(d,s,f) += dydn_d;
+         }
+      }
+   });
+}
+
+// PA DGDiffusion Apply 3D kernel for Gauss-Lobatto/Bernstein
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADGDiffusionApply3D(const int NF,
+                          const Array<double> &b,
+                          const Array<double> &g,
+                          const Vector &_op,
+                          const Vector &_x,
+                          const Vector &_dxdn,
+                          Vector &_y,
+                          Vector &_dydn,
+                          const double a_u,
+                          const double a_v,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, 7, NF);
+   auto x = Reshape(_x.Read(), D1D, D1D, 2, NF);
+   auto dxdn = Reshape(_dxdn.Read(), D1D, D1D, 2, NF);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, 2, NF);
+   auto dydn = Reshape(_dydn.ReadWrite(), D1D, D1D, 2, NF);
+
+   MFEM_FORALL(f, NF,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // values, tangential and normal derivatives of both sides
+      double u[2][max_Q1D][max_Q1D];
+      double du0[2][max_Q1D][max_Q1D], du1[2][max_Q1D][max_Q1D];
+      double dn[2][max_Q1D][max_Q1D];
+      double Bu[max_Q1D][max_D1D], Gu[max_Q1D][max_D1D], Bdn[max_Q1D][max_D1D];
+      for (int s = 0; s < 2; s++)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double bu = 0.0, gu = 0.0, bdn = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  bu += B(qx,dx)*x(dx,dy,s,f);
+                  gu += G(qx,dx)*x(dx,dy,s,f);
+                  bdn += B(qx,dx)*dxdn(dx,dy,s,f);
+               }
+               Bu[qx][dy] = bu;
+               Gu[qx][dy] = gu;
+               Bdn[qx][dy] = bdn;
+            }
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double u_q = 0.0, du0_q = 0.0, du1_q = 0.0, dn_q = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  u_q += B(qy,dy)*Bu[qx][dy];
+                  du0_q += B(qy,dy)*Gu[qx][dy];
+                  du1_q += G(qy,dy)*Bu[qx][dy];
+                  dn_q += B(qy,dy)*Bdn[qx][dy];
+               }
+               u[s][qx][qy] = u_q;
+               du0[s][qx][qy] = du0_q;
+               du1[s][qx][qy] = du1_q;
+               dn[s][qx][qy] = dn_q;
+            }
+         }
+      }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double jump = u[0][qx][qy] - u[1][qx][qy];
+            double flux = 0.0;
+            for (int s = 0; s < 2; s++)
+            {
+               flux += op(qx,qy,3*s,f)*dn[s][qx][qy] +
+                       op(qx,qy,3*s+1,f)*du0[s][qx][qy] +
+                       op(qx,qy,3*s+2,f)*du1[s][qx][qy];
+            }
+            const double val = a_u*flux + op(qx,qy,6,f)*jump;
+            u[0][qx][qy] = val;
+            u[1][qx][qy] = -val;
+            for (int s = 0; s < 2; s++)
+            {
+               dn[s][qx][qy] = a_v*jump*op(qx,qy,3*s,f);
+               du0[s][qx][qy] = a_v*jump*op(qx,qy,3*s+1,f);
+               du1[s][qx][qy] = a_v*jump*op(qx,qy,3*s+2,f);
+            }
+         }
+      }
+      for (int s = 0; s < 2; s++)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double bu = 0.0, gu = 0.0, bdn = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  bu += B(qy,dy)*u[s][qx][qy] + G(qy,dy)*du1[s][qx][qy];
+                  gu += B(qy,dy)*du0[s][qx][qy];
+                  bdn += B(qy,dy)*dn[s][qx][qy];
+               }
+               Bu[qx][dy] = bu;
+               Gu[qx][dy] = gu;
+               Bdn[qx][dy] = bdn;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double y_d = 0.0, dydn_d = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  y_d += B(qx,dx)*Bu[qx][dy] + G(qx,dx)*Gu[qx][dy];
+                  dydn_d += B(qx,dx)*Bdn[qx][dy];
+               }
+               y(dx,dy,s,f) += y_d;
+               dydn(dx,dy,s,f) += dydn_d;
+            }
+         }
+      }
+   });
+}
+
+static void PADGDiffusionApply(const int dim,
+                               const int D1D,
+                               const int Q1D,
+                               const int NF,
+                               const Array<double> &B,
+                               const Array<double> &G,
+                               const Vector &op,
+                               const Vector &x,
+                               const Vector &dxdn,
+                               Vector &y,
+                               Vector &dydn,
+                               const double a_u,
+                               const double a_v)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22:
+            return PADGDiffusionApply2D<2,2>(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v);
+         case 0x33:
+            return PADGDiffusionApply2D<3,3>(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v);
+         case 0x44:
+            return PADGDiffusionApply2D<4,4>(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v);
+         case 0x55:
+            return PADGDiffusionApply2D<5,5>(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v);
+         case 0x66:
+            return PADGDiffusionApply2D<6,6>(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v);
+         default:
+            return PADGDiffusionApply2D(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v,
+                                        D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22:
+            return PADGDiffusionApply3D<2,2>(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v);
+         case 0x33:
+            return PADGDiffusionApply3D<3,3>(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v);
+         case 0x44:
+            return PADGDiffusionApply3D<4,4>(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v);
+         case 0x55:
+            return PADGDiffusionApply3D<5,5>(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v);
+         default:
+            return PADGDiffusionApply3D(NF,B,G,op,x,dxdn,y,dydn,a_u,a_v,
+                                        D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void DGDiffusionIntegrator::AddMultPAFaceNormalDerivatives(const Vector &x,
+                                                           const Vector &dxdn,
+                                                           Vector &y,
+                                                           Vector &dydn) const
+{
+   if (nf == 0) { return; }
+   PADGDiffusionApply(dim, dofs1D, quad1D, nf, maps->B, maps->G, pa_data,
+                      x, dxdn, y, dydn, -1.0, sigma);
+}
+
+void DGDiffusionIntegrator::AddMultTransposePAFaceNormalDerivatives(
+   const Vector &x, const Vector &dxdn, Vector &y, Vector &dydn) const
+{
+   if (nf == 0) { return; }
+   PADGDiffusionApply(dim, dofs1D, quad1D, nf, maps->B, maps->G, pa_data,
+                      x, dxdn, y, dydn, sigma, -1.0);
+}
+
+} // namespace mfem
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/kernel_table.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/diffusion.hpp"
@@ -82,24 +83,25 @@ static void OccaPADiffusionSetup3D(const int D1D,
 
 // PA Diffusion Assemble 2D kernel
 template<const int T_SDIM>
-static void PADiffusionSetup2D(const int Q1D,
+static void PADiffusionSetup2D(const int NQ,
+                               const int NJ,
                                const int NE,
                                const Array<double> &w,
                                const Vector &j,
                                const Vector &c,
                                Vector &d);
 template<>
-void PADiffusionSetup2D<2>(const int Q1D,
+void PADiffusionSetup2D<2>(const int NQ,
+                           const int NJ,
                            const int NE,
                            const Array<double> &w,
                            const Vector &j,
                            const Vector &c,
                            Vector &d)
 {
-   const int NQ = Q1D*Q1D;
    const bool const_c = c.Size() == 1;
    auto W = w.Read();
-   auto J = Reshape(j.Read(), NQ, 2, 2, NE);
+   auto J = Reshape(j.Read(), NJ, 2, 2, NE);
    auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
    auto D = Reshape(d.Write(), NQ, 3, NE);
 
@@ -107,10 +109,11 @@ void PADiffusionSetup2D<2>(const int Q1D,
    {
       for (int q = 0; q < NQ; ++q)
       {
-         const double J11 = J(q,0,0,e);
-         const double J21 = J(q,1,0,e);
-         const double J12 = J(q,0,1,e);
-         const double J22 = J(q,1,1,e);
+         const int qj = (NJ == 1) ? 0 : q;
+         const double J11 = J(qj,0,0,e);
+         const double J21 = J(qj,1,0,e);
+         const double J12 = J(qj,0,1,e);
+         const double J22 = J(qj,1,1,e);
          const double coeff = const_c ? C(0,0) : C(q,e);
          const double c_detJ = W[q] * coeff / ((J11*J22)-(J21*J12));
          D(q,0,e) =  c_detJ * (J12*J12 + J22*J22); // 1,1
@@ -122,7 +125,8 @@ void PADiffusionSetup2D<2>(const int Q1D,
 
 // PA Diffusion Assemble 2D kernel with 3D node coords
 template<>
-void PADiffusionSetup2D<3>(const int Q1D,
+void PADiffusionSetup2D<3>(const int NQ,
+                           const int NJ,
                            const int NE,
                            const Array<double> &w,
                            const Vector &j,
@@ -131,11 +135,10 @@ void PADiffusionSetup2D<3>(const int Q1D,
 {
    constexpr int DIM = 2;
    constexpr int SDIM = 3;
-   const int NQ = Q1D*Q1D;
    const bool const_c = c.Size() == 1;
 
    auto W = w.Read();
-   auto J = Reshape(j.Read(), NQ, SDIM, DIM, NE);
+   auto J = Reshape(j.Read(), NJ, SDIM, DIM, NE);
    auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
    auto D = Reshape(d.Write(), NQ, 3, NE);
    MFEM_FORALL(e, NE,
@@ -143,12 +146,13 @@ void PADiffusionSetup2D<3>(const int Q1D,
       for (int q = 0; q < NQ; ++q)
       {
          const double wq = W[q];
-         const double J11 = J(q,0,0,e);
-         const double J21 = J(q,1,0,e);
-         const double J31 = J(q,2,0,e);
-         const double J12 = J(q,0,1,e);
-         const double J22 = J(q,1,1,e);
-         const double J32 = J(q,2,1,e);
+         const int qj = (NJ == 1) ? 0 : q;
+         const double J11 = J(qj,0,0,e);
+         const double J21 = J(qj,1,0,e);
+         const double J31 = J(qj,2,0,e);
+         const double J12 = J(qj,0,1,e);
+         const double J22 = J(qj,1,1,e);
+         const double J32 = J(qj,2,1,e);
          const double E = J11*J11 + J21*J21 + J31*J31;
          const double G = J12*J12 + J22*J22 + J32*J32;
          const double F = J11*J12 + J21*J22 + J31*J32;
@@ -163,32 +167,33 @@ void PADiffusionSetup2D<3>(const int Q1D,
 }
 
 // PA Diffusion Assemble 3D kernel
-static void PADiffusionSetup3D(const int Q1D,
+static void PADiffusionSetup3D(const int NQ,
+                               const int NJ,
                                const int NE,
                                const Array<double> &w,
                                const Vector &j,
                                const Vector &c,
                                Vector &d)
 {
-   const int NQ = Q1D*Q1D*Q1D;
    const bool const_c = c.Size() == 1;
    auto W = w.Read();
-   auto J = Reshape(j.Read(), NQ, 3, 3, NE);
+   auto J = Reshape(j.Read(), NJ, 3, 3, NE);
    auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
    auto D = Reshape(d.Write(), NQ, 6, NE);
    MFEM_FORALL(e, NE,
    {
       for (int q = 0; q < NQ; ++q)
       {
-         const double J11 = J(q,0,0,e);
-         const double J21 = J(q,1,0,e);
-         const double J31 = J(q,2,0,e);
-         const double J12 = J(q,0,1,e);
-         const double J22 = J(q,1,1,e);
-         const double J32 = J(q,2,1,e);
-         const double J13 = J(q,0,2,e);
-         const double J23 = J(q,1,2,e);
-         const double J33 = J(q,2,2,e);
+         const int qj = (NJ == 1) ? 0 : q;
+         const double J11 = J(qj,0,0,e);
+         const double J21 = J(qj,1,0,e);
+         const double J31 = J(qj,2,0,e);
+         const double J12 = J(qj,0,1,e);
+         const double J22 = J(qj,1,1,e);
+         const double J32 = J(qj,2,1,e);
+         const double J13 = J(qj,0,2,e);
+         const double J23 = J(qj,1,2,e);
+         const double J33 = J(qj,2,2,e);
          const double detJ = J11 * (J22 * J33 - J32 * J23) -
          /* */               J21 * (J12 * J33 - J32 * J13) +
          /* */               J31 * (J12 * J23 - J22 * J13);
@@ -219,6 +224,7 @@ static void PADiffusionSetup(const int dim,
                              const int sdim,
                              const int D1D,
                              const int Q1D,
+                             const int NJ,
                              const int NE,
                              const Array<double> &W,
                              const Vector &J,
@@ -237,8 +243,8 @@ static void PADiffusionSetup(const int dim,
 #else
       MFEM_CONTRACT_VAR(D1D);
 #endif // MFEM_USE_OCCA
-      if (sdim == 2) { PADiffusionSetup2D<2>(Q1D, NE, W, J, C, D); }
-      if (sdim == 3) { PADiffusionSetup2D<3>(Q1D, NE, W, J, C, D); }
+      if (sdim == 2) { PADiffusionSetup2D<2>(W.Size(), NJ, NE, W, J, C, D); }
+      if (sdim == 3) { PADiffusionSetup2D<3>(W.Size(), NJ, NE, W, J, C, D); }
    }
    if (dim == 3)
    {
@@ -249,7 +255,7 @@ static void PADiffusionSetup(const int dim,
          return;
       }
 #endif // MFEM_USE_OCCA
-      PADiffusionSetup3D(Q1D, NE, W, J, C, D);
+      PADiffusionSetup3D(W.Size(), NJ, NE, W, J, C, D);
    }
 }
 
@@ -279,9 +285,25 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
    const int nq = ir->GetNPoints();
    dim = mesh->Dimension();
    ne = fes.GetNE();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   // On affine meshes, a single Jacobian per element is stored and used,
+   // except by the OCCA kernels
+   geom = mesh->GetAffineGeometricFactors(GeometricFactors::JACOBIANS);
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { geom = NULL; }
+#endif
+   if (geom == NULL)
+   {
+      geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   }
    const int sdim = mesh->SpaceDimension();
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   // With non-tensor elements, e.g. triangles and tetrahedra, dofs1D and
+   // quad1D are the total numbers of dofs and quadrature points
+   const bool tensor = UsesTensorBasis(fes);
+#ifdef MFEM_USE_OCCA
+   MFEM_VERIFY(tensor || !DeviceCanUseOcca(),
+               "OCCA PA kernels require tensor-product elements.");
+#endif
+   maps = &el.GetDofToQuad(*ir, tensor ? DofToQuad::TENSOR : DofToQuad::FULL);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    pa_data.SetSize(symmDims * nq * ne, Device::GetDeviceMemoryType());
@@ -311,19 +333,11 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->Project(coeff, *fes.GetMesh(), *ir);
    }
-   PADiffusionSetup(dim, sdim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J,
-                    coeff, pa_data);
+   const int nj = geom->IntRule->GetNPoints();
+   PADiffusionSetup(dim, sdim, dofs1D, quad1D, nj, ne, ir->GetWeights(),
+                    geom->J, coeff, pa_data);
 }
 
 void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
@@ -332,7 +346,9 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
 }
 
 
-template<int T_D1D = 0, int T_Q1D = 0>
+// When T_D1D and T_Q1D are not given, the working arrays are sized with the
+// bound T_MAX, which defaults to MAX_D1D and MAX_Q1D.
+template<int T_D1D = 0, int T_Q1D = 0, int T_MAX = 0>
 static void PADiffusionDiagonal2D(const int NE,
                                   const Array<double> &b,
                                   const Array<double> &g,
@@ -343,8 +359,8 @@ static void PADiffusionDiagonal2D(const int NE,
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(D1D <= (T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D), "");
+   MFEM_VERIFY(Q1D <= (T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D), "");
    auto B = Reshape(b.Read(), Q1D, D1D);
    auto G = Reshape(g.Read(), Q1D, D1D);
    // note the different shape for D, this is a (symmetric) matrix so we only
@@ -355,8 +371,8 @@ static void PADiffusionDiagonal2D(const int NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D;
       // gradphi \cdot Q \gradphi has four terms
       double QD0[MQ1][MD1];
       double QD1[MQ1][MD1];
@@ -490,7 +506,8 @@ static void SmemPADiffusionDiagonal2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+// See PADiffusionDiagonal2D for the meaning of T_MAX.
+template<int T_D1D = 0, int T_Q1D = 0, int T_MAX = 0>
 static void PADiffusionDiagonal3D(const int NE,
                                   const Array<double> &b,
                                   const Array<double> &g,
@@ -502,8 +519,8 @@ static void PADiffusionDiagonal3D(const int NE,
    constexpr int DIM = 3;
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-   constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+   constexpr int MQ1 = T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D;
+   constexpr int MD1 = T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D;
    MFEM_VERIFY(D1D <= MD1, "");
    MFEM_VERIFY(Q1D <= MQ1, "");
    auto B = Reshape(b.Read(), Q1D, D1D);
@@ -514,8 +531,8 @@ static void PADiffusionDiagonal3D(const int NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D;
       double QQD[MQ1][MQ1][MD1];
       double QDD[MQ1][MD1][MD1];
       for (int i = 0; i < DIM; ++i)
@@ -705,6 +722,56 @@ static void SmemPADiffusionDiagonal3D(const int NE,
    });
 }
 
+typedef void (*PADiffusionDiagonalKernel)(const int NE,
+                                          const Array<double> &B,
+                                          const Array<double> &G,
+                                          const Vector &D,
+                                          Vector &Y,
+                                          const int d1d,
+                                          const int q1d);
+
+// PA Diffusion Diagonal kernels for the sizes requested with MFEM_PA_KERNELS
+template<int DIM, int D1D, int Q1D> struct PADiffusionDiagonalSpec;
+
+template<int D1D, int Q1D> struct PADiffusionDiagonalSpec<2,D1D,Q1D>
+{
+   static constexpr int NBZ = D1D <= 3 ? 8 : D1D <= 5 ? 4 : D1D <= 7 ? 2 : 1;
+   static PADiffusionDiagonalKernel Kernel()
+   { return SmemPADiffusionDiagonal2D<D1D,Q1D,NBZ>; }
+};
+
+template<int D1D, int Q1D> struct PADiffusionDiagonalSpec<3,D1D,Q1D>
+{
+   static PADiffusionDiagonalKernel Kernel()
+   { return SmemPADiffusionDiagonal3D<D1D,Q1D>; }
+};
+
+static KernelTable<PADiffusionDiagonalKernel> MakePADiffusionDiagonalTable()
+{
+   KernelTable<PADiffusionDiagonalKernel> t;
+   t.Add(2,2,2,SmemPADiffusionDiagonal2D<2,2,8>);
+   t.Add(2,3,3,SmemPADiffusionDiagonal2D<3,3,8>);
+   t.Add(2,4,4,SmemPADiffusionDiagonal2D<4,4,4>);
+   t.Add(2,5,5,SmemPADiffusionDiagonal2D<5,5,4>);
+   t.Add(2,6,6,SmemPADiffusionDiagonal2D<6,6,2>);
+   t.Add(2,7,7,SmemPADiffusionDiagonal2D<7,7,2>);
+   t.Add(2,8,8,SmemPADiffusionDiagonal2D<8,8,1>);
+   t.Add(2,9,9,SmemPADiffusionDiagonal2D<9,9,1>);
+   t.Add(3,2,3,SmemPADiffusionDiagonal3D<2,3>);
+   t.Add(3,3,4,SmemPADiffusionDiagonal3D<3,4>);
+   t.Add(3,4,5,SmemPADiffusionDiagonal3D<4,5>);
+   t.Add(3,5,6,SmemPADiffusionDiagonal3D<5,6>);
+   t.Add(3,6,7,SmemPADiffusionDiagonal3D<6,7>);
+   t.Add(3,7,8,SmemPADiffusionDiagonal3D<7,8>);
+   t.Add(3,8,9,SmemPADiffusionDiagonal3D<8,9>);
+   t.Add(3,9,10,SmemPADiffusionDiagonal3D<9,10>);
+#define MFEM_PA_KERNEL(DIM,D1D,Q1D) \
+   t.Add(DIM,D1D,Q1D,PADiffusionDiagonalSpec<DIM,D1D,Q1D>::Kernel());
+   MFEM_PA_KERNEL_SPECS
+#undef MFEM_PA_KERNEL
+   return t;
+}
+
 static void PADiffusionAssembleDiagonal(const int dim,
                                         const int D1D,
                                         const int Q1D,
@@ -713,35 +780,101 @@ static void PADiffusionAssembleDiagonal(const int dim,
                                         const Array<double> &G,
                                         const Vector &D,
                                         Vector &Y)
+{
+   static const KernelTable<PADiffusionDiagonalKernel> kernels =
+      MakePADiffusionDiagonalTable();
+   if (PADiffusionDiagonalKernel kernel = kernels.Find(dim, D1D, Q1D))
+   {
+      return kernel(NE,B,G,D,Y,D1D,Q1D);
+   }
+   // Generic kernels, with the working arrays sized by the smallest bound
+   const int M = std::max(D1D, Q1D);
+   if (dim == 2)
+   {
+      if (M <= 4) { return PADiffusionDiagonal2D<0,0,4>(NE,B,G,D,Y,D1D,Q1D); }
+      if (M <= 8) { return PADiffusionDiagonal2D<0,0,8>(NE,B,G,D,Y,D1D,Q1D); }
+      return PADiffusionDiagonal2D(NE,B,G,D,Y,D1D,Q1D);
+   }
+   else if (dim == 3)
+   {
+      if (M <= 4) { return PADiffusionDiagonal3D<0,0,4>(NE,B,G,D,Y,D1D,Q1D); }
+      if (M <= 8) { return PADiffusionDiagonal3D<0,0,8>(NE,B,G,D,Y,D1D,Q1D); }
+      return PADiffusionDiagonal3D(NE,B,G,D,Y,D1D,Q1D);
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// Index of the entry (i,j) of a symmetric DIM x DIM matrix stored as its
+// upper triangular part, row by row, as in the quadrature data of the kernels.
+template<int DIM> static MFEM_HOST_DEVICE inline
+int SymmIndex(const int i, const int j)
+{
+   return (i <= j) ? i*DIM - (i*(i-1))/2 + j - i : j*DIM - (j*(j-1))/2 + i - j;
+}
+
+// PA Diffusion Diagonal kernel for non-tensor elements, e.g. triangles and
+// tetrahedra, using the full NQ x DIM x ND matrix G
+template<int DIM, int T_ND = 0> static
+void NonTensorPADiffusionDiagonal(const int NE,
+                                  const int NQ,
+                                  const Array<double> &g,
+                                  const Vector &d,
+                                  Vector &y,
+                                  const int nd = 0)
+{
+   constexpr int S = (DIM*(DIM+1))/2;
+   const int ND = T_ND ? T_ND : nd;
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto D = Reshape(d.Read(), NQ, S, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int ND = T_ND ? T_ND : nd;
+      for (int dof = 0; dof < ND; ++dof)
+      {
+         double val = 0.0;
+         for (int q = 0; q < NQ; ++q)
+         {
+            for (int i = 0; i < DIM; ++i)
+            {
+               for (int j = 0; j < DIM; ++j)
+               {
+                  val += G(q,i,dof)*D(q,SymmIndex<DIM>(i,j),e)*G(q,j,dof);
+               }
+            }
+         }
+         Y(dof,e) += val;
+      }
+   });
+}
+
+static void PADiffusionAssembleDiagonalNonTensor(const int dim,
+                                                 const int ND,
+                                                 const int NQ,
+                                                 const int NE,
+                                                 const Array<double> &G,
+                                                 const Vector &D,
+                                                 Vector &Y)
 {
    if (dim == 2)
    {
-      switch ((D1D << 4 ) | Q1D)
+      switch (ND)
       {
-         case 0x22: return SmemPADiffusionDiagonal2D<2,2,8>(NE,B,G,D,Y);
-         case 0x33: return SmemPADiffusionDiagonal2D<3,3,8>(NE,B,G,D,Y);
-         case 0x44: return SmemPADiffusionDiagonal2D<4,4,4>(NE,B,G,D,Y);
-         case 0x55: return SmemPADiffusionDiagonal2D<5,5,4>(NE,B,G,D,Y);
-         case 0x66: return SmemPADiffusionDiagonal2D<6,6,2>(NE,B,G,D,Y);
-         case 0x77: return SmemPADiffusionDiagonal2D<7,7,2>(NE,B,G,D,Y);
-         case 0x88: return SmemPADiffusionDiagonal2D<8,8,1>(NE,B,G,D,Y);
-         case 0x99: return SmemPADiffusionDiagonal2D<9,9,1>(NE,B,G,D,Y);
-         default: return PADiffusionDiagonal2D(NE,B,G,D,Y,D1D,Q1D);
+         case 3:  return NonTensorPADiffusionDiagonal<2,3>(NE,NQ,G,D,Y);
+         case 6:  return NonTensorPADiffusionDiagonal<2,6>(NE,NQ,G,D,Y);
+         case 10: return NonTensorPADiffusionDiagonal<2,10>(NE,NQ,G,D,Y);
+         case 15: return NonTensorPADiffusionDiagonal<2,15>(NE,NQ,G,D,Y);
+         default: return NonTensorPADiffusionDiagonal<2>(NE,NQ,G,D,Y,ND);
       }
    }
    else if (dim == 3)
    {
-      switch ((D1D << 4 ) | Q1D)
+      switch (ND)
       {
-         case 0x23: return SmemPADiffusionDiagonal3D<2,3>(NE,B,G,D,Y);
-         case 0x34: return SmemPADiffusionDiagonal3D<3,4>(NE,B,G,D,Y);
-         case 0x45: return SmemPADiffusionDiagonal3D<4,5>(NE,B,G,D,Y);
-         case 0x56: return SmemPADiffusionDiagonal3D<5,6>(NE,B,G,D,Y);
-         case 0x67: return SmemPADiffusionDiagonal3D<6,7>(NE,B,G,D,Y);
-         case 0x78: return SmemPADiffusionDiagonal3D<7,8>(NE,B,G,D,Y);
-         case 0x89: return SmemPADiffusionDiagonal3D<8,9>(NE,B,G,D,Y);
-         case 0x9A: return SmemPADiffusionDiagonal3D<9,10>(NE,B,G,D,Y);
-         default: return PADiffusionDiagonal3D(NE,B,G,D,Y,D1D,Q1D);
+         case 4:  return NonTensorPADiffusionDiagonal<3,4>(NE,NQ,G,D,Y);
+         case 10: return NonTensorPADiffusionDiagonal<3,10>(NE,NQ,G,D,Y);
+         case 20: return NonTensorPADiffusionDiagonal<3,20>(NE,NQ,G,D,Y);
+         default: return NonTensorPADiffusionDiagonal<3>(NE,NQ,G,D,Y,ND);
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -750,6 +883,12 @@ static void PADiffusionAssembleDiagonal(const int dim,
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (pa_data.Size()==0) { SetupPA(*fespace, true); }
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PADiffusionAssembleDiagonalNonTensor(dim, dofs1D, quad1D, ne,
+                                           maps->G, pa_data, diag);
+      return;
+   }
    PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne,
                                maps->B, maps->G, pa_data, diag);
 }
@@ -855,8 +994,13 @@ static void OccaPADiffusionApply3D(const int D1D,
 }
 #endif // MFEM_USE_OCCA
 
-// PA Diffusion Apply 2D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+// PA Diffusion Apply 2D kernel, generic version used when there is no
+// specialization for the given sizes. When T_D1D and T_Q1D are not given, the
+// working arrays are sized with the bound T_MAX (MAX_D1D and MAX_Q1D by
+// default), which the dispatcher picks as small as possible to keep them in
+// cache. The arrays are stored component by component, so that the innermost
+// loops are unit-stride and can be vectorized by the compiler.
+template<int T_D1D = 0, int T_Q1D = 0, int T_MAX = 0>
 static void PADiffusionApply2D(const int NE,
                                const Array<double> &b_,
                                const Array<double> &g_,
@@ -870,8 +1014,8 @@ static void PADiffusionApply2D(const int NE,
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(D1D <= (T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D), "");
+   MFEM_VERIFY(Q1D <= (T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D), "");
    auto B = Reshape(b_.Read(), Q1D, D1D);
    auto G = Reshape(g_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
@@ -884,33 +1028,33 @@ static void PADiffusionApply2D(const int NE,
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int max_D1D = T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D;
 
-      double grad[max_Q1D][max_Q1D][2];
+      double grad[2][max_Q1D][max_Q1D];
       for (int qy = 0; qy < Q1D; ++qy)
       {
          for (int qx = 0; qx < Q1D; ++qx)
          {
-            grad[qy][qx][0] = 0.0;
-            grad[qy][qx][1] = 0.0;
+            grad[0][qy][qx] = 0.0;
+            grad[1][qy][qx] = 0.0;
          }
       }
       for (int dy = 0; dy < D1D; ++dy)
       {
-         double gradX[max_Q1D][2];
+         double gradX[2][max_Q1D];
          for (int qx = 0; qx < Q1D; ++qx)
          {
-            gradX[qx][0] = 0.0;
-            gradX[qx][1] = 0.0;
+            gradX[0][qx] = 0.0;
+            gradX[1][qx] = 0.0;
          }
          for (int dx = 0; dx < D1D; ++dx)
          {
             const double s = X(dx,dy,e);
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               gradX[qx][0] += s * B(qx,dx);
-               gradX[qx][1] += s * G(qx,dx);
+               gradX[0][qx] += s * B(qx,dx);
+               gradX[1][qx] += s * G(qx,dx);
             }
          }
          for (int qy = 0; qy < Q1D; ++qy)
@@ -919,8 +1063,8 @@ static void PADiffusionApply2D(const int NE,
             const double wDy = G(qy,dy);
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               grad[qy][qx][0] += gradX[qx][1] * wy;
-               grad[qy][qx][1] += gradX[qx][0] * wDy;
+               grad[0][qy][qx] += gradX[1][qx] * wy;
+               grad[1][qy][qx] += gradX[0][qx] * wDy;
             }
          }
       }
@@ -935,31 +1079,31 @@ static void PADiffusionApply2D(const int NE,
             const double O12 = D(q,1,e);
             const double O22 = D(q,2,e);
 
-            const double gradX = grad[qy][qx][0];
-            const double gradY = grad[qy][qx][1];
+            const double gradX = grad[0][qy][qx];
+            const double gradY = grad[1][qy][qx];
 
-            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
-            grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+            grad[0][qy][qx] = (O11 * gradX) + (O12 * gradY);
+            grad[1][qy][qx] = (O12 * gradX) + (O22 * gradY);
          }
       }
       for (int qy = 0; qy < Q1D; ++qy)
       {
-         double gradX[max_D1D][2];
+         double gradX[2][max_D1D];
          for (int dx = 0; dx < D1D; ++dx)
          {
-            gradX[dx][0] = 0;
-            gradX[dx][1] = 0;
+            gradX[0][dx] = 0;
+            gradX[1][dx] = 0;
          }
          for (int qx = 0; qx < Q1D; ++qx)
          {
-            const double gX = grad[qy][qx][0];
-            const double gY = grad[qy][qx][1];
+            const double gX = grad[0][qy][qx];
+            const double gY = grad[1][qy][qx];
             for (int dx = 0; dx < D1D; ++dx)
             {
                const double wx  = Bt(dx,qx);
                const double wDx = Gt(dx,qx);
-               gradX[dx][0] += gX * wDx;
-               gradX[dx][1] += gY * wx;
+               gradX[0][dx] += gX * wDx;
+               gradX[1][dx] += gY * wx;
             }
          }
          for (int dy = 0; dy < D1D; ++dy)
@@ -968,7 +1112,7 @@ static void PADiffusionApply2D(const int NE,
             const double wDy = Gt(dy,qy);
             for (int dx = 0; dx < D1D; ++dx)
             {
-               Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               Y(dx,dy,e) += ((gradX[0][dx] * wy) + (gradX[1][dx] * wDy));
             }
          }
       }
@@ -1013,12 +1157,16 @@ static void SmemPADiffusionApply2D(const int NE,
       double (*Gt)[MQ1] = (double (*)[MQ1]) (sBG+1);
       MFEM_SHARED double Xz[NBZ][MD1][MD1];
       MFEM_SHARED double GD[2][NBZ][MD1][MQ1];
-      MFEM_SHARED double GQ[2][NBZ][MD1][MQ1];
+      MFEM_SHARED double GQ[2][NBZ][MQ1][MQ1];
       double (*X)[MD1] = (double (*)[MD1])(Xz + tidz);
-      double (*DQ0)[MD1] = (double (*)[MD1])(GD[0] + tidz);
-      double (*DQ1)[MD1] = (double (*)[MD1])(GD[1] + tidz);
-      double (*QQ0)[MD1] = (double (*)[MD1])(GQ[0] + tidz);
-      double (*QQ1)[MD1] = (double (*)[MD1])(GQ[1] + tidz);
+      // GD holds D1D x Q1D values, indexed [dy][qx] on the way in and
+      // [qy][dx] on the way out
+      double (*DQ0)[MQ1] = (double (*)[MQ1])(GD[0] + tidz);
+      double (*DQ1)[MQ1] = (double (*)[MQ1])(GD[1] + tidz);
+      double (*QD0)[MD1] = (double (*)[MD1])(GD[0] + tidz);
+      double (*QD1)[MD1] = (double (*)[MD1])(GD[1] + tidz);
+      double (*QQ0)[MQ1] = (double (*)[MQ1])(GQ[0] + tidz);
+      double (*QQ1)[MQ1] = (double (*)[MQ1])(GQ[1] + tidz);
       MFEM_FOREACH_THREAD(dy,y,D1D)
       {
          MFEM_FOREACH_THREAD(dx,x,D1D)
@@ -1109,8 +1257,8 @@ static void SmemPADiffusionApply2D(const int NE,
                u += Gt[dx][qx] * QQ0[qy][qx];
                v += Bt[dx][qx] * QQ1[qy][qx];
             }
-            DQ0[qy][dx] = u;
-            DQ1[qy][dx] = v;
+            QD0[qy][dx] = u;
+            QD1[qy][dx] = v;
          }
       }
       MFEM_SYNC_THREAD;
@@ -1122,8 +1270,8 @@ static void SmemPADiffusionApply2D(const int NE,
             double v = 0.0;
             for (int qy = 0; qy < Q1D; ++qy)
             {
-               u += DQ0[qy][dx] * Bt[dy][qy];
-               v += DQ1[qy][dx] * Gt[dy][qy];
+               u += QD0[qy][dx] * Bt[dy][qy];
+               v += QD1[qy][dx] * Gt[dy][qy];
             }
             Y(dx,dy,e) += (u + v);
          }
@@ -1131,8 +1279,10 @@ static void SmemPADiffusionApply2D(const int NE,
    });
 }
 
-// PA Diffusion Apply 3D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+// PA Diffusion Apply 3D kernel, generic version used when there is no
+// specialization for the given sizes. See PADiffusionApply2D for the meaning
+// of T_MAX and the layout of the working arrays.
+template<int T_D1D = 0, int T_Q1D = 0, int T_MAX = 0>
 static void PADiffusionApply3D(const int NE,
                                const Array<double> &b,
                                const Array<double> &g,
@@ -1145,8 +1295,8 @@ static void PADiffusionApply3D(const int NE,
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(D1D <= (T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D), "");
+   MFEM_VERIFY(Q1D <= (T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D), "");
    auto B = Reshape(b.Read(), Q1D, D1D);
    auto G = Reshape(g.Read(), Q1D, D1D);
    auto Bt = Reshape(bt.Read(), D1D, Q1D);
@@ -1158,48 +1308,48 @@ static void PADiffusionApply3D(const int NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double grad[max_Q1D][max_Q1D][max_Q1D][3];
+      constexpr int max_D1D = T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D;
+      double grad[3][max_Q1D][max_Q1D][max_Q1D];
       for (int qz = 0; qz < Q1D; ++qz)
       {
          for (int qy = 0; qy < Q1D; ++qy)
          {
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               grad[qz][qy][qx][0] = 0.0;
-               grad[qz][qy][qx][1] = 0.0;
-               grad[qz][qy][qx][2] = 0.0;
+               grad[0][qz][qy][qx] = 0.0;
+               grad[1][qz][qy][qx] = 0.0;
+               grad[2][qz][qy][qx] = 0.0;
             }
          }
       }
       for (int dz = 0; dz < D1D; ++dz)
       {
-         double gradXY[max_Q1D][max_Q1D][3];
+         double gradXY[3][max_Q1D][max_Q1D];
          for (int qy = 0; qy < Q1D; ++qy)
          {
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               gradXY[qy][qx][0] = 0.0;
-               gradXY[qy][qx][1] = 0.0;
-               gradXY[qy][qx][2] = 0.0;
+               gradXY[0][qy][qx] = 0.0;
+               gradXY[1][qy][qx] = 0.0;
+               gradXY[2][qy][qx] = 0.0;
             }
          }
          for (int dy = 0; dy < D1D; ++dy)
          {
-            double gradX[max_Q1D][2];
+            double gradX[2][max_Q1D];
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               gradX[qx][0] = 0.0;
-               gradX[qx][1] = 0.0;
+               gradX[0][qx] = 0.0;
+               gradX[1][qx] = 0.0;
             }
             for (int dx = 0; dx < D1D; ++dx)
             {
                const double s = X(dx,dy,dz,e);
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  gradX[qx][0] += s * B(qx,dx);
-                  gradX[qx][1] += s * G(qx,dx);
+                  gradX[0][qx] += s * B(qx,dx);
+                  gradX[1][qx] += s * G(qx,dx);
                }
             }
             for (int qy = 0; qy < Q1D; ++qy)
@@ -1208,11 +1358,11 @@ static void PADiffusionApply3D(const int NE,
                const double wDy = G(qy,dy);
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  const double wx  = gradX[qx][0];
-                  const double wDx = gradX[qx][1];
-                  gradXY[qy][qx][0] += wDx * wy;
-                  gradXY[qy][qx][1] += wx  * wDy;
-                  gradXY[qy][qx][2] += wx  * wy;
+                  const double wx  = gradX[0][qx];
+                  const double wDx = gradX[1][qx];
+                  gradXY[0][qy][qx] += wDx * wy;
+                  gradXY[1][qy][qx] += wx  * wDy;
+                  gradXY[2][qy][qx] += wx  * wy;
                }
             }
          }
@@ -1224,9 +1374,9 @@ static void PADiffusionApply3D(const int NE,
             {
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
-                  grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
-                  grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+                  grad[0][qz][qy][qx] += gradXY[0][qy][qx] * wz;
+                  grad[1][qz][qy][qx] += gradXY[1][qy][qx] * wz;
+                  grad[2][qz][qy][qx] += gradXY[2][qy][qx] * wDz;
                }
             }
          }
@@ -1245,48 +1395,48 @@ static void PADiffusionApply3D(const int NE,
                const double O22 = D(q,3,e);
                const double O23 = D(q,4,e);
                const double O33 = D(q,5,e);
-               const double gradX = grad[qz][qy][qx][0];
-               const double gradY = grad[qz][qy][qx][1];
-               const double gradZ = grad[qz][qy][qx][2];
-               grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
-               grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
-               grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
+               const double gradX = grad[0][qz][qy][qx];
+               const double gradY = grad[1][qz][qy][qx];
+               const double gradZ = grad[2][qz][qy][qx];
+               grad[0][qz][qy][qx] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+               grad[1][qz][qy][qx] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
+               grad[2][qz][qy][qx] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
             }
          }
       }
       for (int qz = 0; qz < Q1D; ++qz)
       {
-         double gradXY[max_D1D][max_D1D][3];
+         double gradXY[3][max_D1D][max_D1D];
          for (int dy = 0; dy < D1D; ++dy)
          {
             for (int dx = 0; dx < D1D; ++dx)
             {
-               gradXY[dy][dx][0] = 0;
-               gradXY[dy][dx][1] = 0;
-               gradXY[dy][dx][2] = 0;
+               gradXY[0][dy][dx] = 0;
+               gradXY[1][dy][dx] = 0;
+               gradXY[2][dy][dx] = 0;
             }
          }
          for (int qy = 0; qy < Q1D; ++qy)
          {
-            double gradX[max_D1D][3];
+            double gradX[3][max_D1D];
             for (int dx = 0; dx < D1D; ++dx)
             {
-               gradX[dx][0] = 0;
-               gradX[dx][1] = 0;
-               gradX[dx][2] = 0;
+               gradX[0][dx] = 0;
+               gradX[1][dx] = 0;
+               gradX[2][dx] = 0;
             }
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               const double gX = grad[qz][qy][qx][0];
-               const double gY = grad[qz][qy][qx][1];
-               const double gZ = grad[qz][qy][qx][2];
+               const double gX = grad[0][qz][qy][qx];
+               const double gY = grad[1][qz][qy][qx];
+               const double gZ = grad[2][qz][qy][qx];
                for (int dx = 0; dx < D1D; ++dx)
                {
                   const double wx  = Bt(dx,qx);
                   const double wDx = Gt(dx,qx);
-                  gradX[dx][0] += gX * wDx;
-                  gradX[dx][1] += gY * wx;
-                  gradX[dx][2] += gZ * wx;
+                  gradX[0][dx] += gX * wDx;
+                  gradX[1][dx] += gY * wx;
+                  gradX[2][dx] += gZ * wx;
                }
             }
             for (int dy = 0; dy < D1D; ++dy)
@@ -1295,9 +1445,9 @@ static void PADiffusionApply3D(const int NE,
                const double wDy = Gt(dy,qy);
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
-                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
-                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  gradXY[0][dy][dx] += gradX[0][dx] * wy;
+                  gradXY[1][dy][dx] += gradX[1][dx] * wDy;
+                  gradXY[2][dy][dx] += gradX[2][dx] * wy;
                }
             }
          }
@@ -1310,9 +1460,9 @@ static void PADiffusionApply3D(const int NE,
                for (int dx = 0; dx < D1D; ++dx)
                {
                   Y(dx,dy,dz,e) +=
-                     ((gradXY[dy][dx][0] * wz) +
-                      (gradXY[dy][dx][1] * wz) +
-                      (gradXY[dy][dx][2] * wDz));
+                     ((gradXY[0][dy][dx] * wz) +
+                      (gradXY[1][dy][dx] * wz) +
+                      (gradXY[2][dy][dx] * wDz));
                }
             }
          }
@@ -1637,6 +1787,80 @@ static void SmemPADiffusionApply3D(const int NE,
    });
 }
 
+typedef void (*PADiffusionApplyKernel)(const int NE,
+                                       const Array<double> &B,
+                                       const Array<double> &G,
+                                       const Array<double> &Bt,
+                                       const Array<double> &Gt,
+                                       const Vector &D,
+                                       const Vector &X,
+                                       Vector &Y,
+                                       const int d1d,
+                                       const int q1d);
+
+// PA Diffusion Apply kernels specialized for the given sizes
+template<int DIM, int D1D, int Q1D> struct PADiffusionApplySpec;
+
+template<int D1D, int Q1D> struct PADiffusionApplySpec<2,D1D,Q1D>
+{
+   static constexpr int NBZ =
+      D1D <= 3 ? 16 : D1D <= 5 ? 8 : D1D <= 7 ? 4 : D1D <= 9 ? 2 : 1;
+   static void Apply(const int NE,
+                     const Array<double> &B, const Array<double> &G,
+                     const Array<double> &Bt, const Array<double> &Gt,
+                     const Vector &D, const Vector &X, Vector &Y,
+                     const int, const int)
+   { SmemPADiffusionApply2D<D1D,Q1D,NBZ>(NE,B,G,D,X,Y); }
+};
+
+template<int D1D, int Q1D> struct PADiffusionApplySpec<3,D1D,Q1D>
+{
+   // The shared memory kernel stores B and G in a single Q1D x D1D array,
+   // using their symmetry, which is only possible when Q1D <= D1D+1.
+   static void Apply(const int NE,
+                     const Array<double> &B, const Array<double> &G,
+                     const Array<double> &Bt, const Array<double> &Gt,
+                     const Vector &D, const Vector &X, Vector &Y,
+                     const int, const int)
+   {
+      if (Q1D <= D1D + 1)
+      {
+         SmemPADiffusionApply3D<D1D,Q1D>(NE,B,G,D,X,Y);
+      }
+      else
+      {
+         PADiffusionApply3D<D1D,Q1D>(NE,B,G,Bt,Gt,D,X,Y);
+      }
+   }
+};
+
+static KernelTable<PADiffusionApplyKernel> MakePADiffusionApplyTable()
+{
+   KernelTable<PADiffusionApplyKernel> t;
+   t.Add(2,2,2,PADiffusionApplySpec<2,2,2>::Apply);
+   t.Add(2,3,3,PADiffusionApplySpec<2,3,3>::Apply);
+   t.Add(2,4,4,PADiffusionApplySpec<2,4,4>::Apply);
+   t.Add(2,5,5,PADiffusionApplySpec<2,5,5>::Apply);
+   t.Add(2,6,6,PADiffusionApplySpec<2,6,6>::Apply);
+   t.Add(2,7,7,PADiffusionApplySpec<2,7,7>::Apply);
+   t.Add(2,8,8,PADiffusionApplySpec<2,8,8>::Apply);
+   t.Add(2,9,9,PADiffusionApplySpec<2,9,9>::Apply);
+   t.Add(3,2,3,PADiffusionApplySpec<3,2,3>::Apply);
+   t.Add(3,3,4,PADiffusionApplySpec<3,3,4>::Apply);
+   t.Add(3,4,5,PADiffusionApplySpec<3,4,5>::Apply);
+   t.Add(3,4,6,PADiffusionApplySpec<3,4,6>::Apply);
+   t.Add(3,5,6,PADiffusionApplySpec<3,5,6>::Apply);
+   t.Add(3,5,8,PADiffusionApplySpec<3,5,8>::Apply);
+   t.Add(3,6,7,PADiffusionApplySpec<3,6,7>::Apply);
+   t.Add(3,7,8,PADiffusionApplySpec<3,7,8>::Apply);
+   t.Add(3,8,9,PADiffusionApplySpec<3,8,9>::Apply);
+#define MFEM_PA_KERNEL(DIM,D1D,Q1D) \
+   t.Add(DIM,D1D,Q1D,PADiffusionApplySpec<DIM,D1D,Q1D>::Apply);
+   MFEM_PA_KERNEL_SPECS
+#undef MFEM_PA_KERNEL
+   return t;
+}
+
 static void PADiffusionApply(const int dim,
                              const int D1D,
                              const int Q1D,
@@ -1665,38 +1889,118 @@ static void PADiffusionApply(const int dim,
       MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
-   const int ID = (D1D << 4 ) | Q1D;
-
+   static const KernelTable<PADiffusionApplyKernel> kernels =
+      MakePADiffusionApplyTable();
+   if (PADiffusionApplyKernel kernel = kernels.Find(dim, D1D, Q1D))
+   {
+      return kernel(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+   }
+   // Generic kernels, with the working arrays sized by the smallest bound
+   const int M = std::max(D1D, Q1D);
    if (dim == 2)
    {
-      switch (ID)
+      if (M <= 4)
       {
-         case 0x22: return SmemPADiffusionApply2D<2,2,16>(NE,B,G,D,X,Y);
-         case 0x33: return SmemPADiffusionApply2D<3,3,16>(NE,B,G,D,X,Y);
-         case 0x44: return SmemPADiffusionApply2D<4,4,8>(NE,B,G,D,X,Y);
-         case 0x55: return SmemPADiffusionApply2D<5,5,8>(NE,B,G,D,X,Y);
-         case 0x66: return SmemPADiffusionApply2D<6,6,4>(NE,B,G,D,X,Y);
-         case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,B,G,D,X,Y);
-         case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,B,G,D,X,Y);
-         case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,B,G,D,X,Y);
-         default:   return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         return PADiffusionApply2D<0,0,4>(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
       }
+      if (M <= 8)
+      {
+         return PADiffusionApply2D<0,0,8>(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+      return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
    }
-
    if (dim == 3)
    {
-      switch (ID)
+      if (M <= 4)
+      {
+         return PADiffusionApply3D<0,0,4>(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+      if (M <= 8)
+      {
+         return PADiffusionApply3D<0,0,8>(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+      return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// PA Diffusion Apply kernel for non-tensor elements, e.g. triangles and
+// tetrahedra, using the full NQ x DIM x ND matrix G. The gradient matrix is
+// shared by all elements, so the action on the batch of elements is a product
+// of dense matrices, evaluated one quadrature point at a time.
+template<int DIM, int T_ND = 0> static
+void NonTensorPADiffusionApply(const int NE,
+                               const int NQ,
+                               const Array<double> &g,
+                               const Vector &d,
+                               const Vector &x,
+                               Vector &y,
+                               const int nd = 0)
+{
+   constexpr int S = (DIM*(DIM+1))/2;
+   const int ND = T_ND ? T_ND : nd;
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto D = Reshape(d.Read(), NQ, S, NE);
+   auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int ND = T_ND ? T_ND : nd;
+      for (int q = 0; q < NQ; ++q)
+      {
+         double grad[DIM], Dgrad[DIM];
+         for (int i = 0; i < DIM; ++i) { grad[i] = 0.0; }
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            const double u = X(dof,e);
+            for (int i = 0; i < DIM; ++i) { grad[i] += G(q,i,dof)*u; }
+         }
+         for (int i = 0; i < DIM; ++i)
+         {
+            Dgrad[i] = 0.0;
+            for (int j = 0; j < DIM; ++j)
+            {
+               Dgrad[i] += D(q,SymmIndex<DIM>(i,j),e)*grad[j];
+            }
+         }
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            double val = 0.0;
+            for (int i = 0; i < DIM; ++i) { val += G(q,i,dof)*Dgrad[i]; }
+            Y(dof,e) += val;
+         }
+      }
+   });
+}
+
+static void PADiffusionApplyNonTensor(const int dim,
+                                      const int ND,
+                                      const int NQ,
+                                      const int NE,
+                                      const Array<double> &G,
+                                      const Vector &D,
+                                      const Vector &X,
+                                      Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch (ND)
       {
-         case 0x23: return SmemPADiffusionApply3D<2,3>(NE,B,G,D,X,Y);
-         case 0x34: return SmemPADiffusionApply3D<3,4>(NE,B,G,D,X,Y);
-         case 0x45: return SmemPADiffusionApply3D<4,5>(NE,B,G,D,X,Y);
-         case 0x46: return SmemPADiffusionApply3D<4,6>(NE,B,G,D,X,Y);
-         case 0x56: return SmemPADiffusionApply3D<5,6>(NE,B,G,D,X,Y);
-         case 0x58: return SmemPADiffusionApply3D<5,8>(NE,B,G,D,X,Y);
-         case 0x67: return SmemPADiffusionApply3D<6,7>(NE,B,G,D,X,Y);
-         case 0x78: return SmemPADiffusionApply3D<7,8>(NE,B,G,D,X,Y);
-         case 0x89: return SmemPADiffusionApply3D<8,9>(NE,B,G,D,X,Y);
-         default:   return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 3:  return NonTensorPADiffusionApply<2,3>(NE,NQ,G,D,X,Y);
+         case 6:  return NonTensorPADiffusionApply<2,6>(NE,NQ,G,D,X,Y);
+         case 10: return NonTensorPADiffusionApply<2,10>(NE,NQ,G,D,X,Y);
+         case 15: return NonTensorPADiffusionApply<2,15>(NE,NQ,G,D,X,Y);
+         default: return NonTensorPADiffusionApply<2>(NE,NQ,G,D,X,Y,ND);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch (ND)
+      {
+         case 4:  return NonTensorPADiffusionApply<3,4>(NE,NQ,G,D,X,Y);
+         case 10: return NonTensorPADiffusionApply<3,10>(NE,NQ,G,D,X,Y);
+         case 20: return NonTensorPADiffusionApply<3,20>(NE,NQ,G,D,X,Y);
+         default: return NonTensorPADiffusionApply<3>(NE,NQ,G,D,X,Y,ND);
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -1734,6 +2038,12 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
    else
 #endif
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PADiffusionApplyNonTensor(dim, dofs1D, quad1D, ne, maps->G, pa_data,
+                                x, y);
+   }
+   else
    {
       PADiffusionApply(dim, dofs1D, quad1D, ne,
                        maps->B, maps->G, maps->Bt, maps->Gt,
@@ -1741,4 +2051,32 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+bool DiffusionIntegrator::SupportsPAElementRange() const
+{
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { return false; }
+#endif
+   return !DeviceCanUseCeed();
+}
+
+void DiffusionIntegrator::AddMultPAElements(const Vector &x, Vector &y,
+                                            int e_begin, int e_end) const
+{
+   if (e_begin == e_end) { return; }
+   MFEM_ASSERT(SupportsPAElementRange(), "");
+   Vector x_range, y_range, d_range;
+   MakeElementRangeRef(x, ne, e_begin, e_end, x_range);
+   MakeElementRangeRef(y, ne, e_begin, e_end, y_range);
+   MakeElementRangeRef(pa_data, ne, e_begin, e_end, d_range);
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PADiffusionApplyNonTensor(dim, dofs1D, quad1D, e_end - e_begin, maps->G,
+                                d_range, x_range, y_range);
+      return;
+   }
+   PADiffusionApply(dim, dofs1D, quad1D, e_end - e_begin,
+                    maps->B, maps->G, maps->Bt, maps->Gt,
+                    d_range, x_range, y_range);
+}
+
 } // namespace mfem
@@ -0,0 +1,1055 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+// PA Elasticity Integrator
+
+// The partially assembled data at each quadrature point consists of the inverse
+// Jacobian, J^{-1}(k,i) stored at k + dim*i, followed by lambda and mu, both
+// multiplied by the quadrature weight and the Jacobian determinant.
+
+// The same rule as in ElasticityIntegrator::AssembleElementMatrix(), assuming
+// all elements have the same type and transformation order.
+static const IntegrationRule &GetElasticityPARule(const FiniteElementSpace &fes,
+                                                  const IntegrationRule *ir)
+{
+   if (ir) { return *ir; }
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation &T = *fes.GetElementTransformation(0);
+   return IntRules.Get(el.GetGeomType(), 2*T.OrderGrad(&el));
+}
+
+// Evaluate the Coefficient Q at the points of the rule ir in all elements. The
+// result has size 1 for constant coefficients.
+static void PAElasticityCoefficient(Coefficient *Q,
+                                    const FiniteElementSpace &fes,
+                                    const IntegrationRule *ir,
+                                    Vector &coeff)
+{
+   const int ne = fes.GetNE();
+   const int nq = ir->GetNPoints();
+   if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else if (QuadratureFunctionCoefficient* cQ =
+               dynamic_cast<QuadratureFunctionCoefficient*>(Q))
+   {
+      const QuadratureFunction &qFun = cQ->GetQuadFunction();
+      MFEM_VERIFY(qFun.Size() == ne*nq,
+                  "Incompatible QuadratureFunction dimension \n");
+
+      MFEM_VERIFY(ir == &qFun.GetSpace()->GetElementIntRule(0),
+                  "IntegrationRule used within integrator and in"
+                  " QuadratureFunction appear to be different");
+      qFun.Read();
+      coeff.MakeRef(const_cast<QuadratureFunction &>(qFun),0);
+   }
+   else
+   {
+      Q->Project(coeff, *fes.GetMesh(), *ir);
+   }
+}
+
+// PA Elasticity Assemble 2D kernel
+static void PAElasticitySetup2D(const int NQ,
+                                const int NE,
+                                const Array<double> &w,
+                                const Vector &j,
+                                const Vector &lambda,
+                                const double q_l,
+                                const Vector &mu,
+                                const double q_m,
+                                Vector &op)
+{
+   const bool const_l = lambda.Size() == 1;
+   const bool const_m = mu.Size() == 1;
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, 2, 2, NE);
+   auto L = const_l ? Reshape(lambda.Read(), 1, 1) :
+            Reshape(lambda.Read(), NQ, NE);
+   auto M = const_m ? Reshape(mu.Read(), 1, 1) : Reshape(mu.Read(), NQ, NE);
+   auto D = Reshape(op.Write(), NQ, 6, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double detJ = (J11*J22)-(J21*J12);
+         const double w_detJ = W[q] * detJ;
+         D(q,0,e) =  J22 / detJ;
+         D(q,1,e) = -J21 / detJ;
+         D(q,2,e) = -J12 / detJ;
+         D(q,3,e) =  J11 / detJ;
+         D(q,4,e) = w_detJ * q_l * (const_l ? L(0,0) : L(q,e));
+         D(q,5,e) = w_detJ * q_m * (const_m ? M(0,0) : M(q,e));
+      }
+   });
+}
+
+// PA Elasticity Assemble 3D kernel
+static void PAElasticitySetup3D(const int NQ,
+                                const int NE,
+                                const Array<double> &w,
+                                const Vector &j,
+                                const Vector &lambda,
+                                const double q_l,
+                                const Vector &mu,
+                                const double q_m,
+                                Vector &op)
+{
+   const bool const_l = lambda.Size() == 1;
+   const bool const_m = mu.Size() == 1;
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, 3, 3, NE);
+   auto L = const_l ? Reshape(lambda.Read(), 1, 1) :
+            Reshape(lambda.Read(), NQ, NE);
+   auto M = const_m ? Reshape(mu.Read(), 1, 1) : Reshape(mu.Read(), NQ, NE);
+   auto D = Reshape(op.Write(), NQ, 11, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J31 = J(q,2,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double J32 = J(q,2,1,e);
+         const double J13 = J(q,0,2,e);
+         const double J23 = J(q,1,2,e);
+         const double J33 = J(q,2,2,e);
+         const double detJ = J11 * (J22 * J33 - J32 * J23) -
+         /* */               J21 * (J12 * J33 - J32 * J13) +
+         /* */               J31 * (J12 * J23 - J22 * J13);
+         const double w_detJ = W[q] * detJ;
+         // J^{-1} = adj(J) / detJ
+         D(q,0,e) = ((J22 * J33) - (J23 * J32)) / detJ;
+         D(q,1,e) = ((J31 * J23) - (J21 * J33)) / detJ;
+         D(q,2,e) = ((J21 * J32) - (J31 * J22)) / detJ;
+         D(q,3,e) = ((J32 * J13) - (J12 * J33)) / detJ;
+         D(q,4,e) = ((J11 * J33) - (J13 * J31)) / detJ;
+         D(q,5,e) = ((J31 * J12) - (J11 * J32)) / detJ;
+         D(q,6,e) = ((J12 * J23) - (J22 * J13)) / detJ;
+         D(q,7,e) = ((J21 * J13) - (J11 * J23)) / detJ;
+         D(q,8,e) = ((J11 * J22) - (J12 * J21)) / detJ;
+         D(q,9,e) = w_detJ * q_l * (const_l ? L(0,0) : L(q,e));
+         D(q,10,e) = w_detJ * q_m * (const_m ? M(0,0) : M(q,e));
+      }
+   });
+}
+
+void ElasticityIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = &GetElasticityPARule(fes, IntRule);
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Dimension not supported.");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim && fes.GetVDim() == dim,
+               "the vector dimension of the space must be equal to the mesh"
+               " dimension");
+   nq = ir->GetNPoints();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   pa_data.SetSize((dim*dim + 2) * nq * ne, Device::GetDeviceMemoryType());
+
+   // With the second constructor lambda = q_lambda * mu and mu = q_mu * mu.
+   Vector lambda_coeff, mu_coeff;
+   PAElasticityCoefficient(mu, fes, ir, mu_coeff);
+   if (lambda) { PAElasticityCoefficient(lambda, fes, ir, lambda_coeff); }
+   const Vector &L = lambda ? lambda_coeff : mu_coeff;
+   const double q_l = lambda ? 1.0 : q_lambda;
+   const double q_m = lambda ? 1.0 : q_mu;
+   if (dim == 2)
+   {
+      PAElasticitySetup2D(nq, ne, ir->GetWeights(), geom->J,
+                          L, q_l, mu_coeff, q_m, pa_data);
+   }
+   if (dim == 3)
+   {
+      PAElasticitySetup3D(nq, ne, ir->GetWeights(), geom->J,
+                          L, q_l, mu_coeff, q_m, pa_data);
+   }
+}
+
+// Replace the reference gradient of the displacement, g(c,k) = du_c/dxi_k, by
+// the stress sigma(u) mapped back to the reference element, i.e.
+// sum_i sigma(c,i) J^{-1}(k,i). Ji is J^{-1}, L and M are the scaled lambda
+// and mu.
+template<int DIM> MFEM_HOST_DEVICE static inline
+void PAElasticityQFunction(const double *Ji, const double L, const double M,
+                           double (&g)[DIM][DIM])
+{
+   double Gp[DIM][DIM];
+   double div = 0.0;
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int i = 0; i < DIM; i++)
+      {
+         double s = 0.0;
+         for (int k = 0; k < DIM; k++) { s += g[c][k] * Ji[k+DIM*i]; }
+         Gp[c][i] = s;
+      }
+      div += Gp[c][c];
+   }
+   double S[DIM][DIM];
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int i = 0; i < DIM; i++)
+      {
+         S[c][i] = M * (Gp[c][i] + Gp[i][c]) + ((c == i) ? L * div : 0.0);
+      }
+   }
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int k = 0; k < DIM; k++)
+      {
+         double s = 0.0;
+         for (int i = 0; i < DIM; i++) { s += S[c][i] * Ji[k+DIM*i]; }
+         g[c][k] = s;
+      }
+   }
+}
+
+// PA Elasticity Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAElasticityApply2D(const int NE,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &d_,
+                         const Vector &x_,
+                         Vector &y_,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, DIM*DIM+2, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // reference gradients of all components at the quadrature points
+      double grad[max_Q1D][max_Q1D][DIM][DIM];
+      for (int c = 0; c < DIM; c++)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][c][0] = 0.0;
+               grad[qy][qx][c][1] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = x(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qy][qx][c][0] += gradX[qx][1] * wy;
+                  grad[qy][qx][c][1] += gradX[qx][0] * wDy;
+               }
+            }
+         }
+      }
+      // stress at the quadrature points
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            double Ji[DIM*DIM];
+            for (int s = 0; s < DIM*DIM; s++) { Ji[s] = D(q,s,e); }
+            PAElasticityQFunction<DIM>(Ji, D(q,DIM*DIM,e), D(q,DIM*DIM+1,e),
+                                       grad[qy][qx]);
+         }
+      }
+      for (int c = 0; c < DIM; c++)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0.0;
+               gradX[dx][1] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qy][qx][c][0];
+               const double gY = grad[qy][qx][c][1];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAElasticityApply3D(const int NE,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &d_,
+                         const Vector &x_,
+                         Vector &y_,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, DIM*DIM+2, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // reference gradients of all components at the quadrature points
+      double grad[max_Q1D][max_Q1D][max_Q1D][DIM][DIM];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][c][0] = 0.0;
+                  grad[qz][qy][qx][c][1] = 0.0;
+                  grad[qz][qy][qx][c][2] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double gradXY[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double gradX[max_Q1D][2];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = x(dx,dy,dz,c,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0] += s * B(qx,dx);
+                     gradX[qx][1] += s * G(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double wx  = gradX[qx][0];
+                     const double wDx = gradX[qx][1];
+                     gradXY[qy][qx][0] += wDx * wy;
+                     gradXY[qy][qx][1] += wx  * wDy;
+                     gradXY[qy][qx][2] += wx  * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     grad[qz][qy][qx][c][0] += gradXY[qy][qx][0] * wz;
+                     grad[qz][qy][qx][c][1] += gradXY[qy][qx][1] * wz;
+                     grad[qz][qy][qx][c][2] += gradXY[qy][qx][2] * wDz;
+                  }
+               }
+            }
+         }
+      }
+      // stress at the quadrature points
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               double Ji[DIM*DIM];
+               for (int s = 0; s < DIM*DIM; s++) { Ji[s] = D(q,s,e); }
+               PAElasticityQFunction<DIM>(Ji, D(q,DIM*DIM,e),
+                                          D(q,DIM*DIM+1,e), grad[qz][qy][qx]);
+            }
+         }
+      }
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double gradXY[max_D1D][max_D1D][3];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] = 0;
+                  gradXY[dy][dx][1] = 0;
+                  gradXY[dy][dx][2] = 0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double gradX[max_D1D][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0] = 0;
+                  gradX[dx][1] = 0;
+                  gradX[dx][2] = 0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double gX = grad[qz][qy][qx][c][0];
+                  const double gY = grad[qz][qy][qx][c][1];
+                  const double gZ = grad[qz][qy][qx][c][2];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = Bt(dx,qx);
+                     const double wDx = Gt(dx,qx);
+                     gradX[dx][0] += gX * wDx;
+                     gradX[dx][1] += gY * wx;
+                     gradX[dx][2] += gZ * wx;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy  = Bt(dy,qy);
+                  const double wDy = Gt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz  = Bt(dz,qz);
+               const double wDz = Gt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     y(dx,dy,dz,c,e) +=
+                        ((gradXY[dy][dx][0] * wz) +
+                         (gradXY[dy][dx][1] * wz) +
+                         (gradXY[dy][dx][2] * wDz));
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+static void PAElasticityApply(const int dim,
+                              const int D1D,
+                              const int Q1D,
+                              const int NE,
+                              const Array<double> &B,
+                              const Array<double> &G,
+                              const Array<double> &Bt,
+                              const Array<double> &Gt,
+                              const Vector &D,
+                              const Vector &X,
+                              Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAElasticityApply2D<2,2>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x33: return PAElasticityApply2D<3,3>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x44: return PAElasticityApply2D<4,4>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x55: return PAElasticityApply2D<5,5>(NE,B,G,Bt,Gt,D,X,Y);
+         default:
+            return PAElasticityApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAElasticityApply3D<2,3>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x34: return PAElasticityApply3D<3,4>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x45: return PAElasticityApply3D<4,5>(NE,B,G,Bt,Gt,D,X,Y);
+         default:
+            return PAElasticityApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void ElasticityIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   PAElasticityApply(dim, dofs1D, quad1D, ne,
+                     maps->B, maps->G, maps->Bt, maps->Gt, pa_data, x, y);
+}
+
+void ElasticityIntegrator::AddMultPAElements(const Vector &x, Vector &y,
+                                             int e_begin, int e_end) const
+{
+   if (e_begin == e_end) { return; }
+   Vector x_range, y_range, d_range;
+   MakeElementRangeRef(x, ne, e_begin, e_end, x_range);
+   MakeElementRangeRef(y, ne, e_begin, e_end, y_range);
+   MakeElementRangeRef(pa_data, ne, e_begin, e_end, d_range);
+   PAElasticityApply(dim, dofs1D, quad1D, e_end - e_begin,
+                     maps->B, maps->G, maps->Bt, maps->Gt,
+                     d_range, x_range, y_range);
+}
+
+// The diagonal entry of the dof (n,c) is sum_q gn^T A_c gn, where gn is the
+// reference gradient of the basis function n and the symmetric matrix A_c is
+// (lambda + mu) J^{-1}(:,c) J^{-1}(:,c)^T + mu J^{-1} J^{-T}.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityDiagonal2D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D, DIM*DIM+2, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double QD[MQ1][MD1];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int i = 0; i < DIM; ++i)
+         {
+            for (int j = 0; j < DIM; ++j)
+            {
+               // first tensor contraction, along y direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     QD[qx][dy] = 0.0;
+                     for (int qy = 0; qy < Q1D; ++qy)
+                     {
+                        const int q = qx + qy * Q1D;
+                        const double L = D(q,DIM*DIM,e);
+                        const double M = D(q,DIM*DIM+1,e);
+                        double O = (L + M) * D(q,i+DIM*c,e) * D(q,j+DIM*c,e);
+                        for (int m = 0; m < DIM; ++m)
+                        {
+                           O += M * D(q,i+DIM*m,e) * D(q,j+DIM*m,e);
+                        }
+                        const double By = B(qy,dy);
+                        const double Gy = G(qy,dy);
+                        const double Ly = i==1 ? Gy : By;
+                        const double Ry = j==1 ? Gy : By;
+                        QD[qx][dy] += Ly * O * Ry;
+                     }
+                  }
+               }
+               // second tensor contraction, along x direction
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double temp = 0.0;
+                     for (int qx = 0; qx < Q1D; ++qx)
+                     {
+                        const double Bx = B(qx,dx);
+                        const double Gx = G(qx,dx);
+                        const double Lx = i==0 ? Gx : Bx;
+                        const double Rx = j==0 ? Gx : Bx;
+                        temp += Lx * QD[qx][dy] * Rx;
+                     }
+                     Y(dx,dy,c,e) += temp;
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityDiagonal3D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D*Q1D, DIM*DIM+2, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double QQD[MQ1][MQ1][MD1];
+      double QDD[MQ1][MD1][MD1];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int i = 0; i < DIM; ++i)
+         {
+            for (int j = 0; j < DIM; ++j)
+            {
+               // first tensor contraction, along z direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     for (int dz = 0; dz < D1D; ++dz)
+                     {
+                        QQD[qx][qy][dz] = 0.0;
+                        for (int qz = 0; qz < Q1D; ++qz)
+                        {
+                           const int q = qx + (qy + qz * Q1D) * Q1D;
+                           const double L = D(q,DIM*DIM,e);
+                           const double M = D(q,DIM*DIM+1,e);
+                           double O = (L + M) * D(q,i+DIM*c,e) *
+                                      D(q,j+DIM*c,e);
+                           for (int m = 0; m < DIM; ++m)
+                           {
+                              O += M * D(q,i+DIM*m,e) * D(q,j+DIM*m,e);
+                           }
+                           const double Bz = B(qz,dz);
+                           const double Gz = G(qz,dz);
+                           const double Lz = i==2 ? Gz : Bz;
+                           const double Rz = j==2 ? Gz : Bz;
+                           QQD[qx][qy][dz] += Lz * O * Rz;
+                        }
+                     }
+                  }
+               }
+               // second tensor contraction, along y direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     for (int dy = 0; dy < D1D; ++dy)
+                     {
+                        QDD[qx][dy][dz] = 0.0;
+                        for (int qy = 0; qy < Q1D; ++qy)
+                        {
+                           const double By = B(qy,dy);
+                           const double Gy = G(qy,dy);
+                           const double Ly = i==1 ? Gy : By;
+                           const double Ry = j==1 ? Gy : By;
+                           QDD[qx][dy][dz] += Ly * QQD[qx][qy][dz] * Ry;
+                        }
+                     }
+                  }
+               }
+               // third tensor contraction, along x direction
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        double temp = 0.0;
+                        for (int qx = 0; qx < Q1D; ++qx)
+                        {
+                           const double Bx = B(qx,dx);
+                           const double Gx = G(qx,dx);
+                           const double Lx = i==0 ? Gx : Bx;
+                           const double Rx = j==0 ? Gx : Bx;
+                           temp += Lx * QDD[qx][dy][dz] * Rx;
+                        }
+                        Y(dx,dy,dz,c,e) += temp;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+void ElasticityIntegrator::AssembleDiagonalPA(Vector &diag)
+{
+   if (dim == 2)
+   {
+      return PAElasticityDiagonal2D(ne, maps->B, maps->G, pa_data, diag,
+                                    dofs1D, quad1D);
+   }
+   if (dim == 3)
+   {
+      return PAElasticityDiagonal3D(ne, maps->B, maps->G, pa_data, diag,
+                                    dofs1D, quad1D);
+   }
+   MFEM_ABORT("Dimension not implemented.");
+}
+
+// EA Elasticity: the entry of the element matrix for the dofs (i,a) and (j,b)
+// is the integral of lambda d_a(phi_i) d_b(phi_j) + mu (delta_ab grad(phi_i).
+// grad(phi_j) + d_b(phi_i) d_a(phi_j)). The element matrices have the layout
+// (dofs, components) x (dofs, components), consistent with the E-vectors.
+template<int DIM> MFEM_HOST_DEVICE static inline
+void EAElasticityAdd(const double *Ji, const double L, const double M,
+                     const double *gi, const double *gj,
+                     double (&val)[DIM][DIM])
+{
+   double pi[DIM], pj[DIM];
+   double dot = 0.0;
+   for (int a = 0; a < DIM; a++)
+   {
+      pi[a] = 0.0;
+      pj[a] = 0.0;
+      for (int k = 0; k < DIM; k++)
+      {
+         pi[a] += gi[k] * Ji[k+DIM*a];
+         pj[a] += gj[k] * Ji[k+DIM*a];
+      }
+      dot += pi[a] * pj[a];
+   }
+   for (int a = 0; a < DIM; a++)
+   {
+      for (int b = 0; b < DIM; b++)
+      {
+         val[a][b] += L * pi[a] * pj[b] + M * pi[b] * pj[a] +
+                      ((a == b) ? M * dot : 0.0);
+      }
+   }
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EAElasticityAssemble2D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &padata,
+                                   Vector &eadata,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(padata.Read(), Q1D, Q1D, DIM*DIM+2, NE);
+   auto A = Reshape(eadata.ReadWrite(), D1D, D1D, DIM, D1D, D1D, DIM, NE);
+   MFEM_FORALL_3D(e, NE, D1D, D1D, 1,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double r_B[MQ1][MD1];
+      double r_G[MQ1][MD1];
+      for (int d = 0; d < D1D; d++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            r_B[q][d] = B(q,d);
+            r_G[q][d] = G(q,d);
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(i1,x,D1D)
+      {
+         MFEM_FOREACH_THREAD(i2,y,D1D)
+         {
+            for (int j1 = 0; j1 < D1D; ++j1)
+            {
+               for (int j2 = 0; j2 < D1D; ++j2)
+               {
+                  double val[DIM][DIM] = {{0.0, 0.0}, {0.0, 0.0}};
+                  for (int k1 = 0; k1 < Q1D; ++k1)
+                  {
+                     for (int k2 = 0; k2 < Q1D; ++k2)
+                     {
+                        const double gi[DIM] =
+                        {
+                           r_G[k1][i1] * r_B[k2][i2],
+                           r_B[k1][i1] * r_G[k2][i2]
+                        };
+                        const double gj[DIM] =
+                        {
+                           r_G[k1][j1] * r_B[k2][j2],
+                           r_B[k1][j1] * r_G[k2][j2]
+                        };
+                        double Ji[DIM*DIM];
+                        for (int s = 0; s < DIM*DIM; s++)
+                        {
+                           Ji[s] = D(k1,k2,s,e);
+                        }
+                        EAElasticityAdd<DIM>(Ji, D(k1,k2,DIM*DIM,e),
+                                             D(k1,k2,DIM*DIM+1,e), gi, gj, val);
+                     }
+                  }
+                  for (int a = 0; a < DIM; a++)
+                  {
+                     for (int b = 0; b < DIM; b++)
+                     {
+                        A(i1,i2,a,j1,j2,b,e) += val[a][b];
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EAElasticityAssemble3D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &padata,
+                                   Vector &eadata,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(padata.Read(), Q1D, Q1D, Q1D, DIM*DIM+2, NE);
+   auto A = Reshape(eadata.ReadWrite(),
+                    D1D, D1D, D1D, DIM, D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL_3D(e, NE, D1D, D1D, D1D,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double r_B[MQ1][MD1];
+      double r_G[MQ1][MD1];
+      for (int d = 0; d < D1D; d++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            r_B[q][d] = B(q,d);
+            r_G[q][d] = G(q,d);
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(i1,x,D1D)
+      {
+         MFEM_FOREACH_THREAD(i2,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(i3,z,D1D)
+            {
+               for (int j1 = 0; j1 < D1D; ++j1)
+               {
+                  for (int j2 = 0; j2 < D1D; ++j2)
+                  {
+                     for (int j3 = 0; j3 < D1D; ++j3)
+                     {
+                        double val[DIM][DIM] =
+                        {
+                           {0.0, 0.0, 0.0},
+                           {0.0, 0.0, 0.0},
+                           {0.0, 0.0, 0.0}
+                        };
+                        for (int k1 = 0; k1 < Q1D; ++k1)
+                        {
+                           for (int k2 = 0; k2 < Q1D; ++k2)
+                           {
+                              for (int k3 = 0; k3 < Q1D; ++k3)
+                              {
+                                 const double gi[DIM] =
+                                 {
+                                    r_G[k1][i1] * r_B[k2][i2] * r_B[k3][i3],
+                                    r_B[k1][i1] * r_G[k2][i2] * r_B[k3][i3],
+                                    r_B[k1][i1] * r_B[k2][i2] * r_G[k3][i3]
+                                 };
+                                 const double gj[DIM] =
+                                 {
+                                    r_G[k1][j1] * r_B[k2][j2] * r_B[k3][j3],
+                                    r_B[k1][j1] * r_G[k2][j2] * r_B[k3][j3],
+                                    r_B[k1][j1] * r_B[k2][j2] * r_G[k3][j3]
+                                 };
+                                 double Ji[DIM*DIM];
+                                 for (int s = 0; s < DIM*DIM; s++)
+                                 {
+                                    Ji[s] = D(k1,k2,k3,s,e);
+                                 }
+                                 EAElasticityAdd<DIM>(Ji, D(k1,k2,k3,DIM*DIM,e),
+                                                      D(k1,k2,k3,DIM*DIM+1,e),
+                                                      gi, gj, val);
+                              }
+                           }
+                        }
+                        for (int a = 0; a < DIM; a++)
+                        {
+                           for (int b = 0; b < DIM; b++)
+                           {
+                              A(i1,i2,i3,a,j1,j2,j3,b,e) += val[a][b];
+                           }
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+void ElasticityIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                      Vector &ea_data)
+{
+   AssemblePA(fes);
+   if (ne == 0) { return; }
+   const int D1D = dofs1D;
+   const int Q1D = quad1D;
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return EAElasticityAssemble2D<2,2>(ne,B,G,pa_data,ea_data);
+         case 0x33: return EAElasticityAssemble2D<3,3>(ne,B,G,pa_data,ea_data);
+         case 0x44: return EAElasticityAssemble2D<4,4>(ne,B,G,pa_data,ea_data);
+         case 0x55: return EAElasticityAssemble2D<5,5>(ne,B,G,pa_data,ea_data);
+         default:
+            return EAElasticityAssemble2D(ne,B,G,pa_data,ea_data,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return EAElasticityAssemble3D<2,3>(ne,B,G,pa_data,ea_data);
+         case 0x34: return EAElasticityAssemble3D<3,4>(ne,B,G,pa_data,ea_data);
+         case 0x45: return EAElasticityAssemble3D<4,5>(ne,B,G,pa_data,ea_data);
+         default:
+            return EAElasticityAssemble3D(ne,B,G,pa_data,ea_data,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+} // namespace mfem
@@ -0,0 +1,595 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA Fused Mass + Diffusion + Convection Integrator
+
+// The quadrature point data of the integrators use the following layouts:
+//   mass:       M(q,e),   the scalar weight of u v
+//   diffusion:  D(q,k,e), the symmetric matrix multiplying grad u . grad v
+//   convection: C(q,d,e), the vector multiplying grad u v
+// where the gradients are in reference space. With 'transpose' the convection
+// term is applied as u C . grad v. Absent terms have data of size 0.
+
+// PA Fused Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAFusedApply2D(const int NE,
+                    const bool transpose,
+                    const Array<double> &b_,
+                    const Array<double> &g_,
+                    const Array<double> &bt_,
+                    const Array<double> &gt_,
+                    const Vector &m_,
+                    const Vector &d_,
+                    const Vector &c_,
+                    const Array<int> &map_,
+                    const Vector &x_,
+                    Vector &y_,
+                    const int d1d = 0,
+                    const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_m = m_.Size() > 0;
+   const bool use_d = d_.Size() > 0;
+   const bool use_c = c_.Size() > 0;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   // the data of the absent terms is never accessed
+   auto M = Reshape(use_m ? m_.Read() : NULL, Q1D*Q1D, NE);
+   auto D = Reshape(use_d ? d_.Read() : NULL, Q1D*Q1D, 3, NE);
+   auto C = Reshape(use_c ? c_.Read() : NULL, Q1D*Q1D, 2, NE);
+   // with a gather map, x and y are L-vectors: the element dofs are gathered
+   // from x and scatter-added to y, otherwise x and y are E-vectors
+   const bool use_map = map_.Size() > 0;
+   auto MAP = Reshape(use_map ? map_.Read() : NULL, D1D, D1D, NE);
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // interpolate the values and the reference gradients once
+      double BX[max_D1D][max_Q1D];
+      double GX[max_D1D][max_Q1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            BX[dy][qx] = 0.0;
+            GX[dy][qx] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const int gid = use_map ? MAP(dx,dy,e) : dx + D1D*(dy + D1D*e);
+            const int j = (gid >= 0) ? gid : -1-gid;
+            const double s = (gid >= 0) ? X[j] : -X[j];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BX[dy][qx] += s * B(qx,dx);
+               GX[dy][qx] += s * G(qx,dx);
+            }
+         }
+      }
+      // combined quadrature point update: 's' is tested with the basis, 'f'
+      // with the reference gradients of the basis
+      double S[max_Q1D][max_Q1D];
+      double F[max_Q1D][max_Q1D][2];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double u = 0.0, gX = 0.0, gY = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               u  += BX[dy][qx] * B(qy,dy);
+               gX += GX[dy][qx] * B(qy,dy);
+               gY += BX[dy][qx] * G(qy,dy);
+            }
+            const int q = qx + qy * Q1D;
+            double s = use_m ? M(q,e) * u : 0.0;
+            double f0 = 0.0, f1 = 0.0;
+            if (use_d)
+            {
+               const double O11 = D(q,0,e);
+               const double O12 = D(q,1,e);
+               const double O22 = D(q,2,e);
+               f0 = (O11 * gX) + (O12 * gY);
+               f1 = (O12 * gX) + (O22 * gY);
+            }
+            if (use_c)
+            {
+               const double C1 = C(q,0,e);
+               const double C2 = C(q,1,e);
+               if (transpose)
+               {
+                  f0 += C1 * u;
+                  f1 += C2 * u;
+               }
+               else
+               {
+                  s += (C1 * gX) + (C2 * gY);
+               }
+            }
+            S[qy][qx] = s;
+            F[qy][qx][0] = f0;
+            F[qy][qx][1] = f1;
+         }
+      }
+      // apply the transposed basis once
+      double YE[max_D1D][max_D1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            YE[dy][dx] = 0.0;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double BS[max_D1D];
+         double GF[max_D1D];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            BS[dx] = 0.0;
+            GF[dx] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               // the x-derivative part is added to the value part in y
+               BS[dx] += (S[qy][qx] * Bt(dx,qx)) + (F[qy][qx][0] * Gt(dx,qx));
+               GF[dx] += F[qy][qx][1] * Bt(dx,qx);
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = Bt(dy,qy);
+            const double wDy = Gt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               YE[dy][dx] += (BS[dx] * wy) + (GF[dx] * wDy);
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const int gid = use_map ? MAP(dx,dy,e) : dx + D1D*(dy + D1D*e);
+            if (use_map)
+            {
+               // other elements may add to the same dof concurrently
+               const int j = (gid >= 0) ? gid : -1-gid;
+               AtomicAdd(Y[j], (gid >= 0) ? YE[dy][dx] : -YE[dy][dx]);
+            }
+            else
+            {
+               Y[gid] += YE[dy][dx];
+            }
+         }
+      }
+   });
+}
+
+// PA Fused Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAFusedApply3D(const int NE,
+                    const bool transpose,
+                    const Array<double> &b_,
+                    const Array<double> &g_,
+                    const Array<double> &bt_,
+                    const Array<double> &gt_,
+                    const Vector &m_,
+                    const Vector &d_,
+                    const Vector &c_,
+                    const Array<int> &map_,
+                    const Vector &x_,
+                    Vector &y_,
+                    const int d1d = 0,
+                    const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_m = m_.Size() > 0;
+   const bool use_d = d_.Size() > 0;
+   const bool use_c = c_.Size() > 0;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   // the data of the absent terms is never accessed
+   auto M = Reshape(use_m ? m_.Read() : NULL, Q1D*Q1D*Q1D, NE);
+   auto D = Reshape(use_d ? d_.Read() : NULL, Q1D*Q1D*Q1D, 6, NE);
+   auto C = Reshape(use_c ? c_.Read() : NULL, Q1D*Q1D*Q1D, 3, NE);
+   // with a gather map, x and y are L-vectors: the element dofs are gathered
+   // from x and scatter-added to y, otherwise x and y are E-vectors
+   const bool use_map = map_.Size() > 0;
+   auto MAP = Reshape(use_map ? map_.Read() : NULL, D1D, D1D, D1D, NE);
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // interpolate the values and the reference gradients once
+      double S[max_Q1D][max_Q1D][max_Q1D];
+      double F[max_Q1D][max_Q1D][max_Q1D][3];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               S[qz][qy][qx] = 0.0;
+               F[qz][qy][qx][0] = 0.0;
+               F[qz][qy][qx][1] = 0.0;
+               F[qz][qy][qx][2] = 0.0;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         double BBX[max_Q1D][max_Q1D];
+         double BGX[max_Q1D][max_Q1D];
+         double GBX[max_Q1D][max_Q1D];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BBX[qy][qx] = 0.0;
+               BGX[qy][qx] = 0.0;
+               GBX[qy][qx] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double BX[max_Q1D];
+            double GX[max_Q1D];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BX[qx] = 0.0;
+               GX[qx] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const int gid = use_map ? MAP(dx,dy,dz,e) :
+                               dx + D1D*(dy + D1D*(dz + D1D*e));
+               const int j = (gid >= 0) ? gid : -1-gid;
+               const double s = (gid >= 0) ? X[j] : -X[j];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  BX[qx] += s * B(qx,dx);
+                  GX[qx] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  BBX[qy][qx] += BX[qx] * wy;
+                  BGX[qy][qx] += GX[qx] * wy;
+                  GBX[qy][qx] += BX[qx] * wDy;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz  = B(qz,dz);
+            const double wDz = G(qz,dz);
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  S[qz][qy][qx] += BBX[qy][qx] * wz;
+                  F[qz][qy][qx][0] += BGX[qy][qx] * wz;
+                  F[qz][qy][qx][1] += GBX[qy][qx] * wz;
+                  F[qz][qy][qx][2] += BBX[qy][qx] * wDz;
+               }
+            }
+         }
+      }
+      // combined quadrature point update, in place: 'S' is tested with the
+      // basis, 'F' with the reference gradients of the basis
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               const double u  = S[qz][qy][qx];
+               const double gX = F[qz][qy][qx][0];
+               const double gY = F[qz][qy][qx][1];
+               const double gZ = F[qz][qy][qx][2];
+               double s = use_m ? M(q,e) * u : 0.0;
+               double f0 = 0.0, f1 = 0.0, f2 = 0.0;
+               if (use_d)
+               {
+                  const double O11 = D(q,0,e);
+                  const double O12 = D(q,1,e);
+                  const double O13 = D(q,2,e);
+                  const double O22 = D(q,3,e);
+                  const double O23 = D(q,4,e);
+                  const double O33 = D(q,5,e);
+                  f0 = (O11 * gX) + (O12 * gY) + (O13 * gZ);
+                  f1 = (O12 * gX) + (O22 * gY) + (O23 * gZ);
+                  f2 = (O13 * gX) + (O23 * gY) + (O33 * gZ);
+               }
+               if (use_c)
+               {
+                  const double C1 = C(q,0,e);
+                  const double C2 = C(q,1,e);
+                  const double C3 = C(q,2,e);
+                  if (transpose)
+                  {
+                     f0 += C1 * u;
+                     f1 += C2 * u;
+                     f2 += C3 * u;
+                  }
+                  else
+                  {
+                     s += (C1 * gX) + (C2 * gY) + (C3 * gZ);
+                  }
+               }
+               S[qz][qy][qx] = s;
+               F[qz][qy][qx][0] = f0;
+               F[qz][qy][qx][1] = f1;
+               F[qz][qy][qx][2] = f2;
+            }
+         }
+      }
+      // apply the transposed basis once
+      double YE[max_D1D][max_D1D][max_D1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               YE[dz][dy][dx] = 0.0;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         // the terms applying Bt in x and y are summed before the y pass
+         double BBS[max_D1D][max_D1D];
+         double BGF[max_D1D][max_D1D];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               BBS[dy][dx] = 0.0;
+               BGF[dy][dx] = 0.0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double BS[max_D1D];
+            double BF1[max_D1D];
+            double BF2[max_D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               BS[dx] = 0.0;
+               BF1[dx] = 0.0;
+               BF2[dx] = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  BS[dx] += (S[qz][qy][qx] * Bt(dx,qx)) +
+                            (F[qz][qy][qx][0] * Gt(dx,qx));
+                  BF1[dx] += F[qz][qy][qx][1] * Bt(dx,qx);
+                  BF2[dx] += F[qz][qy][qx][2] * Bt(dx,qx);
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  BBS[dy][dx] += (BS[dx] * wy) + (BF1[dx] * wDy);
+                  BGF[dy][dx] += BF2[dx] * wy;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz  = Bt(dz,qz);
+            const double wDz = Gt(dz,qz);
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  YE[dz][dy][dx] += (BBS[dy][dx] * wz) + (BGF[dy][dx] * wDz);
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const int gid = use_map ? MAP(dx,dy,dz,e) :
+                               dx + D1D*(dy + D1D*(dz + D1D*e));
+               if (use_map)
+               {
+                  // other elements may add to the same dof concurrently
+                  const int j = (gid >= 0) ? gid : -1-gid;
+                  AtomicAdd(Y[j], (gid >= 0) ? YE[dz][dy][dx] :
+                            -YE[dz][dy][dx]);
+               }
+               else
+               {
+                  Y[gid] += YE[dz][dy][dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+static void PAFusedApply(const int dim,
+                         const int D1D,
+                         const int Q1D,
+                         const int NE,
+                         const bool t,
+                         const Array<double> &B,
+                         const Array<double> &G,
+                         const Array<double> &Bt,
+                         const Array<double> &Gt,
+                         const Vector &M,
+                         const Vector &D,
+                         const Vector &C,
+                         const Array<int> &I,
+                         const Vector &X,
+                         Vector &Y)
+{
+   const int ID = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (ID)
+      {
+         case 0x22: return PAFusedApply2D<2,2>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x33: return PAFusedApply2D<3,3>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x44: return PAFusedApply2D<4,4>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x55: return PAFusedApply2D<5,5>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x66: return PAFusedApply2D<6,6>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x77: return PAFusedApply2D<7,7>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x88: return PAFusedApply2D<8,8>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x99: return PAFusedApply2D<9,9>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         default:   return PAFusedApply2D(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch (ID)
+      {
+         case 0x23: return PAFusedApply3D<2,3>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x34: return PAFusedApply3D<3,4>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x45: return PAFusedApply3D<4,5>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x56: return PAFusedApply3D<5,6>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x67: return PAFusedApply3D<6,7>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x78: return PAFusedApply3D<7,8>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         case 0x89: return PAFusedApply3D<8,9>(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y);
+         default:   return PAFusedApply3D(NE,t,B,G,Bt,Gt,M,D,C,I,X,Y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+bool FusedPAIntegrator::Add(const BilinearFormIntegrator *integ)
+{
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { return false; }
+#endif
+   if (DeviceCanUseCeed()) { return false; }
+
+   const MassIntegrator *m = dynamic_cast<const MassIntegrator*>(integ);
+   const DiffusionIntegrator *d =
+      dynamic_cast<const DiffusionIntegrator*>(integ);
+   const ConvectionIntegrator *c =
+      dynamic_cast<const ConvectionIntegrator*>(integ);
+   const DofToQuad *i_maps;
+   int i_dim, i_ne;
+   if (m && !mass)
+   {
+      i_maps = m->maps; i_dim = m->dim; i_ne = m->ne;
+   }
+   else if (d && !diffusion)
+   {
+      i_maps = d->maps; i_dim = d->dim; i_ne = d->ne;
+   }
+   else if (c && !convection)
+   {
+      i_maps = c->maps; i_dim = c->dim; i_ne = c->ne;
+   }
+   else { return false; }
+
+   // the integrator must be assembled on tensor-product elements
+   if (!i_maps || i_maps->mode != DofToQuad::TENSOR ||
+       i_dim < 2 || i_dim > 3) { return false; }
+   if (maps && (i_maps != maps || i_dim != dim || i_ne != ne)) { return false; }
+
+   if (m) { mass = m; }
+   else if (d) { diffusion = d; }
+   else { convection = c; }
+   maps = i_maps;
+   dim = i_dim;
+   ne = i_ne;
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   return true;
+}
+
+void FusedPAIntegrator::AddMult(const Vector &x, Vector &y,
+                                int e_begin, int e_end, bool transpose,
+                                const Array<int> *gather_map) const
+{
+   if (e_begin == e_end) { return; }
+   MFEM_VERIFY(maps, "no integrators were added");
+   Vector m_range, d_range, c_range;
+   if (mass)
+   {
+      MakeElementRangeRef(mass->pa_data, ne, e_begin, e_end, m_range);
+   }
+   if (diffusion)
+   {
+      MakeElementRangeRef(diffusion->pa_data, ne, e_begin, e_end, d_range);
+   }
+   if (convection)
+   {
+      MakeElementRangeRef(convection->pa_data, ne, e_begin, e_end, c_range);
+   }
+   if (gather_map)
+   {
+      // x and y are L-vectors, the kernel works on all elements
+      const int nd = (dim == 2) ? dofs1D*dofs1D : dofs1D*dofs1D*dofs1D;
+      MFEM_VERIFY(e_begin == 0 && e_end == ne &&
+                  gather_map->Size() == ne*nd, "incompatible gather map");
+      PAFusedApply(dim, dofs1D, quad1D, ne, transpose,
+                   maps->B, maps->G, maps->Bt, maps->Gt,
+                   m_range, d_range, c_range, *gather_map, x, y);
+      return;
+   }
+   const Array<int> no_map;
+   Vector x_range, y_range;
+   MakeElementRangeRef(x, ne, e_begin, e_end, x_range);
+   MakeElementRangeRef(y, ne, e_begin, e_end, y_range);
+   PAFusedApply(dim, dofs1D, quad1D, e_end - e_begin, transpose,
+                maps->B, maps->G, maps->Bt, maps->Gt,
+                m_range, d_range, c_range, no_map, x_range, y_range);
+}
+
+} // namespace mfem
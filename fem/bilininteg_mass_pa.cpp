@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/kernel_table.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/mass.hpp"
@@ -47,9 +48,22 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
    dim = mesh->Dimension();
    ne = fes.GetMesh()->GetNE();
    nq = ir->GetNPoints();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
-                                    GeometricFactors::JACOBIANS);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   // On affine meshes, a single Jacobian per element is stored and used
+   geom = mesh->GetAffineGeometricFactors(GeometricFactors::JACOBIANS);
+   if (geom == NULL)
+   {
+      geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
+                                       GeometricFactors::JACOBIANS);
+   }
+   const int nj = geom->IntRule->GetNPoints();
+   // With non-tensor elements, e.g. triangles and tetrahedra, dofs1D and
+   // quad1D are the total numbers of dofs and quadrature points
+   const bool tensor = UsesTensorBasis(fes);
+#ifdef MFEM_USE_OCCA
+   MFEM_VERIFY(tensor || !DeviceCanUseOcca(),
+               "OCCA PA kernels require tensor-product elements.");
+#endif
+   maps = &el.GetDofToQuad(*ir, tensor ? DofToQuad::TENSOR : DofToQuad::FULL);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    pa_data.SetSize(ne*nq, Device::GetDeviceMemoryType());
@@ -79,25 +93,17 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->Project(coeff, *fes.GetMesh(), *ir);
    }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
    {
       const int NE = ne;
       const int NQ = nq;
+      const int NJ = nj;
       const bool const_c = coeff.Size() == 1;
       auto w = ir->GetWeights().Read();
-      auto J = Reshape(geom->J.Read(), NQ,2,2,NE);
+      auto J = Reshape(geom->J.Read(), NJ,2,2,NE);
       auto C =
          const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
       auto v = Reshape(pa_data.Write(), NQ, NE);
@@ -105,10 +111,11 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
       {
          for (int q = 0; q < NQ; ++q)
          {
-            const double J11 = J(q,0,0,e);
-            const double J12 = J(q,1,0,e);
-            const double J21 = J(q,0,1,e);
-            const double J22 = J(q,1,1,e);
+            const int qj = (NJ == 1) ? 0 : q;
+            const double J11 = J(qj,0,0,e);
+            const double J12 = J(qj,1,0,e);
+            const double J21 = J(qj,0,1,e);
+            const double J22 = J(qj,1,1,e);
             const double detJ = (J11*J22)-(J21*J12);
             const double coeff = const_c ? C(0,0) : C(q,e);
             v(q,e) =  w[q] * coeff * detJ;
@@ -119,9 +126,10 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
    {
       const int NE = ne;
       const int NQ = nq;
+      const int NJ = nj;
       const bool const_c = coeff.Size() == 1;
       auto W = ir->GetWeights().Read();
-      auto J = Reshape(geom->J.Read(), NQ,3,3,NE);
+      auto J = Reshape(geom->J.Read(), NJ,3,3,NE);
       auto C =
          const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
       auto v = Reshape(pa_data.Write(), NQ,NE);
@@ -129,9 +137,12 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
       {
          for (int q = 0; q < NQ; ++q)
          {
-            const double J11 = J(q,0,0,e), J12 = J(q,0,1,e), J13 = J(q,0,2,e);
-            const double J21 = J(q,1,0,e), J22 = J(q,1,1,e), J23 = J(q,1,2,e);
-            const double J31 = J(q,2,0,e), J32 = J(q,2,1,e), J33 = J(q,2,2,e);
+            const int qj = (NJ == 1) ? 0 : q;
+            const double J11 = J(qj,0,0,e), J12 = J(qj,0,1,e);
+            const double J13 = J(qj,0,2,e), J21 = J(qj,1,0,e);
+            const double J22 = J(qj,1,1,e), J23 = J(qj,1,2,e);
+            const double J31 = J(qj,2,0,e), J32 = J(qj,2,1,e);
+            const double J33 = J(qj,2,2,e);
             const double detJ = J11 * (J22 * J33 - J32 * J23) -
             /* */               J21 * (J12 * J33 - J32 * J13) +
             /* */               J31 * (J12 * J23 - J22 * J13);
@@ -147,8 +158,10 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    SetupPA(fes);
 }
 
-
-template<int T_D1D = 0, int T_Q1D = 0>
+// When T_D1D and T_Q1D are not given, the working arrays of the generic
+// kernels are sized with the bound T_MAX, which defaults to MAX_D1D and
+// MAX_Q1D.
+template<int T_D1D = 0, int T_Q1D = 0, int T_MAX = 0>
 static void PAMassAssembleDiagonal2D(const int NE,
                                      const Array<double> &b,
                                      const Vector &d,
@@ -158,8 +171,8 @@ static void PAMassAssembleDiagonal2D(const int NE,
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(D1D <= (T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D), "");
+   MFEM_VERIFY(Q1D <= (T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D), "");
    auto B = Reshape(b.Read(), Q1D, D1D);
    auto D = Reshape(d.Read(), Q1D, Q1D, NE);
    auto Y = Reshape(y.ReadWrite(), D1D, D1D, NE);
@@ -167,8 +180,8 @@ static void PAMassAssembleDiagonal2D(const int NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D;
       double QD[MQ1][MD1];
       for (int qx = 0; qx < Q1D; ++qx)
       {
@@ -260,7 +273,7 @@ static void SmemPAMassAssembleDiagonal2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, int T_MAX = 0>
 static void PAMassAssembleDiagonal3D(const int NE,
                                      const Array<double> &b,
                                      const Vector &d,
@@ -270,8 +283,8 @@ static void PAMassAssembleDiagonal3D(const int NE,
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(D1D <= (T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D), "");
+   MFEM_VERIFY(Q1D <= (T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D), "");
    auto B = Reshape(b.Read(), Q1D, D1D);
    auto D = Reshape(d.Read(), Q1D, Q1D, Q1D, NE);
    auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, NE);
@@ -279,8 +292,8 @@ static void PAMassAssembleDiagonal3D(const int NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D;
       double QQD[MQ1][MQ1][MD1];
       double QDD[MQ1][MD1][MD1];
       for (int qx = 0; qx < Q1D; ++qx)
@@ -415,47 +428,140 @@ static void SmemPAMassAssembleDiagonal3D(const int NE,
    });
 }
 
+typedef void (*PAMassDiagonalKernel)(const int NE,
+                                     const Array<double> &B,
+                                     const Vector &D,
+                                     Vector &Y,
+                                     const int d1d,
+                                     const int q1d);
+
+// PA Mass Diagonal kernels for the sizes requested with MFEM_PA_KERNELS
+template<int DIM, int D1D, int Q1D> struct PAMassDiagonalSpec;
+
+template<int D1D, int Q1D> struct PAMassDiagonalSpec<2,D1D,Q1D>
+{
+   static constexpr int NBZ =
+      D1D <= 3 ? 16 : D1D <= 5 ? 8 : D1D <= 7 ? 4 : D1D <= 9 ? 2 : 1;
+   static PAMassDiagonalKernel Kernel()
+   { return SmemPAMassAssembleDiagonal2D<D1D,Q1D,NBZ>; }
+};
+
+template<int D1D, int Q1D> struct PAMassDiagonalSpec<3,D1D,Q1D>
+{
+   static PAMassDiagonalKernel Kernel()
+   { return SmemPAMassAssembleDiagonal3D<D1D,Q1D>; }
+};
+
+static KernelTable<PAMassDiagonalKernel> MakePAMassDiagonalTable()
+{
+   KernelTable<PAMassDiagonalKernel> t;
+   t.Add(2,2,2,SmemPAMassAssembleDiagonal2D<2,2,16>);
+   t.Add(2,3,3,SmemPAMassAssembleDiagonal2D<3,3,16>);
+   t.Add(2,4,4,SmemPAMassAssembleDiagonal2D<4,4,8>);
+   t.Add(2,5,5,SmemPAMassAssembleDiagonal2D<5,5,8>);
+   t.Add(2,6,6,SmemPAMassAssembleDiagonal2D<6,6,4>);
+   t.Add(2,7,7,SmemPAMassAssembleDiagonal2D<7,7,4>);
+   t.Add(2,8,8,SmemPAMassAssembleDiagonal2D<8,8,2>);
+   t.Add(2,9,9,SmemPAMassAssembleDiagonal2D<9,9,2>);
+   t.Add(3,2,3,SmemPAMassAssembleDiagonal3D<2,3>);
+   t.Add(3,3,4,SmemPAMassAssembleDiagonal3D<3,4>);
+   t.Add(3,4,5,SmemPAMassAssembleDiagonal3D<4,5>);
+   t.Add(3,5,6,SmemPAMassAssembleDiagonal3D<5,6>);
+   t.Add(3,6,7,SmemPAMassAssembleDiagonal3D<6,7>);
+   t.Add(3,7,8,SmemPAMassAssembleDiagonal3D<7,8>);
+   t.Add(3,8,9,SmemPAMassAssembleDiagonal3D<8,9>);
+#define MFEM_PA_KERNEL(DIM,D1D,Q1D) \
+   t.Add(DIM,D1D,Q1D,PAMassDiagonalSpec<DIM,D1D,Q1D>::Kernel());
+   MFEM_PA_KERNEL_SPECS
+#undef MFEM_PA_KERNEL
+   return t;
+}
+
 static void PAMassAssembleDiagonal(const int dim, const int D1D,
                                    const int Q1D, const int NE,
                                    const Array<double> &B,
                                    const Vector &D,
                                    Vector &Y)
 {
+   static const KernelTable<PAMassDiagonalKernel> kernels =
+      MakePAMassDiagonalTable();
+   if (PAMassDiagonalKernel kernel = kernels.Find(dim, D1D, Q1D))
+   {
+      return kernel(NE,B,D,Y,D1D,Q1D);
+   }
+   // Generic kernels, with the working arrays sized by the smallest bound
+   const int M = std::max(D1D, Q1D);
    if (dim == 2)
    {
-      switch ((D1D << 4 ) | Q1D)
-      {
-         case 0x22: return SmemPAMassAssembleDiagonal2D<2,2,16>(NE,B,D,Y);
-         case 0x33: return SmemPAMassAssembleDiagonal2D<3,3,16>(NE,B,D,Y);
-         case 0x44: return SmemPAMassAssembleDiagonal2D<4,4,8>(NE,B,D,Y);
-         case 0x55: return SmemPAMassAssembleDiagonal2D<5,5,8>(NE,B,D,Y);
-         case 0x66: return SmemPAMassAssembleDiagonal2D<6,6,4>(NE,B,D,Y);
-         case 0x77: return SmemPAMassAssembleDiagonal2D<7,7,4>(NE,B,D,Y);
-         case 0x88: return SmemPAMassAssembleDiagonal2D<8,8,2>(NE,B,D,Y);
-         case 0x99: return SmemPAMassAssembleDiagonal2D<9,9,2>(NE,B,D,Y);
-         default:   return PAMassAssembleDiagonal2D(NE,B,D,Y,D1D,Q1D);
-      }
+      if (M <= 4) { return PAMassAssembleDiagonal2D<0,0,4>(NE,B,D,Y,D1D,Q1D); }
+      if (M <= 8) { return PAMassAssembleDiagonal2D<0,0,8>(NE,B,D,Y,D1D,Q1D); }
+      return PAMassAssembleDiagonal2D(NE,B,D,Y,D1D,Q1D);
    }
    else if (dim == 3)
    {
-      switch ((D1D << 4 ) | Q1D)
+      if (M <= 4) { return PAMassAssembleDiagonal3D<0,0,4>(NE,B,D,Y,D1D,Q1D); }
+      if (M <= 8) { return PAMassAssembleDiagonal3D<0,0,8>(NE,B,D,Y,D1D,Q1D); }
+      return PAMassAssembleDiagonal3D(NE,B,D,Y,D1D,Q1D);
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// PA Mass Diagonal kernel for non-tensor elements, e.g. triangles and
+// tetrahedra, using the full NQ x ND matrix B
+template<int T_ND = 0> static
+void NonTensorPAMassAssembleDiagonal(const int NE,
+                                     const int NQ,
+                                     const Array<double> &b,
+                                     const Vector &d,
+                                     Vector &y,
+                                     const int nd = 0)
+{
+   const int ND = T_ND ? T_ND : nd;
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(d.Read(), NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int ND = T_ND ? T_ND : nd;
+      for (int dof = 0; dof < ND; ++dof)
       {
-         case 0x23: return SmemPAMassAssembleDiagonal3D<2,3>(NE,B,D,Y);
-         case 0x34: return SmemPAMassAssembleDiagonal3D<3,4>(NE,B,D,Y);
-         case 0x45: return SmemPAMassAssembleDiagonal3D<4,5>(NE,B,D,Y);
-         case 0x56: return SmemPAMassAssembleDiagonal3D<5,6>(NE,B,D,Y);
-         case 0x67: return SmemPAMassAssembleDiagonal3D<6,7>(NE,B,D,Y);
-         case 0x78: return SmemPAMassAssembleDiagonal3D<7,8>(NE,B,D,Y);
-         case 0x89: return SmemPAMassAssembleDiagonal3D<8,9>(NE,B,D,Y);
-         default:   return PAMassAssembleDiagonal3D(NE,B,D,Y,D1D,Q1D);
+         double val = 0.0;
+         for (int q = 0; q < NQ; ++q)
+         {
+            val += B(q,dof)*B(q,dof)*D(q,e);
+         }
+         Y(dof,e) += val;
       }
+   });
+}
+
+static void PAMassAssembleDiagonalNonTensor(const int ND, const int NQ,
+                                            const int NE,
+                                            const Array<double> &B,
+                                            const Vector &D,
+                                            Vector &Y)
+{
+   switch (ND)
+   {
+      case 3:  return NonTensorPAMassAssembleDiagonal<3>(NE,NQ,B,D,Y);
+      case 4:  return NonTensorPAMassAssembleDiagonal<4>(NE,NQ,B,D,Y);
+      case 6:  return NonTensorPAMassAssembleDiagonal<6>(NE,NQ,B,D,Y);
+      case 10: return NonTensorPAMassAssembleDiagonal<10>(NE,NQ,B,D,Y);
+      case 15: return NonTensorPAMassAssembleDiagonal<15>(NE,NQ,B,D,Y);
+      case 20: return NonTensorPAMassAssembleDiagonal<20>(NE,NQ,B,D,Y);
+      default: return NonTensorPAMassAssembleDiagonal(NE,NQ,B,D,Y,ND);
    }
-   MFEM_ABORT("Unknown kernel.");
 }
 
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (pa_data.Size()==0) { SetupPA(*fespace, true); }
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PAMassAssembleDiagonalNonTensor(dofs1D, quad1D, ne, maps->B, pa_data,
+                                      diag);
+      return;
+   }
    PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
 }
 
@@ -552,7 +658,7 @@ static void OccaPAMassApply3D(const int D1D,
 }
 #endif // MFEM_USE_OCCA
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, int T_MAX = 0>
 static void PAMassApply2D(const int NE,
                           const Array<double> &b_,
                           const Array<double> &bt_,
@@ -564,8 +670,8 @@ static void PAMassApply2D(const int NE,
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(D1D <= (T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D), "");
+   MFEM_VERIFY(Q1D <= (T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D), "");
    auto B = Reshape(b_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
@@ -576,8 +682,8 @@ static void PAMassApply2D(const int NE,
       const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int max_D1D = T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D;
       double sol_xy[max_Q1D][max_Q1D];
       for (int qy = 0; qy < Q1D; ++qy)
       {
@@ -767,7 +873,7 @@ static void SmemPAMassApply2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, int T_MAX = 0>
 static void PAMassApply3D(const int NE,
                           const Array<double> &b_,
                           const Array<double> &bt_,
@@ -779,8 +885,8 @@ static void PAMassApply3D(const int NE,
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(D1D <= (T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D), "");
+   MFEM_VERIFY(Q1D <= (T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D), "");
    auto B = Reshape(b_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
@@ -790,8 +896,8 @@ static void PAMassApply3D(const int NE,
    {
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int max_D1D = T_D1D ? T_D1D : T_MAX ? T_MAX : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : T_MAX ? T_MAX : MAX_Q1D;
       double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
       for (int qz = 0; qz < Q1D; ++qz)
       {
@@ -1135,6 +1241,67 @@ static void SmemPAMassApply3D(const int NE,
    });
 }
 
+typedef void (*PAMassApplyKernel)(const int NE,
+                                  const Array<double> &B,
+                                  const Array<double> &Bt,
+                                  const Vector &D,
+                                  const Vector &X,
+                                  Vector &Y,
+                                  const int d1d,
+                                  const int q1d);
+
+// PA Mass Apply kernels for the sizes requested with MFEM_PA_KERNELS
+template<int DIM, int D1D, int Q1D> struct PAMassApplySpec;
+
+template<int D1D, int Q1D> struct PAMassApplySpec<2,D1D,Q1D>
+{
+   static constexpr int NBZ =
+      D1D <= 3 ? 16 : D1D <= 5 ? 8 : D1D <= 7 ? 4 : D1D <= 9 ? 2 : 1;
+   static PAMassApplyKernel Kernel()
+   { return SmemPAMassApply2D<D1D,Q1D,NBZ>; }
+};
+
+template<int D1D, int Q1D> struct PAMassApplySpec<3,D1D,Q1D>
+{
+   static PAMassApplyKernel Kernel() { return SmemPAMassApply3D<D1D,Q1D>; }
+};
+
+static KernelTable<PAMassApplyKernel> MakePAMassApplyTable()
+{
+   KernelTable<PAMassApplyKernel> t;
+   t.Add(2,2,2,SmemPAMassApply2D<2,2,16>);
+   t.Add(2,2,4,SmemPAMassApply2D<2,4,16>);
+   t.Add(2,3,3,SmemPAMassApply2D<3,3,16>);
+   t.Add(2,3,4,SmemPAMassApply2D<3,4,16>);
+   t.Add(2,3,6,SmemPAMassApply2D<3,6,16>);
+   t.Add(2,4,4,SmemPAMassApply2D<4,4,8>);
+   t.Add(2,4,8,SmemPAMassApply2D<4,8,4>);
+   t.Add(2,5,5,SmemPAMassApply2D<5,5,8>);
+   t.Add(2,5,8,SmemPAMassApply2D<5,8,2>);
+   t.Add(2,6,6,SmemPAMassApply2D<6,6,4>);
+   t.Add(2,7,7,SmemPAMassApply2D<7,7,4>);
+   t.Add(2,8,8,SmemPAMassApply2D<8,8,2>);
+   t.Add(2,9,9,SmemPAMassApply2D<9,9,2>);
+   t.Add(3,2,3,SmemPAMassApply3D<2,3>);
+   t.Add(3,2,4,SmemPAMassApply3D<2,4>);
+   t.Add(3,3,4,SmemPAMassApply3D<3,4>);
+   t.Add(3,3,6,SmemPAMassApply3D<3,6>);
+   t.Add(3,4,5,SmemPAMassApply3D<4,5>);
+   t.Add(3,4,6,SmemPAMassApply3D<4,6>);
+   t.Add(3,4,8,SmemPAMassApply3D<4,8>);
+   t.Add(3,5,6,SmemPAMassApply3D<5,6>);
+   t.Add(3,5,8,SmemPAMassApply3D<5,8>);
+   t.Add(3,6,7,SmemPAMassApply3D<6,7>);
+   t.Add(3,7,8,SmemPAMassApply3D<7,8>);
+   t.Add(3,8,9,SmemPAMassApply3D<8,9>);
+   t.Add(3,9,10,SmemPAMassApply3D<9,10>);
+#define MFEM_PA_KERNEL(DIM,D1D,Q1D) \
+   t.Add(DIM,D1D,Q1D,PAMassApplySpec<DIM,D1D,Q1D>::Kernel());
+   MFEM_PA_KERNEL_SPECS
+#undef MFEM_PA_KERNEL
+   return t;
+}
+
 static void PAMassApply(const int dim,
                         const int D1D,
                         const int Q1D,
@@ -1159,49 +1326,81 @@ static void PAMassApply(const int dim,
       MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
-   const int id = (D1D << 4) | Q1D;
+   static const KernelTable<PAMassApplyKernel> kernels = MakePAMassApplyTable();
+   if (PAMassApplyKernel kernel = kernels.Find(dim, D1D, Q1D))
+   {
+      return kernel(NE,B,Bt,D,X,Y,D1D,Q1D);
+   }
+   // Generic kernels, with the working arrays sized by the smallest bound
+   const int M = std::max(D1D, Q1D);
    if (dim == 2)
    {
-      switch (id)
-      {
-         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply2D<2,4,16>(NE,B,Bt,D,X,Y);
-         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply2D<3,4,16>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply2D<3,6,16>(NE,B,Bt,D,X,Y);
-         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply2D<4,8,4>(NE,B,Bt,D,X,Y);
-         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply2D<5,8,2>(NE,B,Bt,D,X,Y);
-         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y);
-         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
-         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
-         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
-      }
+      if (M <= 4) { return PAMassApply2D<0,0,4>(NE,B,Bt,D,X,Y,D1D,Q1D); }
+      if (M <= 8) { return PAMassApply2D<0,0,8>(NE,B,Bt,D,X,Y,D1D,Q1D); }
+      return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
    }
    else if (dim == 3)
    {
-      switch (id)
+      if (M <= 4) { return PAMassApply3D<0,0,4>(NE,B,Bt,D,X,Y,D1D,Q1D); }
+      if (M <= 8) { return PAMassApply3D<0,0,8>(NE,B,Bt,D,X,Y,D1D,Q1D); }
+      return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// PA Mass Apply kernel for non-tensor elements, e.g. triangles and
+// tetrahedra, using the full NQ x ND matrix B. The basis matrix is shared by
+// all elements, so the action on the batch of elements is a product of dense
+// matrices, evaluated one quadrature point at a time without temporaries.
+template<int T_ND = 0> static
+void NonTensorPAMassApply(const int NE,
+                          const int NQ,
+                          const Array<double> &b,
+                          const Vector &d,
+                          const Vector &x,
+                          Vector &y,
+                          const int nd = 0)
+{
+   const int ND = T_ND ? T_ND : nd;
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(d.Read(), NQ, NE);
+   auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int ND = T_ND ? T_ND : nd;
+      for (int q = 0; q < NQ; ++q)
       {
-         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply3D<2,4>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply3D<3,6>(NE,B,Bt,D,X,Y);
-         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y);
-         case 0x46: return SmemPAMassApply3D<4,6>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply3D<4,8>(NE,B,Bt,D,X,Y);
-         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply3D<5,8>(NE,B,Bt,D,X,Y);
-         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y);
-         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
-         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
-         case 0x9A: return SmemPAMassApply3D<9,10>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         double u = 0.0;
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            u += B(q,dof)*X(dof,e);
+         }
+         const double Du = D(q,e)*u;
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            Y(dof,e) += B(q,dof)*Du;
+         }
       }
+   });
+}
+
+static void PAMassApplyNonTensor(const int ND, const int NQ, const int NE,
+                                 const Array<double> &B,
+                                 const Vector &D,
+                                 const Vector &X,
+                                 Vector &Y)
+{
+   switch (ND)
+   {
+      case 3:  return NonTensorPAMassApply<3>(NE,NQ,B,D,X,Y);
+      case 4:  return NonTensorPAMassApply<4>(NE,NQ,B,D,X,Y);
+      case 6:  return NonTensorPAMassApply<6>(NE,NQ,B,D,X,Y);
+      case 10: return NonTensorPAMassApply<10>(NE,NQ,B,D,X,Y);
+      case 15: return NonTensorPAMassApply<15>(NE,NQ,B,D,X,Y);
+      case 20: return NonTensorPAMassApply<20>(NE,NQ,B,D,X,Y);
+      default: return NonTensorPAMassApply(NE,NQ,B,D,X,Y,ND);
    }
-   mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
-   MFEM_ABORT("Unknown kernel.");
 }
 
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
@@ -1235,9 +1434,41 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
    else
 #endif
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PAMassApplyNonTensor(dofs1D, quad1D, ne, maps->B, pa_data, x, y);
+   }
+   else
    {
       PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
    }
 }
 
+bool MassIntegrator::SupportsPAElementRange() const
+{
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { return false; }
+#endif
+   return !DeviceCanUseCeed();
+}
+
+void MassIntegrator::AddMultPAElements(const Vector &x, Vector &y,
+                                       int e_begin, int e_end) const
+{
+   if (e_begin == e_end) { return; }
+   MFEM_ASSERT(SupportsPAElementRange(), "");
+   Vector x_range, y_range, d_range;
+   MakeElementRangeRef(x, ne, e_begin, e_end, x_range);
+   MakeElementRangeRef(y, ne, e_begin, e_end, y_range);
+   MakeElementRangeRef(pa_data, ne, e_begin, e_end, d_range);
+   if (maps->mode == DofToQuad::FULL)
+   {
+      PAMassApplyNonTensor(dofs1D, quad1D, e_end - e_begin, maps->B,
+                           d_range, x_range, y_range);
+      return;
+   }
+   PAMassApply(dim, dofs1D, quad1D, e_end - e_begin, maps->B, maps->Bt,
+               d_range, x_range, y_range);
+}
+
 } // namespace mfem
@@ -25,13 +25,15 @@ static void PAVectorDiffusionSetup2D(const int Q1D,
                                      const int NE,
                                      const Array<double> &w,
                                      const Vector &j,
-                                     const double COEFF,
+                                     const Vector &c,
                                      Vector &op)
 {
    const int NQ = Q1D*Q1D;
+   const bool const_c = c.Size() == 1;
    auto W = w.Read();
 
    auto J = Reshape(j.Read(), NQ, 2, 2, NE);
+   auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
    auto y = Reshape(op.Write(), NQ, 3, NE);
 
    MFEM_FORALL(e, NE,
@@ -42,7 +44,8 @@ static void PAVectorDiffusionSetup2D(const int Q1D,
          const double J21 = J(q,1,0,e);
          const double J12 = J(q,0,1,e);
          const double J22 = J(q,1,1,e);
-         const double c_detJ = W[q] * COEFF / ((J11*J22)-(J21*J12));
+         const double coeff = const_c ? C(0,0) : C(q,e);
+         const double c_detJ = W[q] * coeff / ((J11*J22)-(J21*J12));
          y(q,0,e) =  c_detJ * (J12*J12 + J22*J22); // 1,1
          y(q,1,e) = -c_detJ * (J12*J11 + J22*J21); // 1,2
          y(q,2,e) =  c_detJ * (J11*J11 + J21*J21); // 2,2
@@ -55,12 +58,14 @@ static void PAVectorDiffusionSetup3D(const int Q1D,
                                      const int NE,
                                      const Array<double> &w,
                                      const Vector &j,
-                                     const double COEFF,
+                                     const Vector &c,
                                      Vector &op)
 {
    const int NQ = Q1D*Q1D*Q1D;
+   const bool const_c = c.Size() == 1;
    auto W = w.Read();
    auto J = Reshape(j.Read(), NQ, 3, 3, NE);
+   auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
    auto y = Reshape(op.Write(), NQ, 6, NE);
    MFEM_FORALL(e, NE,
    {
@@ -78,7 +83,8 @@ static void PAVectorDiffusionSetup3D(const int Q1D,
          const double detJ = J11 * (J22 * J33 - J32 * J23) -
          /* */               J21 * (J12 * J33 - J32 * J13) +
          /* */               J31 * (J12 * J23 - J22 * J13);
-         const double c_detJ = W[q] * COEFF / detJ;
+         const double coeff = const_c ? C(0,0) : C(q,e);
+         const double c_detJ = W[q] * coeff / detJ;
          // adj(J)
          const double A11 = (J22 * J33) - (J23 * J32);
          const double A12 = (J32 * J13) - (J12 * J33);
@@ -105,7 +111,7 @@ static void PAVectorDiffusionSetup(const int dim,
                                    const int NE,
                                    const Array<double> &W,
                                    const Vector &J,
-                                   const double COEFF,
+                                   const Vector &C,
                                    Vector &op)
 {
    if (!(dim == 2 || dim == 3))
@@ -114,11 +120,11 @@ static void PAVectorDiffusionSetup(const int dim,
    }
    if (dim == 2)
    {
-      PAVectorDiffusionSetup2D(Q1D, NE, W, J, COEFF, op);
+      PAVectorDiffusionSetup2D(Q1D, NE, W, J, C, op);
    }
    if (dim == 3)
    {
-      PAVectorDiffusionSetup3D(Q1D, NE, W, J, COEFF, op);
+      PAVectorDiffusionSetup3D(Q1D, NE, W, J, C, op);
    }
 }
 
@@ -140,12 +146,33 @@ void VectorDiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    pa_data.SetSize(symmDims * nq * ne, Device::GetDeviceMemoryType());
-   double coeff = 1.0;
-   if (Q)
+   Vector coeff;
+   if (Q == nullptr)
    {
-      ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q);
-      MFEM_VERIFY(cQ != NULL, "only ConstantCoefficient is supported!");
-      coeff = cQ->constant;
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else if (QuadratureFunctionCoefficient* cQ =
+               dynamic_cast<QuadratureFunctionCoefficient*>(Q))
+   {
+      const QuadratureFunction &qFun = cQ->GetQuadFunction();
+      MFEM_VERIFY(qFun.Size() == ne*nq,
+                  "Incompatible QuadratureFunction dimension \n");
+
+      MFEM_VERIFY(ir == &qFun.GetSpace()->GetElementIntRule(0),
+                  "IntegrationRule used within integrator and in"
+                  " QuadratureFunction appear to be different");
+      qFun.Read();
+      coeff.MakeRef(const_cast<QuadratureFunction &>(qFun),0);
+   }
+   else
+   {
+      Q->Project(coeff, *fes.GetMesh(), *ir);
    }
    const Array<double> &w = ir->GetWeights();
    const Vector &j = geom->J;
@@ -156,8 +183,11 @@ void VectorDiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
       constexpr int DIM = 2;
       constexpr int SDIM = 3;
       const int NQ = quad1D*quad1D;
+      const bool const_c = coeff.Size() == 1;
       auto W = w.Read();
       auto J = Reshape(j.Read(), NQ, SDIM, DIM, ne);
+      auto C = const_c ? Reshape(coeff.Read(), 1, 1) :
+               Reshape(coeff.Read(), NQ, ne);
       auto D = Reshape(d.Write(), NQ, SDIM, ne);
       MFEM_FORALL(e, ne,
       {
@@ -174,7 +204,7 @@ void VectorDiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
             const double G = J12*J12 + J22*J22 + J32*J32;
             const double F = J11*J12 + J21*J22 + J31*J32;
             const double iw = 1.0 / sqrt(E*G - F*F);
-            const double alpha = wq * coeff * iw;
+            const double alpha = wq * (const_c ? C(0,0) : C(q,e)) * iw;
             D(q,0,e) =  alpha * G; // 1,1
             D(q,1,e) = -alpha * F; // 1,2
             D(q,2,e) =  alpha * E; // 2,2
@@ -12,6 +12,7 @@
 // Implementation of Coefficient class
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 #include <cmath>
 #include <limits>
@@ -21,6 +22,105 @@ namespace mfem
 
 using namespace std;
 
+void Coefficient::Project(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir)
+{
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   qcoeff.SetSize(NQ*NE);
+   auto C = Reshape(qcoeff.HostWrite(), NQ, NE);
+   for (int e = 0; e < NE; e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         C(q,e) = Eval(T, ip);
+      }
+   }
+}
+
+void Coefficient::Project(Vector &vals, Mesh &mesh, const IntegrationRule &ir,
+                          const Array<int> &qe)
+{
+   const int NQ = ir.GetNPoints();
+   const int *QE = qe.HostRead();
+   vals.SetSize(qe.Size());
+   double *V = vals.HostWrite();
+   ElementTransformation *T = NULL;
+   for (int i = 0, e = -1; i < qe.Size(); i++)
+   {
+      if (QE[i]/NQ != e)
+      {
+         e = QE[i]/NQ;
+         T = mesh.GetElementTransformation(e);
+      }
+      const IntegrationPoint &ip = ir.IntPoint(QE[i]%NQ);
+      T->SetIntPoint(&ip);
+      V[i] = Eval(*T, ip);
+   }
+}
+
+void Coefficient::Project(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "invalid QuadratureFunction");
+   const QuadratureSpace &qs = *qf.GetSpace();
+   Mesh &mesh = *qs.GetMesh();
+   const int NE = mesh.GetNE();
+   if (NE == 0) { return; }
+   if (mesh.GetNumGeometries(mesh.Dimension()) == 1)
+   {
+      // All elements use the same rule
+      Project(qf, mesh, qs.GetElementIntRule(0));
+      return;
+   }
+   qf.HostReadWrite();
+   Vector values;
+   for (int e = 0; e < NE; e++)
+   {
+      const IntegrationRule &ir = qs.GetElementIntRule(e);
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      qf.GetElementValues(e, values);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         values(q) = Eval(T, ip);
+      }
+   }
+}
+
+// The batched evaluations based on the QuadratureInterpolator, directly or
+// through the GeometricFactors, require a single element geometry and elements
+// that can be tabulated.
+static bool UsesBatchedEval(const Mesh &mesh)
+{
+   return (mesh.GetNE() > 0 && mesh.NURBSext == NULL &&
+           mesh.GetNumGeometries(mesh.Dimension()) == 1);
+}
+
+void ConstantCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                  const IntegrationRule &ir)
+{
+   const int N = ir.GetNPoints()*mesh.GetNE();
+   const double c = constant;
+   qcoeff.SetSize(N);
+   auto C = qcoeff.Write();
+   MFEM_FORALL(i, N, C[i] = c;);
+}
+
+void ConstantCoefficient::Project(Vector &vals, Mesh &mesh,
+                                  const IntegrationRule &ir,
+                                  const Array<int> &qe)
+{
+   const int N = qe.Size();
+   const double c = constant;
+   vals.SetSize(N);
+   auto V = vals.Write();
+   MFEM_FORALL(i, N, V[i] = c;);
+}
+
 double PWConstCoefficient::Eval(ElementTransformation & T,
                                 const IntegrationPoint & ip)
 {
@@ -28,6 +128,91 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void PWConstCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                 const IntegrationRule &ir)
+{
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   Array<int> attr(NE);
+   for (int e = 0; e < NE; e++) { attr[e] = mesh.GetAttribute(e); }
+   qcoeff.SetSize(NQ*NE);
+   auto A = attr.Read();
+   auto c = constants.Read();
+   auto C = qcoeff.Write();
+   MFEM_FORALL(i, NQ*NE, C[i] = c[A[i/NQ]-1];);
+}
+
+void PWConstCoefficient::Project(Vector &vals, Mesh &mesh,
+                                 const IntegrationRule &ir,
+                                 const Array<int> &qe)
+{
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   Array<int> attr(NE);
+   for (int e = 0; e < NE; e++) { attr[e] = mesh.GetAttribute(e); }
+   vals.SetSize(qe.Size());
+   auto A = attr.Read();
+   auto QE = qe.Read();
+   auto c = constants.Read();
+   auto V = vals.Write();
+   MFEM_FORALL(i, qe.Size(), V[i] = c[A[QE[i]/NQ]-1];);
+}
+
+// Interpolate the physical coordinates of the points given by the indices
+// q + NQ*e in @a qe, see Coefficient::Project(), from the mesh nodes. The
+// result @a X has the column-major (qe.Size() x SDIM) layout. Return false for
+// the meshes where the batched evaluations are not supported.
+static bool PointCoordinates(Mesh &mesh, const IntegrationRule &ir,
+                             const Array<int> &qe, Vector &X)
+{
+   const GridFunction *nodes = mesh.GetNodes();
+   if (nodes == NULL || !UsesBatchedEval(mesh)) { return false; }
+   const FiniteElementSpace &nfes = *nodes->FESpace();
+   const FiniteElement &nfe = *nfes.GetFE(0);
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   const int ND = nfe.GetDof();
+   const int SDIM = nfes.GetVDim();
+   const int N = qe.Size();
+   // The shape functions of the nodes at the points of the rule are computed
+   // directly: the rule may not be persistent, so the tables cached per rule in
+   // the finite element are not used.
+   Vector B(ND*NQ), shape;
+   for (int q = 0; q < NQ; q++)
+   {
+      shape.SetDataAndSize(B.GetData() + ND*q, ND);
+      nfe.CalcShape(ir.IntPoint(q), shape);
+   }
+   const Operator *elem_restr =
+      nfes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector e_nodes;
+   if (elem_restr)
+   {
+      e_nodes.SetSize(elem_restr->Height());
+      elem_restr->Mult(*nodes, e_nodes);
+   }
+   else
+   {
+      e_nodes.MakeRef(const_cast<GridFunction&>(*nodes), 0, nodes->Size());
+   }
+   X.SetSize(N*SDIM);
+   auto b = Reshape(B.Read(), ND, NQ);
+   auto xe = Reshape(e_nodes.Read(), ND, SDIM, NE);
+   auto QE = qe.Read();
+   auto x = Reshape(X.Write(), N, SDIM);
+   MFEM_FORALL(i, N,
+   {
+      const int q = QE[i] % NQ, e = QE[i] / NQ;
+      for (int d = 0; d < SDIM; d++)
+      {
+         double xd = 0.0;
+         for (int j = 0; j < ND; j++) { xd += b(j,q)*xe(j,d,e); }
+         x(i,d) = xd;
+      }
+   });
+   return true;
+}
+
 double FunctionCoefficient::Eval(ElementTransformation & T,
                                  const IntegrationPoint & ip)
 {
@@ -46,12 +231,135 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                  const IntegrationRule &ir)
+{
+   if (!UsesBatchedEval(mesh))
+   {
+      Coefficient::Project(qcoeff, mesh, ir);
+      return;
+   }
+   // The C-function is called on the host, at the physical coordinates of the
+   // points computed (on the device) with the geometric factors
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   const int sdim = mesh.SpaceDimension();
+   const GeometricFactors *geom =
+      mesh.GetGeometricFactors(ir, GeometricFactors::COORDINATES);
+   const auto X = Reshape(geom->X.HostRead(), NQ, sdim, NE);
+   qcoeff.SetSize(NQ*NE);
+   auto C = Reshape(qcoeff.HostWrite(), NQ, NE);
+   const double t = GetTime();
+   double x[3];
+   Vector transip(x, sdim);
+   for (int e = 0; e < NE; e++)
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         for (int d = 0; d < sdim; d++) { x[d] = X(q,d,e); }
+         C(q,e) = Function ? (*Function)(transip) : (*TDFunction)(transip, t);
+      }
+   }
+}
+
+void FunctionCoefficient::Project(Vector &vals, Mesh &mesh,
+                                  const IntegrationRule &ir,
+                                  const Array<int> &qe)
+{
+   Vector X;
+   if (!PointCoordinates(mesh, ir, qe, X))
+   {
+      Coefficient::Project(vals, mesh, ir, qe);
+      return;
+   }
+   const int N = qe.Size();
+   const int sdim = mesh.SpaceDimension();
+   const auto x_pts = Reshape(X.HostRead(), N, sdim);
+   vals.SetSize(N);
+   double *V = vals.HostWrite();
+   const double t = GetTime();
+   double x[3];
+   Vector transip(x, sdim);
+   for (int i = 0; i < N; i++)
+   {
+      for (int d = 0; d < sdim; d++) { x[d] = x_pts(i,d); }
+      V[i] = Function ? (*Function)(transip) : (*TDFunction)(transip, t);
+   }
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
    return GridF -> GetValue (T, ip, Component);
 }
 
+// Return the QuadratureInterpolator of the space of @a gf for the points of
+// @a ir, with output layout QVectorLayout::byNODES, and set @a e_vec to the
+// corresponding E-vector of @a gf. Return NULL when the values of @a gf can not
+// be interpolated in batch, e.g. for vector FE or INTEGRAL map types.
+static const QuadratureInterpolator *GetInterpolator(const GridFunction &gf,
+                                                     Mesh &mesh,
+                                                     const IntegrationRule &ir,
+                                                     Vector &e_vec)
+{
+   const FiniteElementSpace &fes = *gf.FESpace();
+   if (fes.GetMesh() != &mesh || !UsesBatchedEval(mesh) || fes.GetVDim() > 3)
+   {
+      return NULL;
+   }
+   const FiniteElement &fe = *fes.GetFE(0);
+   if (fe.GetRangeType() != FiniteElement::SCALAR ||
+       fe.GetMapType() != FiniteElement::VALUE)
+   {
+      return NULL;
+   }
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+   // Quads and hexes use sum factorization, with lexicographic E-vectors
+   const ElementDofOrdering e_ordering = qi->UsesTensorProducts() ?
+                                         ElementDofOrdering::LEXICOGRAPHIC :
+                                         ElementDofOrdering::NATIVE;
+   const Operator *elem_restr = fes.GetElementRestriction(e_ordering);
+   if (elem_restr)
+   {
+      e_vec.SetSize(elem_restr->Height());
+      elem_restr->Mult(gf, e_vec);
+   }
+   else
+   {
+      e_vec.MakeRef(const_cast<GridFunction&>(gf), 0, gf.Size());
+   }
+   return qi;
+}
+
+void GridFunctionCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                      const IntegrationRule &ir)
+{
+   Vector e_vec;
+   const QuadratureInterpolator *qi = GetInterpolator(*GridF, mesh, ir, e_vec);
+   if (!qi)
+   {
+      Coefficient::Project(qcoeff, mesh, ir);
+      return;
+   }
+   const int vdim = GridF->FESpace()->GetVDim();
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   qcoeff.SetSize(NQ*NE);
+   if (vdim == 1)
+   {
+      qi->Values(e_vec, qcoeff);
+      return;
+   }
+   // Extract the component from the (NQ x VDIM x NE) values
+   Vector q_val(NQ*vdim*NE);
+   qi->Values(e_vec, q_val);
+   const int c = Component - 1;
+   auto V = Reshape(q_val.Read(), NQ, vdim, NE);
+   auto C = Reshape(qcoeff.Write(), NQ, NE);
+   MFEM_FORALL(i, NQ*NE, C(i%NQ,i/NQ) = V(i%NQ,c,i/NQ););
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
@@ -66,6 +374,53 @@ double TransformedCoefficient::Eval(ElementTransformation &T,
    }
 }
 
+void SumCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                             const IntegrationRule &ir)
+{
+   b->Project(qcoeff, mesh, ir);
+   const int N = qcoeff.Size();
+   const double al = alpha, be = beta;
+   auto C = qcoeff.ReadWrite();
+   if (a == NULL)
+   {
+      const double ac = alpha*aConst;
+      MFEM_FORALL(i, N, C[i] = ac + be*C[i];);
+      return;
+   }
+   Vector qa;
+   a->Project(qa, mesh, ir);
+   auto A = qa.Read();
+   MFEM_FORALL(i, N, C[i] = al*A[i] + be*C[i];);
+}
+
+void ProductCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                 const IntegrationRule &ir)
+{
+   b->Project(qcoeff, mesh, ir);
+   const int N = qcoeff.Size();
+   auto C = qcoeff.ReadWrite();
+   if (a == NULL)
+   {
+      const double ac = aConst;
+      MFEM_FORALL(i, N, C[i] *= ac;);
+      return;
+   }
+   Vector qa;
+   a->Project(qa, mesh, ir);
+   auto A = qa.Read();
+   MFEM_FORALL(i, N, C[i] *= A[i];);
+}
+
+void PowerCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir)
+{
+   a->Project(qcoeff, mesh, ir);
+   const int N = qcoeff.Size();
+   const double pw = p;
+   auto C = qcoeff.ReadWrite();
+   MFEM_FORALL(i, N, C[i] = pow(C[i], pw););
+}
+
 void DeltaCoefficient::SetDeltaCenter(const Vector& vcenter)
 {
    MFEM_VERIFY(vcenter.Size() <= 3,
@@ -101,6 +456,73 @@ void VectorCoefficient::Eval(DenseMatrix &M, ElementTransformation &T,
    }
 }
 
+void VectorCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                const IntegrationRule &ir)
+{
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   qcoeff.SetSize(NQ*vdim*NE);
+   auto C = Reshape(qcoeff.HostWrite(), NQ, vdim, NE);
+   DenseMatrix M;
+   for (int e = 0; e < NE; e++)
+   {
+      Eval(M, *mesh.GetElementTransformation(e), ir);
+      for (int d = 0; d < vdim; d++)
+      {
+         for (int q = 0; q < NQ; q++) { C(q,d,e) = M(d,q); }
+      }
+   }
+}
+
+void VectorCoefficient::Project(Vector &vals, Mesh &mesh,
+                                const IntegrationRule &ir,
+                                const Array<int> &qe)
+{
+   const int NQ = ir.GetNPoints();
+   const int N = qe.Size();
+   const int *QE = qe.HostRead();
+   vals.SetSize(N*vdim);
+   auto V = Reshape(vals.HostWrite(), N, vdim);
+   ElementTransformation *T = NULL;
+   Vector v;
+   for (int i = 0, e = -1; i < N; i++)
+   {
+      if (QE[i]/NQ != e)
+      {
+         e = QE[i]/NQ;
+         T = mesh.GetElementTransformation(e);
+      }
+      const IntegrationPoint &ip = ir.IntPoint(QE[i]%NQ);
+      T->SetIntPoint(&ip);
+      Eval(v, *T, ip);
+      for (int d = 0; d < vdim; d++) { V(i,d) = v(d); }
+   }
+}
+
+void VectorConstantCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                        const IntegrationRule &ir)
+{
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   const int VDIM = vdim;
+   qcoeff.SetSize(NQ*VDIM*NE);
+   auto v = vec.Read();
+   auto C = qcoeff.Write();
+   MFEM_FORALL(i, NQ*VDIM*NE, C[i] = v[(i/NQ)%VDIM];);
+}
+
+void VectorConstantCoefficient::Project(Vector &vals, Mesh &mesh,
+                                        const IntegrationRule &ir,
+                                        const Array<int> &qe)
+{
+   const int N = qe.Size();
+   const int NV = N*vdim;
+   vals.SetSize(NV);
+   auto v = vec.Read();
+   auto V = vals.Write();
+   MFEM_FORALL(i, NV, V[i] = v[i/N];);
+}
+
 void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
                                      const IntegrationPoint &ip)
 {
@@ -124,6 +546,46 @@ void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
    }
 }
 
+void VectorFunctionCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                        const IntegrationRule &ir)
+{
+   if (!UsesBatchedEval(mesh))
+   {
+      VectorCoefficient::Project(qcoeff, mesh, ir);
+      return;
+   }
+   // The C-function is called on the host, see FunctionCoefficient::Project()
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   const int sdim = mesh.SpaceDimension();
+   const GeometricFactors *geom =
+      mesh.GetGeometricFactors(ir, GeometricFactors::COORDINATES);
+   const auto X = Reshape(geom->X.HostRead(), NQ, sdim, NE);
+   Vector qq;
+   if (Q)
+   {
+      Q->SetTime(GetTime());
+      Q->Project(qq, mesh, ir);
+   }
+   const double *q_ptr = Q ? qq.HostRead() : NULL;
+   qcoeff.SetSize(NQ*vdim*NE);
+   auto C = Reshape(qcoeff.HostWrite(), NQ, vdim, NE);
+   const double t = GetTime();
+   double x[3];
+   Vector transip(x, sdim), V(vdim);
+   for (int e = 0; e < NE; e++)
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         for (int d = 0; d < sdim; d++) { x[d] = X(q,d,e); }
+         if (Function) { (*Function)(transip, V); }
+         else { (*TDFunction)(transip, t, V); }
+         const double s = q_ptr ? q_ptr[q+NQ*e] : 1.0;
+         for (int d = 0; d < vdim; d++) { C(q,d,e) = s*V(d); }
+      }
+   }
+}
+
 VectorArrayCoefficient::VectorArrayCoefficient (int dim)
    : VectorCoefficient(dim), Coeff(dim), ownCoeff(dim)
 {
@@ -177,12 +639,62 @@ void VectorGridFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
    GridFunc->GetVectorValue(T, ip, V);
 }
 
+void VectorFunctionCoefficient::Project(Vector &vals, Mesh &mesh,
+                                        const IntegrationRule &ir,
+                                        const Array<int> &qe)
+{
+   Vector X;
+   if (!PointCoordinates(mesh, ir, qe, X))
+   {
+      VectorCoefficient::Project(vals, mesh, ir, qe);
+      return;
+   }
+   Vector qq;
+   if (Q)
+   {
+      Q->SetTime(GetTime());
+      Q->Project(qq, mesh, ir, qe);
+   }
+   const double *q_ptr = Q ? qq.HostRead() : NULL;
+   const int N = qe.Size();
+   const int sdim = mesh.SpaceDimension();
+   const auto x_pts = Reshape(X.HostRead(), N, sdim);
+   vals.SetSize(N*vdim);
+   auto C = Reshape(vals.HostWrite(), N, vdim);
+   const double t = GetTime();
+   double x[3];
+   Vector transip(x, sdim), V(vdim);
+   for (int i = 0; i < N; i++)
+   {
+      for (int d = 0; d < sdim; d++) { x[d] = x_pts(i,d); }
+      if (Function) { (*Function)(transip, V); }
+      else { (*TDFunction)(transip, t, V); }
+      const double s = q_ptr ? q_ptr[i] : 1.0;
+      for (int d = 0; d < vdim; d++) { C(i,d) = s*V(d); }
+   }
+}
+
 void VectorGridFunctionCoefficient::Eval(
    DenseMatrix &M, ElementTransformation &T, const IntegrationRule &ir)
 {
    GridFunc->GetVectorValues(T, ir, M);
 }
 
+void VectorGridFunctionCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                            const IntegrationRule &ir)
+{
+   Vector e_vec;
+   const QuadratureInterpolator *qi =
+      GetInterpolator(*GridFunc, mesh, ir, e_vec);
+   if (!qi)
+   {
+      VectorCoefficient::Project(qcoeff, mesh, ir);
+      return;
+   }
+   qcoeff.SetSize(ir.GetNPoints()*vdim*mesh.GetNE());
+   qi->Values(e_vec, qcoeff);
+}
+
 GradientGridFunctionCoefficient::GradientGridFunctionCoefficient (
    const GridFunction *gf)
    : VectorCoefficient((gf) ?
@@ -209,6 +721,24 @@ void GradientGridFunctionCoefficient::Eval(
    GridFunc->GetGradients(T, ir, M);
 }
 
+void GradientGridFunctionCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                              const IntegrationRule &ir)
+{
+   Vector e_vec;
+   const QuadratureInterpolator *qi =
+      GetInterpolator(*GridFunc, mesh, ir, e_vec);
+   // The physical derivatives require tensor product evaluations
+   if (!qi || !qi->UsesTensorProducts() ||
+       GridFunc->FESpace()->GetVDim() != 1 ||
+       mesh.Dimension() != mesh.SpaceDimension())
+   {
+      VectorCoefficient::Project(qcoeff, mesh, ir);
+      return;
+   }
+   qcoeff.SetSize(ir.GetNPoints()*vdim*mesh.GetNE());
+   qi->PhysDerivatives(e_vec, qcoeff);
+}
+
 CurlGridFunctionCoefficient::CurlGridFunctionCoefficient(
    const GridFunction *gf)
    : VectorCoefficient(0)
@@ -903,4 +1433,21 @@ double QuadratureFunctionCoefficient::Eval(ElementTransformation &T,
    return temp[0];
 }
 
+void QuadratureFunctionCoefficient::Project(Vector &qcoeff, Mesh &mesh,
+                                            const IntegrationRule &ir)
+{
+   const QuadratureSpace &qs = *QuadF.GetSpace();
+   if (QuadF.GetVDim() != 1 || qs.GetMesh() != &mesh ||
+       !UsesBatchedEval(mesh) || &qs.GetElementIntRule(0) != &ir)
+   {
+      Coefficient::Project(qcoeff, mesh, ir);
+      return;
+   }
+   const int N = QuadF.Size();
+   qcoeff.SetSize(N);
+   auto Q = QuadF.Read();
+   auto C = qcoeff.Write();
+   MFEM_FORALL(i, N, C[i] = Q[i];);
+}
+
 }
@@ -21,6 +21,7 @@ namespace mfem
 {
 
 class Mesh;
+class QuadratureFunction;
 
 #ifdef MFEM_USE_MPI
 class ParMesh;
@@ -68,6 +69,30 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at all points of the IntegrationRule
+       @a ir in all elements of @a mesh. */
+   /** The values are stored in @a qcoeff, resized to NQ*NE, with the
+       column-major (NQ x NE) layout of the quadrature point data of the partial
+       assembly. The base class calls the pointwise Eval() in every element;
+       the derived classes replace it with batched evaluations, which run on the
+       device when possible. */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
+   /** @brief Evaluate the coefficient at a subset of the points of the
+       IntegrationRule @a ir in the elements of @a mesh. */
+   /** The points are given by the indices q + NQ*e in @a qe, where q is the
+       index of the point in @a ir, e is the element index and NQ is the number
+       of points in @a ir. The values are stored in @a vals, resized to
+       qe.Size(). The base class calls the pointwise Eval(). This is used by
+       GridFunction::ProjectCoefficient() with the nodes of the finite element,
+       each dof being evaluated in one element only. */
+   virtual void Project(Vector &vals, Mesh &mesh, const IntegrationRule &ir,
+                        const Array<int> &qe);
+
+   /** @brief Evaluate the coefficient at the quadrature points of the
+       QuadratureSpace of @a qf, storing the values in @a qf. */
+   void Project(QuadratureFunction &qf);
+
    virtual ~Coefficient() { }
 };
 
@@ -85,6 +110,11 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   using Coefficient::Project;
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+   virtual void Project(Vector &vals, Mesh &mesh, const IntegrationRule &ir,
+                        const Array<int> &qe);
 };
 
 /** @brief A piecewise constant coefficient with the constants keyed
@@ -121,6 +151,12 @@ public:
    /// Evaluate the coefficient.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   using Coefficient::Project;
+   /// Batched evaluation, keyed off the element attributes on the device.
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+   virtual void Project(Vector &vals, Mesh &mesh, const IntegrationRule &ir,
+                        const Array<int> &qe);
 };
 
 
@@ -167,6 +203,15 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   using Coefficient::Project;
+   /** @brief Batched evaluation: the function is called at the physical
+       coordinates of the points, see Mesh::GetGeometricFactors(). */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+   /** @brief The physical coordinates of the points are interpolated from the
+       mesh nodes, when present, for the requested points only. */
+   virtual void Project(Vector &vals, Mesh &mesh, const IntegrationRule &ir,
+                        const Array<int> &qe);
 };
 
 class GridFunction;
@@ -194,6 +239,11 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   using Coefficient::Project;
+   /** @brief Batched evaluation with the QuadratureInterpolator of the
+       FiniteElementSpace of the GridFunction, on the device when enabled. */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 
@@ -382,6 +432,21 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Evaluate the vector coefficient at all points of the
+       IntegrationRule @a ir in all elements of @a mesh. */
+   /** The values are stored in @a qcoeff, resized to NQ*VDIM*NE, with the
+       column-major (NQ x VDIM x NE) layout of the coordinates in
+       GeometricFactors. The base class uses the Eval() method for all points of
+       one element at a time. See also Coefficient::Project(). */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
+   /** @brief Evaluate the vector coefficient at the subset of the points of
+       @a ir given by the indices in @a qe, see Coefficient::Project(). */
+   /** The values are stored in @a vals, resized to qe.Size()*VDIM, with the
+       column-major (qe.Size() x VDIM) layout. */
+   virtual void Project(Vector &vals, Mesh &mesh, const IntegrationRule &ir,
+                        const Array<int> &qe);
+
    virtual ~VectorCoefficient() { }
 };
 
@@ -403,6 +468,10 @@ public:
 
    /// Return a reference to the constant vector in this class.
    const Vector& GetVec() { return vec; }
+
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+   virtual void Project(Vector &vals, Mesh &mesh, const IntegrationRule &ir,
+                        const Array<int> &qe);
 };
 
 /// A general C-function vector coefficient
@@ -438,6 +507,13 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip);
 
+   /** @brief Batched evaluation: the function is called at the physical
+       coordinates of the points, see Mesh::GetGeometricFactors(). */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+   /// See FunctionCoefficient::Project().
+   virtual void Project(Vector &vals, Mesh &mesh, const IntegrationRule &ir,
+                        const Array<int> &qe);
+
    virtual ~VectorFunctionCoefficient() { }
 };
 
@@ -512,6 +588,11 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   using VectorCoefficient::Project;
+   /** @brief Batched evaluation with the QuadratureInterpolator of the
+       FiniteElementSpace of the GridFunction, on the device when enabled. */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~VectorGridFunctionCoefficient() { }
 };
 
@@ -543,6 +624,11 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   using VectorCoefficient::Project;
+   /** @brief Batched evaluation with QuadratureInterpolator::PhysDerivatives(),
+       for tensor product elements. */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~GradientGridFunctionCoefficient() { }
 };
 
@@ -912,6 +998,10 @@ public:
       return alpha * ((a == NULL ) ? aConst : a->Eval(T, ip) )
              + beta * b->Eval(T, ip);
    }
+
+   using Coefficient::Project;
+   /// Batched evaluation, combining the batched evaluations of the terms.
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 /** Scalar coefficient defined as the product of two scalar coefficients or
@@ -951,6 +1041,10 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return ((a == NULL ) ? aConst : a->Eval(T, ip) ) * b->Eval(T, ip); }
+
+   using Coefficient::Project;
+   /// Batched evaluation, combining the batched evaluations of the factors.
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 /** Scalar coefficient defined as the ratio of two scalars where one or both
@@ -1034,6 +1128,10 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return pow(a->Eval(T, ip), p); }
+
+   using Coefficient::Project;
+   /// Batched evaluation, based on the batched evaluation of the base.
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 
@@ -1572,6 +1670,11 @@ public:
 
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip);
 
+   using Coefficient::Project;
+   /** @brief Copy the values of the QuadratureFunction when its points are
+       those of @a ir in all elements of @a mesh. */
+   virtual void Project(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~QuadratureFunctionCoefficient() { }
 };
 
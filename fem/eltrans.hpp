@@ -342,6 +342,11 @@ public:
 };
 
 /// A standard isoparametric element transformation
+/** The transformation stores the current element, integration point and the
+    quantities evaluated at that point, so each thread has to use its own
+    object, e.g. initialized with Mesh::GetElementTransformation(int,
+    IsoparametricTransformation*). Its methods only read the shared
+    FiniteElement, see the FiniteElement notes on MFEM_THREAD_SAFE. */
 class IsoparametricTransformation : public ElementTransformation
 {
 private:
@@ -505,6 +505,16 @@ const DofToQuad &ScalarFiniteElement::GetDofToQuad(const IntegrationRule &ir,
    return *d2q;
 }
 
+const DofToQuad *ScalarFiniteElement::GetShapeTable(
+   const IntegrationRule &ir) const
+{
+#ifdef MFEM_THREAD_SAFE
+   return NULL;
+#else
+   return &GetDofToQuad(ir, DofToQuad::FULL);
+#endif
+}
+
 // protected method
 const DofToQuad &ScalarFiniteElement::GetTensorDofToQuad(
    const TensorBasisElement &tb,
@@ -1742,8 +1752,13 @@ const double GaussQuad2DFiniteElement::p[] =
 { 0.0915762135097707434595714634022015, 0.445948490915964886318329253883051 };
 
 GaussQuad2DFiniteElement::GaussQuad2DFiniteElement()
-   : NodalFiniteElement(2, Geometry::TRIANGLE, 6, 2), A(6), D(6,2), pol(6)
+   : NodalFiniteElement(2, Geometry::TRIANGLE, 6, 2), A(6)
 {
+#ifndef MFEM_THREAD_SAFE
+   D.SetSize(6,2);
+   pol.SetSize(6);
+#endif
+
    Nodes.IntPoint(0).x = p[0];
    Nodes.IntPoint(0).y = p[0];
    Nodes.IntPoint(1).x = 1. - 2. * p[0];
@@ -1775,6 +1790,9 @@ void GaussQuad2DFiniteElement::CalcShape(const IntegrationPoint &ip,
                                          Vector &shape) const
 {
    const double x = ip.x, y = ip.y;
+#ifdef MFEM_THREAD_SAFE
+   Vector pol(6);
+#endif
    pol(0) = 1.;
    pol(1) = x;
    pol(2) = y;
@@ -1789,6 +1807,9 @@ void GaussQuad2DFiniteElement::CalcDShape(const IntegrationPoint &ip,
                                           DenseMatrix &dshape) const
 {
    const double x = ip.x, y = ip.y;
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix D(6,2);
+#endif
    D(0,0) = 0.;      D(0,1) = 0.;
    D(1,0) = 1.;      D(1,1) = 0.;
    D(2,0) = 0.;      D(2,1) = 1.;
@@ -6894,6 +6915,9 @@ Poly_1D::Basis::Basis(const int p, const double *nodes, EvalType etype)
       }
       case Positive:
          x.SetDataAndSize(NULL, p + 1); // use x to store (p + 1)
+         // Generate the binomial coefficients here, so that Eval() does not
+         // modify the static table
+         Binom(p);
          break;
 
       default: break;
@@ -6906,6 +6930,9 @@ void Poly_1D::Basis::Eval(const double y, Vector &u) const
    {
       case ChangeOfBasis:
       {
+#ifdef MFEM_THREAD_SAFE
+         Vector x(Ai.Width());
+#endif
          CalcBasis(Ai.Width() - 1, y, x);
          Ai.Mult(x, u);
          break;
@@ -6964,6 +6991,9 @@ void Poly_1D::Basis::Eval(const double y, Vector &u, Vector &d) const
    {
       case ChangeOfBasis:
       {
+#ifdef MFEM_THREAD_SAFE
+         Vector x(Ai.Width()), w(Ai.Width());
+#endif
          CalcBasis(Ai.Width() - 1, y, x, w);
          Ai.Mult(x, u);
          Ai.Mult(w, d);
@@ -8525,6 +8555,8 @@ H1Pos_TriangleElement::H1Pos_TriangleElement(const int p)
    dshape_1d.SetSize(p + 1);
    m_dshape.SetSize(dof, dim);
 #endif
+   // Generate the binomial coefficients used by CalcShape() and CalcDShape()
+   Poly_1D::Binom(p);
    dof_map.SetSize(dof);
 
    struct Index
@@ -8670,6 +8702,8 @@ H1Pos_TetrahedronElement::H1Pos_TetrahedronElement(const int p)
    dshape_1d.SetSize(p + 1);
    m_dshape.SetSize(dof, dim);
 #endif
+   // Generate the binomial coefficients used by CalcShape() and CalcDShape()
+   Poly_1D::Binom(p);
    dof_map.SetSize(dof);
 
    struct Index
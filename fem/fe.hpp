@@ -232,6 +232,13 @@ class KnotVector;
 
 
 /// Abstract class for all finite elements.
+/** The evaluation methods, e.g. CalcShape(), CalcDShape() and CalcVShape(),
+    use work arrays stored in the object, so a FiniteElement can not be
+    evaluated concurrently by several threads, unless MFEM is built with
+    MFEM_THREAD_SAFE, in which case the work arrays are local to the methods.
+    The NURBS elements keep the current patch and element as state and are
+    never thread-safe. The DofToQuad maps are created and stored on first use
+    by GetDofToQuad(), which should be called before any concurrent use. */
 class FiniteElement
 {
 protected:
@@ -556,6 +563,17 @@ public:
    /** See the documentation for DofToQuad for more details. */
    virtual const DofToQuad &GetDofToQuad(const IntegrationRule &ir,
                                          DofToQuad::Mode mode) const;
+
+   /** @brief Return the DofToQuad::FULL maps of the shape functions and their
+       reference derivatives at the points of @a ir, or NULL if the element
+       does not support tabulation. */
+   /** The element assembly of the integrators uses the returned tables, which
+       are cached by the address of @a ir as in GetDofToQuad(), instead of
+       evaluating the basis at every point of every element. The default
+       implementation returns NULL. */
+   virtual const DofToQuad *GetShapeTable(const IntegrationRule &ir) const
+   { return NULL; }
+
    /// Deconstruct the FiniteElement
    virtual ~FiniteElement();
 
@@ -669,6 +687,11 @@ public:
 
    virtual const DofToQuad &GetDofToQuad(const IntegrationRule &ir,
                                          DofToQuad::Mode mode) const;
+
+   /** @brief Return the maps from GetDofToQuad() in DofToQuad::FULL mode, or
+       NULL when MFEM is built with MFEM_THREAD_SAFE, since the maps are
+       created on first use. */
+   virtual const DofToQuad *GetShapeTable(const IntegrationRule &ir) const;
 };
 
 
@@ -1057,8 +1080,10 @@ class GaussQuad2DFiniteElement : public NodalFiniteElement
 private:
    static const double p[2];
    DenseMatrix A;
+#ifndef MFEM_THREAD_SAFE
    mutable DenseMatrix D;
    mutable Vector pol;
+#endif
 public:
    /// Construct the GaussQuad2DFiniteElement
    GaussQuad2DFiniteElement();
@@ -1843,6 +1868,8 @@ public:
    private:
       int etype;
       DenseMatrixInverse Ai;
+      // Nodes and weights of the barycentric interpolation; work vectors of
+      // Eval() with ChangeOfBasis, unless MFEM_THREAD_SAFE is defined.
       mutable Vector x, w;
 
    public:
@@ -3162,6 +3189,10 @@ public:
       weights = 1.0;
    }
 
+   /// The NURBS shape functions depend on the current element: returns NULL.
+   virtual const DofToQuad *GetShapeTable(const IntegrationRule &ir) const
+   { return NULL; }
+
    void                 Reset      ()         const { patch = elem = -1; }
    void                 SetIJK     (const int *IJK) const { ijk = IJK; }
    int                  GetPatch   ()         const { return patch; }
@@ -61,6 +61,7 @@ FiniteElementSpace::FiniteElementSpace()
      ndofs(0), nvdofs(0), nedofs(0), nfdofs(0), nbdofs(0),
      fdofs(NULL), bdofs(NULL),
      elem_dof(NULL), bdrElem_dof(NULL), face_dof(NULL),
+     locality_numbering(false),
      NURBSext(NULL), own_ext(false),
      cP(NULL), cR(NULL), cP_is_set(false),
      Th(Operator::ANY_TYPE),
@@ -308,6 +309,48 @@ void FiniteElementSpace::ReorderElementToDofTable()
    }
 }
 
+void FiniteElementSpace::SetLocalityDofNumbering(bool enable)
+{
+   MFEM_VERIFY(!NURBSext && Conforming(),
+               "the locality numbering requires a conforming, non-NURBS mesh");
+#ifdef MFEM_USE_MPI
+   MFEM_VERIFY(dynamic_cast<ParMesh*>(mesh) == NULL,
+               "the locality numbering is not supported in parallel");
+#endif
+   if (enable == locality_numbering) { return; }
+
+   locality_numbering = enable;
+   Destroy();
+   Construct();
+   BuildElementToDofTable();
+}
+
+void FiniteElementSpace::BuildLocalityDofNumbering()
+{
+   MFEM_ASSERT(elem_dof == NULL && dof_renumbering.Size() == 0, "");
+
+   // Number the dofs in the order of the first visit in a loop over the
+   // elements, cf. ReorderElementToDofTable.
+   Array<int> renumbering(ndofs), dofs;
+   renumbering = -1;
+   int counter = 0;
+   for (int i = 0; i < mesh->GetNE(); i++)
+   {
+      GetElementDofs(i, dofs);
+      for (int j = 0; j < dofs.Size(); j++)
+      {
+         const int dof = DecodeDof(dofs[j]);
+         if (renumbering[dof] < 0) { renumbering[dof] = counter++; }
+      }
+   }
+   // dofs not used by any element, e.g. on unused vertices, go last
+   for (int i = 0; i < ndofs; i++)
+   {
+      if (renumbering[i] < 0) { renumbering[i] = counter++; }
+   }
+   mfem::Swap(dof_renumbering, renumbering);
+}
+
 void FiniteElementSpace::BuildDofToArrays()
 {
    if (dof_elem_array.Size()) { return; }
@@ -943,6 +986,18 @@ const Operator *FiniteElementSpace::GetFaceRestriction(
    }
 }
 
+const Operator *FiniteElementSpace::GetFaceNormalDerivativeRestriction(
+   FaceType type) const
+{
+   MFEM_VERIFY(IsDGSpace(), "Face normal derivatives require an L2 space.");
+   OperatorHandle &L2FN = (type == FaceType::Interior) ? L2FN_int : L2FN_bdr;
+   if (L2FN.Ptr() == NULL)
+   {
+      L2FN.Reset(new L2NormalDerivativeFaceRestriction(*this, type));
+   }
+   return L2FN.Ptr();
+}
+
 const QuadratureInterpolator *FiniteElementSpace::GetQuadratureInterpolator(
    const IntegrationRule &ir) const
 {
@@ -1505,6 +1560,7 @@ void FiniteElementSpace::Constructor(Mesh *mesh, NURBSExtension *NURBSext,
 
    elem_dof = NULL;
    face_dof = NULL;
+   locality_numbering = false;
    sequence = mesh->GetSequence();
    Th.SetType(Operator::ANY_TYPE);
 
@@ -1685,6 +1741,9 @@ void FiniteElementSpace::Construct()
 
    ndofs = nvdofs + nedofs + nfdofs + nbdofs;
 
+   dof_renumbering.DeleteAll();
+   if (locality_numbering) { BuildLocalityDofNumbering(); }
+
    // Do not build elem_dof Table here: in parallel it has to be constructed
    // later.
 }
@@ -1788,6 +1847,7 @@ void FiniteElementSpace::GetElementDofs(int i, Array<int> &dofs) const
             dofs[ne+j] = k + j;
          }
       }
+      RenumberDofs(dofs);
    }
 }
 
@@ -1888,6 +1948,7 @@ void FiniteElementSpace::GetBdrElementDofs(int i, Array<int> &dofs) const
             }
          }
       }
+      RenumberDofs(dofs);
    }
 }
 
@@ -1956,6 +2017,7 @@ void FiniteElementSpace::GetFaceDofs(int i, Array<int> &dofs) const
             dofs[ne+k] = j;
          }
       }
+      RenumberDofs(dofs);
    }
 }
 
@@ -1986,6 +2048,7 @@ void FiniteElementSpace::GetEdgeDofs(int i, Array<int> &dofs) const
    {
       dofs[nv+j] = k;
    }
+   RenumberDofs(dofs);
 }
 
 void FiniteElementSpace::GetVertexDofs(int i, Array<int> &dofs) const
@@ -1998,6 +2061,7 @@ void FiniteElementSpace::GetVertexDofs(int i, Array<int> &dofs) const
    {
       dofs[j] = i*nv+j;
    }
+   RenumberDofs(dofs);
 }
 
 void FiniteElementSpace::GetElementInteriorDofs (int i, Array<int> &dofs) const
@@ -2011,6 +2075,7 @@ void FiniteElementSpace::GetElementInteriorDofs (int i, Array<int> &dofs) const
    {
       dofs[j] = k + j;
    }
+   RenumberDofs(dofs);
 }
 
 void FiniteElementSpace::GetEdgeInteriorDofs (int i, Array<int> &dofs) const
@@ -2023,6 +2088,7 @@ void FiniteElementSpace::GetEdgeInteriorDofs (int i, Array<int> &dofs) const
    {
       dofs[j] = k;
    }
+   RenumberDofs(dofs);
 }
 
 void FiniteElementSpace::GetFaceInteriorDofs (int i, Array<int> &dofs) const
@@ -2037,6 +2103,7 @@ void FiniteElementSpace::GetFaceInteriorDofs (int i, Array<int> &dofs) const
       {
          dofs[j] = k;
       }
+      RenumberDofs(dofs);
    }
 }
 
@@ -2119,6 +2186,8 @@ void FiniteElementSpace::Destroy()
    Th.Clear();
    L2E_nat.Clear();
    L2E_lex.Clear();
+   L2FN_int.Clear();
+   L2FN_bdr.Clear();
    for (int i = 0; i < E2Q_array.Size(); i++)
    {
       delete E2Q_array[i];
@@ -117,6 +117,12 @@ protected:
 
    Array<int> dof_elem_array, dof_ldof_array;
 
+   /// See SetLocalityDofNumbering().
+   bool locality_numbering;
+   /** If not empty, maps the dof indices derived from the vertex, edge, face
+       and element numbers (the default numbering) to the locality numbering. */
+   Array<int> dof_renumbering;
+
    NURBSExtension *NURBSext;
    int own_ext;
 
@@ -147,6 +153,9 @@ protected:
    };
    using map_L2F = std::unordered_map<const key_face,Operator*,key_hash>;
    mutable map_L2F L2F;
+   /// The face normal derivative restriction operators, see
+   /// GetFaceNormalDerivativeRestriction().
+   mutable OperatorHandle L2FN_int, L2FN_bdr;
 
    mutable Array<QuadratureInterpolator*> E2Q_array;
    mutable Array<FaceQuadratureInterpolator*> E2IFQ_array;
@@ -169,6 +178,21 @@ protected:
        boundary. */
    void BuildNURBSFaceToDofTable() const;
 
+   /// Build #dof_renumbering, called by Construct() if #locality_numbering.
+   void BuildLocalityDofNumbering();
+
+   /// Apply #dof_renumbering (if any) to a list of signed dofs.
+   void RenumberDofs(Array<int> &dofs) const
+   {
+      if (dof_renumbering.Size() == 0) { return; }
+      for (int i = 0; i < dofs.Size(); i++)
+      {
+         const int dof = dofs[i];
+         dofs[i] = (dof >= 0) ? dof_renumbering[dof]
+                   : -1-dof_renumbering[-1-dof];
+      }
+   }
+
    /// Helpers to remove encoded sign from a DOF
    static inline int DecodeDof(int dof)
    {
@@ -358,6 +382,15 @@ public:
       ElementDofOrdering e_ordering, FaceType,
       L2FaceValues mul = L2FaceValues::DoubleValued) const;
 
+   /** @brief Return an Operator that computes, on each face of type @a type,
+       the derivatives of L-vectors in the direction of the reference axis
+       normal to the face, see L2NormalDerivativeFaceRestriction. */
+   /** The face dofs of the output match the ones of the double-valued face
+       restriction with ElementDofOrdering::LEXICOGRAPHIC. Only serial L2
+       spaces of tensor-product elements are supported. The returned Operator
+       is owned by the FiniteElementSpace. */
+   const Operator *GetFaceNormalDerivativeRestriction(FaceType type) const;
+
    /** @brief Return a QuadratureInterpolator that interpolates E-vectors to
        quadrature point values and/or derivatives (Q-vectors). */
    /** An E-vector represents the element-wise discontinuous version of the FE
@@ -538,6 +571,29 @@ public:
        is preserved. */
    void ReorderElementToDofTable();
 
+   /** @brief Enable or disable the numbering of the scalar DOFs in the order of
+       the mesh elements.
+
+       By default, the DOFs are numbered in blocks: first all vertex DOFs, then
+       all edge, face and interior DOFs. With the locality numbering, the DOFs
+       are numbered in the order they are first visited by a loop over the mesh
+       elements (as in ReorderElementToDofTable()), so that the DOFs of
+       neighboring elements are close in memory. Unlike
+       ReorderElementToDofTable(), all DOF queries (boundary, face, edge,
+       vertex, etc.) use the new numbering, and the numbering is rebuilt by
+       Update(). Combined with Mesh::ReorderElementsForLocality(), this improves
+       the memory access pattern of the ElementRestriction and of assembled
+       matrices.
+
+       The existing GridFunction%s and operators on the space are invalidated,
+       so this method should be called right after the construction of the
+       space. Supported only for serial spaces on conforming, non-NURBS meshes.
+   */
+   void SetLocalityDofNumbering(bool enable = true);
+
+   /// Return true if the locality DOF numbering is enabled.
+   bool GetLocalityDofNumbering() const { return locality_numbering; }
+
    /** @brief Return a reference to the internal Table that stores the lists of
        scalar dofs, for each mesh element, as returned by GetElementDofs(). */
    const Table &GetElementToDofTable() const { return *elem_dof; }
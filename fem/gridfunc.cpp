@@ -14,6 +14,7 @@
 #include "gridfunc.hpp"
 #include "../mesh/nurbs.hpp"
 #include "../general/text.hpp"
+#include "../general/forall.hpp"
 
 #include <limits>
 #include <cstring>
@@ -2237,12 +2238,83 @@ void GridFunction::ProjectDeltaCoefficient(DeltaCoefficient &delta_coeff,
    }
 }
 
+bool GridFunction::ProjectNodalCoefficient(Coefficient *coeff,
+                                           VectorCoefficient *vcoeff,
+                                           const Array<int> *dof_map,
+                                           Vector &x) const
+{
+   Mesh &mesh = *fes->GetMesh();
+   const int NE = mesh.GetNE();
+   const int vdim = fes->GetVDim();
+   if (NE == 0 || mesh.NURBSext ||
+       mesh.GetNumGeometries(mesh.Dimension()) != 1 ||
+       (coeff && vdim != 1) || (vcoeff && vcoeff->GetVDim() != vdim))
+   {
+      return false;
+   }
+   MFEM_ASSERT(dof_map == NULL || vdim == 1, "invalid dof_map");
+   const NodalFiniteElement *fe =
+      dynamic_cast<const NodalFiniteElement*>(fes->GetFE(0));
+   if (fe == NULL || fe->GetMapType() != FiniteElement::VALUE)
+   {
+      return false;
+   }
+
+   // Select the node of each (mapped) dof in the last element containing it
+   const int ND = fe->GetDof();
+   const int ndofs = fes->GetNDofs();
+   const Table &elem_dof = fes->GetElementToDofTable();
+   Array<int> last(ndofs);
+   last = -1;
+   for (int e = 0; e < NE; e++)
+   {
+      const int *dofs = elem_dof.GetRow(e);
+      for (int j = 0; j < ND; j++) { last[dofs[j]] = j + ND*e; }
+   }
+   Array<int> qe, target;
+   for (int e = 0; e < NE; e++)
+   {
+      const int *dofs = elem_dof.GetRow(e);
+      for (int j = 0; j < ND; j++)
+      {
+         const int dof = dofs[j];
+         if (last[dof] != j + ND*e) { continue; }
+         const int t = dof_map ? (*dof_map)[dof] : dof;
+         if (t < 0) { continue; }
+         qe.Append(j + ND*e);
+         target.Append(t);
+      }
+   }
+
+   Vector vals;
+   const IntegrationRule &nodes = fe->GetNodes();
+   if (coeff) { coeff->Project(vals, mesh, nodes, qe); }
+   else { vcoeff->Project(vals, mesh, nodes, qe); }
+
+   // Scatter the values, with layout (N x vdim), to the dofs
+   const int N = qe.Size();
+   const bool byvdim = (fes->GetOrdering() == Ordering::byVDIM);
+   auto V = Reshape(vals.Read(), N, vdim);
+   auto T = target.Read();
+   auto X = x.ReadWrite();
+   MFEM_FORALL(i, N,
+   {
+      for (int d = 0; d < vdim; d++)
+      {
+         X[byvdim ? d + vdim*T[i] : T[i] + ndofs*d] = V(i,d);
+      }
+   });
+   return true;
+}
+
 void GridFunction::ProjectCoefficient(Coefficient &coeff)
 {
    DeltaCoefficient *delta_c = dynamic_cast<DeltaCoefficient *>(&coeff);
 
    if (delta_c == NULL)
    {
+      if (ProjectNodalCoefficient(&coeff, NULL, NULL, *this)) { return; }
+
       Array<int> vdofs;
       Vector vals;
 
@@ -2292,6 +2364,8 @@ void GridFunction::ProjectCoefficient(
 
 void GridFunction::ProjectCoefficient(VectorCoefficient &vcoeff)
 {
+   if (ProjectNodalCoefficient(NULL, &vcoeff, NULL, *this)) { return; }
+
    int i;
    Array<int> vdofs;
    Vector vals;
@@ -2552,6 +2626,124 @@ void GridFunction::ProjectBdrCoefficientTangent(
 #endif
 }
 
+// Return the IntegrationRule used by the batched error computations below, or
+// NULL when the mesh of @a fes does not support batched evaluations at the
+// quadrature points: mixed meshes, NURBS meshes and surface meshes. Meshes
+// without nodes are also excluded, since the geometric factors would add nodes
+// to the mesh, see Mesh::EnsureNodes().
+static const IntegrationRule *BatchedErrorRule(const FiniteElementSpace &fes,
+                                               const IntegrationRule *irs[])
+{
+   const Mesh &mesh = *fes.GetMesh();
+   if (mesh.GetNE() == 0 || mesh.NURBSext || mesh.GetNodes() == NULL ||
+       mesh.Dimension() != mesh.SpaceDimension() ||
+       mesh.GetNumGeometries(mesh.Dimension()) != 1)
+   {
+      return NULL;
+   }
+   const FiniteElement &fe = *fes.GetFE(0);
+   if (irs) { return irs[fe.GetGeomType()]; }
+   return &IntRules.Get(fe.GetGeomType(), 2*fe.GetOrder() + 3);
+}
+
+// Compute the element contributions to the Lp error, before taking the p-th
+// root, between the values @a u and @a u_ex at the points of @a ir, given with
+// the (NQ x VD x NE) layout of Coefficient::Project(). The optional scalar
+// @a weight and vector @a v_weight are used as in GridFunction::ComputeLpError.
+static void ElementLpErrors(const double p, const int VD,
+                            const IntegrationRule &ir, const Vector &detJ,
+                            const Vector &u, const Vector &u_ex,
+                            const Vector *weight, const Vector *v_weight,
+                            Vector &error)
+{
+   const int NQ = ir.GetNPoints();
+   const int NE = detJ.Size()/NQ;
+   const bool finite = p < infinity();
+   const bool use_w = (weight != NULL), use_vw = (v_weight != NULL);
+   const auto W = ir.GetWeights().Read();
+   const auto D = Reshape(detJ.Read(), NQ, NE);
+   const auto U = Reshape(u.Read(), NQ, VD, NE);
+   const auto UE = Reshape(u_ex.Read(), NQ, VD, NE);
+   const auto SW = Reshape(use_w ? weight->Read() : NULL, NQ, NE);
+   const auto VW = Reshape(use_vw ? v_weight->Read() : NULL, NQ, VD, NE);
+   error.SetSize(NE);
+   auto E = error.Write();
+   MFEM_FORALL(e, NE,
+   {
+      double err_e = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         double err = 0.0;
+         for (int d = 0; d < VD; d++)
+         {
+            const double diff = U(q,d,e) - UE(q,d,e);
+            err += use_vw ? diff*VW(q,d,e) : diff*diff;
+         }
+         err = use_vw ? fabs(err) : sqrt(err);
+         if (finite)
+         {
+            err = pow(err, p);
+            if (use_w) { err *= SW(q,e); }
+            err_e += W[q] * D(q,e) * err;
+         }
+         else
+         {
+            if (use_w) { err *= SW(q,e); }
+            err_e = fmax(err_e, err);
+         }
+      }
+      E[e] = err_e;
+   });
+}
+
+// Batched version of the Lp error computations: evaluate the GridFunction
+// @a gf, the exact solution (@a exsol or @a vexsol) and the weights at all
+// quadrature points with Coefficient::Project() and compute the element
+// contributions in @a error, on the device when enabled. Return false when the
+// batched evaluation is not supported, see BatchedErrorRule().
+static bool BatchedLpErrors(const double p, const GridFunction &gf,
+                            Coefficient *exsol, VectorCoefficient *vexsol,
+                            Coefficient *weight, VectorCoefficient *v_weight,
+                            const IntegrationRule *irs[], Vector &error)
+{
+   const IntegrationRule *ir = BatchedErrorRule(*gf.FESpace(), irs);
+   if (!ir) { return false; }
+   Mesh &mesh = *gf.FESpace()->GetMesh();
+   const Vector &detJ = mesh.GetGeometricFactors(
+                           *ir, GeometricFactors::DETERMINANTS)->detJ;
+   Vector u, u_ex, w, vw;
+   int VD = 1;
+   if (exsol)
+   {
+      GridFunctionCoefficient(&gf).Project(u, mesh, *ir);
+      exsol->Project(u_ex, mesh, *ir);
+   }
+   else
+   {
+      VectorGridFunctionCoefficient(&gf).Project(u, mesh, *ir);
+      vexsol->Project(u_ex, mesh, *ir);
+      VD = vexsol->GetVDim();
+      MFEM_VERIFY(u.Size() == u_ex.Size(), "incompatible vector dimensions");
+   }
+   if (weight) { weight->Project(w, mesh, *ir); }
+   if (v_weight) { v_weight->Project(vw, mesh, *ir); }
+   ElementLpErrors(p, VD, *ir, detJ, u, u_ex, weight ? &w : NULL,
+                   v_weight ? &vw : NULL, error);
+   return true;
+}
+
+// Take the p-th root of the (possibly negative) sum of the integrals |err|^p
+static double LpRoot(const double p, const double error)
+{
+   if (p < infinity())
+   {
+      // negative quadrature weights may cause the error to be negative
+      if (error < 0.) { return -pow(-error, 1./p); }
+      return pow(error, 1./p);
+   }
+   return error;
+}
+
 double GridFunction::ComputeL2Error(
    Coefficient *exsol[], const IntegrationRule *irs[]) const
 {
@@ -2613,6 +2805,12 @@ double GridFunction::ComputeL2Error(
    VectorCoefficient &exsol, const IntegrationRule *irs[],
    Array<int> *elems) const
 {
+   if (elems == NULL && BatchedErrorRule(*fes, irs))
+   {
+      // not virtual: ParGridFunction::ComputeL2Error does the MPI reduction
+      return GridFunction::ComputeLpError(2.0, exsol, NULL, NULL, irs);
+   }
+
    double error = 0.0;
    const FiniteElement *fe;
    ElementTransformation *T;
@@ -2654,6 +2852,53 @@ double GridFunction::ComputeL2Error(
    return sqrt(error);
 }
 
+double GridFunction::ComputeGradError(VectorCoefficient *exgrad,
+                                      const IntegrationRule *irs[]) const
+{
+   MFEM_VERIFY(fes->GetVDim() == 1, "only scalar GridFunctions are supported");
+   if (const IntegrationRule *ir = BatchedErrorRule(*fes, irs))
+   {
+      Mesh &mesh = *fes->GetMesh();
+      const Vector &detJ = mesh.GetGeometricFactors(
+                              *ir, GeometricFactors::DETERMINANTS)->detJ;
+      Vector grad, exact_grad, elem_error;
+      GradientGridFunctionCoefficient(this).Project(grad, mesh, *ir);
+      exgrad->Project(exact_grad, mesh, *ir);
+      ElementLpErrors(2.0, exgrad->GetVDim(), *ir, detJ, grad, exact_grad,
+                      NULL, NULL, elem_error);
+      elem_error.HostRead();
+      return LpRoot(2.0, elem_error.Sum());
+   }
+
+   double error = 0.0;
+   Vector grad, exact_grad;
+   for (int i = 0; i < fes->GetNE(); i++)
+   {
+      const FiniteElement *fe = fes->GetFE(i);
+      const IntegrationRule *ir;
+      if (irs)
+      {
+         ir = irs[fe->GetGeomType()];
+      }
+      else
+      {
+         int intorder = 2*fe->GetOrder() + 3; // <----------
+         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+      }
+      ElementTransformation *T = fes->GetElementTransformation(i);
+      for (int j = 0; j < ir->GetNPoints(); j++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(j);
+         T->SetIntPoint(&ip);
+         GetGradient(*T, grad);
+         exgrad->Eval(exact_grad, *T, ip);
+         exact_grad -= grad;
+         error += ip.weight * T->Weight() * (exact_grad * exact_grad);
+      }
+   }
+   return LpRoot(2.0, error);
+}
+
 double GridFunction::ComputeH1Error(
    Coefficient *exsol, VectorCoefficient *exgrad,
    Coefficient *ell_coeff, double Nu, int norm_type) const
@@ -2974,6 +3219,12 @@ double GridFunction::ComputeLpError(const double p, Coefficient &exsol,
    ElementTransformation *T;
    Vector vals;
 
+   if (BatchedLpErrors(p, *this, &exsol, NULL, weight, NULL, irs, vals))
+   {
+      vals.HostRead();
+      return LpRoot(p, (p < infinity()) ? vals.Sum() : vals.Max());
+   }
+
    for (int i = 0; i < fes->GetNE(); i++)
    {
       fe = fes->GetFE(i);
@@ -3038,6 +3289,13 @@ void GridFunction::ComputeElementLpErrors(const double p, Coefficient &exsol,
    MFEM_ASSERT(error.Size() == fes->GetNE(),
                "Incorrect size for result vector");
 
+   if (BatchedLpErrors(p, *this, &exsol, NULL, weight, NULL, irs, error))
+   {
+      error.HostReadWrite();
+      for (int i = 0; i < error.Size(); i++) { error[i] = LpRoot(p, error[i]); }
+      return;
+   }
+
    error = 0.0;
    const FiniteElement *fe;
    ElementTransformation *T;
@@ -3107,6 +3365,13 @@ double GridFunction::ComputeLpError(const double p, VectorCoefficient &exsol,
    DenseMatrix vals, exact_vals;
    Vector loc_errs;
 
+   if (BatchedLpErrors(p, *this, NULL, &exsol, weight, v_weight, irs,
+                       loc_errs))
+   {
+      loc_errs.HostRead();
+      return LpRoot(p, (p < infinity()) ? loc_errs.Sum() : loc_errs.Max());
+   }
+
    for (int i = 0; i < fes->GetNE(); i++)
    {
       fe = fes->GetFE(i);
@@ -3197,6 +3462,13 @@ void GridFunction::ComputeElementLpErrors(const double p,
    MFEM_ASSERT(error.Size() == fes->GetNE(),
                "Incorrect size for result vector");
 
+   if (BatchedLpErrors(p, *this, NULL, &exsol, weight, v_weight, irs, error))
+   {
+      error.HostReadWrite();
+      for (int i = 0; i < error.Size(); i++) { error[i] = LpRoot(p, error[i]); }
+      return;
+   }
+
    error = 0.0;
    const FiniteElement *fe;
    ElementTransformation *T;
@@ -67,6 +67,18 @@ protected:
        degree of freedom. */
    void ProjectDiscCoefficient(VectorCoefficient &coeff, Array<int> &dof_attr);
 
+   /** @brief Batched projection of @a coeff, or @a vcoeff, on a space with
+       nodal finite elements of map type VALUE and a single element type. */
+   /** Each dof is evaluated once, in the last element containing it (as in the
+       element-by-element projection), with the batched Coefficient::Project()
+       for a subset of the nodes of the elements. When @a dof_map is not NULL
+       (scalar spaces only), the value of dof i is written to
+       x(dof_map[i]) when dof_map[i] >= 0 and the other dofs are not evaluated;
+       otherwise @a x is the L-vector. Return false, without changing @a x,
+       when the space is not supported. */
+   bool ProjectNodalCoefficient(Coefficient *coeff, VectorCoefficient *vcoeff,
+                                const Array<int> *dof_map, Vector &x) const;
+
    void Destroy();
 
 public:
@@ -433,6 +445,15 @@ public:
                                  const IntegrationRule *irs[] = NULL,
                                  Array<int> *elems = NULL) const;
 
+   /** @brief Compute the L2 norm of the error in the gradient of a scalar
+       GridFunction, i.e. the H1 seminorm of the error, given the exact gradient
+       @a exgrad. */
+   /** On meshes with a single element type, the gradients are evaluated at all
+       quadrature points at once, see GradientGridFunctionCoefficient::Project,
+       and the element contributions are computed on the device when enabled. */
+   virtual double ComputeGradError(VectorCoefficient *exgrad,
+                                   const IntegrationRule *irs[] = NULL) const;
+
    virtual double ComputeH1Error(Coefficient *exsol, VectorCoefficient *exgrad,
                                  Coefficient *ell_coef, double Nu,
                                  int norm_type) const;
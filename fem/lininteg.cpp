@@ -41,6 +41,13 @@ void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
       ir = &IntRules.Get(el.GetGeomType(), oa * el.GetOrder() + ob);
    }
 
+   const DofToQuad *d2q = el.GetShapeTable(*ir);
+   if (d2q)
+   {
+      AssembleTabulated(*d2q, Q, Tr, qval, elvect);
+      return;
+   }
+
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
@@ -54,6 +61,26 @@ void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
    }
 }
 
+void DomainLFIntegrator::AssembleTabulated(const DofToQuad &d2q,
+                                           Coefficient &Q,
+                                           ElementTransformation &Tr,
+                                           Vector &qval, Vector &elvect)
+{
+   // elvect = B^t f, where B holds the tabulated shape functions and
+   // f = w Q at the points
+   const IntegrationRule &ir = *d2q.IntRule;
+   const int nq = d2q.nqpt;
+   const DenseMatrix B(const_cast<double*>(d2q.B.HostRead()), nq, d2q.ndof);
+   qval.SetSize(nq);
+   for (int i = 0; i < nq; i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      Tr.SetIntPoint(&ip);
+      qval(i) = ip.weight * Tr.Weight() * Q.Eval(Tr, ip);
+   }
+   B.MultTranspose(qval, elvect);
+}
+
 void DomainLFIntegrator::AssembleDeltaElementVect(
    const FiniteElement &fe, ElementTransformation &Trans, Vector &elvect)
 {
@@ -81,6 +108,33 @@ void DomainLFGradIntegrator::AssembleRHSElementVect(
       ir = &IntRules.Get(el.GetGeomType(), intorder);
    }
 
+   const DofToQuad *d2q = el.GetShapeTable(*ir);
+   if (d2q)
+   {
+      // elvect = G^t v, where G holds the tabulated reference derivatives and
+      // v = w J^{-1} Q at the points
+      const int nq = ir->GetNPoints();
+      const int dim = el.GetDim();
+      const DenseMatrix G(const_cast<double*>(d2q->G.HostRead()), nq*dim, dof);
+      qval.SetSize(nq*dim);
+      for (int i = 0; i < nq; i++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(i);
+         Tr.SetIntPoint(&ip);
+         Q.Eval(Qvec, Tr, ip);
+         const DenseMatrix &invJ = Tr.InverseJacobian();
+         const double w = ip.weight * Tr.Weight();
+         for (int d = 0; d < dim; d++)
+         {
+            double v = 0.0;
+            for (int k = 0; k < spaceDim; k++) { v += invJ(d,k) * Qvec(k); }
+            qval(i+nq*d) = w * v;
+         }
+      }
+      G.MultTranspose(qval, elvect);
+      return;
+   }
+
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
@@ -127,6 +181,13 @@ void BoundaryLFIntegrator::AssembleRHSElementVect(
       ir = &IntRules.Get(el.GetGeomType(), intorder);
    }
 
+   const DofToQuad *d2q = el.GetShapeTable(*ir);
+   if (d2q)
+   {
+      DomainLFIntegrator::AssembleTabulated(*d2q, Q, Tr, qval, elvect);
+      return;
+   }
+
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
@@ -92,7 +92,7 @@ public:
 /// Class for domain integration L(v) := (f, v)
 class DomainLFIntegrator : public DeltaLFIntegrator
 {
-   Vector shape;
+   Vector shape, qval;
    Coefficient &Q;
    int oa, ob;
 public:
@@ -117,13 +117,19 @@ public:
                                          Vector &elvect);
 
    using LinearFormIntegrator::AssembleRHSElementVect;
+
+   /** @brief Compute elvect = (Q, v) using the shape functions tabulated in
+       @a d2q, see FiniteElement::GetShapeTable(); @a qval is a work vector. */
+   static void AssembleTabulated(const DofToQuad &d2q, Coefficient &Q,
+                                 ElementTransformation &Tr,
+                                 Vector &qval, Vector &elvect);
 };
 
 /// Class for domain integrator L(v) := (f, grad v)
 class DomainLFGradIntegrator : public DeltaLFIntegrator
 {
 private:
-   Vector shape, Qvec;
+   Vector shape, Qvec, qval;
    VectorCoefficient &Q;
    DenseMatrix dshape;
 
@@ -149,7 +155,7 @@ public:
 /// Class for boundary integration L(v) := (g, v)
 class BoundaryLFIntegrator : public LinearFormIntegrator
 {
-   Vector shape;
+   Vector shape, qval;
    Coefficient &Q;
    int oa, ob;
 public:
@@ -23,6 +23,7 @@
 #include <climits> // INT_MAX
 #include <limits>
 #include <list>
+#include <vector>
 
 namespace mfem
 {
@@ -104,6 +105,11 @@ void ParFiniteElementSpace::ParInit(ParMesh *pm)
    R = NULL;
 
    num_face_nbr_dofs = -1;
+   face_nbr_requests = NULL;
+   face_nbr_num_requests = 0;
+   face_nbr_nvec = 0;
+   face_nbr_gpu_aware = false;
+   face_nbr_pending = false;
 
    if (NURBSext && !pNURBSext())
    {
@@ -1162,6 +1168,127 @@ void ParFiniteElementSpace::ExchangeFaceNbrData()
    delete [] requests;
 }
 
+void ParFiniteElementSpace::SetupFaceNbrExchange(int nvec) const
+{
+   const bool gpu_aware = Device::GetGPUAwareMPI();
+   if (face_nbr_requests && nvec == face_nbr_nvec &&
+       gpu_aware == face_nbr_gpu_aware) { return; }
+
+   FreeFaceNbrExchange();
+   const int num_face_nbrs = pmesh->GetNFaceNeighbors();
+   face_nbr_send_buf.SetSize(nvec*send_face_nbr_ldof.Size_of_connections());
+   face_nbr_recv_buf.SetSize(nvec*num_face_nbr_dofs);
+   double *send_buf = gpu_aware ? face_nbr_send_buf.Write() :
+                      face_nbr_send_buf.HostWrite();
+   double *recv_buf = gpu_aware ? face_nbr_recv_buf.Write() :
+                      face_nbr_recv_buf.HostWrite();
+
+   // The data of the vectors is interleaved, so that the data for each face
+   // neighbor is contiguous.
+   const int *send_offset = send_face_nbr_ldof.GetI();
+   const int *recv_offset = face_nbr_ldof.GetI();
+   face_nbr_num_requests = 2*num_face_nbrs;
+   face_nbr_requests = new MPI_Request[face_nbr_num_requests];
+   MPI_Request *send_requests = face_nbr_requests;
+   MPI_Request *recv_requests = face_nbr_requests + num_face_nbrs;
+   for (int fn = 0; fn < num_face_nbrs; fn++)
+   {
+      const int nbr_rank = pmesh->GetFaceNbrRank(fn);
+      const int tag = 0;
+
+      MPI_Send_init(send_buf + nvec*send_offset[fn],
+                    nvec*(send_offset[fn+1] - send_offset[fn]),
+                    MPI_DOUBLE, nbr_rank, tag, MyComm, &send_requests[fn]);
+
+      MPI_Recv_init(recv_buf + nvec*recv_offset[fn],
+                    nvec*(recv_offset[fn+1] - recv_offset[fn]),
+                    MPI_DOUBLE, nbr_rank, tag, MyComm, &recv_requests[fn]);
+   }
+   face_nbr_nvec = nvec;
+   face_nbr_gpu_aware = gpu_aware;
+}
+
+void ParFiniteElementSpace::FreeFaceNbrExchange() const
+{
+   if (!face_nbr_requests) { return; }
+
+   MFEM_VERIFY(!face_nbr_pending, "a face-neighbor exchange is in progress");
+   // The requests cannot be freed after MPI_Finalize, e.g. when this object
+   // is destroyed after the end of the MPI session.
+   int mpi_finalized;
+   MPI_Finalized(&mpi_finalized);
+   for (int i = 0; !mpi_finalized && i < face_nbr_num_requests; i++)
+   {
+      MPI_Request_free(&face_nbr_requests[i]);
+   }
+   delete [] face_nbr_requests;
+   face_nbr_requests = NULL;
+   face_nbr_num_requests = 0;
+   face_nbr_nvec = 0;
+}
+
+void ParFiniteElementSpace::ExchangeFaceNbrDataBegin(
+   const Array<const Vector*> &x) const
+{
+   MFEM_VERIFY(num_face_nbr_dofs >= 0, "call ExchangeFaceNbrData() first");
+   MFEM_VERIFY(!face_nbr_pending, "a face-neighbor exchange is in progress");
+
+   if (pmesh->GetNFaceNeighbors() == 0) { return; }
+
+   const int nvec = x.Size();
+   SetupFaceNbrExchange(nvec);
+
+   const int send_size = send_face_nbr_ldof.Size_of_connections();
+   const int *d_send_ldof = mfem::Read(send_face_nbr_ldof.GetJMemory(),
+                                       send_size);
+   auto d_send_buf = face_nbr_send_buf.Write();
+   for (int v = 0; v < nvec; v++)
+   {
+      MFEM_ASSERT(x[v]->Size() == GetVSize(), "invalid vector size");
+      auto d_x = x[v]->Read();
+      MFEM_FORALL(i, send_size,
+      {
+         const int ldof = d_send_ldof[i];
+         d_send_buf[nvec*i + v] = d_x[ldof >= 0 ? ldof : -1-ldof];
+      });
+   }
+   if (face_nbr_gpu_aware)
+   {
+      MFEM_STREAM_SYNC;
+      face_nbr_recv_buf.Write();
+   }
+   else
+   {
+      face_nbr_send_buf.HostRead();
+      face_nbr_recv_buf.HostWrite();
+   }
+   MPI_Startall(face_nbr_num_requests, face_nbr_requests);
+   face_nbr_pending = true;
+}
+
+void ParFiniteElementSpace::ExchangeFaceNbrDataEnd(
+   const Array<Vector*> &face_nbr_data) const
+{
+   if (!face_nbr_pending) { return; }
+
+   MPI_Waitall(face_nbr_num_requests, face_nbr_requests, MPI_STATUSES_IGNORE);
+   face_nbr_pending = false;
+
+   const int nvec = face_nbr_nvec;
+   MFEM_VERIFY(face_nbr_data.Size() == nvec, "invalid number of vectors");
+   const int recv_size = num_face_nbr_dofs;
+   auto d_recv_buf = face_nbr_recv_buf.Read();
+   for (int v = 0; v < nvec; v++)
+   {
+      face_nbr_data[v]->SetSize(recv_size);
+      auto d_data = face_nbr_data[v]->Write();
+      MFEM_FORALL(i, recv_size,
+      {
+         d_data[i] = d_recv_buf[nvec*i + v];
+      });
+   }
+}
+
 void ParFiniteElementSpace::GetFaceNbrElementVDofs(
    int i, Array<int> &vdofs) const
 {
@@ -2460,14 +2587,134 @@ static HYPRE_Int* make_j_array(HYPRE_Int* I, int nrows)
    return J;
 }
 
+HypreParMatrix*
+ParFiniteElementSpace::ConformingRebalanceMatrix(int old_ndofs,
+                                                 const Table* old_elem_dof)
+{
+   const Array<int> &partition = pmesh->GetRebalancePartition();
+   const Array<int> &old_index = pmesh->GetRebalanceOldIndex();
+   MFEM_VERIFY(partition.Size() == old_elem_dof->Size() &&
+               old_index.Size() == pmesh->GetNE(),
+               "Mesh::Rebalance was not called before "
+               "ParFiniteElementSpace::RebalanceMatrix");
+
+   const bool assumed = HYPRE_AssumedPartitionCheck();
+   const HYPRE_Int old_offset = old_dof_offsets[assumed ? 0 : MyRank];
+
+   // Send the old global VDOFs of the elements that left to their new ranks,
+   // in the order of the old element numbers. The sign of a DOF (-1-dof) is
+   // preserved.
+   Array<int> dofs, vdofs;
+   std::vector<int> scnt(NRanks, 0), rcnt(NRanks, 0);
+   std::vector<int> sdispl(NRanks), rdispl(NRanks);
+   for (int i = 0; i < partition.Size(); i++)
+   {
+      if (partition[i] != MyRank)
+      {
+         scnt[partition[i]] += old_elem_dof->RowSize(i) * vdim;
+      }
+   }
+   for (int i = 0; i < old_index.Size(); i++)
+   {
+      if (old_index[i] < 0)
+      {
+         GetElementDofs(i, dofs);
+         rcnt[-1 - old_index[i]] += dofs.Size() * vdim;
+      }
+   }
+   int ssize = 0, rsize = 0;
+   for (int p = 0; p < NRanks; p++)
+   {
+      sdispl[p] = ssize;  ssize += scnt[p];
+      rdispl[p] = rsize;  rsize += rcnt[p];
+   }
+
+   std::vector<HYPRE_Int> sbuf(ssize), rbuf(rsize);
+   std::vector<int> spos(sdispl);
+   for (int i = 0; i < partition.Size(); i++)
+   {
+      if (partition[i] == MyRank) { continue; }
+      old_elem_dof->GetRow(i, dofs);
+      DofsToVDofs(dofs, old_ndofs);
+      for (int j = 0; j < dofs.Size(); j++)
+      {
+         const int d = dofs[j];
+         sbuf[spos[partition[i]]++] =
+            (d >= 0) ? old_offset + d : -1 - (old_offset + (-1 - d));
+      }
+   }
+   MPI_Alltoallv(sbuf.data(), scnt.data(), sdispl.data(), HYPRE_MPI_INT,
+                 rbuf.data(), rcnt.data(), rdispl.data(), HYPRE_MPI_INT,
+                 MyComm);
+
+   // Each new VDOF gets the value of (one copy of) its old VDOF, with the
+   // sign flipped if the orientations of the DOF in the two spaces differ.
+   const int vsize = GetVSize();
+   std::vector<HYPRE_Int> J(vsize, -1);
+   std::vector<double> data(vsize);
+   std::vector<int> rpos(rdispl);
+   for (int i = 0; i < pmesh->GetNE(); i++)
+   {
+      GetElementVDofs(i, vdofs);
+      const HYPRE_Int *old_vdofs;
+      std::vector<HYPRE_Int> loc_vdofs;
+      if (old_index[i] >= 0) // we had this element before
+      {
+         old_elem_dof->GetRow(old_index[i], dofs);
+         DofsToVDofs(dofs, old_ndofs);
+         loc_vdofs.resize(dofs.Size());
+         for (int j = 0; j < dofs.Size(); j++)
+         {
+            const int d = dofs[j];
+            loc_vdofs[j] =
+               (d >= 0) ? old_offset + d : -1 - (old_offset + (-1 - d));
+         }
+         old_vdofs = loc_vdofs.data();
+      }
+      else
+      {
+         int &pos = rpos[-1 - old_index[i]];
+         old_vdofs = &rbuf[pos];
+         pos += vdofs.Size();
+      }
+
+      for (int j = 0; j < vdofs.Size(); j++)
+      {
+         int row = vdofs[j];
+         HYPRE_Int col = old_vdofs[j];
+         double sign = 1.0;
+         if (row < 0) { row = -1 - row; sign = -sign; }
+         if (col < 0) { col = -1 - col; sign = -sign; }
+         if (J[row] < 0)
+         {
+            J[row] = col;
+            data[row] = sign;
+         }
+      }
+   }
+
+   Array<int> I(vsize + 1);
+   for (int i = 0; i <= vsize; i++) { I[i] = i; }
+
+   const HYPRE_Int glob_nrows = dof_offsets[assumed ? 2 : NRanks];
+   const HYPRE_Int glob_ncols = old_dof_offsets[assumed ? 2 : NRanks];
+   return new HypreParMatrix(MyComm, vsize, glob_nrows, glob_ncols,
+                             I.GetData(), J.data(), data.data(), dof_offsets,
+                             old_dof_offsets);
+}
+
 HypreParMatrix*
 ParFiniteElementSpace::RebalanceMatrix(int old_ndofs,
                                        const Table* old_elem_dof)
 {
-   MFEM_VERIFY(Nonconforming(), "Only supported for nonconforming meshes.");
    MFEM_VERIFY(old_dof_offsets.Size(), "ParFiniteElementSpace::Update needs to "
                "be called before ParFiniteElementSpace::RebalanceMatrix");
 
+   if (Conforming())
+   {
+      return ConformingRebalanceMatrix(old_ndofs, old_elem_dof);
+   }
+
    HYPRE_Int old_offset = HYPRE_AssumedPartitionCheck()
                           ? old_dof_offsets[0] : old_dof_offsets[MyRank];
 
@@ -2838,6 +3085,7 @@ void ParFiniteElementSpace::Destroy()
 
    delete gcomm; gcomm = NULL;
 
+   FreeFaceNbrExchange();
    num_face_nbr_dofs = -1;
    face_nbr_element_dof.Clear();
    face_nbr_ldof.Clear();
@@ -3004,6 +3252,20 @@ ConformingProlongationOperator::ConformingProlongationOperator(
 }
 
 void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
+{
+   BcastBegin(x, y);
+   BcastEnd(y);
+}
+
+void ConformingProlongationOperator::MultTranspose(
+   const Vector &x, Vector &y) const
+{
+   ReduceBegin(x);
+   ReduceEnd(x, y);
+}
+
+void ConformingProlongationOperator::BcastBegin(const Vector &x,
+                                                Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Width(), "");
    MFEM_ASSERT(y.Size() == Height(), "");
@@ -3023,13 +3285,23 @@ void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
       j = end+1;
    }
    std::copy(xdata+j-m, xdata+Width(), ydata+j);
+}
 
+void ConformingProlongationOperator::BcastEnd(Vector &y) const
+{
    const int out_layout = 0; // 0 - output is ldofs array
-   gc.BcastEnd(ydata, out_layout);
+   gc.BcastEnd(y.HostReadWrite(), out_layout);
 }
 
-void ConformingProlongationOperator::MultTranspose(
-   const Vector &x, Vector &y) const
+void ConformingProlongationOperator::ReduceBegin(const Vector &x) const
+{
+   MFEM_ASSERT(x.Size() == Height(), "");
+
+   gc.ReduceBegin(x.HostRead());
+}
+
+void ConformingProlongationOperator::ReduceEnd(const Vector &x,
+                                               Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Height(), "");
    MFEM_ASSERT(y.Size() == Width(), "");
@@ -3038,8 +3310,6 @@ void ConformingProlongationOperator::MultTranspose(
    double *ydata = y.HostWrite();
    const int m = external_ldofs.Size();
 
-   gc.ReduceBegin(xdata);
-
    int j = 0;
    for (int i = 0; i < m; i++)
    {
@@ -3120,6 +3390,7 @@ DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
       if (recv_size > 0) { req_counter++; }
    }
    requests = new MPI_Request[req_counter];
+   num_requests = 0;
 }
 
 static void ExtractSubVector(const int N,
@@ -3171,6 +3442,13 @@ void DeviceConformingProlongationOperator::BcastEndCopy(
 
 void DeviceConformingProlongationOperator::Mult(const Vector &x,
                                                 Vector &y) const
+{
+   BcastBegin(x, y);
+   BcastEnd(y);
+}
+
+void DeviceConformingProlongationOperator::BcastBegin(const Vector &x,
+                                                      Vector &y) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    BcastBeginCopy(x); // copy to 'shr_buf'
@@ -3197,7 +3475,13 @@ void DeviceConformingProlongationOperator::Mult(const Vector &x,
       }
    }
    BcastLocalCopy(x, y);
-   MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+   num_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::BcastEnd(Vector &y) const
+{
+   MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+   num_requests = 0;
    BcastEndCopy(y); // copy from 'ext_buf'
 }
 
@@ -3259,6 +3543,12 @@ void DeviceConformingProlongationOperator::ReduceEndAssemble(Vector &y) const
 
 void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
                                                          Vector &y) const
+{
+   ReduceBegin(x);
+   ReduceEnd(x, y);
+}
+
+void DeviceConformingProlongationOperator::ReduceBegin(const Vector &x) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    ReduceBeginCopy(x); // copy to 'ext_buf'
@@ -3284,8 +3574,15 @@ void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
                    gtopo.GetComm(), &requests[req_counter++]);
       }
    }
+   num_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::ReduceEnd(const Vector &x,
+                                                     Vector &y) const
+{
    ReduceLocalCopy(x, y);
-   MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+   MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+   num_requests = 0;
    ReduceEndAssemble(y); // assemble from 'shr_buf'
 }
 
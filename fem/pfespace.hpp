@@ -76,6 +76,14 @@ private:
    /// The (block-diagonal) matrix R (restriction of dof to true dof). Owned.
    mutable SparseMatrix *R;
 
+   /** Persistent face-neighbor exchange plan, see ExchangeFaceNbrDataBegin():
+       the send requests followed by the receive requests, the number of
+       vectors they are set for and the message buffers. */
+   mutable MPI_Request *face_nbr_requests;
+   mutable int face_nbr_num_requests, face_nbr_nvec;
+   mutable bool face_nbr_gpu_aware, face_nbr_pending;
+   mutable Vector face_nbr_send_buf, face_nbr_recv_buf;
+
    ParNURBSExtension *pNURBSext() const
    { return dynamic_cast<ParNURBSExtension *>(NURBSext); }
 
@@ -91,6 +99,12 @@ private:
    void Construct();
    void Destroy();
 
+   /** Create the persistent face-neighbor requests for @a nvec vectors,
+       unless they already exist. */
+   void SetupFaceNbrExchange(int nvec) const;
+   /// Free the persistent face-neighbor requests.
+   void FreeFaceNbrExchange() const;
+
    // ldof_type = 0 : DOFs communicator, otherwise VDOFs communicator
    void GetGroupComm(GroupCommunicator &gcomm, int ldof_type,
                      Array<int> *ldof_sign = NULL);
@@ -165,6 +179,10 @@ private:
    HypreParMatrix* RebalanceMatrix(int old_ndofs,
                                    const Table* old_elem_dof);
 
+   /// The RebalanceMatrix() of a space on a conforming mesh.
+   HypreParMatrix* ConformingRebalanceMatrix(int old_ndofs,
+                                             const Table* old_elem_dof);
+
    /** Calculate a GridFunction restriction matrix after mesh derefinement.
        The matrix is constructed so that the new grid function interpolates
        the original function, i.e., the original function is evaluated at the
@@ -341,6 +359,21 @@ public:
 
    // Face-neighbor functions
    void ExchangeFaceNbrData();
+
+   /** @brief Begin the exchange of the face-neighbor data of the vectors
+       @a x, each of size GetVSize(), with one message per face neighbor. */
+   /** ExchangeFaceNbrData() must be called first. The messages are sent with
+       persistent MPI requests, created on the first call and re-created only
+       when the number of vectors changes. Local work that does not need the
+       face-neighbor data can be done before the matching call to
+       ExchangeFaceNbrDataEnd(). Only one exchange can be in progress. */
+   void ExchangeFaceNbrDataBegin(const Array<const Vector*> &x) const;
+
+   /** @brief Finish the exchange started with ExchangeFaceNbrDataBegin():
+       @a face_nbr_data[i] is set to the face-neighbor data of @a x[i], of size
+       GetFaceNbrVSize(). */
+   void ExchangeFaceNbrDataEnd(const Array<Vector*> &face_nbr_data) const;
+
    int GetFaceNbrVSize() const { return num_face_nbr_dofs; }
    void GetFaceNbrElementVDofs(int i, Array<int> &vdofs) const;
    void GetFaceNbrFaceVDofs(int i, Array<int> &vdofs) const;
@@ -396,6 +429,25 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** @brief Split-phase version of Mult(): copy the owned entries of @a x to
+       @a y and start the exchange of the external entries of @a y. */
+   /** Local work that does not read the external entries of @a y can be done
+       before the matching call to BcastEnd(). */
+   virtual void BcastBegin(const Vector &x, Vector &y) const;
+
+   /// Finish the exchange started with BcastBegin().
+   virtual void BcastEnd(Vector &y) const;
+
+   /** @brief Split-phase version of MultTranspose(): start sending the external
+       entries of @a x to their owners. */
+   /** Only the external entries of @a x need to be final at this point, the
+       owned entries are read in ReduceEnd(). */
+   virtual void ReduceBegin(const Vector &x) const;
+
+   /** @brief Finish the exchange started with ReduceBegin(): @a y is set to
+       the owned entries of @a x plus the received contributions. */
+   virtual void ReduceEnd(const Vector &x, Vector &y) const;
 };
 
 /// Auxiliary device class used by ParFiniteElementSpace.
@@ -410,6 +462,7 @@ protected:
    Array<int> ltdof_ldof, unq_ltdof;
    Array<int> unq_shr_i, unq_shr_j;
    MPI_Request *requests;
+   mutable int num_requests; // number of pending requests
    // Kernel: copy ltdofs from 'src' to 'shr_buf' - prepare for send.
    //         shr_buf[i] = src[shr_ltdof[i]]
    void BcastBeginCopy(const Vector &src) const;
@@ -442,6 +495,14 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   virtual void BcastBegin(const Vector &x, Vector &y) const;
+
+   virtual void BcastEnd(Vector &y) const;
+
+   virtual void ReduceBegin(const Vector &x) const;
+
+   virtual void ReduceEnd(const Vector &x, Vector &y) const;
 };
 
 }
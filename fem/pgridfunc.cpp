@@ -203,6 +203,12 @@ HypreParVector *ParGridFunction::ParallelAssemble() const
 }
 
 void ParGridFunction::ExchangeFaceNbrData()
+{
+   ExchangeFaceNbrDataBegin();
+   ExchangeFaceNbrDataEnd();
+}
+
+void ParGridFunction::ExchangeFaceNbrDataBegin()
 {
    pfes->ExchangeFaceNbrData();
 
@@ -211,54 +217,44 @@ void ParGridFunction::ExchangeFaceNbrData()
       return;
    }
 
-   ParMesh *pmesh = pfes->GetParMesh();
+   const Vector *x = this;
+   pfes->ExchangeFaceNbrDataBegin(Array<const Vector*>(&x, 1));
+}
 
-   face_nbr_data.SetSize(pfes->GetFaceNbrVSize());
-   send_data.SetSize(pfes->send_face_nbr_ldof.Size_of_connections());
+void ParGridFunction::ExchangeFaceNbrDataEnd()
+{
+   if (pfes->GetFaceNbrVSize() <= 0)
+   {
+      return;
+   }
 
-   int *send_offset = pfes->send_face_nbr_ldof.GetI();
-   const int *d_send_ldof = mfem::Read(pfes->send_face_nbr_ldof.GetJMemory(),
-                                       send_data.Size());
-   int *recv_offset = pfes->face_nbr_ldof.GetI();
-   MPI_Comm MyComm = pfes->GetComm();
+   Vector *y = &face_nbr_data;
+   pfes->ExchangeFaceNbrDataEnd(Array<Vector*>(&y, 1));
+}
 
-   int num_face_nbrs = pmesh->GetNFaceNeighbors();
-   MPI_Request *requests = new MPI_Request[2*num_face_nbrs];
-   MPI_Request *send_requests = requests;
-   MPI_Request *recv_requests = requests + num_face_nbrs;
-   MPI_Status  *statuses = new MPI_Status[num_face_nbrs];
+void ParGridFunction::ExchangeFaceNbrData(const Array<ParGridFunction*> &gfs)
+{
+   if (gfs.Size() == 0) { return; }
 
-   auto d_data = this->Read();
-   auto d_send_data = send_data.Write();
-   MFEM_FORALL(i, send_data.Size(),
-   {
-      const int ldof = d_send_ldof[i];
-      d_send_data[i] = d_data[ldof >= 0 ? ldof : -1-ldof];
-   });
+   ParFiniteElementSpace *pfes = gfs[0]->pfes;
+   pfes->ExchangeFaceNbrData();
 
-   bool mpi_gpu_aware = Device::GetGPUAwareMPI();
-   auto send_data_ptr = mpi_gpu_aware ? send_data.Read() : send_data.HostRead();
-   auto face_nbr_data_ptr = mpi_gpu_aware ? face_nbr_data.Write() :
-                            face_nbr_data.HostWrite();
-   for (int fn = 0; fn < num_face_nbrs; fn++)
+   if (pfes->GetFaceNbrVSize() <= 0)
    {
-      int nbr_rank = pmesh->GetFaceNbrRank(fn);
-      int tag = 0;
-
-      MPI_Isend(&send_data_ptr[send_offset[fn]],
-                send_offset[fn+1] - send_offset[fn],
-                MPI_DOUBLE, nbr_rank, tag, MyComm, &send_requests[fn]);
-
-      MPI_Irecv(&face_nbr_data_ptr[recv_offset[fn]],
-                recv_offset[fn+1] - recv_offset[fn],
-                MPI_DOUBLE, nbr_rank, tag, MyComm, &recv_requests[fn]);
+      return;
    }
 
-   MPI_Waitall(num_face_nbrs, send_requests, statuses);
-   MPI_Waitall(num_face_nbrs, recv_requests, statuses);
-
-   delete [] statuses;
-   delete [] requests;
+   Array<const Vector*> x(gfs.Size());
+   Array<Vector*> y(gfs.Size());
+   for (int i = 0; i < gfs.Size(); i++)
+   {
+      MFEM_VERIFY(gfs[i]->pfes == pfes, "the grid functions must use the same"
+                  " ParFiniteElementSpace");
+      x[i] = gfs[i];
+      y[i] = &gfs[i]->face_nbr_data;
+   }
+   pfes->ExchangeFaceNbrDataBegin(x);
+   pfes->ExchangeFaceNbrDataEnd(y);
 }
 
 double ParGridFunction::GetValue(int i, const IntegrationPoint &ip, int vdim)
@@ -477,6 +473,22 @@ void ParGridFunction::ProjectCoefficient(Coefficient &coeff)
 
    if (delta_c == NULL)
    {
+      // On conforming meshes, evaluate the true dofs only and get the shared
+      // dofs from their owners
+      if (pfes->Conforming() && pfes->GetVDim() == 1)
+      {
+         Array<int> ldof_tdof(pfes->GetNDofs());
+         for (int i = 0; i < ldof_tdof.Size(); i++)
+         {
+            ldof_tdof[i] = pfes->GetLocalTDofNumber(i);
+         }
+         Vector tv(pfes->GetTrueVSize());
+         if (ProjectNodalCoefficient(&coeff, NULL, &ldof_tdof, tv))
+         {
+            Distribute(tv);
+            return;
+         }
+      }
       GridFunction::ProjectCoefficient(coeff);
    }
    else
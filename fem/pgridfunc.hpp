@@ -38,11 +38,6 @@ protected:
        initialized by ExchangeFaceNbrData(). */
    Vector face_nbr_data;
 
-   /** @brief Vector used as an MPI buffer to send face-neighbor data
-       in ExchangeFaceNbrData() to neighboring processors. */
-   //TODO: Use temporary memory to avoid CUDA malloc allocation cost.
-   Vector send_data;
-
    void ProjectBdrCoefficient(Coefficient *coeff[], VectorCoefficient *vcoeff,
                               Array<int> &attr);
 
@@ -200,6 +195,20 @@ public:
    HypreParVector *ParallelAssemble() const;
 
    void ExchangeFaceNbrData();
+
+   /** @brief Split-phase version of ExchangeFaceNbrData(): start sending the
+       face-neighbor data. */
+   /** The ParFiniteElementSpace keeps persistent MPI requests for the exchange,
+       see ParFiniteElementSpace::ExchangeFaceNbrDataBegin(). */
+   void ExchangeFaceNbrDataBegin();
+
+   /// Finish the exchange started with ExchangeFaceNbrDataBegin().
+   void ExchangeFaceNbrDataEnd();
+
+   /** @brief Exchange the face-neighbor data of several grid functions on the
+       same ParFiniteElementSpace, with one message per face neighbor. */
+   static void ExchangeFaceNbrData(const Array<ParGridFunction*> &gfs);
+
    Vector &FaceNbrData() { return face_nbr_data; }
    const Vector &FaceNbrData() const { return face_nbr_data; }
 
@@ -283,6 +292,13 @@ public:
                           pfes->GetComm());
    }
 
+   virtual double ComputeGradError(VectorCoefficient *exgrad,
+                                   const IntegrationRule *irs[] = NULL) const
+   {
+      return GlobalLpNorm(2.0, GridFunction::ComputeGradError(exgrad, irs),
+                          pfes->GetComm());
+   }
+
    virtual double ComputeMaxError(Coefficient *exsol[],
                                   const IntegrationRule *irs[] = NULL) const
    {
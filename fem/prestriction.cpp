@@ -123,6 +123,7 @@ ParL2FaceRestriction::ParL2FaceRestriction(const ParFiniteElementSpace &fes,
             }
             else if (inf2>=0) // shared boundary
             {
+               shared_faces.Append(f_ind);
                const int se2 = -1 - e2;
                Array<int> sharedDofs;
                pfes.GetFaceNbrElementVDofs(se2, sharedDofs);
@@ -263,10 +264,6 @@ void ParL2FaceRestriction::Mult(const Vector& x, Vector& y) const
 {
    const ParFiniteElementSpace &pfes =
       static_cast<const ParFiniteElementSpace&>(this->fes);
-   ParGridFunction x_gf;
-   x_gf.MakeRef(const_cast<ParFiniteElementSpace*>(&pfes),
-                const_cast<Vector&>(x), 0);
-   x_gf.ExchangeFaceNbrData();
 
    // Assumes all elements have the same number of dofs
    const int nd = dof;
@@ -276,11 +273,18 @@ void ParL2FaceRestriction::Mult(const Vector& x, Vector& y) const
 
    if (m==L2FaceValues::DoubleValued)
    {
+      const_cast<ParFiniteElementSpace&>(pfes).ExchangeFaceNbrData();
+      const bool exchange = pfes.GetFaceNbrVSize() > 0;
+      if (exchange)
+      {
+         const Vector *xp = &x;
+         pfes.ExchangeFaceNbrDataBegin(Array<const Vector*>(&xp, 1));
+      }
+
+      // The second side of the shared faces is set after the exchange.
       auto d_indices1 = scatter_indices1.Read();
       auto d_indices2 = scatter_indices2.Read();
       auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
-      auto d_x_shared = Reshape(x_gf.FaceNbrData().Read(),
-                                t?vd:ndofs, t?ndofs:vd);
       auto d_y = Reshape(y.Write(), nd, vd, 2, nf);
       MFEM_FORALL(i, nfdofs,
       {
@@ -298,17 +302,35 @@ void ParL2FaceRestriction::Mult(const Vector& x, Vector& y) const
             {
                d_y(dof, c, 1, face) = d_x(t?c:idx2, t?idx2:c);
             }
-            else if (idx2>=threshold) // shared boundary
-            {
-               d_y(dof, c, 1, face) = d_x_shared(t?c:(idx2-threshold),
-                                                 t?(idx2-threshold):c);
-            }
-            else // true boundary
+            else if (idx2<0) // true boundary
             {
                d_y(dof, c, 1, face) = 0.0;
             }
          }
       });
+
+      if (exchange)
+      {
+         Vector *yp = &x_face_nbr;
+         pfes.ExchangeFaceNbrDataEnd(Array<Vector*>(&yp, 1));
+      }
+      if (shared_faces.Size() > 0)
+      {
+         auto d_shared_faces = shared_faces.Read();
+         auto d_x_shared = Reshape(x_face_nbr.Read(),
+                                   t?vd:ndofs, t?ndofs:vd);
+         auto d_y = Reshape(y.ReadWrite(), nd, vd, 2, nf);
+         MFEM_FORALL(i, shared_faces.Size()*nd,
+         {
+            const int dof = i % nd;
+            const int face = d_shared_faces[i / nd];
+            const int idx2 = d_indices2[face*nd + dof] - threshold;
+            for (int c = 0; c < vd; ++c)
+            {
+               d_y(dof, c, 1, face) = d_x_shared(t?c:idx2, t?idx2:c);
+            }
+         });
+      }
    }
    else
    {
@@ -28,10 +28,18 @@ class ParFiniteElementSpace;
     objects, see FiniteElementSpace::GetFaceRestriction(). */
 class ParL2FaceRestriction : public L2FaceRestriction
 {
+protected:
+   /// Faces whose second element belongs to a face-neighbor processor.
+   Array<int> shared_faces;
+   /// The face-neighbor data of the input of Mult().
+   mutable Vector x_face_nbr;
+
 public:
    ParL2FaceRestriction(const ParFiniteElementSpace&, ElementDofOrdering,
                         FaceType type,
                         L2FaceValues m = L2FaceValues::DoubleValued);
+   /** @brief Extract the face dofs. The values of the interior faces are
+       extracted while the face-neighbor data is being exchanged. */
    void Mult(const Vector &x, Vector &y) const;
    /** Fill the I array of SparseMatrix corresponding to the sparsity pattern
        given by this ParL2FaceRestriction. */
@@ -17,6 +17,11 @@
 namespace mfem
 {
 
+// Bounds of the generic tensor-product kernels in 3D, limited by the size of
+// their shared memory buffers
+static constexpr int MAX_D1D_3D = 8;
+static constexpr int MAX_Q1D_3D = 8;
+
 QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
                                                const IntegrationRule &ir)
 {
@@ -24,7 +29,7 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
    qspace = NULL;
    IntRule = &ir;
    q_layout = QVectorLayout::byNODES;
-   use_tensor_products = true; // not implemented yet (not used)
+   use_tensor_products = true;
 
    if (fespace->GetNE() == 0) { return; }
    const FiniteElement *fe = fespace->GetFE(0);
@@ -39,7 +44,7 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
    qspace = &qs;
    IntRule = NULL;
    q_layout = QVectorLayout::byNODES;
-   use_tensor_products = true; // not implemented yet (not used)
+   use_tensor_products = true;
 
    if (fespace->GetNE() == 0) { return; }
    const FiniteElement *fe = fespace->GetFE(0);
@@ -64,7 +69,6 @@ void QuadratureInterpolator::Eval2D(
    const int NQ = T_NQ ? T_NQ : nq;
    const int VDIM = T_VDIM ? T_VDIM : vdim;
    MFEM_VERIFY(ND <= MAX_ND2D, "");
-   MFEM_VERIFY(NQ <= MAX_NQ2D, "");
    MFEM_VERIFY(VDIM == 2 || !(eval_flags & DETERMINANTS), "");
    auto B = Reshape(maps.B.Read(), NQ, ND);
    auto G = Reshape(maps.G.Read(), NQ, 2, ND);
@@ -152,7 +156,6 @@ void QuadratureInterpolator::Eval3D(
    const int NQ = T_NQ ? T_NQ : nq;
    const int VDIM = T_VDIM ? T_VDIM : vdim;
    MFEM_VERIFY(ND <= MAX_ND3D, "");
-   MFEM_VERIFY(NQ <= MAX_NQ3D, "");
    MFEM_VERIFY(VDIM == 3 || !(eval_flags & DETERMINANTS), "");
    auto B = Reshape(maps.B.Read(), NQ, ND);
    auto G = Reshape(maps.G.Read(), NQ, 3, ND);
@@ -226,196 +229,9 @@ void QuadratureInterpolator::Eval3D(
    });
 }
 
-void QuadratureInterpolator::Mult(
-   const Vector &e_vec, unsigned eval_flags,
-   Vector &q_val, Vector &q_der, Vector &q_det) const
-{
-   if (q_layout == QVectorLayout::byVDIM)
-   {
-      if (eval_flags & VALUES) { Values(e_vec, q_val); }
-      if (eval_flags & DERIVATIVES) { Derivatives(e_vec, q_der); }
-      if (eval_flags & DETERMINANTS)
-      {
-         MFEM_ABORT("evaluation of determinants with 'byVDIM' output layout"
-                    " is not implemented yet!");
-      }
-      return;
-   }
-
-   // q_layout == QVectorLayout::byNODES
-   const int ne = fespace->GetNE();
-   if (ne == 0) { return; }
-   const int vdim = fespace->GetVDim();
-   const int dim = fespace->GetMesh()->Dimension();
-   const FiniteElement *fe = fespace->GetFE(0);
-   const IntegrationRule *ir =
-      IntRule ? IntRule : &qspace->GetElementIntRule(0);
-   const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::FULL);
-   const int nd = maps.ndof;
-   const int nq = maps.nqpt;
-   void (*eval_func)(
-      const int NE,
-      const int vdim,
-      const DofToQuad &maps,
-      const Vector &e_vec,
-      Vector &q_val,
-      Vector &q_der,
-      Vector &q_det,
-      const int eval_flags) = NULL;
-   if (vdim == 1)
-   {
-      if (dim == 2)
-      {
-         switch (100*nd + nq)
-         {
-            // Q0
-            case 101: eval_func = &Eval2D<1,1,1>; break;
-            case 104: eval_func = &Eval2D<1,1,4>; break;
-            // Q1
-            case 404: eval_func = &Eval2D<1,4,4>; break;
-            case 409: eval_func = &Eval2D<1,4,9>; break;
-            // Q2
-            case 909: eval_func = &Eval2D<1,9,9>; break;
-            case 916: eval_func = &Eval2D<1,9,16>; break;
-            // Q3
-            case 1616: eval_func = &Eval2D<1,16,16>; break;
-            case 1625: eval_func = &Eval2D<1,16,25>; break;
-            case 1636: eval_func = &Eval2D<1,16,36>; break;
-            // Q4
-            case 2525: eval_func = &Eval2D<1,25,25>; break;
-            case 2536: eval_func = &Eval2D<1,25,36>; break;
-            case 2549: eval_func = &Eval2D<1,25,49>; break;
-            case 2564: eval_func = &Eval2D<1,25,64>; break;
-         }
-         if (nq >= 100 || !eval_func)
-         {
-            eval_func = &Eval2D<1>;
-         }
-      }
-      else if (dim == 3)
-      {
-         switch (1000*nd + nq)
-         {
-            // Q0
-            case 1001: eval_func = &Eval3D<1,1,1>; break;
-            case 1008: eval_func = &Eval3D<1,1,8>; break;
-            // Q1
-            case 8008: eval_func = &Eval3D<1,8,8>; break;
-            case 8027: eval_func = &Eval3D<1,8,27>; break;
-            // Q2
-            case 27027: eval_func = &Eval3D<1,27,27>; break;
-            case 27064: eval_func = &Eval3D<1,27,64>; break;
-            // Q3
-            case 64064: eval_func = &Eval3D<1,64,64>; break;
-            case 64125: eval_func = &Eval3D<1,64,125>; break;
-            case 64216: eval_func = &Eval3D<1,64,216>; break;
-            // Q4
-            case 125125: eval_func = &Eval3D<1,125,125>; break;
-            case 125216: eval_func = &Eval3D<1,125,216>; break;
-         }
-         if (nq >= 1000 || !eval_func)
-         {
-            eval_func = &Eval3D<1>;
-         }
-      }
-   }
-   else if (vdim == 3 && dim == 2)
-   {
-      switch (100*nd + nq)
-      {
-         // Q0
-         case 101: eval_func = &Eval2D<3,1,1>; break;
-         case 104: eval_func = &Eval2D<3,1,4>; break;
-         // Q1
-         case 404: eval_func = &Eval2D<3,4,4>; break;
-         case 409: eval_func = &Eval2D<3,4,9>; break;
-         // Q2
-         case 904: eval_func = &Eval2D<3,9,4>; break;
-         case 909: eval_func = &Eval2D<3,9,9>; break;
-         case 916: eval_func = &Eval2D<3,9,16>; break;
-         case 925: eval_func = &Eval2D<3,9,25>; break;
-         // Q3
-         case 1616: eval_func = &Eval2D<3,16,16>; break;
-         case 1625: eval_func = &Eval2D<3,16,25>; break;
-         case 1636: eval_func = &Eval2D<3,16,36>; break;
-         // Q4
-         case 2525: eval_func = &Eval2D<3,25,25>; break;
-         case 2536: eval_func = &Eval2D<3,25,36>; break;
-         case 2549: eval_func = &Eval2D<3,25,49>; break;
-         case 2564: eval_func = &Eval2D<3,25,64>; break;
-         default:   eval_func = &Eval2D<3>;
-      }
-   }
-   else if (vdim == dim)
-   {
-      if (dim == 2)
-      {
-         switch (100*nd + nq)
-         {
-            // Q1
-            case 404: eval_func = &Eval2D<2,4,4>; break;
-            case 409: eval_func = &Eval2D<2,4,9>; break;
-            // Q2
-            case 909: eval_func = &Eval2D<2,9,9>; break;
-            case 916: eval_func = &Eval2D<2,9,16>; break;
-            // Q3
-            case 1616: eval_func = &Eval2D<2,16,16>; break;
-            case 1625: eval_func = &Eval2D<2,16,25>; break;
-            case 1636: eval_func = &Eval2D<2,16,36>; break;
-            // Q4
-            case 2525: eval_func = &Eval2D<2,25,25>; break;
-            case 2536: eval_func = &Eval2D<2,25,36>; break;
-            case 2549: eval_func = &Eval2D<2,25,49>; break;
-            case 2564: eval_func = &Eval2D<2,25,64>; break;
-         }
-         if (nq >= 100 || !eval_func)
-         {
-            eval_func = &Eval2D<2>;
-         }
-      }
-      else if (dim == 3)
-      {
-         switch (1000*nd + nq)
-         {
-            // Q1
-            case 8008: eval_func = &Eval3D<3,8,8>; break;
-            case 8027: eval_func = &Eval3D<3,8,27>; break;
-            // Q2
-            case 27027: eval_func = &Eval3D<3,27,27>; break;
-            case 27064: eval_func = &Eval3D<3,27,64>; break;
-            // Q3
-            case 64064: eval_func = &Eval3D<3,64,64>; break;
-            case 64125: eval_func = &Eval3D<3,64,125>; break;
-            case 64216: eval_func = &Eval3D<3,64,216>; break;
-            // Q4
-            case 125125: eval_func = &Eval3D<3,125,125>; break;
-            case 125216: eval_func = &Eval3D<3,125,216>; break;
-         }
-         if (nq >= 1000 || !eval_func)
-         {
-            eval_func = &Eval3D<3>;
-         }
-      }
-   }
-   if (eval_func)
-   {
-      eval_func(ne, vdim, maps, e_vec, q_val, q_der, q_det, eval_flags);
-   }
-   else
-   {
-      MFEM_ABORT("case not supported yet");
-   }
-}
-
-void QuadratureInterpolator::MultTranspose(
-   unsigned eval_flags, const Vector &q_val, const Vector &q_der,
-   Vector &e_vec) const
-{
-   MFEM_ABORT("this method is not implemented yet");
-}
-
 
-template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+template<QVectorLayout Q_LAYOUT,
+         int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void D2QValues2D(const int NE,
                         const Array<double> &b_,
                         const Vector &x_,
@@ -431,7 +247,9 @@ static void D2QValues2D(const int NE,
 
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto x = Reshape(x_.Read(), D1D, D1D, VDIM, NE);
-   auto y = Reshape(y_.Write(), VDIM, Q1D, Q1D, NE);
+   auto y = Q_LAYOUT == QVectorLayout::byNODES ?
+            Reshape(y_.Write(), Q1D, Q1D, VDIM, NE):
+            Reshape(y_.Write(), VDIM, Q1D, Q1D, NE);
 
    MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
    {
@@ -494,7 +312,8 @@ static void D2QValues2D(const int NE,
                {
                   qq += DQ[dy][qx] * B[qy][dy];
                }
-               y(c,qx,qy,e) = qq;
+               if (Q_LAYOUT == QVectorLayout::byVDIM) { y(c,qx,qy,e) = qq; }
+               if (Q_LAYOUT == QVectorLayout::byNODES) { y(qx,qy,c,e) = qq; }
             }
          }
          MFEM_SYNC_THREAD;
@@ -502,7 +321,8 @@ static void D2QValues2D(const int NE,
    });
 }
 
-template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0,
+template<QVectorLayout Q_LAYOUT,
+         int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0,
          int MAX_D = 0, int MAX_Q = 0>
 static void D2QValues3D(const int NE,
                         const Array<double> &b_,
@@ -518,7 +338,9 @@ static void D2QValues3D(const int NE,
 
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, VDIM, NE);
-   auto y = Reshape(y_.Write(), VDIM, Q1D, Q1D, Q1D, NE);
+   auto y = Q_LAYOUT == QVectorLayout::byNODES ?
+            Reshape(y_.Write(), Q1D, Q1D, Q1D, VDIM, NE):
+            Reshape(y_.Write(), VDIM, Q1D, Q1D, Q1D, NE);
 
    MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
    {
@@ -604,7 +426,14 @@ static void D2QValues3D(const int NE,
                   {
                      u += DQQ[dz][qy][qx] * B[qz][dz];
                   }
-                  y(c,qx,qy,qz,e) = u;
+                  if (Q_LAYOUT == QVectorLayout::byVDIM)
+                  {
+                     y(c,qx,qy,qz,e) = u;
+                  }
+                  if (Q_LAYOUT == QVectorLayout::byNODES)
+                  {
+                     y(qx,qy,qz,c,e) = u;
+                  }
                }
             }
          }
@@ -613,6 +442,7 @@ static void D2QValues3D(const int NE,
    });
 }
 
+template<QVectorLayout Q_LAYOUT>
 static void D2QValues(const FiniteElementSpace &fes,
                       const DofToQuad *maps,
                       const Vector &e_vec,
@@ -624,24 +454,28 @@ static void D2QValues(const FiniteElementSpace &fes,
    const int D1D = maps->ndof;
    const int Q1D = maps->nqpt;
    const int id = (vdim<<8) | (D1D<<4) | Q1D;
+   const Array<double> &B = maps->B;
+   constexpr QVectorLayout L = Q_LAYOUT;
 
    if (dim == 2)
    {
       switch (id)
       {
-         case 0x124: return D2QValues2D<1,2,4,8>(NE, maps->B, e_vec, q_val);
-         case 0x136: return D2QValues2D<1,3,6,4>(NE, maps->B, e_vec, q_val);
-         case 0x148: return D2QValues2D<1,4,8,2>(NE, maps->B, e_vec, q_val);
-         case 0x224: return D2QValues2D<2,2,4,8>(NE, maps->B, e_vec, q_val);
-         case 0x236: return D2QValues2D<2,3,6,4>(NE, maps->B, e_vec, q_val);
-         case 0x248: return D2QValues2D<2,4,8,2>(NE, maps->B, e_vec, q_val);
+         case 0x124: return D2QValues2D<L,1,2,4,8>(NE, B, e_vec, q_val);
+         case 0x136: return D2QValues2D<L,1,3,6,4>(NE, B, e_vec, q_val);
+         case 0x148: return D2QValues2D<L,1,4,8,2>(NE, B, e_vec, q_val);
+         case 0x222: return D2QValues2D<L,2,2,2,16>(NE, B, e_vec, q_val);
+         case 0x223: return D2QValues2D<L,2,2,3,16>(NE, B, e_vec, q_val);
+         case 0x224: return D2QValues2D<L,2,2,4,8>(NE, B, e_vec, q_val);
+         case 0x236: return D2QValues2D<L,2,3,6,4>(NE, B, e_vec, q_val);
+         case 0x248: return D2QValues2D<L,2,4,8,2>(NE, B, e_vec, q_val);
          default:
          {
             MFEM_VERIFY(D1D <= MAX_D1D, "Orders higher than " << MAX_D1D-1
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MAX_Q1D, "Quadrature rules with more than "
                         << MAX_Q1D << " 1D points are not supported!");
-            D2QValues2D(NE, maps->B, e_vec, q_val, vdim, D1D, Q1D);
+            D2QValues2D<L>(NE, B, e_vec, q_val, vdim, D1D, Q1D);
             return;
          }
       }
@@ -650,21 +484,23 @@ static void D2QValues(const FiniteElementSpace &fes,
    {
       switch (id)
       {
-         case 0x124: return D2QValues3D<1,2,4>(NE, maps->B, e_vec, q_val);
-         case 0x136: return D2QValues3D<1,3,6>(NE, maps->B, e_vec, q_val);
-         case 0x148: return D2QValues3D<1,4,8>(NE, maps->B, e_vec, q_val);
-         case 0x324: return D2QValues3D<3,2,4>(NE, maps->B, e_vec, q_val);
-         case 0x336: return D2QValues3D<3,3,6>(NE, maps->B, e_vec, q_val);
-         case 0x348: return D2QValues3D<3,4,8>(NE, maps->B, e_vec, q_val);
+         case 0x124: return D2QValues3D<L,1,2,4>(NE, B, e_vec, q_val);
+         case 0x136: return D2QValues3D<L,1,3,6>(NE, B, e_vec, q_val);
+         case 0x148: return D2QValues3D<L,1,4,8>(NE, B, e_vec, q_val);
+         case 0x322: return D2QValues3D<L,3,2,2>(NE, B, e_vec, q_val);
+         case 0x323: return D2QValues3D<L,3,2,3>(NE, B, e_vec, q_val);
+         case 0x324: return D2QValues3D<L,3,2,4>(NE, B, e_vec, q_val);
+         case 0x336: return D2QValues3D<L,3,3,6>(NE, B, e_vec, q_val);
+         case 0x348: return D2QValues3D<L,3,4,8>(NE, B, e_vec, q_val);
          default:
          {
-            constexpr int MD = 8;
-            constexpr int MQ = 8;
+            constexpr int MD = MAX_D1D_3D;
+            constexpr int MQ = MAX_Q1D_3D;
             MFEM_VERIFY(D1D <= MD, "Orders higher than " << MD-1
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MQ, "Quadrature rules with more than " << MQ
                         << " 1D points are not supported!");
-            D2QValues3D<0,0,0,MD,MQ>(NE, maps->B, e_vec, q_val, vdim, D1D, Q1D);
+            D2QValues3D<L,0,0,0,MD,MQ>(NE, B, e_vec, q_val, vdim, D1D, Q1D);
             return;
          }
       }
@@ -673,24 +509,8 @@ static void D2QValues(const FiniteElementSpace &fes,
    MFEM_ABORT("Unknown kernel");
 }
 
-void QuadratureInterpolator::Values(const Vector &e_vec, Vector &q_val) const
-{
-   if (q_layout == QVectorLayout::byNODES)
-   {
-      Vector empty;
-      Mult(e_vec, VALUES, q_val, empty, empty);
-      return;
-   }
-
-   // q_layout == QVectorLayout::byVDIM
-   if (fespace->GetNE() == 0) { return; }
-   const IntegrationRule &ir = *IntRule;
-   const DofToQuad::Mode mode = DofToQuad::TENSOR;
-   const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
-   D2QValues(*fespace, &d2q, e_vec, q_val);
-}
-
-template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+template<QVectorLayout Q_LAYOUT,
+         int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void D2QGrad2D(const int NE,
                       const double *b_,
                       const double *g_,
@@ -708,7 +528,9 @@ static void D2QGrad2D(const int NE,
    auto b = Reshape(b_, Q1D, D1D);
    auto g = Reshape(g_, Q1D, D1D);
    auto x = Reshape(x_, D1D, D1D, VDIM, NE);
-   auto y = Reshape(y_, VDIM, 2, Q1D, Q1D, NE);
+   auto y = Q_LAYOUT == QVectorLayout::byNODES ?
+            Reshape(y_, Q1D, Q1D, VDIM, 2, NE):
+            Reshape(y_, VDIM, 2, Q1D, Q1D, NE);
 
    MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
    {
@@ -780,8 +602,16 @@ static void D2QGrad2D(const int NE,
                   u += DQ1[dy][qx] * B[qy][dy];
                   v += DQ0[dy][qx] * G[qy][dy];
                }
-               y(c,0,qx,qy,e) = u;
-               y(c,1,qx,qy,e) = v;
+               if (Q_LAYOUT == QVectorLayout::byVDIM)
+               {
+                  y(c,0,qx,qy,e) = u;
+                  y(c,1,qx,qy,e) = v;
+               }
+               if (Q_LAYOUT == QVectorLayout::byNODES)
+               {
+                  y(qx,qy,c,0,e) = u;
+                  y(qx,qy,c,1,e) = v;
+               }
             }
          }
          MFEM_SYNC_THREAD;
@@ -789,9 +619,10 @@ static void D2QGrad2D(const int NE,
    });
 }
 
-template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0,
+template<QVectorLayout Q_LAYOUT,
+         int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0,
          int MAX_D = 0, int MAX_Q = 0>
-static  void D2QGrad3D(const int NE,
+static void D2QGrad3D(const int NE,
                        const double *b_,
                        const double *g_,
                        const double *x_,
@@ -807,7 +638,9 @@ static  void D2QGrad3D(const int NE,
    auto b = Reshape(b_, Q1D, D1D);
    auto g = Reshape(g_, Q1D, D1D);
    auto x = Reshape(x_, D1D, D1D, D1D, VDIM, NE);
-   auto y = Reshape(y_, VDIM, 3, Q1D, Q1D, Q1D, NE);
+   auto y = Q_LAYOUT == QVectorLayout::byNODES ?
+            Reshape(y_, Q1D, Q1D, Q1D, VDIM, 3, NE):
+            Reshape(y_, VDIM, 3, Q1D, Q1D, Q1D, NE);
 
    MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
    {
@@ -913,9 +746,18 @@ static  void D2QGrad3D(const int NE,
                      v += DQQ1[dz][qy][qx] * B[qz][dz];
                      w += DQQ2[dz][qy][qx] * G[qz][dz];
                   }
-                  y(c,0,qx,qy,qz,e) = u;
-                  y(c,1,qx,qy,qz,e) = v;
-                  y(c,2,qx,qy,qz,e) = w;
+                  if (Q_LAYOUT == QVectorLayout::byVDIM)
+                  {
+                     y(c,0,qx,qy,qz,e) = u;
+                     y(c,1,qx,qy,qz,e) = v;
+                     y(c,2,qx,qy,qz,e) = w;
+                  }
+                  if (Q_LAYOUT == QVectorLayout::byNODES)
+                  {
+                     y(qx,qy,qz,c,0,e) = u;
+                     y(qx,qy,qz,c,1,e) = v;
+                     y(qx,qy,qz,c,2,e) = w;
+                  }
                }
             }
          }
@@ -924,6 +766,7 @@ static  void D2QGrad3D(const int NE,
    });
 }
 
+template<QVectorLayout Q_LAYOUT>
 static void D2QGrad(const FiniteElementSpace &fes,
                     const DofToQuad *maps,
                     const Vector &e_vec,
@@ -939,23 +782,27 @@ static void D2QGrad(const FiniteElementSpace &fes,
    const double *G = maps->G.Read();
    const double *X = e_vec.Read();
    double *Y = q_der.Write();
+   constexpr QVectorLayout L = Q_LAYOUT;
    if (dim == 2)
    {
       switch (id)
       {
-         case 0x134: return D2QGrad2D<1,3,4,8>(NE, B, G, X, Y);
-         case 0x146: return D2QGrad2D<1,4,6,4>(NE, B, G, X, Y);
-         case 0x158: return D2QGrad2D<1,5,8,2>(NE, B, G, X, Y);
-         case 0x234: return D2QGrad2D<2,3,4,8>(NE, B, G, X, Y);
-         case 0x246: return D2QGrad2D<2,4,6,4>(NE, B, G, X, Y);
-         case 0x258: return D2QGrad2D<2,5,8,2>(NE, B, G, X, Y);
+         case 0x134: return D2QGrad2D<L,1,3,4,8>(NE, B, G, X, Y);
+         case 0x146: return D2QGrad2D<L,1,4,6,4>(NE, B, G, X, Y);
+         case 0x158: return D2QGrad2D<L,1,5,8,2>(NE, B, G, X, Y);
+         case 0x222: return D2QGrad2D<L,2,2,2,16>(NE, B, G, X, Y);
+         case 0x223: return D2QGrad2D<L,2,2,3,16>(NE, B, G, X, Y);
+         case 0x224: return D2QGrad2D<L,2,2,4,8>(NE, B, G, X, Y);
+         case 0x234: return D2QGrad2D<L,2,3,4,8>(NE, B, G, X, Y);
+         case 0x246: return D2QGrad2D<L,2,4,6,4>(NE, B, G, X, Y);
+         case 0x258: return D2QGrad2D<L,2,5,8,2>(NE, B, G, X, Y);
          default:
          {
             MFEM_VERIFY(D1D <= MAX_D1D, "Orders higher than " << MAX_D1D-1
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MAX_Q1D, "Quadrature rules with more than "
                         << MAX_Q1D << " 1D points are not supported!");
-            D2QGrad2D(NE, B, G, X, Y, vdim, D1D, Q1D);
+            D2QGrad2D<L>(NE, B, G, X, Y, vdim, D1D, Q1D);
             return;
          }
       }
@@ -964,21 +811,24 @@ static void D2QGrad(const FiniteElementSpace &fes,
    {
       switch (id)
       {
-         case 0x134: return D2QGrad3D<1,3,4>(NE, B, G, X, Y);
-         case 0x146: return D2QGrad3D<1,4,6>(NE, B, G, X, Y);
-         case 0x158: return D2QGrad3D<1,5,8>(NE, B, G, X, Y);
-         case 0x334: return D2QGrad3D<3,3,4>(NE, B, G, X, Y);
-         case 0x346: return D2QGrad3D<3,4,6>(NE, B, G, X, Y);
-         case 0x358: return D2QGrad3D<3,5,8>(NE, B, G, X, Y);
+         case 0x134: return D2QGrad3D<L,1,3,4>(NE, B, G, X, Y);
+         case 0x146: return D2QGrad3D<L,1,4,6>(NE, B, G, X, Y);
+         case 0x158: return D2QGrad3D<L,1,5,8>(NE, B, G, X, Y);
+         case 0x322: return D2QGrad3D<L,3,2,2>(NE, B, G, X, Y);
+         case 0x323: return D2QGrad3D<L,3,2,3>(NE, B, G, X, Y);
+         case 0x324: return D2QGrad3D<L,3,2,4>(NE, B, G, X, Y);
+         case 0x334: return D2QGrad3D<L,3,3,4>(NE, B, G, X, Y);
+         case 0x346: return D2QGrad3D<L,3,4,6>(NE, B, G, X, Y);
+         case 0x358: return D2QGrad3D<L,3,5,8>(NE, B, G, X, Y);
          default:
          {
-            constexpr int MD = 8;
-            constexpr int MQ = 8;
+            constexpr int MD = MAX_D1D_3D;
+            constexpr int MQ = MAX_Q1D_3D;
             MFEM_VERIFY(D1D <= MD, "Orders higher than " << MD-1
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MQ, "Quadrature rules with more than " << MQ
                         << " 1D points are not supported!");
-            D2QGrad3D<0,0,0,MD,MQ>(NE, B, G, X, Y, vdim, D1D, Q1D);
+            D2QGrad3D<L,0,0,0,MD,MQ>(NE, B, G, X, Y, vdim, D1D, Q1D);
             return;
          }
       }
@@ -987,7 +837,8 @@ static void D2QGrad(const FiniteElementSpace &fes,
    MFEM_ABORT("Unknown kernel");
 }
 
-template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+template<QVectorLayout Q_LAYOUT,
+         int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void D2QPhysGrad2D(const int NE,
                           const double *b_,
                           const double *g_,
@@ -1007,7 +858,9 @@ static void D2QPhysGrad2D(const int NE,
    auto g = Reshape(g_, Q1D, D1D);
    auto j = Reshape(j_, Q1D, Q1D, 2, 2, NE);
    auto x = Reshape(x_, D1D, D1D, VDIM, NE);
-   auto y = Reshape(y_, VDIM, 2, Q1D, Q1D, NE);
+   auto y = Q_LAYOUT == QVectorLayout::byNODES ?
+            Reshape(y_, Q1D, Q1D, VDIM, 2, NE):
+            Reshape(y_, VDIM, 2, Q1D, Q1D, NE);
 
    MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
    {
@@ -1086,8 +939,18 @@ static void D2QPhysGrad2D(const int NE,
                Jloc[2] = j(qx,qy,0,1,e);
                Jloc[3] = j(qx,qy,1,1,e);
                kernels::CalcInverse<2>(Jloc, Jinv);
-               y(c,0,qx,qy,e) = Jinv[0]*u + Jinv[1]*v;
-               y(c,1,qx,qy,e) = Jinv[2]*u + Jinv[3]*v;
+               const double d0 = Jinv[0]*u + Jinv[1]*v;
+               const double d1 = Jinv[2]*u + Jinv[3]*v;
+               if (Q_LAYOUT == QVectorLayout::byVDIM)
+               {
+                  y(c,0,qx,qy,e) = d0;
+                  y(c,1,qx,qy,e) = d1;
+               }
+               if (Q_LAYOUT == QVectorLayout::byNODES)
+               {
+                  y(qx,qy,c,0,e) = d0;
+                  y(qx,qy,c,1,e) = d1;
+               }
             }
          }
          MFEM_SYNC_THREAD;
@@ -1095,9 +958,10 @@ static void D2QPhysGrad2D(const int NE,
    });
 }
 
-template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0,
+template<QVectorLayout Q_LAYOUT,
+         int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0,
          int MAX_D = 0, int MAX_Q = 0>
-static  void D2QPhysGrad3D(const int NE,
+static void D2QPhysGrad3D(const int NE,
                            const double *b_,
                            const double *g_,
                            const double *j_,
@@ -1115,7 +979,9 @@ static  void D2QPhysGrad3D(const int NE,
    auto g = Reshape(g_, Q1D, D1D);
    auto j = Reshape(j_, Q1D, Q1D, Q1D, 3, 3, NE);
    auto x = Reshape(x_, D1D, D1D, D1D, VDIM, NE);
-   auto y = Reshape(y_, VDIM, 3, Q1D, Q1D, Q1D, NE);
+   auto y = Q_LAYOUT == QVectorLayout::byNODES ?
+            Reshape(y_, Q1D, Q1D, Q1D, VDIM, 3, NE):
+            Reshape(y_, VDIM, 3, Q1D, Q1D, Q1D, NE);
 
    MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
    {
@@ -1231,9 +1097,21 @@ static  void D2QPhysGrad3D(const int NE,
                      }
                   }
                   kernels::CalcInverse<3>(Jloc, Jinv);
-                  y(c,0,qx,qy,qz,e) = Jinv[0]*u + Jinv[1]*v + Jinv[2]*w;
-                  y(c,1,qx,qy,qz,e) = Jinv[3]*u + Jinv[4]*v + Jinv[5]*w;
-                  y(c,2,qx,qy,qz,e) = Jinv[6]*u + Jinv[7]*v + Jinv[8]*w;
+                  const double d0 = Jinv[0]*u + Jinv[1]*v + Jinv[2]*w;
+                  const double d1 = Jinv[3]*u + Jinv[4]*v + Jinv[5]*w;
+                  const double d2 = Jinv[6]*u + Jinv[7]*v + Jinv[8]*w;
+                  if (Q_LAYOUT == QVectorLayout::byVDIM)
+                  {
+                     y(c,0,qx,qy,qz,e) = d0;
+                     y(c,1,qx,qy,qz,e) = d1;
+                     y(c,2,qx,qy,qz,e) = d2;
+                  }
+                  if (Q_LAYOUT == QVectorLayout::byNODES)
+                  {
+                     y(qx,qy,qz,c,0,e) = d0;
+                     y(qx,qy,qz,c,1,e) = d1;
+                     y(qx,qy,qz,c,2,e) = d2;
+                  }
                }
             }
          }
@@ -1242,7 +1120,7 @@ static  void D2QPhysGrad3D(const int NE,
    });
 }
 
-
+template<QVectorLayout Q_LAYOUT>
 static void D2QPhysGrad(const FiniteElementSpace &fes,
                         const GeometricFactors *geom,
                         const DofToQuad *maps,
@@ -1260,23 +1138,24 @@ static void D2QPhysGrad(const FiniteElementSpace &fes,
    const double *J = geom->J.Read();
    const double *X = e_vec.Read();
    double *Y = q_der.Write();
+   constexpr QVectorLayout L = Q_LAYOUT;
    if (dim == 2)
    {
       switch (id)
       {
-         case 0x134: return D2QPhysGrad2D<1,3,4,8>(NE, B, G, J, X, Y);
-         case 0x146: return D2QPhysGrad2D<1,4,6,4>(NE, B, G, J, X, Y);
-         case 0x158: return D2QPhysGrad2D<1,5,8,2>(NE, B, G, J, X, Y);
-         case 0x234: return D2QPhysGrad2D<2,3,4,8>(NE, B, G, J, X, Y);
-         case 0x246: return D2QPhysGrad2D<2,4,6,4>(NE, B, G, J, X, Y);
-         case 0x258: return D2QPhysGrad2D<2,5,8,2>(NE, B, G, J, X, Y);
+         case 0x134: return D2QPhysGrad2D<L,1,3,4,8>(NE, B, G, J, X, Y);
+         case 0x146: return D2QPhysGrad2D<L,1,4,6,4>(NE, B, G, J, X, Y);
+         case 0x158: return D2QPhysGrad2D<L,1,5,8,2>(NE, B, G, J, X, Y);
+         case 0x234: return D2QPhysGrad2D<L,2,3,4,8>(NE, B, G, J, X, Y);
+         case 0x246: return D2QPhysGrad2D<L,2,4,6,4>(NE, B, G, J, X, Y);
+         case 0x258: return D2QPhysGrad2D<L,2,5,8,2>(NE, B, G, J, X, Y);
          default:
          {
             MFEM_VERIFY(D1D <= MAX_D1D, "Orders higher than " << MAX_D1D-1
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MAX_Q1D, "Quadrature rules with more than "
                         << MAX_Q1D << " 1D points are not supported!");
-            D2QPhysGrad2D(NE, B, G, J, X, Y, vdim, D1D, Q1D);
+            D2QPhysGrad2D<L>(NE, B, G, J, X, Y, vdim, D1D, Q1D);
             return;
          }
       }
@@ -1285,21 +1164,21 @@ static void D2QPhysGrad(const FiniteElementSpace &fes,
    {
       switch (id)
       {
-         case 0x134: return D2QPhysGrad3D<1,3,4>(NE, B, G, J, X, Y);
-         case 0x146: return D2QPhysGrad3D<1,4,6>(NE, B, G, J, X, Y);
-         case 0x158: return D2QPhysGrad3D<1,5,8>(NE, B, G, J, X, Y);
-         case 0x334: return D2QPhysGrad3D<3,3,4>(NE, B, G, J, X, Y);
-         case 0x346: return D2QPhysGrad3D<3,4,6>(NE, B, G, J, X, Y);
-         case 0x358: return D2QPhysGrad3D<3,5,8>(NE, B, G, J, X, Y);
+         case 0x134: return D2QPhysGrad3D<L,1,3,4>(NE, B, G, J, X, Y);
+         case 0x146: return D2QPhysGrad3D<L,1,4,6>(NE, B, G, J, X, Y);
+         case 0x158: return D2QPhysGrad3D<L,1,5,8>(NE, B, G, J, X, Y);
+         case 0x334: return D2QPhysGrad3D<L,3,3,4>(NE, B, G, J, X, Y);
+         case 0x346: return D2QPhysGrad3D<L,3,4,6>(NE, B, G, J, X, Y);
+         case 0x358: return D2QPhysGrad3D<L,3,5,8>(NE, B, G, J, X, Y);
          default:
          {
-            constexpr int MD = 8;
-            constexpr int MQ = 8;
+            constexpr int MD = MAX_D1D_3D;
+            constexpr int MQ = MAX_Q1D_3D;
             MFEM_VERIFY(D1D <= MD, "Orders higher than " << MD-1
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MQ, "Quadrature rules with more than " << MQ
                         << " 1D points are not supported!");
-            D2QPhysGrad3D<0,0,0,MD,MQ>(NE, B, G, J, X, Y, vdim, D1D, Q1D);
+            D2QPhysGrad3D<L,0,0,0,MD,MQ>(NE, B, G, J, X, Y, vdim, D1D, Q1D);
             return;
          }
       }
@@ -1308,44 +1187,325 @@ static void D2QPhysGrad(const FiniteElementSpace &fes,
    MFEM_ABORT("Unknown kernel");
 }
 
-void QuadratureInterpolator::Derivatives(const Vector &e_vec,
-                                         Vector &q_der) const
+// Determinants of the DIM x DIM Jacobian matrices given by the derivatives
+// computed with D2QGrad, in the Q_LAYOUT layout.
+template<QVectorLayout Q_LAYOUT, int DIM>
+static void D2QDet(const int NE,
+                   const int NQ,
+                   const Vector &d_,
+                   Vector &y_)
 {
-   if (q_layout == QVectorLayout::byNODES)
+   auto d = Q_LAYOUT == QVectorLayout::byNODES ?
+            Reshape(d_.Read(), NQ, DIM, DIM, NE):
+            Reshape(d_.Read(), DIM, DIM, NQ, NE);
+   auto y = Reshape(y_.Write(), NQ, NE);
+   MFEM_FORALL(i, NQ*NE,
    {
-      Vector empty;
-      Mult(e_vec, DERIVATIVES, empty, q_der, empty);
-      return;
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double J[DIM*DIM];
+      for (int col = 0; col < DIM; col++)
+      {
+         for (int row = 0; row < DIM; row++)
+         {
+            J[row+DIM*col] = (Q_LAYOUT == QVectorLayout::byNODES) ?
+                             d(q,row,col,e) : d(row,col,q,e);
+         }
+      }
+      y(q,e) = kernels::Det<DIM>(J);
+   });
+}
+
+bool QuadratureInterpolator::UsesTensorProducts() const
+{
+   if (!use_tensor_products || fespace->GetNE() == 0) { return false; }
+   const FiniteElement *fe = fespace->GetFE(0);
+   if (dynamic_cast<const TensorBasisElement*>(fe) == NULL) { return false; }
+   const int dim = fe->GetDim();
+   const IntegrationRule *ir =
+      IntRule ? IntRule : &qspace->GetElementIntRule(0);
+   const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::TENSOR);
+   const int D1D = maps.ndof;
+   const int Q1D = maps.nqpt;
+   if (dim == 2)
+   {
+      return Q1D*Q1D == ir->GetNPoints() &&
+             D1D <= MAX_D1D && Q1D <= MAX_Q1D;
    }
+   if (dim == 3)
+   {
+      return Q1D*Q1D*Q1D == ir->GetNPoints() &&
+             D1D <= MAX_D1D_3D && Q1D <= MAX_Q1D_3D;
+   }
+   return false;
+}
 
-   // q_layout == QVectorLayout::byVDIM
-   if (fespace->GetNE() == 0) { return; }
-   const IntegrationRule &ir = *IntRule;
-   const DofToQuad::Mode mode = DofToQuad::TENSOR;
-   const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
-   D2QGrad(*fespace, &d2q, e_vec, q_der);
+template<QVectorLayout Q_LAYOUT>
+static void TensorMult(const FiniteElementSpace &fes,
+                       const DofToQuad &maps,
+                       const Vector &e_vec, unsigned eval_flags,
+                       Vector &q_val, Vector &q_der, Vector &q_det)
+{
+   typedef QuadratureInterpolator QI;
+   const int dim = fes.GetMesh()->Dimension();
+   const int vdim = fes.GetVDim();
+   const int NE = fes.GetNE();
+   const int NQ = (dim == 2) ? maps.nqpt*maps.nqpt :
+                  maps.nqpt*maps.nqpt*maps.nqpt;
+   if (eval_flags & QI::VALUES)
+   {
+      D2QValues<Q_LAYOUT>(fes, &maps, e_vec, q_val);
+   }
+   if (!(eval_flags & (QI::DERIVATIVES | QI::DETERMINANTS))) { return; }
+
+   // The determinants are computed from the derivatives, stored in a
+   // temporary vector when they were not requested.
+   Vector der_tmp;
+   if (!(eval_flags & QI::DERIVATIVES))
+   {
+      der_tmp.SetSize(vdim*dim*NQ*NE);
+      der_tmp.UseDevice(true);
+   }
+   Vector &der = (eval_flags & QI::DERIVATIVES) ? q_der : der_tmp;
+   D2QGrad<Q_LAYOUT>(fes, &maps, e_vec, der);
+   if (eval_flags & QI::DETERMINANTS)
+   {
+      MFEM_VERIFY(vdim == dim, "determinants require vdim == dim");
+      if (dim == 2) { D2QDet<Q_LAYOUT,2>(NE, NQ, der, q_det); }
+      if (dim == 3) { D2QDet<Q_LAYOUT,3>(NE, NQ, der, q_det); }
+   }
 }
 
-void QuadratureInterpolator::PhysDerivatives(const Vector &e_vec,
-                                             Vector &q_der) const
+void QuadratureInterpolator::Mult(
+   const Vector &e_vec, unsigned eval_flags,
+   Vector &q_val, Vector &q_der, Vector &q_det) const
 {
-   if (q_layout == QVectorLayout::byNODES)
+   const int ne = fespace->GetNE();
+   if (ne == 0) { return; }
+   const FiniteElement *fe = fespace->GetFE(0);
+   const IntegrationRule *ir =
+      IntRule ? IntRule : &qspace->GetElementIntRule(0);
+
+   if (UsesTensorProducts())
    {
-      MFEM_ABORT("evaluation of physical derivatives with 'byNODES' output"
-                 " layout is not implemented yet!");
+      const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::TENSOR);
+      if (q_layout == QVectorLayout::byNODES)
+      {
+         TensorMult<QVectorLayout::byNODES>(*fespace, maps, e_vec, eval_flags,
+                                            q_val, q_der, q_det);
+      }
+      else
+      {
+         TensorMult<QVectorLayout::byVDIM>(*fespace, maps, e_vec, eval_flags,
+                                           q_val, q_der, q_det);
+      }
       return;
    }
 
-   // q_layout == QVectorLayout::byVDIM
+   MFEM_VERIFY(q_layout == QVectorLayout::byNODES, "the 'byVDIM' output"
+               " layout requires tensor product evaluation!");
+   const int vdim = fespace->GetVDim();
+   const int dim = fespace->GetMesh()->Dimension();
+   const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::FULL);
+   const int nd = maps.ndof;
+   const int nq = maps.nqpt;
+   void (*eval_func)(
+      const int NE,
+      const int vdim,
+      const DofToQuad &maps,
+      const Vector &e_vec,
+      Vector &q_val,
+      Vector &q_der,
+      Vector &q_det,
+      const int eval_flags) = NULL;
+   if (vdim == 1)
+   {
+      if (dim == 2)
+      {
+         switch (100*nd + nq)
+         {
+            // Q0
+            case 101: eval_func = &Eval2D<1,1,1>; break;
+            case 104: eval_func = &Eval2D<1,1,4>; break;
+            // Q1
+            case 404: eval_func = &Eval2D<1,4,4>; break;
+            case 409: eval_func = &Eval2D<1,4,9>; break;
+            // Q2
+            case 909: eval_func = &Eval2D<1,9,9>; break;
+            case 916: eval_func = &Eval2D<1,9,16>; break;
+            // Q3
+            case 1616: eval_func = &Eval2D<1,16,16>; break;
+            case 1625: eval_func = &Eval2D<1,16,25>; break;
+            case 1636: eval_func = &Eval2D<1,16,36>; break;
+            // Q4
+            case 2525: eval_func = &Eval2D<1,25,25>; break;
+            case 2536: eval_func = &Eval2D<1,25,36>; break;
+            case 2549: eval_func = &Eval2D<1,25,49>; break;
+            case 2564: eval_func = &Eval2D<1,25,64>; break;
+         }
+         if (nq >= 100 || !eval_func)
+         {
+            eval_func = &Eval2D<1>;
+         }
+      }
+      else if (dim == 3)
+      {
+         switch (1000*nd + nq)
+         {
+            // Q0
+            case 1001: eval_func = &Eval3D<1,1,1>; break;
+            case 1008: eval_func = &Eval3D<1,1,8>; break;
+            // Q1
+            case 8008: eval_func = &Eval3D<1,8,8>; break;
+            case 8027: eval_func = &Eval3D<1,8,27>; break;
+            // Q2
+            case 27027: eval_func = &Eval3D<1,27,27>; break;
+            case 27064: eval_func = &Eval3D<1,27,64>; break;
+            // Q3
+            case 64064: eval_func = &Eval3D<1,64,64>; break;
+            case 64125: eval_func = &Eval3D<1,64,125>; break;
+            case 64216: eval_func = &Eval3D<1,64,216>; break;
+            // Q4
+            case 125125: eval_func = &Eval3D<1,125,125>; break;
+            case 125216: eval_func = &Eval3D<1,125,216>; break;
+         }
+         if (nq >= 1000 || !eval_func)
+         {
+            eval_func = &Eval3D<1>;
+         }
+      }
+   }
+   else if (vdim == 3 && dim == 2)
+   {
+      switch (100*nd + nq)
+      {
+         // Q0
+         case 101: eval_func = &Eval2D<3,1,1>; break;
+         case 104: eval_func = &Eval2D<3,1,4>; break;
+         // Q1
+         case 404: eval_func = &Eval2D<3,4,4>; break;
+         case 409: eval_func = &Eval2D<3,4,9>; break;
+         // Q2
+         case 904: eval_func = &Eval2D<3,9,4>; break;
+         case 909: eval_func = &Eval2D<3,9,9>; break;
+         case 916: eval_func = &Eval2D<3,9,16>; break;
+         case 925: eval_func = &Eval2D<3,9,25>; break;
+         // Q3
+         case 1616: eval_func = &Eval2D<3,16,16>; break;
+         case 1625: eval_func = &Eval2D<3,16,25>; break;
+         case 1636: eval_func = &Eval2D<3,16,36>; break;
+         // Q4
+         case 2525: eval_func = &Eval2D<3,25,25>; break;
+         case 2536: eval_func = &Eval2D<3,25,36>; break;
+         case 2549: eval_func = &Eval2D<3,25,49>; break;
+         case 2564: eval_func = &Eval2D<3,25,64>; break;
+         default:   eval_func = &Eval2D<3>;
+      }
+   }
+   else if (vdim == dim)
+   {
+      if (dim == 2)
+      {
+         switch (100*nd + nq)
+         {
+            // Q1
+            case 404: eval_func = &Eval2D<2,4,4>; break;
+            case 409: eval_func = &Eval2D<2,4,9>; break;
+            // Q2
+            case 909: eval_func = &Eval2D<2,9,9>; break;
+            case 916: eval_func = &Eval2D<2,9,16>; break;
+            // Q3
+            case 1616: eval_func = &Eval2D<2,16,16>; break;
+            case 1625: eval_func = &Eval2D<2,16,25>; break;
+            case 1636: eval_func = &Eval2D<2,16,36>; break;
+            // Q4
+            case 2525: eval_func = &Eval2D<2,25,25>; break;
+            case 2536: eval_func = &Eval2D<2,25,36>; break;
+            case 2549: eval_func = &Eval2D<2,25,49>; break;
+            case 2564: eval_func = &Eval2D<2,25,64>; break;
+         }
+         if (nq >= 100 || !eval_func)
+         {
+            eval_func = &Eval2D<2>;
+         }
+      }
+      else if (dim == 3)
+      {
+         switch (1000*nd + nq)
+         {
+            // Q1
+            case 8008: eval_func = &Eval3D<3,8,8>; break;
+            case 8027: eval_func = &Eval3D<3,8,27>; break;
+            // Q2
+            case 27027: eval_func = &Eval3D<3,27,27>; break;
+            case 27064: eval_func = &Eval3D<3,27,64>; break;
+            // Q3
+            case 64064: eval_func = &Eval3D<3,64,64>; break;
+            case 64125: eval_func = &Eval3D<3,64,125>; break;
+            case 64216: eval_func = &Eval3D<3,64,216>; break;
+            // Q4
+            case 125125: eval_func = &Eval3D<3,125,125>; break;
+            case 125216: eval_func = &Eval3D<3,125,216>; break;
+         }
+         if (nq >= 1000 || !eval_func)
+         {
+            eval_func = &Eval3D<3>;
+         }
+      }
+   }
+   if (eval_func)
+   {
+      eval_func(ne, vdim, maps, e_vec, q_val, q_der, q_det, eval_flags);
+   }
+   else
+   {
+      MFEM_ABORT("case not supported yet");
+   }
+}
+
+void QuadratureInterpolator::MultTranspose(
+   unsigned eval_flags, const Vector &q_val, const Vector &q_der,
+   Vector &e_vec) const
+{
+   MFEM_ABORT("this method is not implemented yet");
+}
+
+
+void QuadratureInterpolator::Values(const Vector &e_vec, Vector &q_val) const
+{
+   Vector empty;
+   Mult(e_vec, VALUES, q_val, empty, empty);
+}
+
+void QuadratureInterpolator::Derivatives(const Vector &e_vec,
+                                         Vector &q_der) const
+{
+   Vector empty;
+   Mult(e_vec, DERIVATIVES, empty, q_der, empty);
+}
+
+void QuadratureInterpolator::PhysDerivatives(const Vector &e_vec,
+                                             Vector &q_der) const
+{
    Mesh *mesh = fespace->GetMesh();
    if (mesh->GetNE() == 0) { return; }
+   MFEM_VERIFY(UsesTensorProducts(), "evaluation of physical derivatives"
+               " requires tensor product evaluation!");
    // mesh->DeleteGeometricFactors(); // This should be done outside
-   const IntegrationRule &ir = *IntRule;
+   const IntegrationRule &ir =
+      IntRule ? *IntRule : qspace->GetElementIntRule(0);
    const GeometricFactors *geom =
       mesh->GetGeometricFactors(ir, GeometricFactors::JACOBIANS);
    const DofToQuad::Mode mode = DofToQuad::TENSOR;
    const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
-   D2QPhysGrad(*fespace, geom, &d2q, e_vec, q_der);
+   if (q_layout == QVectorLayout::byNODES)
+   {
+      D2QPhysGrad<QVectorLayout::byNODES>(*fespace, geom, &d2q, e_vec, q_der);
+   }
+   else
+   {
+      D2QPhysGrad<QVectorLayout::byVDIM>(*fespace, geom, &d2q, e_vec, q_der);
+   }
 }
 
 } // namespace mfem
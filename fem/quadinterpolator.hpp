@@ -72,11 +72,21 @@ public:
 
    /** @brief Disable the use of tensor product evaluations, for tensor-product
        elements, e.g. quads and hexes. */
-   /** Currently, tensor product evaluations are not implemented and this method
-       has no effect. */
+   /** By default, tensor product evaluations are enabled. See
+       UsesTensorProducts() for the conditions under which they are used. */
    void DisableTensorProducts(bool disable = true) const
    { use_tensor_products = !disable; }
 
+   /** @brief Return true if the interpolation uses tensor product (sum
+       factorization) evaluations. */
+   /** This is the case when tensor product evaluations are not disabled, the
+       elements are tensor-product elements, the quadrature rule is a tensor
+       product rule and the 1D sizes are supported by the tensor kernels. The
+       input E-vectors must then use ElementDofOrdering::LEXICOGRAPHIC, while
+       ElementDofOrdering::NATIVE is expected otherwise. The 'byVDIM' output
+       layout and PhysDerivatives() require tensor product evaluations. */
+   bool UsesTensorProducts() const;
+
    /** @brief Query the current output Q-vector layout. The default value is
        QVectorLayout::byNODES. */
    QVectorLayout GetOutputLayout() const { return q_layout; }
@@ -94,7 +104,8 @@ public:
        When the DETERMINANTS flags is set, it is assumed that the derivatives
        form a matrix at each quadrature point (i.e. the associated
        FiniteElementSpace is a vector space) and their determinants are computed
-       and stored in @a q_det. */
+       and stored in @a q_det. The ordering of @a e_vec is described in
+       UsesTensorProducts(). */
    void Mult(const Vector &e_vec, unsigned eval_flags,
              Vector &q_val, Vector &q_der, Vector &q_det) const;
 
@@ -168,6 +168,65 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultElements(const Vector& x, Vector& y,
+                                      int e_begin, int e_end) const
+{
+   MFEM_ASSERT(0 <= e_begin && e_begin <= e_end && e_end <= ne, "");
+   if (e_begin == e_end) { return; }
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int first = e_begin*nd;
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.ReadWrite(), nd, vd, ne);
+   auto d_gatherMap = gatherMap.Read();
+   MFEM_FORALL(k, (e_end - e_begin)*nd,
+   {
+      const int i = first + k;
+      const int gid = d_gatherMap[i];
+      const bool plus = gid >= 0;
+      const int j = plus ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = d_x(t?c:j, t?j:c);
+         d_y(i % nd, c, i / nd) = plus ? dofValue : -dofValue;
+      }
+   });
+}
+
+void ElementRestriction::MultTransposeDofs(const Array<int> &dofs,
+                                           const Vector& x, Vector& y) const
+{
+   if (dofs.Size() == 0) { return; }
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_dofs = dofs.Read();
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_x = Reshape(x.Read(), nd, vd, ne);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(k, dofs.Size(),
+   {
+      const int i = d_dofs[k];
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+            dofValue += (d_indices[j] >= 0) ? d_x(idx_j % nd, c,
+            idx_j / nd) : -d_x(idx_j % nd, c, idx_j / nd);
+         }
+         d_y(t?c:i,t?i:c) = dofValue;
+      }
+   });
+}
+
 void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -642,6 +701,37 @@ void GetFaceDofs(const int dim, const int face_id,
    }
 }
 
+void GetFaceNormalAxis(const int dim, const int face_id, int &axis, int &end)
+{
+   switch (dim)
+   {
+      case 1:
+         axis = 0;
+         end = face_id; // WEST, EAST
+         break;
+      case 2:
+         switch (face_id)
+         {
+            case 0: axis = 1; end = 0; break; // SOUTH
+            case 1: axis = 0; end = 1; break; // EAST
+            case 2: axis = 1; end = 1; break; // NORTH
+            case 3: axis = 0; end = 0; break; // WEST
+         }
+         break;
+      case 3:
+         switch (face_id)
+         {
+            case 0: axis = 2; end = 0; break; // BOTTOM
+            case 1: axis = 1; end = 0; break; // SOUTH
+            case 2: axis = 0; end = 1; break; // EAST
+            case 3: axis = 1; end = 1; break; // NORTH
+            case 4: axis = 0; end = 0; break; // WEST
+            case 5: axis = 2; end = 1; break; // TOP
+         }
+         break;
+   }
+}
+
 H1FaceRestriction::H1FaceRestriction(const FiniteElementSpace &fes,
                                      const ElementDofOrdering e_ordering,
                                      const FaceType type)
@@ -1403,6 +1493,219 @@ void L2FaceRestriction::AddFaceMatricesToElementMatrices(Vector &fea_data,
    }
 }
 
+L2NormalDerivativeFaceRestriction::L2NormalDerivativeFaceRestriction(
+   const FiniteElementSpace &fes, const FaceType type)
+   : fes(fes),
+     nf(fes.GetNFbyType(type)),
+     vdim(fes.GetVDim()),
+     byvdim(fes.GetOrdering() == Ordering::byVDIM),
+     ndofs(fes.GetNDofs()),
+     dof(nf > 0 ?
+         fes.GetTraceElement(0, fes.GetMesh()->GetFaceBaseGeometry(0))->GetDof()
+         : 0),
+     dof1d(fes.GetFE(0)->GetOrder()+1),
+     line_indices(dof1d*dof*2*nf),
+     face_ends(2*nf),
+     dshape(2*dof1d),
+     offsets(ndofs+1)
+{
+   const FiniteElement *fe = fes.GetFE(0);
+   const TensorBasisElement *tfe = dynamic_cast<const TensorBasisElement*>(fe);
+   MFEM_VERIFY(tfe != NULL &&
+               (tfe->GetBasisType()==BasisType::GaussLobatto ||
+                tfe->GetBasisType()==BasisType::Positive),
+               "Only Gauss-Lobatto and Bernstein basis are supported in "
+               "L2NormalDerivativeFaceRestriction.");
+   MFEM_VERIFY(fes.GetMesh()->Conforming(),
+               "Non-conforming meshes not yet supported with partial assembly.");
+   if (nf==0) { return; }
+   height = 2*vdim*nf*dof;
+   width = fes.GetVSize();
+
+   // The derivatives of the 1D basis functions at both ends of the interval
+   Vector shape1d(dof1d), dshape1d(dof1d);
+   for (int end = 0; end < 2; end++)
+   {
+      tfe->GetBasis1D().Eval(end, shape1d, dshape1d);
+      for (int j = 0; j < dof1d; j++)
+      {
+         dshape(j + dof1d*end) = dshape1d(j);
+      }
+   }
+
+   // Computation of the element dofs on the lines normal to the faces, going
+   // through the face dofs
+   const Table& e2dTable = fes.GetElementToDofTable();
+   const int* elementMap = e2dTable.GetJ();
+   const int elem_dofs = fe->GetDof();
+   const int dim = fes.GetMesh()->Dimension();
+   Array<int> faceMap1(dof), faceMap2(dof);
+   auto lines = Reshape(line_indices.HostWrite(), dof1d, dof, 2, nf);
+   auto ends = Reshape(face_ends.HostWrite(), 2, nf);
+   int e1, e2;
+   int inf1, inf2;
+   int f_ind = 0;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      fes.GetMesh()->GetFaceElements(f, &e1, &e2);
+      fes.GetMesh()->GetFaceInfos(f, &inf1, &inf2);
+      MFEM_VERIFY(e2 >= 0 || inf2 < 0, "Shared faces are not supported in "
+                  "L2NormalDerivativeFaceRestriction.");
+      if ((type==FaceType::Interior && e2<0) ||
+          (type==FaceType::Boundary && e2>=0))
+      {
+         continue;
+      }
+      int axis, end;
+      const int face_id1 = inf1 / 64;
+      GetFaceDofs(dim, face_id1, dof1d, faceMap1);
+      GetFaceNormalAxis(dim, face_id1, axis, end);
+      int stride = 1;
+      for (int k = 0; k < axis; k++) { stride *= dof1d; }
+      ends(0, f_ind) = end;
+      for (int d = 0; d < dof; ++d)
+      {
+         const int first = faceMap1[d] - end*(dof1d-1)*stride;
+         for (int j = 0; j < dof1d; j++)
+         {
+            lines(j, d, 0, f_ind) = elementMap[e1*elem_dofs + first + j*stride];
+         }
+      }
+      if (e2 >= 0) // interior face
+      {
+         const int face_id2 = inf2 / 64;
+         const int orientation = inf2 % 64;
+         GetFaceDofs(dim, face_id2, dof1d, faceMap2);
+         GetFaceNormalAxis(dim, face_id2, axis, end);
+         stride = 1;
+         for (int k = 0; k < axis; k++) { stride *= dof1d; }
+         ends(1, f_ind) = end;
+         for (int d = 0; d < dof; ++d)
+         {
+            const int pd = PermuteFaceL2(dim, face_id1, face_id2,
+                                         orientation, dof1d, d);
+            const int first = faceMap2[pd] - end*(dof1d-1)*stride;
+            for (int j = 0; j < dof1d; j++)
+            {
+               lines(j, d, 1, f_ind) =
+                  elementMap[e2*elem_dofs + first + j*stride];
+            }
+         }
+      }
+      else // true boundary face
+      {
+         ends(1, f_ind) = -1;
+         for (int d = 0; d < dof; ++d)
+         {
+            for (int j = 0; j < dof1d; j++)
+            {
+               lines(j, d, 1, f_ind) = -1;
+            }
+         }
+      }
+      f_ind++;
+   }
+   MFEM_VERIFY(f_ind==nf, "Unexpected number of faces.");
+
+   // Computation of gather_indices
+   for (int i = 0; i <= ndofs; ++i)
+   {
+      offsets[i] = 0;
+   }
+   for (int i = 0; i < line_indices.Size(); ++i)
+   {
+      if (line_indices[i] >= 0) { ++offsets[line_indices[i] + 1]; }
+   }
+   for (int i = 1; i <= ndofs; ++i)
+   {
+      offsets[i] += offsets[i - 1];
+   }
+   gather_indices.SetSize(offsets[ndofs]);
+   for (int i = 0; i < line_indices.Size(); ++i)
+   {
+      if (line_indices[i] >= 0)
+      {
+         gather_indices[offsets[line_indices[i]]++] = i;
+      }
+   }
+   for (int i = ndofs; i > 0; --i)
+   {
+      offsets[i] = offsets[i - 1];
+   }
+   offsets[0] = 0;
+}
+
+void L2NormalDerivativeFaceRestriction::Mult(const Vector& x, Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int d1d = dof1d;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_lines = Reshape(line_indices.Read(), d1d, nd, 2, nf);
+   auto d_ends = Reshape(face_ends.Read(), 2, nf);
+   auto d_dshape = Reshape(dshape.Read(), d1d, 2);
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.Write(), nd, vd, 2, nf);
+   MFEM_FORALL(i, 2*nf*nd,
+   {
+      const int dof = i % nd;
+      const int side = (i / nd) % 2;
+      const int face = i / (2*nd);
+      const int end = d_ends(side, face);
+      for (int c = 0; c < vd; ++c)
+      {
+         double dn = 0.0;
+         if (end >= 0)
+         {
+            for (int j = 0; j < d1d; ++j)
+            {
+               const int idx = d_lines(j, dof, side, face);
+               dn += d_dshape(j, end) * d_x(t?c:idx, t?idx:c);
+            }
+         }
+         d_y(dof, c, side, face) = dn;
+      }
+   });
+}
+
+void L2NormalDerivativeFaceRestriction::MultTranspose(const Vector& x,
+                                                      Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int d1d = dof1d;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = gather_indices.Read();
+   auto d_ends = Reshape(face_ends.Read(), 2, nf);
+   auto d_dshape = Reshape(dshape.Read(), d1d, 2);
+   auto d_x = Reshape(x.Read(), nd, vd, 2, nf);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int k = offset; k < nextOffset; ++k)
+         {
+            // entry (j, dof, side, face) of the line indices
+            const int idx_k = d_indices[k];
+            const int j = idx_k % d1d;
+            const int dof = (idx_k / d1d) % nd;
+            const int side = (idx_k / (d1d*nd)) % 2;
+            const int face = idx_k / (2*d1d*nd);
+            dofValue += d_dshape(j, d_ends(side, face)) *
+                        d_x(dof, c, side, face);
+         }
+         d_y(t?c:i,t?i:c) += dofValue;
+      }
+   });
+}
+
 int ToLexOrdering(const int dim, const int face_id, const int size1d,
                   const int index)
 {
@@ -57,6 +57,20 @@ public:
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
 
+   /// Compute Mult only for the elements with indices in [e_begin, e_end).
+   /** The entries of @a y that belong to other elements are not changed. */
+   void MultElements(const Vector &x, Vector &y, int e_begin, int e_end) const;
+
+   /** @brief Return the map from the E-vector entries of the first vector
+       component to the signed L-vector dofs, -1-dof for negative
+       orientation. */
+   const Array<int> &GetGatherMap() const { return gatherMap; }
+
+   /// Compute MultTranspose only for the (scalar) dofs listed in @a dofs.
+   /** The entries of @a y that belong to other dofs are not changed. */
+   void MultTransposeDofs(const Array<int> &dofs,
+                          const Vector &x, Vector &y) const;
+
    /// @brief Fills the E-vector y with `boolean` values 0.0 and 1.0 such that each
    /// each entry of the L-vector is uniquely represented in `y`.
    /** This means, the sum of the E-vector `y` is equal to the sum of the
@@ -168,10 +182,53 @@ public:
                                          Vector &ea_data) const;
 };
 
+/** @brief Operator that computes the derivatives of an L2 field, in the
+    direction of the reference axis normal to each face, on the faces.
+
+    For every face and every side of the face, the output contains the face
+    dofs (i.e. the coefficients in the face basis) of the derivative of the
+    element function with respect to the reference coordinate of the element
+    that is normal to the face. The layout of the output, (face dofs, vdim, 2,
+    faces), and the ordering of the face dofs of both sides are the ones of the
+    double-valued L2FaceRestriction; on boundary faces the second side is 0.
+
+    Only tensor-product elements with Gauss-Lobatto or Bernstein bases on
+    conforming meshes without shared faces are supported. */
+class L2NormalDerivativeFaceRestriction : public Operator
+{
+protected:
+   const FiniteElementSpace &fes;
+   const int nf;
+   const int vdim;
+   const bool byvdim;
+   const int ndofs;
+   const int dof;
+   const int dof1d;
+   /// Element dofs on the lines normal to the faces, (dof1d, dof, 2, nf).
+   Array<int> line_indices;
+   /// End of the normal reference axis (0 or 1) of each side, (2, nf).
+   Array<int> face_ends;
+   /// Derivatives of the 1D basis functions at 0 and 1, (dof1d, 2).
+   Vector dshape;
+   /// CSR-like map from the L-vector dofs to the entries of #line_indices.
+   Array<int> offsets;
+   Array<int> gather_indices;
+
+public:
+   L2NormalDerivativeFaceRestriction(const FiniteElementSpace &fes,
+                                     const FaceType type);
+   virtual void Mult(const Vector &x, Vector &y) const;
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+};
+
 // Return the face degrees of freedom returned in Lexicographic order.
 void GetFaceDofs(const int dim, const int face_id,
                  const int dof1d, Array<int> &faceMap);
 
+// Return the reference axis normal to the face of a tensor-product element,
+// and the end of the axis (0 or 1) where the face lies.
+void GetFaceNormalAxis(const int dim, const int face_id, int &axis, int &end);
+
 // Convert from Native ordering to lexicographic ordering
 int ToLexOrdering(const int dim, const int face_id, const int size1d,
                   const int index);
@@ -51,5 +51,41 @@ void WriteBase64(std::ostream &out, const void *bytes, size_t nbytes)
    }
 }
 
+static int b64index(char c)
+{
+   if (c >= 'A' && c <= 'Z') { return c - 'A'; }
+   if (c >= 'a' && c <= 'z') { return c - 'a' + 26; }
+   if (c >= '0' && c <= '9') { return c - '0' + 52; }
+   if (c == '+') { return 62; }
+   if (c == '/') { return 63; }
+   return -1;
+}
+
+void DecodeBase64(const char *src, size_t length, std::vector<char> &buf)
+{
+   buf.reserve(buf.size() + (length/4)*3);
+   unsigned int acc = 0;
+   int nbits = 0;
+   for (size_t i = 0; i < length; i++)
+   {
+      const char c = src[i];
+      if (c == '=') { break; }
+      const int idx = b64index(c);
+      if (idx < 0)
+      {
+         MFEM_VERIFY(c == ' ' || c == '\n' || c == '\r' || c == '\t',
+                     "invalid base 64 character: '" << c << "'");
+         continue;
+      }
+      acc = (acc << 6) | idx;
+      nbits += 6;
+      if (nbits >= 8)
+      {
+         nbits -= 8;
+         buf.push_back(char((acc >> nbits) & 0xff));
+      }
+   }
+}
+
 } // namespace mfem::bin_io
 } // namespace mfem
@@ -50,6 +50,15 @@ void AppendBytes(std::vector<char> &vec, const T &val)
 
 void WriteBase64(std::ostream &out, const void *bytes, size_t length);
 
+/// Return the number of characters needed to encode @a nbytes bytes in base 64
+/// (including padding).
+inline size_t NumBase64Chars(size_t nbytes) { return ((nbytes + 2)/3)*4; }
+
+/// Decode @a length base 64 characters from @a src, appending the result to
+/// @a buf. Whitespace is skipped; decoding stops at the first padding
+/// character.
+void DecodeBase64(const char *src, size_t length, std::vector<char> &buf);
+
 } // namespace mfem::bin_io
 
 } // namespace mfem
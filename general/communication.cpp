@@ -25,6 +25,7 @@
 #include "text.hpp"
 #include "sort_pairs.hpp"
 #include "globals.hpp"
+#include "forall.hpp"
 
 #include <iostream>
 #include <map>
@@ -348,6 +349,12 @@ GroupCommunicator::GroupCommunicator(GroupTopology &gt, Mode m)
    num_requests = 0;
    request_marker = NULL;
    buf_offsets = NULL;
+   vec_num_sends = 0;
+   vec_requests = NULL;
+   vec_nvec = 0;
+   vec_gpu_aware = false;
+   coll_comm = MPI_COMM_NULL;
+   coll_master_size = 0;
 }
 
 void GroupCommunicator::Create(const Array<int> &ldof_group)
@@ -483,6 +490,197 @@ void GroupCommunicator::Finalize()
          }
       }
    }
+
+   // Construct the data for the multi-vector operations: the messages use the
+   // same neighbor and group order as the byNeighbor mode. For each message we
+   // store the offset and the size (for one vector) in vec_msg_offsets.
+   nbr_master_ldof.SetSize(0);
+   nbr_slave_ldof.SetSize(0);
+   vec_nbr_rank.SetSize(0);
+   vec_msg_offsets.SetSize(0);
+   for (int master = 1; master >= 0; master--)
+   {
+      const Table &nbr_groups = master ? nbr_send_groups : nbr_recv_groups;
+      Array<int> &nbr_ldof = master ? nbr_master_ldof : nbr_slave_ldof;
+      for (int nbr = 1; nbr < nbr_groups.Size(); nbr++)
+      {
+         const int num_groups = nbr_groups.RowSize(nbr);
+         if (num_groups == 0) { continue; }
+
+         const int offset = nbr_ldof.Size();
+         const int *grp_list = nbr_groups.GetRow(nbr);
+         for (int i = 0; i < num_groups; i++)
+         {
+            nbr_ldof.Append(group_ldof.GetRow(grp_list[i]),
+                            group_ldof.RowSize(grp_list[i]));
+         }
+         vec_nbr_rank.Append(gtopo.GetNeighborRank(nbr));
+         vec_msg_offsets.Append(offset);
+         vec_msg_offsets.Append(nbr_ldof.Size() - offset);
+      }
+      if (master) { vec_num_sends = vec_nbr_rank.Size(); }
+   }
+
+   // A master ldof is sent to all other processors in its group, so it may
+   // appear multiple times in nbr_master_ldof.
+   const int num_master = nbr_master_ldof.Size();
+   Array<Pair<int,int> > ldof_pos(num_master);
+   for (int j = 0; j < num_master; j++)
+   {
+      ldof_pos[j].one = nbr_master_ldof[j];
+      ldof_pos[j].two = j;
+   }
+   SortPairs<int,int>(ldof_pos, num_master);
+   master_ldof.SetSize(0);
+   master_pos_offsets.SetSize(0);
+   master_pos.SetSize(num_master);
+   for (int j = 0; j < num_master; j++)
+   {
+      if (j == 0 || ldof_pos[j].one != ldof_pos[j-1].one)
+      {
+         master_ldof.Append(ldof_pos[j].one);
+         master_pos_offsets.Append(j);
+      }
+      master_pos[j] = ldof_pos[j].two;
+   }
+   master_pos_offsets.Append(num_master);
+
+   const int num_msgs = vec_nbr_rank.Size();
+   vec_requests = new MPI_Request[2*num_msgs];
+   for (int i = 0; i < 2*num_msgs; i++)
+   {
+      vec_requests[i] = MPI_REQUEST_NULL;
+   }
+   SetupVectorRequests(1);
+
+   if (mode == byNeighborCollective) { SetupNeighborCollective(); }
+}
+
+void GroupCommunicator::SetMode(Mode m)
+{
+   MFEM_VERIFY(comm_lock == 0, "object is in use");
+
+   mode = m;
+   // buf_offsets is allocated in Finalize()
+   if (mode == byNeighborCollective && buf_offsets != NULL &&
+       coll_comm == MPI_COMM_NULL)
+   {
+      SetupNeighborCollective();
+   }
+}
+
+void GroupCommunicator::SetupNeighborCollective()
+{
+#if MPI_VERSION >= 3
+   coll_nbr.SetSize(0);
+   coll_master_counts.SetSize(0);
+   coll_master_displs.SetSize(0);
+   coll_slave_counts.SetSize(0);
+   coll_slave_displs.SetSize(0);
+   int master_size = 0, slave_size = 0;
+   for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
+   {
+      int send_size = 0, recv_size = 0;
+      const int num_send_groups = nbr_send_groups.RowSize(nbr);
+      const int *send_grp_list = nbr_send_groups.GetRow(nbr);
+      for (int i = 0; i < num_send_groups; i++)
+      {
+         send_size += group_ldof.RowSize(send_grp_list[i]);
+      }
+      const int num_recv_groups = nbr_recv_groups.RowSize(nbr);
+      const int *recv_grp_list = nbr_recv_groups.GetRow(nbr);
+      for (int i = 0; i < num_recv_groups; i++)
+      {
+         recv_size += group_ldof.RowSize(recv_grp_list[i]);
+      }
+      if (send_size == 0 && recv_size == 0) { continue; }
+
+      coll_nbr.Append(nbr);
+      coll_master_counts.Append(send_size);
+      coll_master_displs.Append(master_size);
+      coll_slave_counts.Append(recv_size);
+      coll_slave_displs.Append(slave_size);
+      master_size += send_size;
+      slave_size += recv_size;
+   }
+   coll_master_size = master_size;
+   MFEM_ASSERT(master_size + slave_size == group_buf_size, "");
+
+   // The graph is symmetric: the same neighbors are used as sources and
+   // destinations, in the Bcast and in the Reduce direction.
+   Array<int> nbr_ranks(coll_nbr.Size());
+   for (int k = 0; k < coll_nbr.Size(); k++)
+   {
+      nbr_ranks[k] = gtopo.GetNeighborRank(coll_nbr[k]);
+   }
+   MPI_Dist_graph_create_adjacent(gtopo.GetComm(),
+                                  nbr_ranks.Size(), nbr_ranks.GetData(),
+                                  MPI_UNWEIGHTED,
+                                  nbr_ranks.Size(), nbr_ranks.GetData(),
+                                  MPI_UNWEIGHTED,
+                                  MPI_INFO_NULL, 0, &coll_comm);
+#else
+   MFEM_ABORT("the byNeighborCollective mode requires MPI-3");
+#endif
+}
+
+void GroupCommunicator::SetupVectorRequests(int nvec) const
+{
+   const bool gpu_aware = Device::GetGPUAwareMPI();
+   if (nvec == vec_nvec && gpu_aware == vec_gpu_aware) { return; }
+
+   FreeVectorRequests();
+   master_buf.SetSize(nvec*nbr_master_ldof.Size());
+   slave_buf.SetSize(nvec*nbr_slave_ldof.Size());
+   double *m_buf = gpu_aware ? master_buf.Write() : master_buf.HostWrite();
+   double *s_buf = gpu_aware ? slave_buf.Write() : slave_buf.HostWrite();
+
+   // In the Reduce direction the roles of the send and receive messages are
+   // swapped, so each message buffer is used by two persistent requests.
+   const int num_msgs = vec_nbr_rank.Size();
+   MPI_Request *bcast_req = vec_requests, *reduce_req = vec_requests+num_msgs;
+   for (int i = 0; i < num_msgs; i++)
+   {
+      const bool master = (i < vec_num_sends);
+      double *buf = (master ? m_buf : s_buf) + nvec*vec_msg_offsets[2*i];
+      const int count = nvec*vec_msg_offsets[2*i+1];
+      const int rank = vec_nbr_rank[i];
+      if (master)
+      {
+         MPI_Send_init(buf, count, MPI_DOUBLE, rank, 40823, gtopo.GetComm(),
+                       &bcast_req[i]);
+         MPI_Recv_init(buf, count, MPI_DOUBLE, rank, 43823, gtopo.GetComm(),
+                       &reduce_req[i]);
+      }
+      else
+      {
+         MPI_Recv_init(buf, count, MPI_DOUBLE, rank, 40823, gtopo.GetComm(),
+                       &bcast_req[i]);
+         MPI_Send_init(buf, count, MPI_DOUBLE, rank, 43823, gtopo.GetComm(),
+                       &reduce_req[i]);
+      }
+   }
+   vec_nvec = nvec;
+   vec_gpu_aware = gpu_aware;
+}
+
+void GroupCommunicator::FreeVectorRequests() const
+{
+   if (vec_nvec == 0) { return; }
+
+   // The requests cannot be freed after MPI_Finalize, e.g. when this object
+   // is destroyed after the end of the MPI session.
+   int mpi_finalized;
+   MPI_Finalized(&mpi_finalized);
+   for (int i = 0; i < 2*vec_nbr_rank.Size(); i++)
+   {
+      if (!mpi_finalized && vec_requests[i] != MPI_REQUEST_NULL)
+      {
+         MPI_Request_free(&vec_requests[i]);
+      }
+      vec_requests[i] = MPI_REQUEST_NULL;
+   }
+   vec_nvec = 0;
 }
 
 void GroupCommunicator::SetLTDofTable(const Array<int> &ldof_ltdof)
@@ -824,6 +1022,35 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
          MFEM_ASSERT(buf - (T*)group_buf.GetData() == group_buf_size, "");
          break;
       }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+#if MPI_VERSION >= 3
+         group_buf.SetSize(group_buf_size*sizeof(T));
+         T *buf = (T *)group_buf.GetData();
+         for (int k = 0; k < coll_nbr.Size(); k++)
+         {
+            const int nbr = coll_nbr[k];
+            const int num_send_groups = nbr_send_groups.RowSize(nbr);
+            const int *grp_list = nbr_send_groups.GetRow(nbr);
+            for (int i = 0; i < num_send_groups; i++)
+            {
+               buf = CopyGroupToBuffer(ldata, buf, grp_list[i], layout);
+            }
+         }
+         T *master_buf = (T *)group_buf.GetData();
+         MPI_Ineighbor_alltoallv(master_buf,
+                                 coll_master_counts, coll_master_displs,
+                                 MPITypeMap<T>::mpi_type,
+                                 master_buf + coll_master_size,
+                                 coll_slave_counts, coll_slave_displs,
+                                 MPITypeMap<T>::mpi_type,
+                                 coll_comm,
+                                 &requests[0]);
+         request_counter = 1;
+#endif
+         break;
+      }
    }
 
    comm_lock = 1; // 1 - locked fot Bcast
@@ -886,6 +1113,24 @@ void GroupCommunicator::BcastEnd(T *ldata, int layout) const
          }
          break;
       }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+         MPI_Wait(&requests[0], MPI_STATUS_IGNORE);
+
+         const T *buf = (T*)group_buf.GetData() + coll_master_size;
+         for (int k = 0; k < coll_nbr.Size(); k++)
+         {
+            const int nbr = coll_nbr[k];
+            const int num_recv_groups = nbr_recv_groups.RowSize(nbr);
+            const int *grp_list = nbr_recv_groups.GetRow(nbr);
+            for (int i = 0; i < num_recv_groups; i++)
+            {
+               buf = CopyGroupFromBuffer(buf, ldata, grp_list[i], layout);
+            }
+         }
+         break;
+      }
    }
 
    comm_lock = 0; // 0 - no lock
@@ -1005,6 +1250,36 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
          MFEM_ASSERT(buf - (T*)group_buf.GetData() == group_buf_size, "");
          break;
       }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+#if MPI_VERSION >= 3
+         // In Reduce operation: send_groups <--> recv_groups
+         T *slave_buf = buf + coll_master_size;
+         buf = slave_buf;
+         for (int k = 0; k < coll_nbr.Size(); k++)
+         {
+            const int nbr = coll_nbr[k];
+            const int num_send_groups = nbr_recv_groups.RowSize(nbr);
+            const int *grp_list = nbr_recv_groups.GetRow(nbr);
+            for (int i = 0; i < num_send_groups; i++)
+            {
+               const int layout = 0; // ldata is an array on all ldofs
+               buf = CopyGroupToBuffer(ldata, buf, grp_list[i], layout);
+            }
+         }
+         MPI_Ineighbor_alltoallv(slave_buf,
+                                 coll_slave_counts, coll_slave_displs,
+                                 MPITypeMap<T>::mpi_type,
+                                 (T *)group_buf.GetData(),
+                                 coll_master_counts, coll_master_displs,
+                                 MPITypeMap<T>::mpi_type,
+                                 coll_comm,
+                                 &requests[0]);
+         request_counter = 1;
+#endif
+         break;
+      }
    }
 
    comm_lock = 2;
@@ -1075,6 +1350,26 @@ void GroupCommunicator::ReduceEnd(T *ldata, int layout,
          }
          break;
       }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+         MPI_Wait(&requests[0], MPI_STATUS_IGNORE);
+
+         // In Reduce operation: send_groups <--> recv_groups
+         const T *buf = (T*)group_buf.GetData();
+         for (int k = 0; k < coll_nbr.Size(); k++)
+         {
+            const int nbr = coll_nbr[k];
+            const int num_recv_groups = nbr_send_groups.RowSize(nbr);
+            const int *grp_list = nbr_send_groups.GetRow(nbr);
+            for (int i = 0; i < num_recv_groups; i++)
+            {
+               buf = ReduceGroupFromBuffer(buf, ldata, grp_list[i],
+                                           layout, Op);
+            }
+         }
+         break;
+      }
    }
 
    comm_lock = 0; // 0 - no lock
@@ -1164,7 +1459,7 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
    int num_sends = 0, num_recvs = 0;
    size_t mem_sends = 0, mem_recvs = 0;
    int num_master_groups = 0, num_empty_groups = 0;
-   int num_active_neighbors = 0; // for mode == byNeighbor
+   int num_active_neighbors = 0; // for mode != byGroup
    switch (mode)
    {
       case byGroup:
@@ -1191,6 +1486,7 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
          break;
 
       case byNeighbor:
+      case byNeighborCollective:
          for (int gr = 1; gr < group_ldof.Size(); gr++)
          {
             const int nldofs = group_ldof.RowSize(gr);
@@ -1245,7 +1541,8 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
    }
    out << "Rank " << myid << ":\n"
        "   mode             = " <<
-       (mode == byGroup ? "byGroup" : "byNeighbor") << "\n"
+       (mode == byGroup ? "byGroup" : mode == byNeighbor ? "byNeighbor" :
+        "byNeighborCollective") << "\n"
        "   number of sends  = " << num_sends <<
        " (" << mem_sends << " bytes)\n"
        "   number of recvs  = " << num_recvs <<
@@ -1255,7 +1552,7 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
        num_master_groups << " + " <<
        group_ldof.Size()-num_master_groups-num_empty_groups << " + " <<
        num_empty_groups << " (master + slave + empty)\n";
-   if (mode == byNeighbor)
+   if (mode != byGroup)
    {
       out <<
           "   num neighbors    = " << nbr_send_groups.Size() << " = " <<
@@ -1275,8 +1572,129 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
    MPI_Barrier(gtopo.GetComm());
 }
 
+void GroupCommunicator::BcastVectorsBegin(double *ldata, int vsize,
+                                          int nvec) const
+{
+   MFEM_VERIFY(comm_lock == 0, "object is already in use");
+
+   const int num_msgs = vec_nbr_rank.Size();
+   if (num_msgs == 0) { return; }
+
+   SetupVectorRequests(nvec);
+   const int n = nvec*nbr_master_ldof.Size();
+   const int *d_ldof = nbr_master_ldof.Read();
+   double *d_buf = master_buf.Write();
+   MFEM_FORALL(i, n,
+   {
+      d_buf[i] = ldata[(i % nvec)*vsize + d_ldof[i / nvec]];
+   });
+   if (vec_gpu_aware)
+   {
+      MFEM_STREAM_SYNC;
+      slave_buf.Write();
+   }
+   else
+   {
+      master_buf.HostRead();
+      slave_buf.HostWrite();
+   }
+   MPI_Startall(num_msgs, vec_requests);
+
+   comm_lock = 3; // 3 - locked for BcastVectors
+}
+
+void GroupCommunicator::BcastVectorsEnd(double *ldata, int vsize,
+                                        int nvec) const
+{
+   if (comm_lock == 0) { return; }
+   // The above also handles the case without neighbors.
+   MFEM_VERIFY(comm_lock == 3, "object is NOT locked for BcastVectors");
+   MFEM_VERIFY(nvec == vec_nvec, "invalid number of vectors");
+
+   MPI_Waitall(vec_nbr_rank.Size(), vec_requests, MPI_STATUSES_IGNORE);
+   const int n = nvec*nbr_slave_ldof.Size();
+   const int *d_ldof = nbr_slave_ldof.Read();
+   const double *d_buf = slave_buf.Read();
+   MFEM_FORALL(i, n,
+   {
+      ldata[(i % nvec)*vsize + d_ldof[i / nvec]] = d_buf[i];
+   });
+
+   comm_lock = 0; // 0 - no lock
+}
+
+void GroupCommunicator::ReduceVectorsBegin(const double *ldata, int vsize,
+                                           int nvec) const
+{
+   MFEM_VERIFY(comm_lock == 0, "object is already in use");
+
+   const int num_msgs = vec_nbr_rank.Size();
+   if (num_msgs == 0) { return; }
+
+   SetupVectorRequests(nvec);
+   const int n = nvec*nbr_slave_ldof.Size();
+   const int *d_ldof = nbr_slave_ldof.Read();
+   double *d_buf = slave_buf.Write();
+   MFEM_FORALL(i, n,
+   {
+      d_buf[i] = ldata[(i % nvec)*vsize + d_ldof[i / nvec]];
+   });
+   if (vec_gpu_aware)
+   {
+      MFEM_STREAM_SYNC;
+      master_buf.Write();
+   }
+   else
+   {
+      slave_buf.HostRead();
+      master_buf.HostWrite();
+   }
+   MPI_Startall(num_msgs, vec_requests + num_msgs);
+
+   comm_lock = 4; // 4 - locked for ReduceVectors
+}
+
+void GroupCommunicator::ReduceVectorsEnd(double *ldata, int vsize,
+                                         int nvec) const
+{
+   if (comm_lock == 0) { return; }
+   // The above also handles the case without neighbors.
+   MFEM_VERIFY(comm_lock == 4, "object is NOT locked for ReduceVectors");
+   MFEM_VERIFY(nvec == vec_nvec, "invalid number of vectors");
+
+   const int num_msgs = vec_nbr_rank.Size();
+   MPI_Waitall(num_msgs, vec_requests + num_msgs, MPI_STATUSES_IGNORE);
+   // Each thread sums all contributions to one master ldof, so the result
+   // does not depend on the order in which the messages arrive.
+   const int n = nvec*master_ldof.Size();
+   const int *d_ldof = master_ldof.Read();
+   const int *d_offsets = master_pos_offsets.Read();
+   const int *d_pos = master_pos.Read();
+   const double *d_buf = master_buf.Read();
+   MFEM_FORALL(i, n,
+   {
+      const int u = i / nvec, v = i % nvec;
+      double sum = 0.0;
+      for (int k = d_offsets[u]; k < d_offsets[u+1]; k++)
+      {
+         sum += d_buf[nvec*d_pos[k] + v];
+      }
+      ldata[v*vsize + d_ldof[u]] += sum;
+   });
+
+   comm_lock = 0; // 0 - no lock
+}
+
 GroupCommunicator::~GroupCommunicator()
 {
+   FreeVectorRequests();
+   delete [] vec_requests;
+   if (coll_comm != MPI_COMM_NULL)
+   {
+      int mpi_finalized;
+      MPI_Finalized(&mpi_finalized);
+      if (!mpi_finalized) { MPI_Comm_free(&coll_comm); }
+   }
    delete [] buf_offsets;
    delete [] request_marker;
    // delete [] statuses;
@@ -146,8 +146,11 @@ public:
    enum Mode
    {
       byGroup,    ///< Communications are performed one group at a time.
-      byNeighbor  /**< Communications are performed one neighbor at a time,
+      byNeighbor, /**< Communications are performed one neighbor at a time,
                        aggregating over groups. */
+      byNeighborCollective /**< Communications are performed with one MPI-3
+                                neighborhood collective on a distributed graph
+                                communicator, aggregating over groups. */
    };
 
 protected:
@@ -159,13 +162,52 @@ protected:
    mutable Array<char> group_buf;
    MPI_Request *requests;
    // MPI_Status  *statuses;
-   // comm_lock: 0 - no lock, 1 - locked for Bcast, 2 - locked for Reduce
+   // comm_lock: 0 - no lock, 1 - locked for Bcast, 2 - locked for Reduce,
+   //            3 - locked for BcastVectors, 4 - locked for ReduceVectors
    mutable int comm_lock;
    mutable int num_requests;
    int *request_marker;
    int *buf_offsets; // size = max(number of groups, number of neighbors)
    Table nbr_send_groups, nbr_recv_groups; // nbr 0 = me
 
+   // Data for the byNeighborCollective mode: the distributed graph
+   // communicator, the neighbors in the graph and, for each of them, the
+   // sizes and the offsets of the master and slave parts of group_buf. The
+   // master part (groups in nbr_send_groups) comes first.
+   MPI_Comm coll_comm;
+   Array<int> coll_nbr;
+   Array<int> coll_master_counts, coll_master_displs;
+   Array<int> coll_slave_counts, coll_slave_displs;
+   int coll_master_size;
+
+   // Data for the multi-vector operations BcastVectorsBegin(), etc. The ldofs
+   // of the groups in nbr_send_groups (master ldofs) and nbr_recv_groups
+   // (slave ldofs) of all neighbors, concatenated in the message order.
+   Array<int> nbr_master_ldof, nbr_slave_ldof;
+   // Unique ldofs in nbr_master_ldof and, for each of them, the list of its
+   // positions in nbr_master_ldof (CSR format), used by ReduceVectorsEnd().
+   Array<int> master_ldof, master_pos_offsets, master_pos;
+   // Neighbor ranks and message sizes (for one vector) of the multi-vector
+   // operations, sends first, then receives (in the Bcast direction).
+   Array<int> vec_nbr_rank, vec_msg_offsets;
+   int vec_num_sends;
+   // Persistent MPI requests for BcastVectors (first half) and ReduceVectors
+   // (second half), created for vec_nvec vectors bound to the buffers below.
+   MPI_Request *vec_requests;
+   mutable int vec_nvec;
+   mutable bool vec_gpu_aware;
+   mutable Array<double> master_buf, slave_buf;
+
+   /** @brief Create the persistent requests for the multi-vector operations
+       with @a nvec vectors, unless they already exist. */
+   void SetupVectorRequests(int nvec) const;
+
+   /// Free the persistent requests for the multi-vector operations.
+   void FreeVectorRequests() const;
+
+   /// Create the distributed graph communicator for byNeighborCollective.
+   void SetupNeighborCollective();
+
 public:
    /// Construct a GroupCommunicator object.
    /** The object must be initialized before it can be used to perform any
@@ -188,8 +230,22 @@ public:
    const Table &GroupLDofTable() const { return group_ldof; }
 
    /// Allocate internal buffers after the GroupLDofTable is defined
+   /** In the byNeighborCollective mode, this method is collective over the
+       communicator of the GroupTopology. */
    void Finalize();
 
+   /// Get the communication mode.
+   Mode GetMode() const { return mode; }
+
+   /** @brief Set the communication mode used by the Bcast and Reduce
+       operations. */
+   /** Switching to the byNeighborCollective mode after Finalize() creates the
+       distributed graph communicator, so in this case the call is collective
+       over the communicator of the GroupTopology. The multi-vector operations,
+       see BcastVectorsBegin(), use persistent point-to-point requests in all
+       modes. */
+   void SetMode(Mode m);
+
    /// Initialize the internal group_ltdof Table.
    /** This method must be called before performing operations that use local
        data layout 2, see CopyGroupToBuffer() for layout descriptions. */
@@ -327,6 +383,46 @@ public:
    /// Reduce operation bitwise OR, instantiated for int only
    template <class T> static void BitOR(OpData<T>);
 
+   /** @brief Begin a broadcast within each group of the @a nvec vectors of
+       size @a vsize stored consecutively in @a ldata. */
+   /** The data of each vector uses layout 0, see CopyGroupToBuffer(). The
+       data of all vectors is aggregated into one message per neighbor that is
+       sent using persistent MPI requests, created in Finalize() and re-created
+       only when @a nvec changes. The packing and unpacking of the messages is
+       performed on the device, so @a ldata must be a pointer returned by the
+       Read(), Write() or ReadWrite() methods of Vector or Array, e.g.
+       `x.ReadWrite()`. If MPI is GPU-aware, see Device::SetGPUAwareMPI(), the
+       messages are sent directly from device memory. */
+   void BcastVectorsBegin(double *ldata, int vsize, int nvec = 1) const;
+
+   /// Finalize a broadcast started with BcastVectorsBegin().
+   void BcastVectorsEnd(double *ldata, int vsize, int nvec = 1) const;
+
+   /// Broadcast within each group of multiple vectors, see BcastVectorsBegin().
+   void BcastVectors(double *ldata, int vsize, int nvec = 1) const
+   {
+      BcastVectorsBegin(ldata, vsize, nvec);
+      BcastVectorsEnd(ldata, vsize, nvec);
+   }
+
+   /** @brief Begin a sum reduction within each group of the @a nvec vectors of
+       size @a vsize stored consecutively in @a ldata. */
+   /** The input data of each vector uses layout 0, see CopyGroupToBuffer().
+       See BcastVectorsBegin() for the requirements on @a ldata. */
+   void ReduceVectorsBegin(const double *ldata, int vsize, int nvec = 1) const;
+
+   /** @brief Finalize a sum reduction started with ReduceVectorsBegin(),
+       adding the received values to the master ldofs in @a ldata. */
+   void ReduceVectorsEnd(double *ldata, int vsize, int nvec = 1) const;
+
+   /** @brief Sum reduction within each group of multiple vectors, see
+       ReduceVectorsBegin(). */
+   void ReduceVectors(double *ldata, int vsize, int nvec = 1) const
+   {
+      ReduceVectorsBegin(ldata, vsize, nvec);
+      ReduceVectorsEnd(ldata, vsize, nvec);
+   }
+
    /// Print information about the GroupCommunicator from all MPI ranks.
    void PrintInfo(std::ostream &out = mfem::out) const;
 
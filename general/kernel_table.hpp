@@ -0,0 +1,65 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_KERNEL_TABLE_HPP
+#define MFEM_KERNEL_TABLE_HPP
+
+#include "../config/config.hpp"
+#include "error.hpp"
+#include <unordered_map>
+
+// List of additional (dim, D1D, Q1D) specializations of the tensor-product
+// partial assembly kernels, requested at build time with MFEM_PA_KERNELS, see
+// INSTALL. It expands to a sequence of MFEM_PA_KERNEL(dim, D1D, Q1D) entries.
+#ifndef MFEM_PA_KERNEL_SPECS
+#define MFEM_PA_KERNEL_SPECS
+#endif
+
+namespace mfem
+{
+
+/** @brief Table of compile-time specializations of a tensor-product kernel,
+    indexed by the dimension and the 1D numbers of dofs and quadrature points.
+
+    The PA dispatchers look up the table and fall back to a generic kernel
+    with runtime bounds when no specialization was registered, so that the set
+    of specialized sizes can be extended without editing the dispatchers. */
+template <typename Kernel>
+class KernelTable
+{
+private:
+   std::unordered_map<int, Kernel> table;
+
+   static int Key(const int dim, const int D1D, const int Q1D)
+   {
+      MFEM_ASSERT(D1D < 256 && Q1D < 256, "invalid kernel size");
+      return (dim << 16) | (D1D << 8) | Q1D;
+   }
+
+public:
+   /// Register the @a kernel specialized for the given sizes.
+   void Add(const int dim, const int D1D, const int Q1D, Kernel kernel)
+   { table[Key(dim, D1D, Q1D)] = kernel; }
+
+   /// Return the specialized kernel, or NULL if there is none.
+   Kernel Find(const int dim, const int D1D, const int Q1D) const
+   {
+      auto it = table.find(Key(dim, D1D, Q1D));
+      return (it == table.end()) ? NULL : it->second;
+   }
+
+   /// Return the number of registered specializations.
+   int Size() const { return table.size(); }
+};
+
+} // namespace mfem
+
+#endif // MFEM_KERNEL_TABLE_HPP
@@ -38,7 +38,11 @@ protected:
       RectangularConstrainedOperator* &Aout);
 
    /// Returns RAP Operator of this, taking in input/output Prolongation matrices
-   Operator *SetupRAP(const Operator *Pi, const Operator *Po);
+   /** Derived classes can override this method to return a specialized
+       operator with the same action, e.g. one that overlaps the communication
+       in @a Pi and @a Po with local work. The returned operator is owned by
+       the caller, unless it is this Operator. */
+   virtual Operator *SetupRAP(const Operator *Pi, const Operator *Po);
 
 public:
    /// Defines operator diagonal policy upon elimination of rows and/or columns.
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <iomanip>
 #include <limits>
 #include <cmath>
 #include <cstring>
@@ -761,6 +762,12 @@ const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
       GeometricFactors *gf = geom_factors[i];
       if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags)
       {
+         if (gf->nodes_sequence != nodes_sequence)
+         {
+            // The nodes have moved: recompute in the existing storage
+            this->EnsureNodes();
+            gf->Compute();
+         }
          return gf;
       }
    }
@@ -772,6 +779,60 @@ const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
    return gf;
 }
 
+const GeometricFactors* Mesh::GetAffineGeometricFactors(const int flags)
+{
+   if (GetNE() == 0 || GetNumGeometries(Dim) > 1 || !IsAffine())
+   {
+      return NULL;
+   }
+   // The Jacobians are constant in each element, so they are evaluated at a
+   // single point
+   const Geometry::Type geom = GetElementBaseGeometry(0);
+   return GetGeometricFactors(IntRules.Get(geom, 0), flags);
+}
+
+bool Mesh::IsAffine()
+{
+   if (affine_sequence == sequence && affine_nodes_sequence == nodes_sequence)
+   {
+      return affine;
+   }
+   affine_sequence = sequence;
+   affine_nodes_sequence = nodes_sequence;
+   affine = false;
+   if (NURBSext) { return false; }
+   IsoparametricTransformation T;
+   Vector xc;
+   for (int e = 0; e < GetNE(); e++)
+   {
+      GetElementTransformation(e, &T);
+      const FiniteElement *fe = T.GetFE();
+      if (dynamic_cast<const NodalFiniteElement*>(fe) == NULL) { return false; }
+      // Compare the nodes of the element with the affine map defined by the
+      // Jacobian and the image of the center of the reference element
+      const IntegrationPoint &c = Geometries.GetCenter(fe->GetGeomType());
+      T.SetIntPoint(&c);
+      T.Transform(c, xc);
+      const DenseMatrix &J = T.Jacobian();
+      const DenseMatrix &pm = T.GetPointMat();
+      const IntegrationRule &nodes = fe->GetNodes();
+      const double tol = 1e-12 * J.MaxMaxNorm();
+      for (int i = 0; i < nodes.GetNPoints(); i++)
+      {
+         const IntegrationPoint &ip = nodes.IntPoint(i);
+         const double dxi[3] = { ip.x - c.x, ip.y - c.y, ip.z - c.z };
+         for (int d = 0; d < J.Height(); d++)
+         {
+            double x = xc(d);
+            for (int k = 0; k < J.Width(); k++) { x += J(d,k) * dxi[k]; }
+            if (fabs(x - pm(d,i)) > tol) { return false; }
+         }
+      }
+   }
+   affine = true;
+   return true;
+}
+
 const FaceGeometricFactors* Mesh::GetFaceGeometricFactors(
    const IntegrationRule& ir,
    const int flags, FaceType type)
@@ -782,6 +843,12 @@ const FaceGeometricFactors* Mesh::GetFaceGeometricFactors(
       if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags &&
           gf->type==type)
       {
+         if (gf->nodes_sequence != nodes_sequence)
+         {
+            // The nodes have moved: recompute in the existing storage
+            this->EnsureNodes();
+            gf->Compute();
+         }
          return gf;
       }
    }
@@ -1063,6 +1130,8 @@ void Mesh::Init()
    nbBoundaryFaces = -1;
    meshgen = mesh_geoms = 0;
    sequence = 0;
+   nodes_sequence = 0;
+   affine_sequence = affine_nodes_sequence = -1;
    Nodes = NULL;
    own_nodes = 1;
    NURBSext = NULL;
@@ -1159,6 +1228,7 @@ void Mesh::ResetLazyData()
    delete face_edge;    face_edge = NULL;
    delete edge_vertex;  edge_vertex = NULL;
    DeleteGeometricFactors();
+   affine_sequence = -1;
    nbInteriorFaces = -1;
    nbBoundaryFaces = -1;
 }
@@ -1708,6 +1778,7 @@ void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
       return;
    }
    MFEM_VERIFY(ordering.Size() == GetNE(), "invalid reordering array.")
+   RestoreTopologyTables();
 
    // Data members that need to be updated:
 
@@ -1845,6 +1916,24 @@ void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
    }
 }
 
+void Mesh::ReorderElementsForLocality(bool use_gecko)
+{
+   if (NURBSext || ncmesh) { return; }
+
+   Array<int> ordering;
+   if (use_gecko)
+   {
+      GetGeckoElementOrdering(ordering);
+   }
+   else
+   {
+      GetHilbertElementOrdering(ordering);
+   }
+   // The edges and faces are regenerated by ReorderElements in the order of
+   // the new elements, see GetElementToEdgeTable and GetElementToFaceTable.
+   ReorderElements(ordering, true);
+}
+
 
 void Mesh::MarkForRefinement()
 {
@@ -2423,6 +2512,8 @@ void Mesh::Finalize(bool refine, bool fix_orientation)
    //  2) if (Nodes == NULL), vertices must be defined
    //  3) if (Nodes != NULL), Nodes must be defined
 
+   RestoreTopologyTables();
+
    const bool check_orientation = true; // for regular elements, not boundary
    const bool curved = (Nodes != NULL);
    const bool may_change_topology =
@@ -2458,7 +2549,10 @@ void Mesh::Finalize(bool refine, bool fix_orientation)
       }
       else
       {
-         FinalizeTopology(); // Re-computes some data unnecessarily.
+         // Re-computes some data unnecessarily. The boundary is not generated
+         // again: it was either given or generated by the first call, and a
+         // ParMesh rank may legitimately have no boundary elements.
+         FinalizeTopology(false);
       }
 
       // TODO: maybe introduce Mesh::NODE_REORDER operation and FESpace::
@@ -2961,6 +3055,8 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
 
    // Create the new Mesh instance without a record of its refinement history
    sequence = 0;
+   nodes_sequence = 0;
+   affine_sequence = affine_nodes_sequence = -1;
    last_operation = Mesh::NONE;
 
    // Duplicate the elements
@@ -3331,6 +3427,11 @@ void Mesh::Loader(std::istream &input, int generate_edges,
    {
       ReadVTKMesh(input, curved, read_gf, finalize_topo);
    }
+   else if (mesh_type.rfind("<VTKFile ", 0) == 0 ||
+            mesh_type.rfind("<?xml", 0) == 0) // VTK XML (.vtu)
+   {
+      ReadXML_VTKMesh(input, curved, read_gf, finalize_topo, mesh_type);
+   }
    else if (mesh_type == "MFEM NURBS mesh v1.0")
    {
       ReadNURBSMesh(input, curved, read_gf);
@@ -4447,6 +4548,8 @@ int Mesh::CheckBdrElementOrientation(bool fix_it)
 {
    int wo = 0; // count wrong orientations
 
+   RestoreTopologyTables();
+
    if (Dim == 2)
    {
       if (el_to_edge == NULL) // edges were not generated
@@ -4580,6 +4683,7 @@ void Mesh::GetGeometries(int dim, Array<Geometry::Type> &el_geoms) const
 
 void Mesh::GetElementEdges(int i, Array<int> &edges, Array<int> &cor) const
 {
+   if (el_to_edge == NULL && Dim > 1) { BuildElementToEdgeTable(); }
    if (el_to_edge)
    {
       el_to_edge->GetRow(i, edges);
@@ -4612,6 +4716,10 @@ void Mesh::GetBdrElementEdges(int i, Array<int> &edges, Array<int> &cor) const
    }
    else if (Dim == 3)
    {
+      if (bel_to_edge == NULL && el_to_edge == NULL)
+      {
+         BuildElementToEdgeTable();
+      }
       if (bel_to_edge)
       {
          bel_to_edge->GetRow(i, edges);
@@ -4799,6 +4907,7 @@ const
 {
    int n, j;
 
+   if (el_to_face == NULL && Dim == 3) { BuildElementToFaceTable(); }
    if (el_to_face)
    {
       el_to_face->GetRow(i, fcs);
@@ -5070,6 +5179,7 @@ const Table & Mesh::ElementToElementTable()
 
 const Table & Mesh::ElementToFaceTable() const
 {
+   if (el_to_face == NULL && Dim == 3) { BuildElementToFaceTable(); }
    if (el_to_face == NULL)
    {
       mfem_error("Mesh::ElementToFaceTable()");
@@ -5079,6 +5189,7 @@ const Table & Mesh::ElementToFaceTable() const
 
 const Table & Mesh::ElementToEdgeTable() const
 {
+   if (el_to_edge == NULL && Dim > 1) { BuildElementToEdgeTable(); }
    if (el_to_edge == NULL)
    {
       mfem_error("Mesh::ElementToEdgeTable()");
@@ -5086,6 +5197,218 @@ const Table & Mesh::ElementToEdgeTable() const
    return *el_to_edge;
 }
 
+void Mesh::BuildElementToEdgeTable() const
+{
+   MFEM_ASSERT(el_to_edge == NULL && Dim > 1, "");
+
+   // GetVertexToVertexTable uses edge_vertex, if present, so that the edges
+   // keep the numbering they had when the table was released.
+   DSTable v_to_v(NumOfVertices);
+   GetVertexToVertexTable(v_to_v);
+   MFEM_VERIFY(v_to_v.NumberOfEntries() == NumOfEdges,
+               "the edge numbering could not be restored");
+
+   el_to_edge = new Table;
+   GetElementArrayEdgeTable(elements, v_to_v, *el_to_edge);
+   if (Dim == 3)
+   {
+      delete bel_to_edge;
+      bel_to_edge = new Table;
+      GetElementArrayEdgeTable(boundary, v_to_v, *bel_to_edge);
+   }
+}
+
+void Mesh::BuildElementToFaceTable() const
+{
+   MFEM_ASSERT(el_to_face == NULL && Dim == 3, "");
+
+   // Recover the table from faces_info: every face of a conforming mesh is
+   // listed there together with its local index in the adjacent elements.
+   el_to_face = new Table;
+   el_to_face->MakeI(NumOfElements);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      el_to_face->AddColumnsInRow(i, elements[i]->GetNFaces());
+   }
+   el_to_face->MakeJ(); // now I[i] is the offset of row i
+   const int *I = el_to_face->GetI();
+   int *J = el_to_face->GetJ();
+   for (int f = 0; f < NumOfFaces; f++)
+   {
+      const FaceInfo &fi = faces_info[f];
+      J[I[fi.Elem1No] + fi.Elem1Inf/64] = f;
+      if (fi.Elem2No >= 0)
+      {
+         J[I[fi.Elem2No] + fi.Elem2Inf/64] = f;
+      }
+   }
+}
+
+void Mesh::RestoreTopologyTables() const
+{
+   if (el_to_edge == NULL && Dim > 1 && NumOfEdges > 0)
+   {
+      BuildElementToEdgeTable();
+   }
+   if (el_to_face == NULL && Dim == 3 && NumOfFaces > 0)
+   {
+      BuildElementToFaceTable();
+   }
+}
+
+static void VerifyReleasable(const Mesh *mesh)
+{
+   MFEM_VERIFY(mesh->Conforming() && !mesh->NURBSext,
+               "releasing topology tables requires a conforming, non-NURBS "
+               "mesh");
+#ifdef MFEM_USE_MPI
+   MFEM_VERIFY(dynamic_cast<const ParMesh*>(mesh) == NULL,
+               "releasing topology tables is not supported in parallel");
+#else
+   MFEM_CONTRACT_VAR(mesh);
+#endif
+}
+
+void Mesh::ReleaseElementToEdgeTable()
+{
+   VerifyReleasable(this);
+   if (el_to_edge == NULL) { return; }
+
+   GetEdgeVertexTable(); // defines the edge numbering from now on
+   delete el_to_edge;
+   el_to_edge = NULL;
+   if (Dim == 3)
+   {
+      delete bel_to_edge;
+      bel_to_edge = NULL;
+   }
+}
+
+void Mesh::ReleaseElementToFaceTable()
+{
+   VerifyReleasable(this);
+   delete el_to_face;
+   el_to_face = NULL;
+}
+
+void Mesh::ReleaseElementToElementTable()
+{
+   delete el_to_el;
+   el_to_el = NULL;
+}
+
+void Mesh::ReleaseFaceToEdgeTable()
+{
+   delete face_edge;
+   face_edge = NULL;
+}
+
+static long TableMemoryUsage(const Table *table)
+{
+   return table ? table->MemoryUsage() : 0;
+}
+
+static long ElementArrayMemoryUsage(const Array<Element*> &elements)
+{
+   long mem = elements.MemoryUsage();
+   for (int i = 0; i < elements.Size(); i++)
+   {
+      if (!elements[i]) { continue; }
+      switch (elements[i]->GetType())
+      {
+         case Element::POINT:         mem += sizeof(Point); break;
+         case Element::SEGMENT:       mem += sizeof(Segment); break;
+         case Element::TRIANGLE:      mem += sizeof(Triangle); break;
+         case Element::QUADRILATERAL: mem += sizeof(Quadrilateral); break;
+         case Element::TETRAHEDRON:   mem += sizeof(Tetrahedron); break;
+         case Element::HEXAHEDRON:    mem += sizeof(Hexahedron); break;
+         case Element::WEDGE:         mem += sizeof(Wedge); break;
+         default: break;
+      }
+   }
+   return mem;
+}
+
+static long GeometricFactorsMemoryUsage(const Array<GeometricFactors*> &gf)
+{
+   long mem = gf.MemoryUsage();
+   for (int i = 0; i < gf.Size(); i++)
+   {
+      mem += (gf[i]->X.Size() + gf[i]->J.Size() + gf[i]->detJ.Size())
+             * sizeof(double);
+   }
+   return mem;
+}
+
+long Mesh::MemoryUsage() const
+{
+   return vertices.MemoryUsage() +
+          ElementArrayMemoryUsage(elements) +
+          ElementArrayMemoryUsage(boundary) +
+          ElementArrayMemoryUsage(faces) +
+          faces_info.MemoryUsage() +
+          nc_faces_info.MemoryUsage() +
+          TableMemoryUsage(el_to_edge) +
+          TableMemoryUsage(el_to_face) +
+          TableMemoryUsage(el_to_el) +
+          be_to_edge.MemoryUsage() +
+          TableMemoryUsage(bel_to_edge) +
+          be_to_face.MemoryUsage() +
+          TableMemoryUsage(face_edge) +
+          TableMemoryUsage(edge_vertex) +
+          GeometricFactorsMemoryUsage(geom_factors) +
+          (Nodes ? Nodes->Size()*sizeof(double) : 0) +
+          (ncmesh ? ncmesh->MemoryUsage() : 0) +
+          sizeof(*this);
+}
+
+void Mesh::PrintMemoryUsage(std::ostream &out) const
+{
+   static const double MiB = 1024.*1024.;
+   struct Entry { const char *name; long count, mem; };
+   const Entry entries[] =
+   {
+      { "vertices", NumOfVertices, vertices.MemoryUsage() },
+      { "elements", NumOfElements, ElementArrayMemoryUsage(elements) },
+      { "boundary elements", NumOfBdrElements,
+        ElementArrayMemoryUsage(boundary) },
+      { "faces", faces.Size(), ElementArrayMemoryUsage(faces) },
+      { "faces_info", faces_info.Size(), faces_info.MemoryUsage() },
+      { "nc_faces_info", nc_faces_info.Size(), nc_faces_info.MemoryUsage() },
+      { "el_to_edge", el_to_edge ? el_to_edge->Size() : 0,
+        TableMemoryUsage(el_to_edge) },
+      { "el_to_face", el_to_face ? el_to_face->Size() : 0,
+        TableMemoryUsage(el_to_face) },
+      { "el_to_el", el_to_el ? el_to_el->Size() : 0,
+        TableMemoryUsage(el_to_el) },
+      { "be_to_edge", be_to_edge.Size(), be_to_edge.MemoryUsage() },
+      { "bel_to_edge", bel_to_edge ? bel_to_edge->Size() : 0,
+        TableMemoryUsage(bel_to_edge) },
+      { "be_to_face", be_to_face.Size(), be_to_face.MemoryUsage() },
+      { "face_edge", face_edge ? face_edge->Size() : 0,
+        TableMemoryUsage(face_edge) },
+      { "edge_vertex", edge_vertex ? edge_vertex->Size() : 0,
+        TableMemoryUsage(edge_vertex) },
+      { "geom_factors", geom_factors.Size(),
+        GeometricFactorsMemoryUsage(geom_factors) },
+      { "Nodes", Nodes ? Nodes->Size() : 0,
+        Nodes ? long(Nodes->Size()*sizeof(double)) : 0 },
+      { "ncmesh", ncmesh ? 1 : 0, ncmesh ? ncmesh->MemoryUsage() : 0 }
+   };
+
+   out << "Mesh memory usage:\n"
+       "------------------\n";
+   for (const Entry &e : entries)
+   {
+      out << "   " << std::left << std::setw(18) << e.name << std::right
+          << ": " << std::setw(10) << e.count << "  [ " << std::setw(10)
+          << e.mem/MiB << " MiB ]\n";
+   }
+   out << "   " << std::left << std::setw(18) << "total" << std::right
+       << ": " << std::setw(10) << " " << "  [ " << std::setw(10)
+       << MemoryUsage()/MiB << " MiB ]" << std::endl;
+}
+
 void Mesh::AddPointFaceElement(int lf, int gf, int el)
 {
    if (faces_info[gf].Elem1No == -1)  // this will be elem1
@@ -5493,6 +5816,7 @@ void Mesh::ReorientTetMesh()
       return;
    }
 
+   RestoreTopologyTables();
    ResetLazyData();
 
    DSTable *old_v_to_v = NULL;
@@ -6385,6 +6709,7 @@ void Mesh::MoveVertices(const Vector &displacements)
       {
          vertices[i](j) += displacements(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetVertices(Vector &vert_coord) const
@@ -6405,6 +6730,7 @@ void Mesh::SetVertices(const Vector &vert_coord)
       {
          vertices[i](j) = vert_coord(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetNode(int i, double *coord) const
@@ -6444,6 +6770,7 @@ void Mesh::SetNode(int i, const double *coord)
       }
 
    }
+   NodesUpdated();
 }
 
 void Mesh::MoveNodes(const Vector &displacements)
@@ -6456,6 +6783,7 @@ void Mesh::MoveNodes(const Vector &displacements)
    {
       MoveVertices(displacements);
    }
+   NodesUpdated();
 }
 
 void Mesh::GetNodes(Vector &node_coord) const
@@ -6480,6 +6808,7 @@ void Mesh::SetNodes(const Vector &node_coord)
    {
       SetVertices(node_coord);
    }
+   NodesUpdated();
 }
 
 void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
@@ -6494,12 +6823,14 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
       delete NURBSext;
       NURBSext = nodes.FESpace()->StealNURBSext();
    }
+   NodesUpdated();
 }
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
 {
    mfem::Swap<GridFunction*>(Nodes, nodes);
    mfem::Swap<int>(own_nodes, own_nodes_);
+   NodesUpdated();
    // TODO:
    // if (nodes)
    //    nodes->FESpace()->MakeNURBSextOwner();
@@ -6534,6 +6865,7 @@ void Mesh::UpdateNodes()
       Nodes->FESpace()->Update();
       Nodes->Update();
    }
+   NodesUpdated();
 }
 
 void Mesh::UniformRefinement2D_base(bool update_nodes)
@@ -7292,6 +7624,7 @@ void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
    int i, j, ind, nedges;
    Array<int> v;
 
+   RestoreTopologyTables();
    ResetLazyData();
 
    if (ncmesh)
@@ -7535,6 +7868,7 @@ void Mesh::NonconformingRefinement(const Array<Refinement> &refinements,
    MFEM_VERIFY(!NURBSext, "Nonconforming refinement of NURBS meshes is "
                "not supported. Project the NURBS to Nodes first.");
 
+   RestoreTopologyTables();
    ResetLazyData();
 
    if (!ncmesh)
@@ -7753,6 +8087,11 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    mfem::Swap(bdr_attributes, other.bdr_attributes);
 
    mfem::Swap(geom_factors, other.geom_factors);
+   mfem::Swap(nodes_sequence, other.nodes_sequence);
+   // The geometry of both meshes has changed
+   NodesUpdated();
+   other.NodesUpdated();
+   affine_sequence = other.affine_sequence = -1;
 
 #ifdef MFEM_USE_MEMALLOC
    TetMemory.Swap(other.TetMemory);
@@ -7807,6 +8146,8 @@ void Mesh::UniformRefinement(int ref_algo)
 {
    Array<int> list;
 
+   RestoreTopologyTables();
+
    if (NURBSext)
    {
       NURBSUniformRefinement();
@@ -10149,6 +10490,7 @@ void Mesh::Transform(void (*f)(const Vector&, Vector&))
       xnew.ProjectCoefficient(f_pert);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::Transform(VectorCoefficient &deformation)
@@ -10173,6 +10515,7 @@ void Mesh::Transform(VectorCoefficient &deformation)
       xnew.ProjectCoefficient(deformation);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::RemoveUnusedVertices()
@@ -10286,6 +10629,8 @@ void Mesh::RemoveInternalBoundaries()
 {
    if (NURBSext || ncmesh) { return; }
 
+   RestoreTopologyTables();
+
    int num_bdr_elem = 0;
    int new_bel_to_edge_nnz = 0;
    for (int i = 0; i < GetNBE(); i++)
@@ -10516,7 +10861,13 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    this->mesh = mesh;
    IntRule = &ir;
    computed_factors = flags;
+   Compute();
+}
 
+void GeometricFactors::Compute()
+{
+   const IntegrationRule &ir = *IntRule;
+   const int flags = computed_factors;
    const GridFunction *nodes = mesh->GetNodes();
    const FiniteElementSpace *fespace = nodes->FESpace();
    const FiniteElement *fe = fespace->GetFE(0);
@@ -10526,10 +10877,6 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    const int ND   = fe->GetDof();
    const int NQ   = ir.GetNPoints();
 
-   // For now, we are not using tensor product evaluation
-   const Operator *elem_restr = fespace->GetElementRestriction(
-                                   ElementDofOrdering::NATIVE);
-
    unsigned eval_flags = 0;
    if (flags & GeometricFactors::COORDINATES)
    {
@@ -10548,9 +10895,12 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    }
 
    const QuadratureInterpolator *qi = fespace->GetQuadratureInterpolator(ir);
-   // For now, we are not using tensor product evaluation (not implemented)
-   qi->DisableTensorProducts();
    qi->SetOutputLayout(QVectorLayout::byNODES);
+   // Quads and hexes use sum factorization, with lexicographic E-vectors
+   const ElementDofOrdering e_ordering = qi->UsesTensorProducts() ?
+                                         ElementDofOrdering::LEXICOGRAPHIC :
+                                         ElementDofOrdering::NATIVE;
+   const Operator *elem_restr = fespace->GetElementRestriction(e_ordering);
    if (elem_restr)
    {
       Vector Enodes(vdim*ND*NE);
@@ -10561,6 +10911,7 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    {
       qi->Mult(*nodes, eval_flags, X, J, detJ);
    }
+   nodes_sequence = mesh->GetNodesSequence();
 }
 
 FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
@@ -10571,7 +10922,13 @@ FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
    this->mesh = mesh;
    IntRule = &ir;
    computed_factors = flags;
+   Compute();
+}
 
+void FaceGeometricFactors::Compute()
+{
+   const IntegrationRule &ir = *IntRule;
+   const int flags = computed_factors;
    const GridFunction *nodes = mesh->GetNodes();
    const FiniteElementSpace *fespace = nodes->FESpace();
    const int vdim = fespace->GetVDim();
@@ -10610,6 +10967,7 @@ FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
    const FaceQuadratureInterpolator *qi = fespace->GetFaceQuadratureInterpolator(
                                              ir, type);
    qi->Mult(Fnodes, eval_flags, X, J, detJ, normal);
+   nodes_sequence = mesh->GetNodesSequence();
 }
 
 NodeExtrudeCoefficient::NodeExtrudeCoefficient(const int dim, const int _n,
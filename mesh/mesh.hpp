@@ -82,6 +82,11 @@ protected:
    // Mesh, such as FiniteElementSpace, GridFunction, etc.
    long sequence;
 
+   // Counter for changes of the mesh nodes (or vertices), see NodesUpdated().
+   // Used to recompute the cached geometric factors when they are requested
+   // after the nodes have moved.
+   long nodes_sequence;
+
    Array<Element *> elements;
    // Vertices are only at the corners of elements, where you would expect them
    // in the lowest-order mesh. In some cases, e.g. in a Mesh that defines the
@@ -153,11 +158,14 @@ protected:
    Array<FaceInfo> faces_info;
    Array<NCFaceInfo> nc_faces_info;
 
-   Table *el_to_edge;
-   Table *el_to_face;
+   // The tables el_to_edge, bel_to_edge and el_to_face can be released, see
+   // ReleaseElementToEdgeTable() and ReleaseElementToFaceTable(), in which case
+   // they are rebuilt on demand.
+   mutable Table *el_to_edge;
+   mutable Table *el_to_face;
    Table *el_to_el;
    Array<int> be_to_edge;  // for 2D
-   Table *bel_to_edge;     // for 3D
+   mutable Table *bel_to_edge; // for 3D
    Array<int> be_to_face;
    mutable Table *face_edge;
    mutable Table *edge_vertex;
@@ -206,6 +214,11 @@ public:
    Array<FaceGeometricFactors*>
    face_geom_factors; ///< Optional face geometric factors.
 
+   // Cached result of IsAffine(), valid while the sequence and the nodes
+   // sequence of the Mesh are equal to the recorded ones.
+   bool affine;
+   long affine_sequence, affine_nodes_sequence;
+
    // Global parameter that can be used to control the removal of unused
    // vertices performed when reading a mesh in MFEM format. The default value
    // (true) is set in mesh_readers.cpp.
@@ -223,6 +236,15 @@ protected:
    void Destroy();         // Delete all owned data.
    void ResetLazyData();
 
+   /** Rebuild el_to_edge (and bel_to_edge in 3D) after
+       ReleaseElementToEdgeTable(), keeping the edge numbering. */
+   void BuildElementToEdgeTable() const;
+   /// Rebuild el_to_face from faces_info after ReleaseElementToFaceTable().
+   void BuildElementToFaceTable() const;
+   /** Rebuild the released topology tables; called before operations that
+       change the topology and expect all tables to be present. */
+   void RestoreTopologyTables() const;
+
    Element *ReadElementWithoutAttr(std::istream &);
    static void PrintElementWithoutAttr(const Element *, std::ostream &);
 
@@ -238,6 +260,8 @@ protected:
    void ReadTrueGridMesh(std::istream &input);
    void ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
                     bool &finalize_topo);
+   void ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
+                        bool &finalize_topo, const std::string &xml_prefix="");
    void ReadNURBSMesh(std::istream &input, int &curved, int &read_gf);
    void ReadInlineMesh(std::istream &input, bool generate_edges = false);
    void ReadGmshMesh(std::istream &input, int &curved, int &read_gf);
@@ -246,6 +270,15 @@ protected:
    void ReadCubit(const char *filename, int &curved, int &read_gf);
 #endif
 
+   /** Create the mesh from the VTK points, cell connectivity, cell offsets
+       (of size NE+1), cell types, and optional cell attributes, as read from
+       legacy (.vtk) and XML (.vtu) VTK files. */
+   void CreateVTKMesh(const Vector &points, const Array<int> &cell_data,
+                      const Array<int> &cell_offsets,
+                      const Array<int> &cell_types,
+                      const Array<int> &cell_attributes,
+                      int &curved, int &read_gf, bool &finalize_topo);
+
    /// Determine the mesh generator bitmask #meshgen, see MeshGenerator().
    /** Also, initializes #mesh_geoms. */
    void SetMeshGen();
@@ -618,6 +651,15 @@ public:
        reorders vertices, edges and faces along with the elements. */
    void ReorderElements(const Array<int> &ordering, bool reorder_vertices = true);
 
+   /** Reorder the elements along a space-filling curve, using the Hilbert
+       ordering (default) or the Gecko ordering, see GetHilbertElementOrdering()
+       and GetGeckoElementOrdering(). The vertices, edges and faces are then
+       renumbered in the order they are first visited by the new element
+       sequence. Finite element spaces created afterwards can additionally use
+       FiniteElementSpace::SetLocalityDofNumbering(). Only conforming,
+       non-NURBS meshes are reordered; the call is ignored otherwise. */
+   void ReorderElementsForLocality(bool use_gecko = false);
+
    /** Creates mesh for the parallelepiped [0,sx]x[0,sy]x[0,sz], divided into
        nx*ny*nz hexahedra if type=HEXAHEDRON or into 6*nx*ny*nz tetrahedrons if
        type=TETRAHEDRON. If sfc_ordering = true (default), elements are ordered
@@ -744,6 +786,20 @@ public:
    const GeometricFactors* GetGeometricFactors(const IntegrationRule& ir,
                                                const int flags);
 
+   /** @brief Return the geometric factors of an affine mesh, evaluated at a
+       single point of each element, or NULL if the mesh is not affine. */
+   /** The Jacobians of the element transformations of an affine mesh are
+       constant in each element, so the returned factors store them, and their
+       determinants, once per element, i.e. with NQ = 1 in the layouts of
+       GeometricFactors. Meshes with mixed element types are not considered
+       affine. */
+   const GeometricFactors* GetAffineGeometricFactors(const int flags);
+
+   /** @brief Return true if all element transformations are affine, e.g. for
+       straight-sided simplices and parallelogram or parallelepiped elements. */
+   /** The result is cached until the mesh or its nodes are modified. */
+   bool IsAffine();
+
    /** @brief Return the mesh geometric factors for the faces corresponding
         to the given integration rule. */
    const FaceGeometricFactors* GetFaceGeometricFactors(const IntegrationRule& ir,
@@ -751,10 +807,24 @@ public:
                                                        FaceType type);
 
    /// Destroy all GeometricFactors stored by the Mesh.
-   /** This method can be used to force recomputation of the GeometricFactors,
-       for example, after the mesh nodes are modified externally. */
+   /** This method can be used to release the memory used by the
+       GeometricFactors. After the mesh nodes are modified externally, it is
+       enough to call NodesUpdated(). */
    void DeleteGeometricFactors();
 
+   /** @brief Notify the Mesh that its nodes (or vertices) were modified
+       externally, e.g. through the GridFunction returned by GetNodes(). */
+   /** The stored GeometricFactors and FaceGeometricFactors are then recomputed,
+       reusing their memory, when they are requested again. The methods of the
+       Mesh that move or replace the nodes, e.g. MoveNodes(), SetNodes(),
+       NewNodes() and Transform(), call this method. */
+   void NodesUpdated() { nodes_sequence++; }
+
+   /** @brief Return the number of node updates, see NodesUpdated(). Objects
+       depending on the mesh geometry can compare it with a recorded value to
+       determine if they need to be updated. */
+   long GetNodesSequence() const { return nodes_sequence; }
+
    /// Equals 1 + num_holes - num_loops
    inline int EulerNumber() const
    { return NumOfVertices - NumOfEdges + NumOfFaces - NumOfElements; }
@@ -924,9 +994,13 @@ public:
 
    /** Builds the transformation defining the i-th element in the user-defined
        variable. */
+   /** This method can be called concurrently by several threads, each with its
+       own @a ElTr. */
    void GetElementTransformation(int i, IsoparametricTransformation *ElTr);
 
    /// Returns the transformation defining the i-th element
+   /** The returned object is owned by the Mesh and reused by subsequent calls,
+       so it can not be used by several threads at the same time. */
    ElementTransformation *GetElementTransformation(int i);
 
    /** Return the transformation defining the i-th element assuming
@@ -1035,6 +1109,36 @@ public:
 
    const Table &ElementToEdgeTable() const;
 
+   /** @name Releasing derived topology tables
+
+       The following methods free connectivity tables that are derived from
+       the element-to-vertex connectivity, e.g. to reduce the memory footprint
+       of workflows that only need the elements and the faces (DG methods) or
+       only the elements (conversion tools). The tables are rebuilt on demand,
+       with the same numbering of the edges and faces, by the methods that use
+       them, e.g. GetElementEdges() and GetElementFaces(). Use
+       PrintMemoryUsage() to see the memory used by the individual tables.
+       These methods are supported for serial conforming meshes only. */
+   ///@{
+   /** @brief Release the element-to-edge and, in 3D, the boundary
+       element-to-edge tables. The compact edge-to-vertex table is kept to
+       preserve the edge numbering. */
+   void ReleaseElementToEdgeTable();
+   /// Release the element-to-face table (3D only).
+   void ReleaseElementToFaceTable();
+   /// Release the element-to-element table, see ElementToElementTable().
+   void ReleaseElementToElementTable();
+   /// Release the face-to-edge table, see GetFaceEdgeTable().
+   void ReleaseFaceToEdgeTable();
+   ///@}
+
+   /// Return the approximate memory used by the Mesh, in bytes.
+   long MemoryUsage() const;
+
+   /** @brief Print the memory used by the vertices, elements and the
+       individual topology tables of the Mesh. */
+   void PrintMemoryUsage(std::ostream &out = mfem::out) const;
+
    ///  The returned Table must be destroyed by the caller
    Table *GetVertexToElementTable();
 
@@ -1396,6 +1500,15 @@ public:
        - NQ = number of quadrature points per element, and
        - NE = number of elements in the mesh. */
    Vector detJ;
+
+private:
+   /// Value of Mesh::GetNodesSequence() when the factors were computed.
+   long nodes_sequence;
+
+   /// Compute the factors from the current mesh nodes, reusing the storage.
+   void Compute();
+
+   friend class Mesh;
 };
 
 /** @brief Structure for storing face geometric factors: coordinates, Jacobians,
@@ -1450,6 +1563,15 @@ public:
        - SDIM = space dimension of the mesh = mesh.SpaceDimension(), and
        - NF = number of faces in the mesh. */
    Vector normal;
+
+private:
+   /// Value of Mesh::GetNodesSequence() when the factors were computed.
+   long nodes_sequence;
+
+   /// Compute the factors from the current mesh nodes, reusing the storage.
+   void Compute();
+
+   friend class Mesh;
 };
 
 /// Class used to extrude the nodes of a mesh
@@ -11,20 +11,156 @@
 
 #include "mesh_headers.hpp"
 #include "../fem/fem.hpp"
+#include "../general/binaryio.hpp"
 #include "../general/text.hpp"
 
 #include <iostream>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <map>
 
 #ifdef MFEM_USE_NETCDF
 #include "netcdf.h"
 #endif
 
+#ifdef MFEM_USE_ZLIB
+#include <zlib.h>
+#endif
+
 using namespace std;
 
 namespace mfem
 {
 
+namespace internal
+{
+
+// Whitespace-delimited tokenizer reading directly from the buffer of a stream.
+// Parsing the large numeric sections of mesh files with the formatted
+// std::istream::operator>> is dominated by the sentry construction and locale
+// handling of each call; this class bypasses both. The position of the
+// underlying stream is kept consistent, so formatted and tokenized reads can
+// be freely interleaved.
+class MeshTokenReader
+{
+private:
+   std::streambuf *sb;
+   std::string token;
+
+   void Next()
+   {
+      int c = sb->sgetc();
+      while (c != EOF && isspace(c)) { c = sb->snextc(); }
+      token.clear();
+      while (c != EOF && !isspace(c))
+      {
+         token.push_back(char(c));
+         c = sb->snextc();
+      }
+      MFEM_VERIFY(!token.empty(), "unexpected end of mesh file");
+   }
+
+public:
+   MeshTokenReader(std::istream &input) : sb(input.rdbuf()) { }
+
+   long long ReadLong()
+   {
+      Next();
+      const char *p = token.c_str();
+      const bool neg = (*p == '-');
+      if (*p == '-' || *p == '+') { p++; }
+      MFEM_VERIFY(*p, "invalid integer in mesh file: " << token);
+      long long val = 0;
+      for ( ; *p; p++)
+      {
+         MFEM_VERIFY(*p >= '0' && *p <= '9',
+                     "invalid integer in mesh file: " << token);
+         val = 10*val + (*p - '0');
+      }
+      return neg ? -val : val;
+   }
+
+   int ReadInt() { return int(ReadLong()); }
+
+   double ReadDouble()
+   {
+      Next();
+      char *end;
+      const double val = strtod(token.c_str(), &end);
+      MFEM_VERIFY(*end == '\0', "invalid number in mesh file: " << token);
+      return val;
+   }
+};
+
+// Map from the (positive, not necessarily contiguous) node tags of a Gmsh file
+// to consecutive vertex indices. A dense lookup table is used when the tags are
+// reasonably compact, which is the common case, with a fall back to std::map.
+class GmshNodeMap
+{
+private:
+   long long min_tag;
+   std::vector<int> dense;
+   std::map<long long, int> sparse;
+   bool use_dense;
+
+public:
+   GmshNodeMap() : min_tag(0), use_dense(false) { }
+
+   /// Prepare the map for @a num_nodes tags in the range [@a min, @a max].
+   void Init(long long min, long long max, int num_nodes)
+   {
+      min_tag = min;
+      dense.clear();
+      sparse.clear();
+      use_dense = (max - min < 4*(long long)num_nodes + 1024);
+      if (use_dense) { dense.assign(max - min + 1, -1); }
+   }
+
+   /// Return false if @a tag was already inserted.
+   bool Insert(long long tag, int index)
+   {
+      if (use_dense)
+      {
+         if (tag < min_tag || tag - min_tag >= (long long)dense.size())
+         {
+            return false;
+         }
+         int &entry = dense[tag - min_tag];
+         if (entry != -1) { return false; }
+         entry = index;
+         return true;
+      }
+      return sparse.insert(std::make_pair(tag, index)).second;
+   }
+
+   /// Return the vertex index for @a tag, or abort if the tag is unknown.
+   int Find(long long tag) const
+   {
+      int index = -1;
+      if (use_dense)
+      {
+         if (tag >= min_tag && tag - min_tag < (long long)dense.size())
+         {
+            index = dense[tag - min_tag];
+         }
+      }
+      else
+      {
+         std::map<long long, int>::const_iterator it = sparse.find(tag);
+         if (it != sparse.end()) { index = it->second; }
+      }
+      if (index < 0)
+      {
+         MFEM_ABORT("Gmsh file : vertex index doesn't exist");
+      }
+      return index;
+   }
+};
+
+} // namespace mfem::internal
+
 bool Mesh::remove_unused_vertices = true;
 
 void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
@@ -372,194 +508,120 @@ const int Mesh::vtk_quadratic_hex[27] =
    24, 22, 21, 23, 20, 25, 26
 };
 
-void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
-                       bool &finalize_topo)
+void Mesh::CreateVTKMesh(const Vector &points, const Array<int> &cell_data,
+                         const Array<int> &cell_offsets,
+                         const Array<int> &cell_types,
+                         const Array<int> &cell_attributes,
+                         int &curved, int &read_gf, bool &finalize_topo)
 {
-   // VTK resources:
-   //   * https://www.vtk.org/doc/nightly/html/vtkCellType_8h_source.html
-   //   * https://www.vtk.org/doc/nightly/html/classvtkCell.html
-   //   * https://lorensen.github.io/VTKExamples/site/VTKFileFormats
-   //   * https://www.kitware.com/products/books/VTKUsersGuide.pdf
-
-   int i, j, n, attr;
-
-   string buff;
-   getline(input, buff); // comment line
-   getline(input, buff);
-   filter_dos(buff);
-   if (buff != "ASCII")
-   {
-      MFEM_ABORT("VTK mesh is not in ASCII format!");
-      return;
-   }
-   getline(input, buff);
-   filter_dos(buff);
-   if (buff != "DATASET UNSTRUCTURED_GRID")
-   {
-      MFEM_ABORT("VTK mesh is not UNSTRUCTURED_GRID!");
-      return;
-   }
+   int i, j, n;
 
-   // Read the points, skipping optional sections such as the FIELD data from
-   // VisIt's VTK export (or from Mesh::PrintVTK with field_data==1).
-   do
-   {
-      input >> buff;
-      if (!input.good())
-      {
-         MFEM_ABORT("VTK mesh does not have POINTS data!");
-      }
-   }
-   while (buff != "POINTS");
-   int np = 0;
-   Vector points;
-   {
-      input >> np >> ws;
-      points.SetSize(3*np);
-      getline(input, buff); // "double"
-      for (i = 0; i < points.Size(); i++)
-      {
-         input >> points(i);
-      }
-   }
+   const int np = points.Size()/3;
+   const int *cells = cell_data.GetData();
 
-   // Read the cells
-   NumOfElements = n = 0;
-   Array<int> cells_data;
-   input >> ws >> buff;
-   if (buff == "CELLS")
-   {
-      input >> NumOfElements >> n >> ws;
-      cells_data.SetSize(n);
-      for (i = 0; i < n; i++)
-      {
-         input >> cells_data[i];
-      }
-   }
-
-   // Read the cell types
    Dim = -1;
    int order = -1;
-   input >> ws >> buff;
-   if (buff == "CELL_TYPES")
+   NumOfElements = cell_types.Size();
+   MFEM_VERIFY(cell_offsets.Size() == NumOfElements + 1,
+               "VTK mesh : inconsistent cell offsets");
+   elements.SetSize(NumOfElements);
+   for (i = 0; i < NumOfElements; i++)
    {
-      input >> NumOfElements;
-      elements.SetSize(NumOfElements);
-      for (j = i = 0; i < NumOfElements; i++)
+      const int *v = cells + cell_offsets[i];
+      const int nv = cell_offsets[i+1] - cell_offsets[i];
+      int ct = cell_types[i], elem_dim, elem_nv, elem_order = 1;
+      switch (ct)
       {
-         int ct, elem_dim, elem_order = 1;
-         input >> ct;
-         switch (ct)
-         {
-            case 5:   // triangle
-               elem_dim = 2;
-               elements[i] = new Triangle(&cells_data[j+1]);
-               break;
-            case 9:   // quadrilateral
-               elem_dim = 2;
-               elements[i] = new Quadrilateral(&cells_data[j+1]);
-               break;
-            case 10:  // tetrahedron
-               elem_dim = 3;
+         case 5:   // triangle
+            elem_dim = 2;
+            elem_nv = 3;
+            elements[i] = new Triangle(v);
+            break;
+         case 9:   // quadrilateral
+            elem_dim = 2;
+            elem_nv = 4;
+            elements[i] = new Quadrilateral(v);
+            break;
+         case 10:  // tetrahedron
+            elem_dim = 3;
+            elem_nv = 4;
 #ifdef MFEM_USE_MEMALLOC
-               elements[i] = TetMemory.Alloc();
-               elements[i]->SetVertices(&cells_data[j+1]);
+            elements[i] = TetMemory.Alloc();
+            elements[i]->SetVertices(v);
 #else
-               elements[i] = new Tetrahedron(&cells_data[j+1]);
+            elements[i] = new Tetrahedron(v);
 #endif
-               break;
-            case 12:  // hexahedron
-               elem_dim = 3;
-               elements[i] = new Hexahedron(&cells_data[j+1]);
-               break;
-            case 13:  // wedge
-               elem_dim = 3;
-               // switch between vtk vertex ordering and mfem vertex ordering:
-               // swap vertices (1,2) and (4,5)
-               elements[i] =
-                  new Wedge(cells_data[j+1], cells_data[j+3], cells_data[j+2],
-                            cells_data[j+4], cells_data[j+6], cells_data[j+5]);
-               break;
+            break;
+         case 12:  // hexahedron
+            elem_dim = 3;
+            elem_nv = 8;
+            elements[i] = new Hexahedron(v);
+            break;
+         case 13:  // wedge
+            elem_dim = 3;
+            elem_nv = 6;
+            // switch between vtk vertex ordering and mfem vertex ordering:
+            // swap vertices (1,2) and (4,5)
+            elements[i] = new Wedge(v[0], v[2], v[1], v[3], v[5], v[4]);
+            break;
 
-            case 22:  // quadratic triangle
-               elem_dim = 2;
-               elem_order = 2;
-               elements[i] = new Triangle(&cells_data[j+1]);
-               break;
-            case 28:  // biquadratic quadrilateral
-               elem_dim = 2;
-               elem_order = 2;
-               elements[i] = new Quadrilateral(&cells_data[j+1]);
-               break;
-            case 24:  // quadratic tetrahedron
-               elem_dim = 3;
-               elem_order = 2;
+         case 22:  // quadratic triangle
+            elem_dim = 2;
+            elem_nv = 6;
+            elem_order = 2;
+            elements[i] = new Triangle(v);
+            break;
+         case 28:  // biquadratic quadrilateral
+            elem_dim = 2;
+            elem_nv = 9;
+            elem_order = 2;
+            elements[i] = new Quadrilateral(v);
+            break;
+         case 24:  // quadratic tetrahedron
+            elem_dim = 3;
+            elem_nv = 10;
+            elem_order = 2;
 #ifdef MFEM_USE_MEMALLOC
-               elements[i] = TetMemory.Alloc();
-               elements[i]->SetVertices(&cells_data[j+1]);
+            elements[i] = TetMemory.Alloc();
+            elements[i]->SetVertices(v);
 #else
-               elements[i] = new Tetrahedron(&cells_data[j+1]);
+            elements[i] = new Tetrahedron(v);
 #endif
-               break;
-            case 32: // biquadratic-quadratic wedge
-               elem_dim = 3;
-               elem_order = 2;
-               // switch between vtk vertex ordering and mfem vertex ordering:
-               // swap vertices (1,2) and (4,5)
-               elements[i] =
-                  new Wedge(cells_data[j+1], cells_data[j+3], cells_data[j+2],
-                            cells_data[j+4], cells_data[j+6], cells_data[j+5]);
-               break;
-            case 29:  // triquadratic hexahedron
-               elem_dim = 3;
-               elem_order = 2;
-               elements[i] = new Hexahedron(&cells_data[j+1]);
-               break;
-            default:
-               MFEM_ABORT("VTK mesh : cell type " << ct << " is not supported!");
-               return;
-         }
-         MFEM_VERIFY(Dim == -1 || Dim == elem_dim,
-                     "elements with different dimensions are not supported");
-         MFEM_VERIFY(order == -1 || order == elem_order,
-                     "elements with different orders are not supported");
-         Dim = elem_dim;
-         order = elem_order;
-         j += cells_data[j] + 1;
-      }
-   }
-
-   // Read attributes
-   streampos sp = input.tellg();
-   input >> ws >> buff;
-   if (buff == "CELL_DATA")
-   {
-      input >> n >> ws;
-      getline(input, buff);
-      filter_dos(buff);
-      // "SCALARS material dataType numComp"
-      if (!strncmp(buff.c_str(), "SCALARS material", 16))
-      {
-         getline(input, buff); // "LOOKUP_TABLE default"
-         for (i = 0; i < NumOfElements; i++)
-         {
-            input >> attr;
-            elements[i]->SetAttribute(attr);
-         }
+            break;
+         case 32: // biquadratic-quadratic wedge
+            elem_dim = 3;
+            elem_nv = 18;
+            elem_order = 2;
+            // switch between vtk vertex ordering and mfem vertex ordering:
+            // swap vertices (1,2) and (4,5)
+            elements[i] = new Wedge(v[0], v[2], v[1], v[3], v[5], v[4]);
+            break;
+         case 29:  // triquadratic hexahedron
+            elem_dim = 3;
+            elem_nv = 27;
+            elem_order = 2;
+            elements[i] = new Hexahedron(v);
+            break;
+         default:
+            MFEM_ABORT("VTK mesh : cell type " << ct << " is not supported!");
+            return;
       }
-      else
+      MFEM_VERIFY(nv == elem_nv, "VTK mesh : cell " << i << " of type " << ct
+                  << " has " << nv << " points, expected " << elem_nv);
+      MFEM_VERIFY(Dim == -1 || Dim == elem_dim,
+                  "elements with different dimensions are not supported");
+      MFEM_VERIFY(order == -1 || order == elem_order,
+                  "elements with different orders are not supported");
+      Dim = elem_dim;
+      order = elem_order;
+      if (cell_attributes.Size())
       {
-         input.seekg(sp);
+         elements[i]->SetAttribute(cell_attributes[i]);
       }
    }
-   else
-   {
-      input.seekg(sp);
-   }
 
    if (order == 1)
    {
-      cells_data.DeleteAll();
       NumOfVertices = np;
       vertices.SetSize(np);
       for (i = 0; i < np; i++)
@@ -568,7 +630,6 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
          vertices[i](1) = points(3*i+1);
          vertices[i](2) = points(3*i+2);
       }
-      points.Destroy();
 
       // No boundary is defined in a VTK mesh
       NumOfBdrElements = 0;
@@ -636,7 +697,7 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
 
       // Map vtk points to edge/face/element dofs
       Array<int> dofs;
-      for (n = i = 0; i < NumOfElements; i++)
+      for (i = 0; i < NumOfElements; i++)
       {
          fes->GetElementDofs(i, dofs);
          const int *vtk_mfem;
@@ -656,15 +717,16 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
                break;
          }
 
-         for (n++, j = 0; j < dofs.Size(); j++, n++)
+         const int *v = cells + cell_offsets[i];
+         for (j = 0; j < dofs.Size(); j++)
          {
-            if (pts_dof[cells_data[n]] == -1)
+            if (pts_dof[v[j]] == -1)
             {
-               pts_dof[cells_data[n]] = dofs[vtk_mfem[j]];
+               pts_dof[v[j]] = dofs[vtk_mfem[j]];
             }
             else
             {
-               if (pts_dof[cells_data[n]] != dofs[vtk_mfem[j]])
+               if (pts_dof[v[j]] != dofs[vtk_mfem[j]])
                {
                   MFEM_ABORT("VTK mesh : inconsistent quadratic mesh!");
                }
@@ -690,6 +752,557 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
    }
 }
 
+void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
+                       bool &finalize_topo)
+{
+   // VTK resources:
+   //   * https://www.vtk.org/doc/nightly/html/vtkCellType_8h_source.html
+   //   * https://www.vtk.org/doc/nightly/html/classvtkCell.html
+   //   * https://lorensen.github.io/VTKExamples/site/VTKFileFormats
+   //   * https://www.kitware.com/products/books/VTKUsersGuide.pdf
+
+   int i, j, n, ncells;
+
+   string buff;
+   getline(input, buff); // comment line
+   getline(input, buff);
+   filter_dos(buff);
+   if (buff != "ASCII")
+   {
+      MFEM_ABORT("VTK mesh is not in ASCII format!");
+      return;
+   }
+   getline(input, buff);
+   filter_dos(buff);
+   if (buff != "DATASET UNSTRUCTURED_GRID")
+   {
+      MFEM_ABORT("VTK mesh is not UNSTRUCTURED_GRID!");
+      return;
+   }
+
+   // Read the points, skipping optional sections such as the FIELD data from
+   // VisIt's VTK export (or from Mesh::PrintVTK with field_data==1).
+   do
+   {
+      input >> buff;
+      if (!input.good())
+      {
+         MFEM_ABORT("VTK mesh does not have POINTS data!");
+      }
+   }
+   while (buff != "POINTS");
+   internal::MeshTokenReader tokens(input);
+   int np = 0;
+   Vector points;
+   {
+      input >> np >> ws;
+      points.SetSize(3*np);
+      getline(input, buff); // "double"
+      for (i = 0; i < points.Size(); i++)
+      {
+         points(i) = tokens.ReadDouble();
+      }
+   }
+
+   // Read the cells, storing the connectivity and the cell offsets separately
+   ncells = n = 0;
+   Array<int> cell_data, cell_offsets(1);
+   cell_offsets[0] = 0;
+   input >> ws >> buff;
+   if (buff == "CELLS")
+   {
+      input >> ncells >> n >> ws;
+      cell_data.SetSize(n - ncells);
+      cell_offsets.SetSize(ncells + 1);
+      for (j = i = 0; i < ncells; i++)
+      {
+         const int nv = tokens.ReadInt();
+         MFEM_VERIFY(nv >= 0 && j + nv <= cell_data.Size(),
+                     "VTK mesh : invalid CELLS section");
+         for (int k = 0; k < nv; k++)
+         {
+            cell_data[j++] = tokens.ReadInt();
+         }
+         cell_offsets[i+1] = j;
+      }
+   }
+
+   // Read the cell types
+   Array<int> cell_types;
+   input >> ws >> buff;
+   if (buff == "CELL_TYPES")
+   {
+      input >> n;
+      MFEM_VERIFY(n == ncells, "VTK mesh : inconsistent number of cells");
+      cell_types.SetSize(n);
+      for (i = 0; i < n; i++)
+      {
+         cell_types[i] = tokens.ReadInt();
+      }
+   }
+
+   // Read attributes
+   Array<int> cell_attributes;
+   streampos sp = input.tellg();
+   input >> ws >> buff;
+   if (buff == "CELL_DATA")
+   {
+      input >> n >> ws;
+      getline(input, buff);
+      filter_dos(buff);
+      // "SCALARS material dataType numComp"
+      if (!strncmp(buff.c_str(), "SCALARS material", 16))
+      {
+         getline(input, buff); // "LOOKUP_TABLE default"
+         cell_attributes.SetSize(cell_types.Size());
+         for (i = 0; i < cell_attributes.Size(); i++)
+         {
+            cell_attributes[i] = tokens.ReadInt();
+         }
+      }
+      else
+      {
+         input.seekg(sp);
+      }
+   }
+   else
+   {
+      input.seekg(sp);
+   }
+
+   CreateVTKMesh(points, cell_data, cell_offsets, cell_types, cell_attributes,
+                 curved, read_gf, finalize_topo);
+}
+
+namespace internal
+{
+
+// Helpers for reading VTK XML unstructured grid (.vtu) files, see
+// https://vtk.org/Wiki/VTK_XML_Formats. Only the subset of XML used by these
+// files is handled.
+
+/// Position of the next start tag <name at or after @a pos, or string::npos.
+static size_t FindXMLTag(const string &xml, const string &name, size_t pos,
+                         size_t limit = string::npos)
+{
+   const string tag = "<" + name;
+   while ((pos = xml.find(tag, pos)) < limit)
+   {
+      const size_t p = pos + tag.size();
+      if (p < xml.size() &&
+          (isspace(xml[p]) || xml[p] == '>' || xml[p] == '/'))
+      {
+         return pos;
+      }
+      pos = p;
+   }
+   return string::npos;
+}
+
+struct XMLElement
+{
+   map<string, string> attributes;
+   size_t content_begin, content_end;
+
+   string Get(const string &name, const string &default_value = "") const
+   {
+      map<string, string>::const_iterator it = attributes.find(name);
+      return (it != attributes.end()) ? it->second : default_value;
+   }
+};
+
+/// Parse the element <name ...> starting at @a pos: its attributes and the
+/// extent of its content (empty for self-closing elements).
+static void ParseXMLElement(const string &xml, const string &name, size_t pos,
+                            XMLElement &el)
+{
+   el.attributes.clear();
+   size_t p = pos + 1 + name.size();
+   while (1)
+   {
+      while (p < xml.size() && isspace(xml[p])) { p++; }
+      MFEM_VERIFY(p < xml.size(), "VTU mesh : unterminated tag <" << name);
+      if (xml[p] == '>')
+      {
+         el.content_begin = p + 1;
+         el.content_end = xml.find("</" + name, el.content_begin);
+         MFEM_VERIFY(el.content_end != string::npos,
+                     "VTU mesh : missing </" << name << ">");
+         return;
+      }
+      if (xml[p] == '/')
+      {
+         el.content_begin = el.content_end = p + 2;
+         return;
+      }
+      const size_t eq = xml.find('=', p);
+      const size_t q1 = xml.find_first_of("\"'", eq);
+      MFEM_VERIFY(eq != string::npos && q1 != string::npos,
+                  "VTU mesh : invalid attribute in <" << name << ">");
+      const size_t q2 = xml.find(xml[q1], q1 + 1);
+      MFEM_VERIFY(q2 != string::npos,
+                  "VTU mesh : invalid attribute in <" << name << ">");
+      size_t key_end = eq;
+      while (key_end > p && isspace(xml[key_end-1])) { key_end--; }
+      el.attributes[xml.substr(p, key_end - p)] =
+         xml.substr(q1 + 1, q2 - q1 - 1);
+      p = q2 + 1;
+   }
+}
+
+template <typename S, typename T>
+static void CopyVTUData(const vector<char> &bytes, int n, T *out)
+{
+   MFEM_VERIFY(bytes.size() >= n*sizeof(S),
+               "VTU mesh : not enough data in DataArray");
+   for (int i = 0; i < n; i++)
+   {
+      S val;
+      memcpy(&val, bytes.data() + i*sizeof(S), sizeof(S));
+      out[i] = T(val);
+   }
+}
+
+/// Reader for the data arrays of a VTU file stored in the string @a xml.
+class VTUReader
+{
+private:
+   const string &xml;
+   bool compressed, header64;
+   size_t appended; // first byte of the appended data, or string::npos
+   bool appended_raw;
+
+   size_t HeaderWord(const char *h) const
+   {
+      if (header64)
+      {
+         uint64_t w;
+         memcpy(&w, h, sizeof(w));
+         return size_t(w);
+      }
+      uint32_t w;
+      memcpy(&w, h, sizeof(w));
+      return size_t(w);
+   }
+
+   size_t HeaderSize() const { return header64 ? 8 : 4; }
+
+   /// Uncompress the zlib blocks in @a data as described by @a header.
+   void Uncompress(const char *header, const char *data, size_t size,
+                   vector<char> &out) const
+   {
+#ifdef MFEM_USE_ZLIB
+      const size_t hs = HeaderSize();
+      const size_t nblocks = HeaderWord(header);
+      const size_t block_size = HeaderWord(header + hs);
+      const size_t last_size = HeaderWord(header + 2*hs);
+      out.clear();
+      size_t offset = 0;
+      for (size_t b = 0; b < nblocks; b++)
+      {
+         const size_t usize =
+            (b + 1 == nblocks && last_size != 0) ? last_size : block_size;
+         const size_t csize = HeaderWord(header + (3 + b)*hs);
+         MFEM_VERIFY(offset + csize <= size,
+                     "VTU mesh : truncated compressed data");
+         const size_t pos = out.size();
+         out.resize(pos + usize);
+         uLongf dest_len = usize;
+         const int err = uncompress(
+                            reinterpret_cast<Bytef*>(out.data() + pos),
+                            &dest_len,
+                            reinterpret_cast<const Bytef*>(data + offset),
+                            csize);
+         MFEM_VERIFY(err == Z_OK && dest_len == usize,
+                     "VTU mesh : zlib decompression failed");
+         offset += csize;
+      }
+#else
+      MFEM_CONTRACT_VAR(header);
+      MFEM_CONTRACT_VAR(data);
+      MFEM_CONTRACT_VAR(size);
+      MFEM_CONTRACT_VAR(out);
+      MFEM_ABORT("MFEM must be compiled with ZLib support to read compressed "
+                 "VTU files.");
+#endif
+   }
+
+   /// Decode base 64 encoded binary data (header followed by the data).
+   void DecodeBase64(size_t begin, size_t end, vector<char> &out) const
+   {
+      string s;
+      s.reserve(end - begin);
+      for (size_t i = begin; i < end; i++)
+      {
+         if (!isspace(xml[i])) { s.push_back(xml[i]); }
+      }
+      const size_t hs = HeaderSize();
+      vector<char> header;
+      out.clear();
+      if (!compressed)
+      {
+         // The header may be encoded separately from, or together with, the
+         // data; in the former case its encoding ends with padding.
+         const size_t len = bin_io::NumBase64Chars(hs);
+         if (s.size() > len && s.find('=') < len)
+         {
+            bin_io::DecodeBase64(s.data(), len, header);
+            bin_io::DecodeBase64(s.data() + len, s.size() - len, out);
+         }
+         else
+         {
+            bin_io::DecodeBase64(s.data(), s.size(), out);
+            MFEM_VERIFY(out.size() >= hs, "VTU mesh : invalid binary data");
+            header.assign(out.begin(), out.begin() + hs);
+            out.erase(out.begin(), out.begin() + hs);
+         }
+         const size_t nbytes = HeaderWord(header.data());
+         MFEM_VERIFY(out.size() >= nbytes, "VTU mesh : truncated binary data");
+         out.resize(nbytes);
+      }
+      else
+      {
+         // The header is encoded separately; its first word gives its size.
+         MFEM_VERIFY(s.size() >= bin_io::NumBase64Chars(3*hs),
+                     "VTU mesh : invalid compressed data");
+         bin_io::DecodeBase64(s.data(), bin_io::NumBase64Chars(3*hs), header);
+         const size_t len =
+            bin_io::NumBase64Chars((3 + HeaderWord(header.data()))*hs);
+         MFEM_VERIFY(s.size() >= len, "VTU mesh : invalid compressed data");
+         header.clear();
+         bin_io::DecodeBase64(s.data(), len, header);
+         vector<char> data;
+         bin_io::DecodeBase64(s.data() + len, s.size() - len, data);
+         Uncompress(header.data(), data.data(), data.size(), out);
+      }
+   }
+
+   /// Read raw binary data (header followed by the data) at @a pos.
+   void ReadRaw(size_t pos, vector<char> &out) const
+   {
+      const size_t hs = HeaderSize();
+      MFEM_VERIFY(pos + hs <= xml.size(), "VTU mesh : invalid appended data");
+      const char *h = xml.data() + pos;
+      if (!compressed)
+      {
+         const size_t nbytes = HeaderWord(h);
+         MFEM_VERIFY(pos + hs + nbytes <= xml.size(),
+                     "VTU mesh : truncated appended data");
+         out.assign(h + hs, h + hs + nbytes);
+      }
+      else
+      {
+         const size_t nblocks = HeaderWord(h);
+         const size_t header_size = (3 + nblocks)*hs;
+         MFEM_VERIFY(pos + header_size <= xml.size(),
+                     "VTU mesh : truncated appended data");
+         size_t data_size = 0;
+         for (size_t b = 0; b < nblocks; b++)
+         {
+            data_size += HeaderWord(h + (3 + b)*hs);
+         }
+         MFEM_VERIFY(pos + header_size + data_size <= xml.size(),
+                     "VTU mesh : truncated appended data");
+         Uncompress(h, h + header_size, data_size, out);
+      }
+   }
+
+public:
+   VTUReader(const string &xml_, const XMLElement &file, size_t appended_tag)
+      : xml(xml_), appended(string::npos), appended_raw(false)
+   {
+      const string type = file.Get("type");
+      MFEM_VERIFY(type == "UnstructuredGrid",
+                  "VTU mesh : VTKFile type " << type << " is not supported!");
+      const string byte_order = file.Get("byte_order", VTKByteOrder());
+      MFEM_VERIFY(byte_order == VTKByteOrder(),
+                  "VTU mesh : byte order " << byte_order << " is not supported!");
+      header64 = (file.Get("header_type", "UInt32") == "UInt64");
+      const string compressor = file.Get("compressor");
+      MFEM_VERIFY(compressor.empty() || compressor == "vtkZLibDataCompressor",
+                  "VTU mesh : compressor " << compressor << " is not supported!");
+      compressed = !compressor.empty();
+      if (appended_tag != string::npos)
+      {
+         XMLElement el;
+         ParseXMLElement(xml, "AppendedData", appended_tag, el);
+         appended_raw = (el.Get("encoding") == "raw");
+         appended = xml.find('_', el.content_begin);
+         MFEM_VERIFY(appended != string::npos,
+                     "VTU mesh : invalid <AppendedData> section");
+         appended++;
+      }
+   }
+
+   /// Read the first @a n values of the DataArray @a da into @a out.
+   template <typename T>
+   void ReadDataArray(const XMLElement &da, int n, T *out) const
+   {
+      const string format = da.Get("format", "ascii");
+      if (format == "ascii")
+      {
+         const char *p = xml.c_str() + da.content_begin;
+         const char *end = xml.c_str() + da.content_end;
+         for (int i = 0; i < n; i++)
+         {
+            char *next;
+            const double val = strtod(p, &next);
+            MFEM_VERIFY(next != p && next <= end,
+                        "VTU mesh : not enough data in DataArray "
+                        << da.Get("Name"));
+            out[i] = T(val);
+            p = next;
+         }
+         return;
+      }
+
+      vector<char> bytes;
+      if (format == "binary")
+      {
+         DecodeBase64(da.content_begin, da.content_end, bytes);
+      }
+      else if (format == "appended")
+      {
+         MFEM_VERIFY(appended != string::npos,
+                     "VTU mesh : missing <AppendedData> section");
+         const size_t offset = strtoull(da.Get("offset", "0").c_str(), NULL, 10);
+         if (appended_raw)
+         {
+            ReadRaw(appended + offset, bytes);
+         }
+         else
+         {
+            const size_t begin = appended + offset;
+            size_t end = begin;
+            while (end < xml.size() && xml[end] != '<' && xml[end] != '_')
+            {
+               end++;
+            }
+            DecodeBase64(begin, end, bytes);
+         }
+      }
+      else
+      {
+         MFEM_ABORT("VTU mesh : DataArray format " << format
+                    << " is not supported!");
+      }
+
+      const string type = da.Get("type");
+      if (type == "Int8") { CopyVTUData<int8_t>(bytes, n, out); }
+      else if (type == "UInt8") { CopyVTUData<uint8_t>(bytes, n, out); }
+      else if (type == "Int16") { CopyVTUData<int16_t>(bytes, n, out); }
+      else if (type == "UInt16") { CopyVTUData<uint16_t>(bytes, n, out); }
+      else if (type == "Int32") { CopyVTUData<int32_t>(bytes, n, out); }
+      else if (type == "UInt32") { CopyVTUData<uint32_t>(bytes, n, out); }
+      else if (type == "Int64") { CopyVTUData<int64_t>(bytes, n, out); }
+      else if (type == "UInt64") { CopyVTUData<uint64_t>(bytes, n, out); }
+      else if (type == "Float32") { CopyVTUData<float>(bytes, n, out); }
+      else if (type == "Float64") { CopyVTUData<double>(bytes, n, out); }
+      else
+      {
+         MFEM_ABORT("VTU mesh : DataArray type " << type << " is not supported!");
+      }
+   }
+};
+
+} // namespace mfem::internal
+
+void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
+                           bool &finalize_topo, const std::string &xml_prefix)
+{
+   using internal::XMLElement;
+   using internal::FindXMLTag;
+   using internal::ParseXMLElement;
+
+   // Read the whole file: the appended data section may contain raw binary
+   // data, so no line-based parsing is attempted.
+   string xml = xml_prefix + '\n';
+   xml.append(istreambuf_iterator<char>(input), istreambuf_iterator<char>());
+
+   // Only search for tags before the appended data, if any
+   const size_t appended = FindXMLTag(xml, "AppendedData", 0);
+
+   XMLElement file, piece, el;
+   size_t pos = FindXMLTag(xml, "VTKFile", 0, appended);
+   MFEM_VERIFY(pos != string::npos, "VTU mesh : missing <VTKFile> element");
+   ParseXMLElement(xml, "VTKFile", pos, file);
+   const internal::VTUReader vtu(xml, file, appended);
+
+   pos = FindXMLTag(xml, "Piece", pos, appended);
+   MFEM_VERIFY(pos != string::npos, "VTU mesh : missing <Piece> element");
+   ParseXMLElement(xml, "Piece", pos, piece);
+   MFEM_VERIFY(FindXMLTag(xml, "Piece", piece.content_end + 1, appended)
+               == string::npos, "VTU mesh : multiple pieces are not supported");
+   const int np = atoi(piece.Get("NumberOfPoints", "0").c_str());
+   const int ncells = atoi(piece.Get("NumberOfCells", "0").c_str());
+
+   // Points
+   Vector points(3*np);
+   pos = FindXMLTag(xml, "Points", piece.content_begin, piece.content_end);
+   MFEM_VERIFY(pos != string::npos, "VTU mesh : missing <Points> element");
+   pos = FindXMLTag(xml, "DataArray", pos, piece.content_end);
+   MFEM_VERIFY(pos != string::npos, "VTU mesh : missing points DataArray");
+   ParseXMLElement(xml, "DataArray", pos, el);
+   MFEM_VERIFY(el.Get("NumberOfComponents", "1") == "3",
+               "VTU mesh : points must have three components");
+   vtu.ReadDataArray(el, 3*np, points.GetData());
+
+   // Cells: connectivity, (end) offsets and types
+   XMLElement connectivity, offsets, types;
+   bool have_connectivity = false, have_offsets = false, have_types = false;
+   pos = FindXMLTag(xml, "Cells", piece.content_begin, piece.content_end);
+   MFEM_VERIFY(pos != string::npos, "VTU mesh : missing <Cells> element");
+   XMLElement cells;
+   ParseXMLElement(xml, "Cells", pos, cells);
+   pos = cells.content_begin;
+   while ((pos = FindXMLTag(xml, "DataArray", pos, cells.content_end))
+          != string::npos)
+   {
+      ParseXMLElement(xml, "DataArray", pos, el);
+      const string name = el.Get("Name");
+      if (name == "connectivity") { connectivity = el; have_connectivity = true; }
+      else if (name == "offsets") { offsets = el; have_offsets = true; }
+      else if (name == "types") { types = el; have_types = true; }
+      pos = el.content_end;
+   }
+   MFEM_VERIFY(have_connectivity && have_offsets && have_types,
+               "VTU mesh : incomplete <Cells> element");
+
+   Array<int> cell_offsets(ncells + 1), cell_types(ncells), cell_data;
+   cell_offsets[0] = 0;
+   vtu.ReadDataArray(offsets, ncells, cell_offsets.GetData() + 1);
+   vtu.ReadDataArray(types, ncells, cell_types.GetData());
+   cell_data.SetSize(cell_offsets[ncells]);
+   vtu.ReadDataArray(connectivity, cell_data.Size(), cell_data.GetData());
+
+   // Optional element attributes, stored as the cell data array "material"
+   // (as written by Mesh::PrintVTU) or "attribute"
+   Array<int> cell_attributes;
+   pos = FindXMLTag(xml, "CellData", piece.content_begin, piece.content_end);
+   if (pos != string::npos)
+   {
+      XMLElement cell_data_el;
+      ParseXMLElement(xml, "CellData", pos, cell_data_el);
+      pos = cell_data_el.content_begin;
+      while ((pos = FindXMLTag(xml, "DataArray", pos,
+                               cell_data_el.content_end)) != string::npos)
+      {
+         ParseXMLElement(xml, "DataArray", pos, el);
+         const string name = el.Get("Name");
+         if (name == "material" || name == "attribute")
+         {
+            cell_attributes.SetSize(ncells);
+            vtu.ReadDataArray(el, ncells, cell_attributes.GetData());
+            break;
+         }
+         pos = el.content_end;
+      }
+   }
+
+   CreateVTKMesh(points, cell_data, cell_offsets, cell_types, cell_attributes,
+                 curved, read_gf, finalize_topo);
+}
+
 void Mesh::ReadNURBSMesh(std::istream &input, int &curved, int &read_gf)
 {
    NURBSext = new NURBSExtension(input);
@@ -887,6 +1500,129 @@ void Mesh::ReadInlineMesh(std::istream &input, bool generate_edges)
    }
 }
 
+// Number of nodes for each type of Gmsh elements, type is the index of the
+// array + 1
+static const int nodes_of_gmsh_element[] =
+{
+   2, // 2-node line.
+   3, // 3-node triangle.
+   4, // 4-node quadrangle.
+   4, // 4-node tetrahedron.
+   8, // 8-node hexahedron.
+   6, // 6-node prism.
+   5, // 5-node pyramid.
+   3, /* 3-node second order line (2 nodes associated with the vertices
+           and 1 with the edge). */
+   6, /* 6-node second order triangle (3 nodes associated with the
+           vertices and 3 with the edges). */
+   9, /* 9-node second order quadrangle (4 nodes associated with the
+           vertices, 4 with the edges and 1 with the face). */
+   10,/* 10-node second order tetrahedron (4 nodes associated with the
+            vertices and 6 with the edges). */
+   27,/* 27-node second order hexahedron (8 nodes associated with the
+            vertices, 12 with the edges, 6 with the faces and 1 with
+            the volume). */
+   18,/* 18-node second order prism (6 nodes associated with the
+            vertices, 9 with the edges and 3 with the quadrangular
+            faces). */
+   14,/* 14-node second order pyramid (5 nodes associated with the
+            vertices, 8 with the edges and 1 with the quadrangular
+            face). */
+   1, // 1-node point.
+   8, /* 8-node second order quadrangle (4 nodes associated with the
+           vertices and 4 with the edges). */
+   20,/* 20-node second order hexahedron (8 nodes associated with the
+            vertices and 12 with the edges). */
+   15,/* 15-node second order prism (6 nodes associated with the
+            vertices and 9 with the edges). */
+   13,/* 13-node second order pyramid (5 nodes associated with the
+            vertices and 8 with the edges). */
+   9, /* 9-node third order incomplete triangle (3 nodes associated
+           with the vertices, 6 with the edges) */
+   10,/* 10-node third order triangle (3 nodes associated with the
+            vertices, 6 with the edges, 1 with the face) */
+   12,/* 12-node fourth order incomplete triangle (3 nodes associated
+            with the vertices, 9 with the edges) */
+   15,/* 15-node fourth order triangle (3 nodes associated with the
+            vertices, 9 with the edges, 3 with the face) */
+   15,/* 15-node fifth order incomplete triangle (3 nodes associated
+            with the vertices, 12 with the edges) */
+   21,/* 21-node fifth order complete triangle (3 nodes associated with
+            the vertices, 12 with the edges, 6 with the face) */
+   4, /* 4-node third order edge (2 nodes associated with the vertices,
+           2 internal to the edge) */
+   5, /* 5-node fourth order edge (2 nodes associated with the
+           vertices, 3 internal to the edge) */
+   6, /* 6-node fifth order edge (2 nodes associated with the vertices,
+           4 internal to the edge) */
+   20 /* 20-node third order tetrahedron (4 nodes associated with the
+            vertices, 12 with the edges, 4 with the faces) */
+};
+
+static const int num_gmsh_element_types =
+   sizeof(nodes_of_gmsh_element)/sizeof(nodes_of_gmsh_element[0]);
+
+// Return the MFEM geometry of the supported Gmsh element types, or
+// Geometry::INVALID.
+static Geometry::Type GmshElementGeometry(int type_of_element)
+{
+   switch (type_of_element)
+   {
+      case 1: return Geometry::SEGMENT;     // 2-node line
+      case 2: return Geometry::TRIANGLE;    // 3-node triangle
+      case 3: return Geometry::SQUARE;      // 4-node quadrangle
+      case 4: return Geometry::TETRAHEDRON; // 4-node tetrahedron
+      case 5: return Geometry::CUBE;        // 8-node hexahedron
+      case 15: return Geometry::POINT;      // 1-node point
+      default: return Geometry::INVALID;
+   }
+}
+
+// Read @a n unsigned integers (size_t in binary files) of a Gmsh 4.1 section.
+static void GmshReadSizes(std::istream &input, internal::MeshTokenReader &tokens,
+                          bool binary, size_t n, long long *out)
+{
+   if (binary)
+   {
+      std::vector<uint64_t> buf(n);
+      input.read(reinterpret_cast<char*>(buf.data()), n*sizeof(uint64_t));
+      for (size_t i = 0; i < n; i++) { out[i] = (long long)buf[i]; }
+   }
+   else
+   {
+      for (size_t i = 0; i < n; i++) { out[i] = tokens.ReadLong(); }
+   }
+}
+
+// Read @a n doubles of a Gmsh 4.1 section.
+static void GmshReadDoubles(std::istream &input,
+                            internal::MeshTokenReader &tokens,
+                            bool binary, size_t n, double *out)
+{
+   if (binary)
+   {
+      input.read(reinterpret_cast<char*>(out), n*sizeof(double));
+   }
+   else
+   {
+      for (size_t i = 0; i < n; i++) { out[i] = tokens.ReadDouble(); }
+   }
+}
+
+static long long GmshReadSize(std::istream &input,
+                              internal::MeshTokenReader &tokens, bool binary)
+{
+   long long val;
+   GmshReadSizes(input, tokens, binary, 1, &val);
+   return val;
+}
+
+static int GmshReadInt(std::istream &input, internal::MeshTokenReader &tokens,
+                       bool binary)
+{
+   return binary ? bin_io::read<int>(input) : tokens.ReadInt();
+}
+
 void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
 {
    string buff;
@@ -897,6 +1633,14 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
    {
       MFEM_ABORT("Gmsh file version < 2.2");
    }
+   // Gmsh 4.0 uses a different layout of the sections than 4.1 and later
+   if (version >= 4.0 && version < 4.1)
+   {
+      MFEM_ABORT("Gmsh file version 4.0 is not supported, use 2.2 or 4.1");
+   }
+   const bool v41 = (version >= 4.1);
+   // The data size is sizeof(double) in version 2.2 and sizeof(size_t) in
+   // version 4.1; only 8 byte sizes are supported in the latter case.
    if (dsize != sizeof(double))
    {
       MFEM_ABORT("Gmsh file : dsize != sizeof(double)");
@@ -913,240 +1657,269 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
       }
    }
 
+   internal::MeshTokenReader tokens(input);
+
    // A map between a serial number of the vertex and its number in the file
    // (there may be gaps in the numbering, and also Gmsh enumerates vertices
    // starting from 1, not 0)
-   map<int, int> vertices_map;
+   internal::GmshNodeMap vertices_map;
+
+   // The physical tag of the geometrical entities, by dimension (version 4.1
+   // only, where the element attributes are given through the entities)
+   std::map<int, int> entity_attributes[4];
+
    // Read the lines of the mesh file. If we face specific keyword, we'll treat
    // the section.
    while (input >> buff)
    {
-      if (buff == "$Nodes") // reading mesh vertices
+      if (buff == "$Entities" && v41) // reading geometrical entities
+      {
+         getline(input, buff);
+         long long num_entities[4];
+         GmshReadSizes(input, tokens, binary, 4, num_entities);
+         double bbox[6];
+         for (int d = 0; d < 4; d++)
+         {
+            for (long long e = 0; e < num_entities[d]; e++)
+            {
+               const int tag = GmshReadInt(input, tokens, binary);
+               // a point, or the bounding box of a curve/surface/volume
+               GmshReadDoubles(input, tokens, binary, (d == 0) ? 3 : 6, bbox);
+               const long long n_phys = GmshReadSize(input, tokens, binary);
+               for (long long p = 0; p < n_phys; p++)
+               {
+                  const int phys_tag = GmshReadInt(input, tokens, binary);
+                  // the first physical tag is used as the element attribute
+                  if (p == 0) { entity_attributes[d][tag] = phys_tag; }
+               }
+               if (d > 0)
+               {
+                  const long long n_bdr = GmshReadSize(input, tokens, binary);
+                  for (long long b = 0; b < n_bdr; b++)
+                  {
+                     GmshReadInt(input, tokens, binary);
+                  }
+               }
+            }
+         }
+      } // section '$Entities'
+      else if (buff == "$Nodes" && v41) // reading mesh vertices
+      {
+         getline(input, buff);
+         long long header[4]; // numEntityBlocks numNodes minTag maxTag
+         GmshReadSizes(input, tokens, binary, 4, header);
+         NumOfVertices = header[1];
+         vertices.SetSize(NumOfVertices);
+         vertices_map.Init(header[2], header[3], NumOfVertices);
+
+         std::vector<long long> tags;
+         std::vector<double> coords;
+         int ver = 0;
+         for (long long b = 0; b < header[0]; b++)
+         {
+            const int entity_dim = GmshReadInt(input, tokens, binary);
+            GmshReadInt(input, tokens, binary); // entity tag
+            const int parametric = GmshReadInt(input, tokens, binary);
+            const long long n_nodes = GmshReadSize(input, tokens, binary);
+            MFEM_VERIFY(ver + n_nodes <= NumOfVertices,
+                        "Gmsh file : inconsistent number of nodes");
+            // Gmsh always outputs 3 coordinates, followed by the parametric
+            // coordinates, if any
+            const int n_coords = 3 + (parametric ? entity_dim : 0);
+            tags.resize(n_nodes);
+            coords.resize(n_nodes*n_coords);
+            GmshReadSizes(input, tokens, binary, tags.size(), tags.data());
+            GmshReadDoubles(input, tokens, binary, coords.size(), coords.data());
+            for (long long i = 0; i < n_nodes; i++, ver++)
+            {
+               vertices[ver] = Vertex(&coords[i*n_coords], 3);
+               if (!vertices_map.Insert(tags[i], ver))
+               {
+                  MFEM_ABORT("Gmsh file : vertices indices are not unique");
+               }
+            }
+         }
+         MFEM_VERIFY(ver == NumOfVertices,
+                     "Gmsh file : inconsistent number of nodes");
+      } // section '$Nodes' (version 4.1)
+      else if (buff == "$Nodes") // reading mesh vertices
       {
          input >> NumOfVertices;
          getline(input, buff);
          vertices.SetSize(NumOfVertices);
-         int serial_number;
+         Array<int> serial_numbers(NumOfVertices);
          const int gmsh_dim = 3; // Gmsh always outputs 3 coordinates
          double coord[gmsh_dim];
          for (int ver = 0; ver < NumOfVertices; ++ver)
          {
             if (binary)
             {
-               input.read(reinterpret_cast<char*>(&serial_number), sizeof(int));
+               input.read(reinterpret_cast<char*>(&serial_numbers[ver]),
+                          sizeof(int));
                input.read(reinterpret_cast<char*>(coord), gmsh_dim*sizeof(double));
             }
             else // ASCII
             {
-               input >> serial_number;
+               serial_numbers[ver] = tokens.ReadInt();
                for (int ci = 0; ci < gmsh_dim; ++ci)
                {
-                  input >> coord[ci];
+                  coord[ci] = tokens.ReadDouble();
                }
             }
             vertices[ver] = Vertex(coord, gmsh_dim);
-            vertices_map[serial_number] = ver;
          }
-         if (static_cast<int>(vertices_map.size()) != NumOfVertices)
+         if (NumOfVertices > 0)
          {
-            MFEM_ABORT("Gmsh file : vertices indices are not unique");
+            vertices_map.Init(serial_numbers.Min(), serial_numbers.Max(),
+                              NumOfVertices);
+         }
+         for (int ver = 0; ver < NumOfVertices; ++ver)
+         {
+            if (!vertices_map.Insert(serial_numbers[ver], ver))
+            {
+               MFEM_ABORT("Gmsh file : vertices indices are not unique");
+            }
          }
       } // section '$Nodes'
       else if (buff == "$Elements") // reading mesh elements
       {
-         int num_of_all_elements;
-         input >> num_of_all_elements;
-         // = NumOfElements + NumOfBdrElements + (maybe, PhysicalPoints)
-         getline(input, buff);
-
-         int serial_number; // serial number of an element
-         int type_of_element; // ID describing a type of a mesh element
-         int n_tags; // number of different tags describing an element
-         int phys_domain; // element's attribute
-         int elem_domain; // another element's attribute (rarely used)
-         int n_partitions; // number of partitions where an element takes place
-
-         // number of nodes for each type of Gmsh elements, type is the index of
-         // the array + 1
-         int nodes_of_gmsh_element[] =
-         {
-            2, // 2-node line.
-            3, // 3-node triangle.
-            4, // 4-node quadrangle.
-            4, // 4-node tetrahedron.
-            8, // 8-node hexahedron.
-            6, // 6-node prism.
-            5, // 5-node pyramid.
-            3, /* 3-node second order line (2 nodes associated with the vertices
-                    and 1 with the edge). */
-            6, /* 6-node second order triangle (3 nodes associated with the
-                    vertices and 3 with the edges). */
-            9, /* 9-node second order quadrangle (4 nodes associated with the
-                    vertices, 4 with the edges and 1 with the face). */
-            10,/* 10-node second order tetrahedron (4 nodes associated with the
-                     vertices and 6 with the edges). */
-            27,/* 27-node second order hexahedron (8 nodes associated with the
-                     vertices, 12 with the edges, 6 with the faces and 1 with
-                     the volume). */
-            18,/* 18-node second order prism (6 nodes associated with the
-                     vertices, 9 with the edges and 3 with the quadrangular
-                     faces). */
-            14,/* 14-node second order pyramid (5 nodes associated with the
-                     vertices, 8 with the edges and 1 with the quadrangular
-                     face). */
-            1, // 1-node point.
-            8, /* 8-node second order quadrangle (4 nodes associated with the
-                    vertices and 4 with the edges). */
-            20,/* 20-node second order hexahedron (8 nodes associated with the
-                     vertices and 12 with the edges). */
-            15,/* 15-node second order prism (6 nodes associated with the
-                     vertices and 9 with the edges). */
-            13,/* 13-node second order pyramid (5 nodes associated with the
-                     vertices and 8 with the edges). */
-            9, /* 9-node third order incomplete triangle (3 nodes associated
-                    with the vertices, 6 with the edges) */
-            10,/* 10-node third order triangle (3 nodes associated with the
-                     vertices, 6 with the edges, 1 with the face) */
-            12,/* 12-node fourth order incomplete triangle (3 nodes associated
-                     with the vertices, 9 with the edges) */
-            15,/* 15-node fourth order triangle (3 nodes associated with the
-                     vertices, 9 with the edges, 3 with the face) */
-            15,/* 15-node fifth order incomplete triangle (3 nodes associated
-                     with the vertices, 12 with the edges) */
-            21,/* 21-node fifth order complete triangle (3 nodes associated with
-                     the vertices, 12 with the edges, 6 with the face) */
-            4, /* 4-node third order edge (2 nodes associated with the vertices,
-                    2 internal to the edge) */
-            5, /* 5-node fourth order edge (2 nodes associated with the
-                    vertices, 3 internal to the edge) */
-            6, /* 6-node fifth order edge (2 nodes associated with the vertices,
-                    4 internal to the edge) */
-            20 /* 20-node third order tetrahedron (4 nodes associated with the
-                     vertices, 12 with the edges, 4 with the faces) */
-         };
-
          vector<Element*> elements_0D, elements_1D, elements_2D, elements_3D;
-         elements_0D.reserve(num_of_all_elements);
-         elements_1D.reserve(num_of_all_elements);
-         elements_2D.reserve(num_of_all_elements);
-         elements_3D.reserve(num_of_all_elements);
+         vector<Element*> *elements_by_dim[4] =
+         { &elements_0D, &elements_1D, &elements_2D, &elements_3D };
+         vector<int> vert_indices;
 
-         if (binary)
+         if (v41)
          {
-            int n_elem_part = 0; // partial sum of elements that are read
-            const int header_size = 3;
-            // header consists of 3 numbers: type of the element, number of
-            // elements of this type, and number of tags
-            int header[header_size];
-            int n_elem_one_type; // number of elements of a specific type
+            getline(input, buff);
+            long long header[4]; // numEntityBlocks numElements minTag maxTag
+            GmshReadSizes(input, tokens, binary, 4, header);
+            for (int d = 0; d < 4; d++)
+            {
+               elements_by_dim[d]->reserve(header[1]);
+            }
 
-            while (n_elem_part < num_of_all_elements)
+            std::vector<long long> data;
+            for (long long b = 0; b < header[0]; b++)
             {
-               input.read(reinterpret_cast<char*>(header),
-                          header_size*sizeof(int));
-               type_of_element = header[0];
-               n_elem_one_type = header[1];
-               n_tags          = header[2];
+               const int entity_dim = GmshReadInt(input, tokens, binary);
+               const int entity_tag = GmshReadInt(input, tokens, binary);
+               const int type_of_element = GmshReadInt(input, tokens, binary);
+               const long long n_elem = GmshReadSize(input, tokens, binary);
+               MFEM_VERIFY(type_of_element >= 1 &&
+                           type_of_element <= num_gmsh_element_types,
+                           "Gmsh file : unknown element type "
+                           << type_of_element);
+               const int n_elem_nodes = nodes_of_gmsh_element[type_of_element-1];
+               // each element is given by its tag followed by its nodes
+               data.resize(n_elem*(1 + n_elem_nodes));
+               GmshReadSizes(input, tokens, binary, data.size(), data.data());
 
-               n_elem_part += n_elem_one_type;
+               const Geometry::Type geom = GmshElementGeometry(type_of_element);
+               if (geom == Geometry::INVALID)
+               {
+                  MFEM_WARNING("Unsupported Gmsh element type.");
+                  continue;
+               }
+               // the attribute is the physical tag of the entity or, if the
+               // entity is not part of a physical group, its tag
+               const std::map<int, int> &attr_map =
+                  entity_attributes[entity_dim];
+               std::map<int, int>::const_iterator it = attr_map.find(entity_tag);
+               const int attr = (it != attr_map.end()) ? it->second : entity_tag;
+               // non-positive attributes are not allowed in MFEM
+               if (attr <= 0)
+               {
+                  MFEM_ABORT("Non-positive element attribute in Gmsh mesh!");
+               }
 
-               const int n_elem_nodes = nodes_of_gmsh_element[type_of_element-1];
-               vector<int> data(1+n_tags+n_elem_nodes);
-               for (int el = 0; el < n_elem_one_type; ++el)
+               vert_indices.resize(n_elem_nodes);
+               vector<Element*> &elems = *elements_by_dim[Geometry::Dimension[geom]];
+               for (long long el = 0; el < n_elem; ++el)
                {
-                  input.read(reinterpret_cast<char*>(&data[0]),
-                             data.size()*sizeof(int));
-                  int dd = 0; // index for data array
-                  serial_number = data[dd++];
-                  // physical domain - the most important value (to distinguish
-                  // materials with different properties)
-                  phys_domain = (n_tags > 0) ? data[dd++] : 1;
-                  // elementary domain - to distinguish different geometrical
-                  // domains (typically, it's used rarely)
-                  elem_domain = (n_tags > 1) ? data[dd++] : 0;
-                  // the number of tags is bigger than 2 if there are some
-                  // partitions (domain decompositions)
-                  n_partitions = (n_tags > 2) ? data[dd++] : 0;
-                  // we currently just skip the partitions if they exist, and go
-                  // directly to vertices describing the mesh element
-                  vector<int> vert_indices(n_elem_nodes);
+                  const long long *nodes = &data[el*(1 + n_elem_nodes) + 1];
                   for (int vi = 0; vi < n_elem_nodes; ++vi)
                   {
-                     map<int, int>::const_iterator it =
-                        vertices_map.find(data[1+n_tags+vi]);
-                     if (it == vertices_map.end())
-                     {
-                        MFEM_ABORT("Gmsh file : vertex index doesn't exist");
-                     }
-                     vert_indices[vi] = it->second;
+                     vert_indices[vi] = vertices_map.Find(nodes[vi]);
                   }
+                  Element *elem = NewElement(geom);
+                  elem->SetVertices(vert_indices.data());
+                  elem->SetAttribute(attr);
+                  elems.push_back(elem);
+               }
+            }
+         } // if version 4.1
+         else
+         {
+            int num_of_all_elements;
+            input >> num_of_all_elements;
+            // = NumOfElements + NumOfBdrElements + (maybe, PhysicalPoints)
+            getline(input, buff);
+
+            int serial_number; // serial number of an element
+            int type_of_element; // ID describing a type of a mesh element
+            int n_tags; // number of different tags describing an element
+            int phys_domain; // element's attribute
+            int elem_domain; // another element's attribute (rarely used)
+            int n_partitions; // number of partitions where an element takes place
+
+            for (int d = 0; d < 4; d++)
+            {
+               elements_by_dim[d]->reserve(num_of_all_elements);
+            }
 
-                  // non-positive attributes are not allowed in MFEM
-                  if (phys_domain <= 0)
+            vector<int> data;
+            int n_elem_part = 0; // partial sum of elements that are read
+            int n_elem_one_type = 0; // number of elements of a specific type
+            for (int el = 0; el < num_of_all_elements; ++el)
+            {
+               if (binary)
+               {
+                  if (n_elem_one_type == 0)
                   {
-                     MFEM_ABORT("Non-positive element attribute in Gmsh mesh!");
+                     // header consists of 3 numbers: type of the element,
+                     // number of elements of this type, and number of tags
+                     const int header_size = 3;
+                     int header[header_size];
+                     input.read(reinterpret_cast<char*>(header),
+                                header_size*sizeof(int));
+                     type_of_element = header[0];
+                     n_elem_one_type = header[1];
+                     n_tags          = header[2];
+                     n_elem_part += n_elem_one_type;
+                     MFEM_VERIFY(n_elem_one_type > 0 &&
+                                 n_elem_part <= num_of_all_elements,
+                                 "Gmsh file : wrong binary format");
                   }
-
-                  // initialize the mesh element
-                  switch (type_of_element)
+                  n_elem_one_type--;
+                  MFEM_VERIFY(type_of_element >= 1 &&
+                              type_of_element <= num_gmsh_element_types,
+                              "Gmsh file : unknown element type "
+                              << type_of_element);
+                  const int n_elem_nodes =
+                     nodes_of_gmsh_element[type_of_element-1];
+                  data.resize(1+n_tags+n_elem_nodes);
+                  input.read(reinterpret_cast<char*>(&data[0]),
+                             data.size()*sizeof(int));
+                  // the serial number is followed by the tags and the nodes
+                  data.erase(data.begin());
+               }
+               else // ASCII
+               {
+                  serial_number = tokens.ReadInt();
+                  type_of_element = tokens.ReadInt();
+                  n_tags = tokens.ReadInt();
+                  MFEM_VERIFY(type_of_element >= 1 &&
+                              type_of_element <= num_gmsh_element_types,
+                              "Gmsh file : unknown element type "
+                              << type_of_element);
+                  const int n_elem_nodes =
+                     nodes_of_gmsh_element[type_of_element-1];
+                  data.resize(n_tags+n_elem_nodes);
+                  for (size_t i = 0; i < data.size(); i++)
                   {
-                     case 1: // 2-node line
-                     {
-                        elements_1D.push_back(
-                           new Segment(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     case 2: // 3-node triangle
-                     {
-                        elements_2D.push_back(
-                           new Triangle(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     case 3: // 4-node quadrangle
-                     {
-                        elements_2D.push_back(
-                           new Quadrilateral(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     case 4: // 4-node tetrahedron
-                     {
-#ifdef MFEM_USE_MEMALLOC
-                        elements_3D.push_back(TetMemory.Alloc());
-                        elements_3D.back()->SetVertices(&vert_indices[0]);
-                        elements_3D.back()->SetAttribute(phys_domain);
-#else
-                        elements_3D.push_back(
-                           new Tetrahedron(&vert_indices[0], phys_domain));
-#endif
-                        break;
-                     }
-                     case 5: // 8-node hexahedron
-                     {
-                        elements_3D.push_back(
-                           new Hexahedron(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     case 15: // 1-node point
-                     {
-                        elements_0D.push_back(
-                           new Point(&vert_indices[0], phys_domain));
-                        break;
-                     }
-                     default: // any other element
-                        MFEM_WARNING("Unsupported Gmsh element type.");
-                        break;
-
-                  } // switch (type_of_element)
-               } // el (elements of one type)
-            } // all elements
-         } // if binary
-         else // ASCII
-         {
-            for (int el = 0; el < num_of_all_elements; ++el)
-            {
-               input >> serial_number >> type_of_element >> n_tags;
-               vector<int> data(n_tags);
-               for (int i = 0; i < n_tags; ++i) { input >> data[i]; }
+                     data[i] = tokens.ReadInt();
+                  }
+               }
                // physical domain - the most important value (to distinguish
                // materials with different properties)
                phys_domain = (n_tags > 0) ? data[0] : 1;
@@ -1159,17 +1932,10 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                // we currently just skip the partitions if they exist, and go
                // directly to vertices describing the mesh element
                const int n_elem_nodes = nodes_of_gmsh_element[type_of_element-1];
-               vector<int> vert_indices(n_elem_nodes);
-               int index;
+               vert_indices.resize(n_elem_nodes);
                for (int vi = 0; vi < n_elem_nodes; ++vi)
                {
-                  input >> index;
-                  map<int, int>::const_iterator it = vertices_map.find(index);
-                  if (it == vertices_map.end())
-                  {
-                     MFEM_ABORT("Gmsh file : vertex index doesn't exist");
-                  }
-                  vert_indices[vi] = it->second;
+                  vert_indices[vi] = vertices_map.Find(data[n_tags+vi]);
                }
 
                // non-positive attributes are not allowed in MFEM
@@ -1179,57 +1945,22 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                }
 
                // initialize the mesh element
-               switch (type_of_element)
+               const Geometry::Type geom = GmshElementGeometry(type_of_element);
+               if (geom == Geometry::INVALID)
                {
-                  case 1: // 2-node line
-                  {
-                     elements_1D.push_back(
-                        new Segment(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  case 2: // 3-node triangle
-                  {
-                     elements_2D.push_back(
-                        new Triangle(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  case 3: // 4-node quadrangle
-                  {
-                     elements_2D.push_back(
-                        new Quadrilateral(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  case 4: // 4-node tetrahedron
-                  {
-#ifdef MFEM_USE_MEMALLOC
-                     elements_3D.push_back(TetMemory.Alloc());
-                     elements_3D.back()->SetVertices(&vert_indices[0]);
-                     elements_3D.back()->SetAttribute(phys_domain);
-#else
-                     elements_3D.push_back(
-                        new Tetrahedron(&vert_indices[0], phys_domain));
-#endif
-                     break;
-                  }
-                  case 5: // 8-node hexahedron
-                  {
-                     elements_3D.push_back(
-                        new Hexahedron(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  case 15: // 1-node point
-                  {
-                     elements_0D.push_back(
-                        new Point(&vert_indices[0], phys_domain));
-                     break;
-                  }
-                  default: // any other element
-                     MFEM_WARNING("Unsupported Gmsh element type.");
-                     break;
-
-               } // switch (type_of_element)
+                  MFEM_WARNING("Unsupported Gmsh element type.");
+                  continue;
+               }
+               Element *elem = NewElement(geom);
+               elem->SetVertices(vert_indices.data());
+               elem->SetAttribute(phys_domain);
+               elements_by_dim[Geometry::Dimension[geom]]->push_back(elem);
             } // el (all elements)
-         } // if ASCII
+
+            MFEM_CONTRACT_VAR(serial_number);
+            MFEM_CONTRACT_VAR(n_partitions);
+            MFEM_CONTRACT_VAR(elem_domain);
+         } // if version 2.2
 
          if (!elements_3D.empty())
          {
@@ -1298,10 +2029,6 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
             MFEM_ABORT("Gmsh file : no elements found");
             return;
          }
-
-         MFEM_CONTRACT_VAR(n_partitions);
-         MFEM_CONTRACT_VAR(elem_domain);
-
       } // section '$Elements'
       else if (buff == "$Periodic") // Reading master/slave node pairs
       {
@@ -1314,23 +2041,53 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
          {
             v2v[i] = i;
          }
-         int num_per_ent;
-         int num_nodes;
-         int slave, master;
-         input >> num_per_ent;
-         getline(input, buff); // Read end-of-line
-         for (int i = 0; i < num_per_ent; i++)
-         {
-            getline(input, buff); // Read and ignore entity dimension and tags
-            getline(input, buff); // Read and ignore affine mapping
-            // Read master/slave vertex pairs
-            input >> num_nodes;
-            for (int j=0; j<num_nodes; j++)
+         if (v41)
+         {
+            getline(input, buff);
+            const long long num_per_ent = GmshReadSize(input, tokens, binary);
+            std::vector<double> affine;
+            std::vector<long long> pairs;
+            for (long long i = 0; i < num_per_ent; i++)
             {
-               input >> slave >> master;
-               v2v[slave - 1] = master - 1;
+               // entity dimension, entity tag, and master entity tag
+               for (int j = 0; j < 3; j++)
+               {
+                  GmshReadInt(input, tokens, binary);
+               }
+               // ignore the affine mapping
+               affine.resize(GmshReadSize(input, tokens, binary));
+               GmshReadDoubles(input, tokens, binary, affine.size(),
+                               affine.data());
+               // read master/slave node pairs
+               pairs.resize(2*GmshReadSize(input, tokens, binary));
+               GmshReadSizes(input, tokens, binary, pairs.size(), pairs.data());
+               for (size_t j = 0; j < pairs.size(); j += 2)
+               {
+                  v2v[vertices_map.Find(pairs[j])] =
+                     vertices_map.Find(pairs[j+1]);
+               }
             }
+         }
+         else
+         {
+            int num_per_ent;
+            int num_nodes;
+            int slave, master;
+            input >> num_per_ent;
             getline(input, buff); // Read end-of-line
+            for (int i = 0; i < num_per_ent; i++)
+            {
+               getline(input, buff); // Read and ignore entity dimension and tags
+               getline(input, buff); // Read and ignore affine mapping
+               // Read master/slave vertex pairs
+               input >> num_nodes;
+               for (int j=0; j<num_nodes; j++)
+               {
+                  input >> slave >> master;
+                  v2v[vertices_map.Find(slave)] = vertices_map.Find(master);
+               }
+               getline(input, buff); // Read end-of-line
+            }
          }
 
          // Convert nodes to discontinuous GridFunction
@@ -22,6 +22,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 using namespace std;
 
@@ -1077,6 +1080,899 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    // TODO: AMR meshes, NURBS meshes?
 }
 
+// Helper functions for the construction of a ParMesh from distributed data.
+
+// Return the rank owning the global vertex 'gv', given the offsets of the
+// blocks of global vertices owned by each rank.
+static inline int VertexOwner(const Array<int> &vert_offsets, int gv)
+{
+   return int(std::upper_bound(vert_offsets.begin(), vert_offsets.end(), gv)
+              - vert_offsets.begin()) - 1;
+}
+
+// Compute the position 'pos' of every item in a buffer where the items are
+// grouped by their destination ranks 'dest' (preserving their order), and the
+// number of items sent to each rank, 'cnt'.
+static void GroupByRank(int nranks, const std::vector<int> &dest,
+                        std::vector<int> &pos, std::vector<int> &cnt)
+{
+   cnt.assign(nranks, 0);
+   for (size_t i = 0; i < dest.size(); i++) { cnt[dest[i]]++; }
+   std::vector<int> offset(nranks, 0);
+   for (int p = 1; p < nranks; p++) { offset[p] = offset[p-1] + cnt[p-1]; }
+   pos.resize(dest.size());
+   for (size_t i = 0; i < dest.size(); i++) { pos[i] = offset[dest[i]]++; }
+}
+
+// Copy the records of 'width' entries in 'data' to the positions 'pos' of
+// 'buf'.
+template <typename T>
+static void PackRecords(const std::vector<int> &pos, int width, const T *data,
+                        std::vector<T> &buf)
+{
+   buf.resize(pos.size()*width);
+   for (size_t i = 0; i < pos.size(); i++)
+   {
+      std::copy(data + i*width, data + (i+1)*width, &buf[0] + pos[i]*width);
+   }
+}
+
+static std::vector<int> ScaleCounts(const std::vector<int> &cnt, int width)
+{
+   std::vector<int> scnt(cnt);
+   for (size_t p = 0; p < scnt.size(); p++) { scnt[p] *= width; }
+   return scnt;
+}
+
+// Send scnt[p] consecutive entries of 'send' to rank p. On return, 'recv'
+// contains the entries received from all ranks, ordered by source rank, and
+// rcnt[p] is the number of entries received from rank p.
+template <typename T>
+static void ExchangeData(MPI_Comm comm, MPI_Datatype type,
+                         const std::vector<int> &scnt,
+                         const std::vector<T> &send,
+                         std::vector<int> &rcnt, std::vector<T> &recv)
+{
+   const int nranks = scnt.size();
+   std::vector<int> sdispl(nranks), rdispl(nranks);
+   rcnt.resize(nranks);
+   MPI_Alltoall(const_cast<int*>(scnt.data()), 1, MPI_INT,
+                rcnt.data(), 1, MPI_INT, comm);
+   int ssize = 0, rsize = 0;
+   for (int p = 0; p < nranks; p++)
+   {
+      sdispl[p] = ssize;
+      rdispl[p] = rsize;
+      ssize += scnt[p];
+      rsize += rcnt[p];
+   }
+   recv.resize(rsize);
+   MPI_Alltoallv(const_cast<T*>(send.data()), const_cast<int*>(scnt.data()),
+                 sdispl.data(), type, recv.data(), rcnt.data(), rdispl.data(),
+                 type, comm);
+}
+
+// Fetch from their owners the coordinates of the global vertices 'gv', given
+// in increasing order.
+static void FetchVertexCoordinates(MPI_Comm comm,
+                                   const Array<int> &vert_offsets,
+                                   const double *coords, int sdim,
+                                   const std::vector<int> &gv,
+                                   std::vector<double> &gv_coords)
+{
+   const int nranks = vert_offsets.Size()-1;
+   int myrank;
+   MPI_Comm_rank(comm, &myrank);
+
+   std::vector<int> scnt(nranks, 0), rcnt, rverts;
+   for (size_t i = 0; i < gv.size(); i++)
+   {
+      scnt[VertexOwner(vert_offsets, gv[i])]++;
+   }
+   ExchangeData(comm, MPI_INT, scnt, gv, rcnt, rverts);
+
+   const int first = vert_offsets[myrank];
+   std::vector<double> reply(rverts.size()*sdim);
+   for (size_t i = 0; i < rverts.size(); i++)
+   {
+      const double *x = coords + (rverts[i] - first)*sdim;
+      std::copy(x, x + sdim, &reply[0] + i*sdim);
+   }
+   std::vector<int> ccnt;
+   ExchangeData(comm, MPI_DOUBLE, ScaleCounts(rcnt, sdim), reply, ccnt,
+                gv_coords);
+}
+
+// Return the index of the point with integer coordinates 'x' (each with
+// 'bits' bits, 'x' is overwritten) along the Hilbert curve in 'dim'
+// dimensions. The point is first transformed to the transposed Hilbert index
+// following J. Skilling, "Programming the Hilbert curve", AIP Conference
+// Proceedings 707, 2004.
+static unsigned long long HilbertKey(unsigned *x, int dim, int bits)
+{
+   const unsigned M = 1u << (bits-1);
+   if (dim > 1)
+   {
+      // inverse undo
+      for (unsigned Q = M; Q > 1; Q >>= 1)
+      {
+         const unsigned P = Q - 1;
+         for (int i = 0; i < dim; i++)
+         {
+            if (x[i] & Q) { x[0] ^= P; }
+            else
+            {
+               const unsigned t = (x[0] ^ x[i]) & P;
+               x[0] ^= t;
+               x[i] ^= t;
+            }
+         }
+      }
+      // Gray encode
+      for (int i = 1; i < dim; i++) { x[i] ^= x[i-1]; }
+      unsigned t = 0;
+      for (unsigned Q = M; Q > 1; Q >>= 1)
+      {
+         if (x[dim-1] & Q) { t ^= Q - 1; }
+      }
+      for (int i = 0; i < dim; i++) { x[i] ^= t; }
+   }
+   unsigned long long key = 0;
+   for (int b = bits-1; b >= 0; b--)
+   {
+      for (int i = 0; i < dim; i++)
+      {
+         key = (key << 1) | ((x[i] >> b) & 1u);
+      }
+   }
+   return key;
+}
+
+// Compute the keys 'key' of the points 'x' (ordered byVDIM) along the Hilbert
+// curve through the global bounding box of the points on all ranks.
+static void HilbertKeys(MPI_Comm comm, int sdim, const std::vector<double> &x,
+                        std::vector<unsigned long long> &key)
+{
+   std::vector<double> loc_box(2*sdim, std::numeric_limits<double>::max());
+   std::vector<double> box(2*sdim);
+   for (size_t i = 0; i < x.size(); i++)
+   {
+      const int d = i % sdim;
+      loc_box[d] = std::min(loc_box[d], x[i]);
+      loc_box[sdim+d] = std::min(loc_box[sdim+d], -x[i]);
+   }
+   MPI_Allreduce(loc_box.data(), box.data(), 2*sdim, MPI_DOUBLE, MPI_MIN,
+                 comm);
+
+   const int bits = std::min(32, 64/sdim);
+   const double max_coord = double((1ull << bits) - 1);
+   const int n = x.size()/sdim;
+   unsigned ix[3];
+   key.resize(n);
+   for (int i = 0; i < n; i++)
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         const double len = -box[sdim+d] - box[d];
+         const double c = (len > 0.0) ? (x[i*sdim+d] - box[d])/len : 0.0;
+         ix[d] = unsigned(std::min(std::max(c, 0.0), 1.0)*max_coord);
+      }
+      key[i] = HilbertKey(ix, sdim, bits);
+   }
+}
+
+// Split the curve into NRanks consecutive pieces with approximately equal
+// total weight of the elements with keys 'key' and weights 'weight' (or unit
+// weights, if NULL), and return the rank of each element in 'part'. The
+// NRanks-1 splitters are found simultaneously with a binary search over the
+// key space, each step of which requires one MPI_Allreduce.
+static void PartitionCurve(MPI_Comm comm,
+                           const std::vector<unsigned long long> &key,
+                           const double *weight, std::vector<int> &part)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+   const int n = key.size();
+
+   std::vector<int> perm(n);
+   for (int i = 0; i < n; i++) { perm[i] = i; }
+   std::sort(perm.begin(), perm.end(),
+             [&key](int a, int b) { return key[a] < key[b]; });
+   std::vector<unsigned long long> skey(n);
+   std::vector<double> wsum(n+1);
+   wsum[0] = 0.0;
+   for (int i = 0; i < n; i++)
+   {
+      skey[i] = key[perm[i]];
+      wsum[i+1] = wsum[i] + (weight ? weight[perm[i]] : 1.0);
+   }
+   double total;
+   MPI_Allreduce(&wsum[n], &total, 1, MPI_DOUBLE, MPI_SUM, comm);
+
+   // splitter r is the smallest key with total weight of the keys up to it
+   // (inclusive) not less than (r+1)*total/nranks
+   const int ns = nranks-1;
+   std::vector<unsigned long long> lo(ns, 0ull), hi(ns, ~0ull), mid(ns);
+   std::vector<double> loc_w(ns), glob_w(ns);
+   for (bool done = (ns == 0); !done; )
+   {
+      for (int r = 0; r < ns; r++)
+      {
+         mid[r] = lo[r] + (hi[r] - lo[r])/2;
+         loc_w[r] = wsum[std::upper_bound(skey.begin(), skey.end(), mid[r])
+                         - skey.begin()];
+      }
+      MPI_Allreduce(loc_w.data(), glob_w.data(), ns, MPI_DOUBLE, MPI_SUM,
+                    comm);
+      done = true;
+      for (int r = 0; r < ns; r++)
+      {
+         if (glob_w[r] >= total*(r+1)/nranks) { hi[r] = mid[r]; }
+         else { lo[r] = mid[r] + 1; }
+         done = done && (lo[r] == hi[r]);
+      }
+   }
+
+   part.resize(n);
+   for (int i = 0; i < n; i++)
+   {
+      part[i] = std::lower_bound(hi.begin(), hi.end(), key[i]) - hi.begin();
+   }
+}
+
+// Fill 'fv' with the vertices of the facets of the reference element 'geom'
+// (i.e. the faces in 3D, the edges in 2D, the vertices in 1D), padded with -1
+// to four vertices per facet.
+template <Geometry::Type Geom>
+static void GetFaceVertices(std::vector<int> &fv)
+{
+   typedef Geometry::Constants<Geom> gc;
+   fv.assign(4*gc::NumFaces, -1);
+   for (int f = 0; f < gc::NumFaces; f++)
+   {
+      for (int j = 0; j < gc::MaxFaceVert; j++)
+      {
+         fv[4*f+j] = gc::FaceVert[f][j];
+      }
+   }
+}
+
+template <Geometry::Type Geom>
+static void GetEdgeVertices(std::vector<int> &fv)
+{
+   typedef Geometry::Constants<Geom> gc;
+   fv.assign(4*gc::NumEdges, -1);
+   for (int e = 0; e < gc::NumEdges; e++)
+   {
+      fv[4*e+0] = gc::Edges[e][0];
+      fv[4*e+1] = gc::Edges[e][1];
+   }
+}
+
+static int GetFacetVertices(Geometry::Type geom, std::vector<int> &fv)
+{
+   switch (geom)
+   {
+      case Geometry::SEGMENT:
+         fv.assign(8, -1);
+         fv[0] = 0;
+         fv[4] = 1;
+         break;
+      case Geometry::TRIANGLE:
+         GetEdgeVertices<Geometry::TRIANGLE>(fv); break;
+      case Geometry::SQUARE:
+         GetEdgeVertices<Geometry::SQUARE>(fv); break;
+      case Geometry::TETRAHEDRON:
+         GetFaceVertices<Geometry::TETRAHEDRON>(fv); break;
+      case Geometry::CUBE:
+         GetFaceVertices<Geometry::CUBE>(fv); break;
+      case Geometry::PRISM:
+         GetFaceVertices<Geometry::PRISM>(fv); break;
+      default:
+         MFEM_ABORT("invalid element geometry: " << geom);
+   }
+   return fv.size()/4;
+}
+
+// Sort the 'n' vertices 'v' and pad them with -1 to 'ks' entries to obtain the
+// key of an entity.
+static void MakeEntityKey(const int *v, int n, int ks, int *key)
+{
+   std::copy(v, v + n, key);
+   std::sort(key, key + n);
+   std::fill(key + n, key + ks, -1);
+}
+
+static bool KeyLess(const int *a, const int *b, int ks)
+{
+   return std::lexicographical_compare(a, a + ks, b, b + ks);
+}
+
+// Return the permutation sorting the keys of 'ks' entries in 'keys'.
+static void SortKeys(int ks, const std::vector<int> &keys,
+                     std::vector<int> &perm)
+{
+   perm.resize(keys.size()/ks);
+   for (size_t i = 0; i < perm.size(); i++) { perm[i] = i; }
+   const int *k = keys.data();
+   std::sort(perm.begin(), perm.end(), [k, ks](int a, int b)
+   { return KeyLess(k + a*ks, k + b*ks, ks); });
+}
+
+// Determine the ranks holding each of the entities given by their keys of 'ks'
+// global vertex numbers in 'keys', see MakeEntityKey(). Every rank holding an
+// entity must call this function with its key; the queries are resolved by
+// the owner of the first vertex of the key. On return, row i of 'ent_ranks'
+// lists the ranks holding entity i, in increasing order.
+static void FindEntityRanks(MPI_Comm comm, const Array<int> &vert_offsets,
+                            int ks, const std::vector<int> &keys,
+                            Table &ent_ranks)
+{
+   const int nranks = vert_offsets.Size()-1;
+   const int n = keys.size()/ks;
+
+   std::vector<int> dest(n), pos, cnt, rcnt, rkeys;
+   for (int i = 0; i < n; i++)
+   {
+      dest[i] = VertexOwner(vert_offsets, keys[i*ks]);
+   }
+   GroupByRank(nranks, dest, pos, cnt);
+   {
+      std::vector<int> sbuf;
+      PackRecords(pos, ks, keys.data(), sbuf);
+      ExchangeData(comm, MPI_INT, ScaleCounts(cnt, ks), sbuf, rcnt, rkeys);
+   }
+
+   // find the ranks of each received key
+   const int m = rkeys.size()/ks;
+   std::vector<int> src(m), perm;
+   for (int p = 0, j = 0; p < nranks; p++)
+   {
+      for (int k = 0; k < rcnt[p]/ks; k++) { src[j++] = p; }
+   }
+   SortKeys(ks, rkeys, perm);
+   std::vector<int> first(m), size(m);
+   for (int a = 0, b; a < m; a = b)
+   {
+      const int *ka = &rkeys[perm[a]*ks];
+      b = a+1;
+      while (b < m && std::equal(ka, ka + ks, &rkeys[perm[b]*ks])) { b++; }
+      std::sort(perm.begin() + a, perm.begin() + b,
+                [&src](int x, int y) { return src[x] < src[y]; });
+      for (int c = a; c < b; c++)
+      {
+         first[perm[c]] = a;
+         size[perm[c]] = b - a;
+      }
+   }
+
+   // reply to each source, in the order of its queries, with the number of
+   // ranks followed by the ranks
+   std::vector<int> reply, reply_cnt(nranks, 0), rreply, rreply_cnt;
+   for (int p = 0, j = 0; p < nranks; p++)
+   {
+      for (int k = 0; k < rcnt[p]/ks; k++, j++)
+      {
+         reply.push_back(size[j]);
+         for (int c = 0; c < size[j]; c++)
+         {
+            reply.push_back(src[perm[first[j]+c]]);
+         }
+         reply_cnt[p] += 1 + size[j];
+      }
+   }
+   ExchangeData(comm, MPI_INT, reply_cnt, reply, rreply_cnt, rreply);
+
+   // the replies arrive in the order of the packed queries
+   std::vector<int> order(n), offset(n);
+   for (int i = 0; i < n; i++) { order[pos[i]] = i; }
+   for (int k = 0, r = 0; k < n; k++)
+   {
+      offset[order[k]] = r;
+      r += 1 + rreply[r];
+   }
+   ent_ranks.MakeI(n);
+   for (int i = 0; i < n; i++)
+   {
+      ent_ranks.AddColumnsInRow(i, rreply[offset[i]]);
+   }
+   ent_ranks.MakeJ();
+   for (int i = 0; i < n; i++)
+   {
+      ent_ranks.AddConnections(i, &rreply[offset[i]+1], rreply[offset[i]]);
+   }
+   ent_ranks.ShiftUpI();
+}
+
+// Determine the ranks receiving the boundary elements: every boundary element
+// (with key 'bdr_keys') goes to the lowest rank 'facet_rank' of the facets
+// (with keys 'facet_keys') of the elements containing it.
+static void FindBoundaryRanks(MPI_Comm comm, const Array<int> &vert_offsets,
+                              int ks, const std::vector<int> &facet_keys,
+                              const std::vector<int> &facet_rank,
+                              const std::vector<int> &bdr_keys,
+                              std::vector<int> &bdr_rank)
+{
+   const int nranks = vert_offsets.Size()-1;
+   const int nf = facet_rank.size(), nb = bdr_keys.size()/ks;
+
+   // send the facets, with their ranks appended, to the owners of their keys
+   std::vector<int> rfacets;
+   {
+      std::vector<int> recs(nf*(ks+1)), dest(nf), pos, cnt, sbuf, rcnt;
+      for (int i = 0; i < nf; i++)
+      {
+         std::copy(&facet_keys[i*ks], &facet_keys[i*ks] + ks, &recs[i*(ks+1)]);
+         recs[i*(ks+1)+ks] = facet_rank[i];
+         dest[i] = VertexOwner(vert_offsets, facet_keys[i*ks]);
+      }
+      GroupByRank(nranks, dest, pos, cnt);
+      PackRecords(pos, ks+1, recs.data(), sbuf);
+      ExchangeData(comm, MPI_INT, ScaleCounts(cnt, ks+1), sbuf, rcnt, rfacets);
+   }
+
+   // send the boundary element keys to the same owners
+   std::vector<int> bdest(nb), bpos, bcnt, rbkeys, rbcnt;
+   {
+      std::vector<int> sbuf;
+      for (int i = 0; i < nb; i++)
+      {
+         bdest[i] = VertexOwner(vert_offsets, bdr_keys[i*ks]);
+      }
+      GroupByRank(nranks, bdest, bpos, bcnt);
+      PackRecords(bpos, ks, bdr_keys.data(), sbuf);
+      ExchangeData(comm, MPI_INT, ScaleCounts(bcnt, ks), sbuf, rbcnt, rbkeys);
+   }
+
+   // match: sorting the facet records by (key, rank) puts the lowest rank of
+   // each key first
+   const int k1 = ks+1, mf = rfacets.size()/k1, mb = rbkeys.size()/ks;
+   std::vector<int> fperm, reply(mb);
+   SortKeys(k1, rfacets, fperm);
+   for (int j = 0; j < mb; j++)
+   {
+      const int *key = &rbkeys[j*ks];
+      int a = 0, b = mf; // find the first facet with key not less than 'key'
+      while (a < b)
+      {
+         const int c = (a + b)/2;
+         if (KeyLess(&rfacets[fperm[c]*k1], key, ks)) { a = c + 1; }
+         else { b = c; }
+      }
+      MFEM_VERIFY(a < mf && std::equal(key, key + ks, &rfacets[fperm[a]*k1]),
+                  "boundary element is not a face of any element");
+      reply[j] = rfacets[fperm[a]*k1 + ks];
+   }
+
+   // the replies arrive in the order of the packed boundary keys
+   std::vector<int> reply_cnt(nranks), rreply, rreply_cnt;
+   for (int p = 0; p < nranks; p++) { reply_cnt[p] = rbcnt[p]/ks; }
+   ExchangeData(comm, MPI_INT, reply_cnt, reply, rreply_cnt, rreply);
+   bdr_rank.resize(nb);
+   for (int i = 0; i < nb; i++) { bdr_rank[i] = rreply[bpos[i]]; }
+}
+
+ParMesh::ParMesh(MPI_Comm comm, const double *vertices_, int num_vertices,
+                 const int *element_indices, Geometry::Type element_type,
+                 const int *element_attributes, int num_elements,
+                 const int *boundary_indices, Geometry::Type boundary_type,
+                 const int *boundary_attributes, int num_boundary_elements,
+                 int dimension, int space_dimension, bool refine)
+   : glob_elem_offset(-1)
+   , glob_offset_sequence(-1)
+   , gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   ncmesh = pncmesh = NULL;
+
+   if (space_dimension == -1)
+   {
+      space_dimension = dimension;
+   }
+   const int sdim = space_dimension;
+   MFEM_VERIFY(Geometry::Dimension[element_type] == dimension &&
+               Geometry::Dimension[boundary_type] == dimension-1,
+               "invalid element or boundary element geometry");
+   const int nv_el = Geometry::NumVerts[element_type];
+   const int nv_be = Geometry::NumVerts[boundary_type];
+
+   // the global vertices vert_offsets[p] <= gv < vert_offsets[p+1] are owned
+   // by rank p
+   Array<int> vert_offsets(NRanks+1);
+   vert_offsets[0] = 0;
+   MPI_Allgather(&num_vertices, 1, MPI_INT, vert_offsets.GetData()+1, 1,
+                 MPI_INT, MyComm);
+   vert_offsets.PartialSum();
+
+   // fetch the coordinates of the vertices of the given elements
+   std::vector<int> in_verts(element_indices,
+                             element_indices + num_elements*nv_el);
+   std::sort(in_verts.begin(), in_verts.end());
+   in_verts.erase(std::unique(in_verts.begin(), in_verts.end()),
+                  in_verts.end());
+   std::vector<double> in_coords;
+   FetchVertexCoordinates(MyComm, vert_offsets, vertices_, sdim, in_verts,
+                          in_coords);
+
+   // copy the vertex coordinates of each element, to be sent with it
+   std::vector<double> el_coords(num_elements*nv_el*sdim);
+   for (int i = 0; i < num_elements*nv_el; i++)
+   {
+      const int k = std::lower_bound(in_verts.begin(), in_verts.end(),
+                                     element_indices[i]) - in_verts.begin();
+      std::copy(&in_coords[k*sdim], &in_coords[k*sdim] + sdim,
+                &el_coords[i*sdim]);
+   }
+
+   // compute the keys of the element centers along the Hilbert curve
+   std::vector<unsigned long long> el_key;
+   {
+      std::vector<double> centers(num_elements*sdim, 0.0);
+      for (int i = 0; i < num_elements; i++)
+      {
+         for (int j = 0; j < nv_el; j++)
+         {
+            for (int d = 0; d < sdim; d++)
+            {
+               centers[i*sdim+d] += el_coords[(i*nv_el+j)*sdim+d]/nv_el;
+            }
+         }
+      }
+      HilbertKeys(MyComm, sdim, centers, el_key);
+   }
+
+   // partition the elements
+   std::vector<int> el_rank;
+   PartitionCurve(MyComm, el_key, NULL, el_rank);
+
+   // the boundary elements go to the lowest rank of the elements containing
+   // them
+   std::vector<int> be_rank;
+   {
+      const int ks = (dimension == 3) ? 4 : dimension;
+      std::vector<int> fv;
+      const int nf = GetFacetVertices(element_type, fv);
+
+      std::vector<int> facet_keys(num_elements*nf*ks);
+      std::vector<int> facet_rank(num_elements*nf);
+      for (int i = 0; i < num_elements; i++)
+      {
+         const int *ev = element_indices + i*nv_el;
+         for (int f = 0; f < nf; f++)
+         {
+            int v[4], n = 0;
+            for ( ; n < 4 && fv[4*f+n] >= 0; n++) { v[n] = ev[fv[4*f+n]]; }
+            MakeEntityKey(v, n, ks, &facet_keys[(i*nf+f)*ks]);
+            facet_rank[i*nf+f] = el_rank[i];
+         }
+      }
+      std::vector<int> bdr_keys(num_boundary_elements*ks);
+      for (int i = 0; i < num_boundary_elements; i++)
+      {
+         MakeEntityKey(boundary_indices + i*nv_be, nv_be, ks, &bdr_keys[i*ks]);
+      }
+      FindBoundaryRanks(MyComm, vert_offsets, ks, facet_keys, facet_rank,
+                        bdr_keys, be_rank);
+   }
+
+   // migrate the elements: attribute and vertices, vertex coordinates, key
+   std::vector<int> el_ints, el_int_cnt;
+   std::vector<double> el_dbls;
+   std::vector<unsigned long long> el_keys;
+   {
+      std::vector<int> pos, cnt, rcnt, ibuf(num_elements*(1+nv_el)), sbuf;
+      for (int i = 0; i < num_elements; i++)
+      {
+         ibuf[i*(1+nv_el)] = element_attributes[i];
+         std::copy(element_indices + i*nv_el, element_indices + (i+1)*nv_el,
+                   &ibuf[i*(1+nv_el)+1]);
+      }
+      GroupByRank(NRanks, el_rank, pos, cnt);
+      PackRecords(pos, 1+nv_el, ibuf.data(), sbuf);
+      ExchangeData(MyComm, MPI_INT, ScaleCounts(cnt, 1+nv_el), sbuf,
+                   el_int_cnt, el_ints);
+
+      std::vector<double> dbuf;
+      PackRecords(pos, nv_el*sdim, el_coords.data(), dbuf);
+      ExchangeData(MyComm, MPI_DOUBLE, ScaleCounts(cnt, nv_el*sdim), dbuf,
+                   rcnt, el_dbls);
+
+      std::vector<unsigned long long> kbuf;
+      PackRecords(pos, 1, el_key.data(), kbuf);
+      ExchangeData(MyComm, MPI_UNSIGNED_LONG_LONG, cnt, kbuf, rcnt, el_keys);
+   }
+
+   // migrate the boundary elements: attribute and vertices
+   std::vector<int> be_ints;
+   {
+      std::vector<int> pos, cnt, rcnt, ibuf(num_boundary_elements*(1+nv_be));
+      std::vector<int> sbuf;
+      for (int i = 0; i < num_boundary_elements; i++)
+      {
+         ibuf[i*(1+nv_be)] = boundary_attributes[i];
+         std::copy(boundary_indices + i*nv_be, boundary_indices + (i+1)*nv_be,
+                   &ibuf[i*(1+nv_be)+1]);
+      }
+      GroupByRank(NRanks, be_rank, pos, cnt);
+      PackRecords(pos, 1+nv_be, ibuf.data(), sbuf);
+      ExchangeData(MyComm, MPI_INT, ScaleCounts(cnt, 1+nv_be), sbuf, rcnt,
+                   be_ints);
+   }
+
+   // the local vertices, in increasing global order
+   const int ne = el_keys.size(), nbe = be_ints.size()/(1+nv_be);
+   Array<int> vert_gid(ne*nv_el);
+   for (int i = 0; i < ne; i++)
+   {
+      for (int j = 0; j < nv_el; j++)
+      {
+         vert_gid[i*nv_el+j] = el_ints[i*(1+nv_el)+1+j];
+      }
+   }
+   vert_gid.Sort();
+   vert_gid.Unique();
+
+   InitMesh(dimension, sdim, vert_gid.Size(), ne, nbe);
+   NumOfVertices = vert_gid.Size();
+
+   // the local elements, ordered along the curve
+   std::vector<int> el_order(ne);
+   for (int i = 0; i < ne; i++) { el_order[i] = i; }
+   std::stable_sort(el_order.begin(), el_order.end(), [&el_keys](int a, int b)
+   { return el_keys[a] < el_keys[b]; });
+   int lv[8];
+   for (int i = 0; i < ne; i++)
+   {
+      const int k = el_order[i];
+      const int *rec = &el_ints[k*(1+nv_el)];
+      for (int j = 0; j < nv_el; j++)
+      {
+         lv[j] = vert_gid.FindSorted(rec[1+j]);
+         double *x = vertices[lv[j]]();
+         for (int d = 0; d < sdim; d++)
+         {
+            x[d] = el_dbls[(k*nv_el+j)*sdim+d];
+         }
+      }
+      elements[i] = NewElement(element_type);
+      elements[i]->SetVertices(lv);
+      elements[i]->SetAttribute(rec[0]);
+   }
+   NumOfElements = ne;
+
+   for (int i = 0; i < nbe; i++)
+   {
+      const int *rec = &be_ints[i*(1+nv_be)];
+      for (int j = 0; j < nv_be; j++)
+      {
+         lv[j] = vert_gid.FindSorted(rec[1+j]);
+         MFEM_ASSERT(lv[j] >= 0, "invalid boundary element vertex");
+      }
+      boundary[i] = NewElement(boundary_type);
+      boundary[i]->SetVertices(lv);
+      boundary[i]->SetAttribute(rec[0]);
+   }
+   NumOfBdrElements = nbe;
+
+   // the boundary is given: on the boundary of a local mesh there are
+   // shared faces too
+   FinalizeTopology(false);
+   ReduceMeshGen(); // determine the global 'meshgen'
+
+   BuildSharedEntities(vert_offsets, vert_gid);
+
+   const bool fix_orientation = false;
+   Finalize(refine, fix_orientation);
+}
+
+void ParMesh::BuildSharedEntities(const Array<int> &vert_offsets,
+                                  const Array<int> &vert_gid)
+{
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   {
+      // the first group is the local one
+      group.Recreate(1, &MyRank);
+      groups.Insert(group);
+   }
+   Table ent_ranks;
+
+   // shared vertices: query all local vertices
+   Array<int> vert_group(NumOfVertices);
+   {
+      std::vector<int> keys(vert_gid.begin(), vert_gid.end());
+      FindEntityRanks(MyComm, vert_offsets, 1, keys, ent_ranks);
+   }
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      vert_group[i] = -1;
+      if (ent_ranks.RowSize(i) > 1)
+      {
+         group.Recreate(ent_ranks.RowSize(i), ent_ranks.GetRow(i));
+         vert_group[i] = groups.Insert(group) - 1;
+      }
+   }
+
+   // Candidate shared edges and faces: in 3D, the edges and the faces with
+   // one local element, which have only shared vertices; in 2D, the edges
+   // with one local element. The local vertices follow the global vertex
+   // order, so sorting the candidates by their local keys orders the shared
+   // entities of each group identically on all of its ranks.
+   std::vector<int> edge_keys, face_keys, face_ids, perm;
+   if (Dim > 1)
+   {
+      Table *edge_vert = GetEdgeVertexTable();
+      for (int e = 0; e < NumOfEdges; e++)
+      {
+         const int *v = edge_vert->GetRow(e);
+         if (vert_group[v[0]] < 0 || vert_group[v[1]] < 0) { continue; }
+         if (Dim == 2 && faces_info[e].Elem2No >= 0) { continue; }
+         edge_keys.push_back(std::min(v[0], v[1]));
+         edge_keys.push_back(std::max(v[0], v[1]));
+      }
+   }
+   if (Dim > 2)
+   {
+      for (int f = 0; f < NumOfFaces; f++)
+      {
+         if (faces_info[f].Elem2No >= 0) { continue; }
+         const int *v = faces[f]->GetVertices();
+         const int nv = faces[f]->GetNVertices();
+         int j = 0;
+         while (j < nv && vert_group[v[j]] >= 0) { j++; }
+         if (j < nv) { continue; }
+         face_keys.resize(face_keys.size()+4);
+         MakeEntityKey(v, nv, 4, &face_keys[face_keys.size()-4]);
+         face_ids.push_back(f);
+      }
+   }
+   {
+      std::vector<int> tmp(edge_keys);
+      SortKeys(2, tmp, perm);
+      for (size_t k = 0; k < perm.size(); k++)
+      {
+         edge_keys[2*k] = tmp[2*perm[k]];
+         edge_keys[2*k+1] = tmp[2*perm[k]+1];
+      }
+      tmp = face_keys;
+      std::vector<int> tmp_ids(face_ids);
+      SortKeys(4, tmp, perm);
+      for (size_t k = 0; k < perm.size(); k++)
+      {
+         std::copy(&tmp[4*perm[k]], &tmp[4*perm[k]] + 4, &face_keys[4*k]);
+         face_ids[k] = tmp_ids[perm[k]];
+      }
+   }
+
+   // shared edges
+   const int ne = edge_keys.size()/2;
+   Array<int> edge_group(ne);
+   {
+      std::vector<int> keys(edge_keys.size());
+      for (size_t i = 0; i < keys.size(); i++)
+      {
+         keys[i] = vert_gid[edge_keys[i]];
+      }
+      FindEntityRanks(MyComm, vert_offsets, 2, keys, ent_ranks);
+   }
+   for (int i = 0; i < ne; i++)
+   {
+      edge_group[i] = -1;
+      if (ent_ranks.RowSize(i) > 1)
+      {
+         group.Recreate(ent_ranks.RowSize(i), ent_ranks.GetRow(i));
+         edge_group[i] = groups.Insert(group) - 1;
+      }
+   }
+
+   // shared faces
+   const int nf = face_ids.size();
+   Array<int> face_group(nf);
+   {
+      std::vector<int> keys(face_keys.size());
+      for (size_t i = 0; i < keys.size(); i++)
+      {
+         keys[i] = (face_keys[i] >= 0) ? vert_gid[face_keys[i]] : -1;
+      }
+      FindEntityRanks(MyComm, vert_offsets, 4, keys, ent_ranks);
+   }
+   for (int i = 0; i < nf; i++)
+   {
+      face_group[i] = -1;
+      if (ent_ranks.RowSize(i) > 1)
+      {
+         group.Recreate(ent_ranks.RowSize(i), ent_ranks.GetRow(i));
+         face_group[i] = groups.Insert(group) - 1;
+      }
+   }
+
+   // build the group communication topology
+   gtopo.Create(groups, 822);
+   const int ngroups = groups.Size()-1;
+
+   // fill out group_svert and svert_lvert
+   group_svert.MakeI(ngroups);
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      if (vert_group[i] >= 0) { group_svert.AddAColumnInRow(vert_group[i]); }
+   }
+   group_svert.MakeJ();
+   svert_lvert.SetSize(0);
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      if (vert_group[i] >= 0)
+      {
+         group_svert.AddConnection(vert_group[i], svert_lvert.Size());
+         svert_lvert.Append(i);
+      }
+   }
+   group_svert.ShiftUpI();
+
+   // fill out group_sedge and shared_edges, oriented from the lower to the
+   // higher global vertex number
+   group_sedge.MakeI(ngroups);
+   for (int i = 0; i < ne; i++)
+   {
+      if (edge_group[i] >= 0) { group_sedge.AddAColumnInRow(edge_group[i]); }
+   }
+   group_sedge.MakeJ();
+   for (int i = 0; i < ne; i++)
+   {
+      if (edge_group[i] >= 0)
+      {
+         group_sedge.AddConnection(edge_group[i], shared_edges.Size());
+         shared_edges.Append(new Segment(edge_keys[2*i], edge_keys[2*i+1], 1));
+      }
+   }
+   group_sedge.ShiftUpI();
+
+   // fill out group_stria, group_squad, shared_trias and shared_quads; the
+   // vertices of a shared face start with its lowest global vertex, followed
+   // by its lower neighbor
+   group_stria.MakeI(ngroups);
+   group_squad.MakeI(ngroups);
+   for (int i = 0; i < nf; i++)
+   {
+      if (face_group[i] < 0) { continue; }
+      if (faces[face_ids[i]]->GetType() == Element::TRIANGLE)
+      {
+         group_stria.AddAColumnInRow(face_group[i]);
+      }
+      else
+      {
+         group_squad.AddAColumnInRow(face_group[i]);
+      }
+   }
+   group_stria.MakeJ();
+   group_squad.MakeJ();
+   for (int i = 0; i < nf; i++)
+   {
+      if (face_group[i] < 0) { continue; }
+      const int *v = faces[face_ids[i]]->GetVertices();
+      if (faces[face_ids[i]]->GetType() == Element::TRIANGLE)
+      {
+         group_stria.AddConnection(face_group[i], shared_trias.Size());
+         shared_trias.Append(Vert3(face_keys[4*i], face_keys[4*i+1],
+                                   face_keys[4*i+2]));
+      }
+      else
+      {
+         int m = 0;
+         for (int j = 1; j < 4; j++) { if (v[j] < v[m]) { m = j; } }
+         const int s = (v[(m+1)%4] < v[(m+3)%4]) ? 1 : 3;
+         group_squad.AddConnection(face_group[i], shared_quads.Size());
+         shared_quads.Append(Vert4(v[m], v[(m+s)%4], v[(m+2*s)%4],
+                                   v[(m+3*s)%4]));
+      }
+   }
+   group_stria.ShiftUpI();
+   group_squad.ShiftUpI();
+}
+
 ParMesh::ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type)
    : Mesh(orig_mesh, ref_factor, ref_type),
      MyComm(orig_mesh->GetComm()),
@@ -1338,7 +2234,7 @@ long ParMesh::GetGlobalElementNum(int local_element_num) const
 void ParMesh::DistributeAttributes(Array<int> &attr)
 {
    // Determine the largest attribute number across all processors
-   int max_attr = attr.Max();
+   int max_attr = attr.Size() ? attr.Max() : 0;
    int glb_max_attr = -1;
    MPI_Allreduce(&max_attr, &glb_max_attr, 1, MPI_INT, MPI_MAX, MyComm);
 
@@ -3376,7 +4272,16 @@ bool ParMesh::NonconformingDerefinement(Array<double> &elem_error,
 
 void ParMesh::Rebalance()
 {
-   RebalanceImpl(NULL); // default SFC-based partition
+   if (Conforming())
+   {
+      Array<int> partition;
+      ComputeRebalancePartition(NULL, partition);
+      RebalanceImpl(&partition);
+   }
+   else
+   {
+      RebalanceImpl(NULL); // default SFC-based partition
+   }
 }
 
 void ParMesh::Rebalance(const Array<int> &partition)
@@ -3384,13 +4289,82 @@ void ParMesh::Rebalance(const Array<int> &partition)
    RebalanceImpl(&partition);
 }
 
-void ParMesh::RebalanceImpl(const Array<int> *partition)
+void ParMesh::Rebalance(const Vector &elem_weights)
 {
-   if (Conforming())
+   MFEM_VERIFY(elem_weights.Size() == GetNE(),
+               "invalid number of element weights: " << elem_weights.Size());
+   Array<int> partition;
+   ComputeRebalancePartition(&elem_weights, partition);
+   RebalanceImpl(&partition);
+}
+
+void ParMesh::ComputeRebalancePartition(const Vector *elem_weights,
+                                        Array<int> &partition) const
+{
+   const int ne = GetNE();
+   partition.SetSize(ne);
+
+   if (Nonconforming())
+   {
+      // split the global sequence of leaf elements, each rank having a
+      // contiguous part of it, by the running sum of the weights
+      double my_weight = 0.0, prefix, total;
+      for (int i = 0; i < ne; i++)
+      {
+         my_weight += elem_weights ? (*elem_weights)(i) : 1.0;
+      }
+      MPI_Scan(&my_weight, &prefix, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+      MPI_Allreduce(&my_weight, &total, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+      MFEM_VERIFY(total > 0.0, "the total weight must be positive");
+
+      prefix -= my_weight;
+      for (int i = 0; i < ne; i++)
+      {
+         const double w = elem_weights ? (*elem_weights)(i) : 1.0;
+         const double mid = prefix + 0.5*w;
+         partition[i] = std::min(int(mid*NRanks/total), NRanks-1);
+         prefix += w;
+      }
+      return;
+   }
+
+   // order the elements along the Hilbert curve through their centers
+   // (vertex averages)
+   const int sdim = SpaceDimension();
+   std::vector<double> centers(ne*sdim, 0.0);
+   for (int i = 0; i < ne; i++)
+   {
+      const int *v = elements[i]->GetVertices();
+      const int nv = elements[i]->GetNVertices();
+      for (int j = 0; j < nv; j++)
+      {
+         for (int d = 0; d < sdim; d++)
+         {
+            centers[i*sdim+d] += vertices[v[j]](d)/nv;
+         }
+      }
+   }
+   std::vector<unsigned long long> key;
+   HilbertKeys(MyComm, sdim, centers, key);
+
+   std::vector<int> part;
+   if (elem_weights)
    {
-      MFEM_ABORT("Load balancing is currently not supported for conforming"
-                 " meshes.");
+      double total, my_total = elem_weights->Sum();
+      MPI_Allreduce(&my_total, &total, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+      MFEM_VERIFY(total > 0.0, "the total weight must be positive");
    }
+   PartitionCurve(MyComm, key, elem_weights ? elem_weights->GetData() : NULL,
+                  part);
+   for (int i = 0; i < ne; i++) { partition[i] = part[i]; }
+}
+
+void ParMesh::RebalanceImpl(const Array<int> *partition)
+{
+   MFEM_VERIFY(NURBSext == NULL, "Load balancing of NURBS meshes is not "
+               "supported.");
+   MFEM_VERIFY(partition == NULL || partition->Size() == GetNE(),
+               "invalid partition size: " << partition->Size());
 
    // Make sure the Nodes use a ParFiniteElementSpace
    if (Nodes && dynamic_cast<ParFiniteElementSpace*>(Nodes->FESpace()) == NULL)
@@ -3411,20 +4385,28 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    DeleteFaceNbrData();
 
-   pncmesh->Rebalance(partition);
+   if (Conforming())
+   {
+      MFEM_ASSERT(partition, "");
+      RebalanceConforming(*partition);
+   }
+   else
+   {
+      pncmesh->Rebalance(partition);
 
-   ParMesh* pmesh2 = new ParMesh(*pncmesh);
-   pncmesh->OnMeshUpdated(pmesh2);
+      ParMesh* pmesh2 = new ParMesh(*pncmesh);
+      pncmesh->OnMeshUpdated(pmesh2);
 
-   attributes.Copy(pmesh2->attributes);
-   bdr_attributes.Copy(pmesh2->bdr_attributes);
+      attributes.Copy(pmesh2->attributes);
+      bdr_attributes.Copy(pmesh2->bdr_attributes);
 
-   Swap(*pmesh2, false);
-   delete pmesh2;
+      Swap(*pmesh2, false);
+      delete pmesh2;
 
-   pncmesh->GetConformingSharedStructures(*this);
+      pncmesh->GetConformingSharedStructures(*this);
 
-   GenerateNCFaceInfo();
+      GenerateNCFaceInfo();
+   }
 
    last_operation = Mesh::REBALANCE;
    sequence++;
@@ -3432,6 +4414,233 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
    UpdateNodes();
 }
 
+void ParMesh::RebalanceConforming(const Array<int> &partition)
+{
+   const int sdim = spaceDim;
+
+   ResetLazyData();
+
+   // Number the vertices globally: each rank numbers the vertices it owns
+   // (those that are not shared and the shared vertices in groups it is the
+   // master of) and receives the numbers of the others from the masters.
+   Array<int> vert_gid(NumOfVertices), vert_offsets(NRanks+1);
+   {
+      Array<int> vert_group(NumOfVertices);
+      vert_group = 0;
+      for (int gr = 1; gr < GetNGroups(); gr++)
+      {
+         for (int j = 0; j < group_svert.RowSize(gr-1); j++)
+         {
+            vert_group[svert_lvert[group_svert.GetRow(gr-1)[j]]] = gr;
+         }
+      }
+      int num_owned = 0;
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         if (gtopo.IAmMaster(vert_group[i])) { num_owned++; }
+      }
+      vert_offsets[0] = 0;
+      MPI_Allgather(&num_owned, 1, MPI_INT, vert_offsets.GetData()+1, 1,
+                    MPI_INT, MyComm);
+      vert_offsets.PartialSum();
+      for (int i = 0, k = vert_offsets[MyRank]; i < NumOfVertices; i++)
+      {
+         vert_gid[i] = gtopo.IAmMaster(vert_group[i]) ? k++ : -1;
+      }
+      GroupCommunicator gcomm(gtopo);
+      gcomm.Create(vert_group);
+      gcomm.Bcast(vert_gid);
+   }
+
+   // pack the elements: geometry, attribute, refinement flag and vertices,
+   // and their vertex coordinates
+   int nv_el = 0, my_nv_el = 0;
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      my_nv_el = std::max(my_nv_el, elements[i]->GetNVertices());
+   }
+   MPI_Allreduce(&my_nv_el, &nv_el, 1, MPI_INT, MPI_MAX, MyComm);
+   const int iw = 3 + nv_el, dw = nv_el*sdim;
+
+   std::vector<int> el_rank(partition.begin(), partition.end());
+   std::vector<int> el_ints, el_int_cnt;
+   std::vector<double> el_dbls;
+   {
+      std::vector<int> ibuf(NumOfElements*iw, -1), pos, cnt, sbuf, rcnt;
+      std::vector<double> dbuf(NumOfElements*dw, 0.0), sdbuf;
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         Element *el = elements[i];
+         const int *v = el->GetVertices();
+         MFEM_VERIFY(0 <= el_rank[i] && el_rank[i] < NRanks,
+                     "invalid rank in partition: " << el_rank[i]);
+         ibuf[i*iw] = el->GetGeometryType();
+         ibuf[i*iw+1] = el->GetAttribute();
+         ibuf[i*iw+2] = (el->GetType() == Element::TETRAHEDRON) ?
+                        static_cast<Tetrahedron*>(el)->GetRefinementFlag() : 0;
+         for (int j = 0; j < el->GetNVertices(); j++)
+         {
+            ibuf[i*iw+3+j] = vert_gid[v[j]];
+            const double *x = vertices[v[j]]();
+            std::copy(x, x + sdim, &dbuf[i*dw+j*sdim]);
+         }
+      }
+      GroupByRank(NRanks, el_rank, pos, cnt);
+      PackRecords(pos, iw, ibuf.data(), sbuf);
+      ExchangeData(MyComm, MPI_INT, ScaleCounts(cnt, iw), sbuf, el_int_cnt,
+                   el_ints);
+      PackRecords(pos, dw, dbuf.data(), sdbuf);
+      ExchangeData(MyComm, MPI_DOUBLE, ScaleCounts(cnt, dw), sdbuf, rcnt,
+                   el_dbls);
+   }
+
+   // the boundary elements follow the elements containing them
+   const int bw = 2 + 4;
+   std::vector<int> be_ints;
+   {
+      std::vector<int> ibuf(NumOfBdrElements*bw, -1), dest(NumOfBdrElements);
+      std::vector<int> pos, cnt, sbuf, rcnt;
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         const Element *be = boundary[i];
+         const int *v = be->GetVertices();
+         int el, info;
+         GetBdrElementAdjacentElement(i, el, info);
+         dest[i] = el_rank[el];
+         ibuf[i*bw] = be->GetGeometryType();
+         ibuf[i*bw+1] = be->GetAttribute();
+         for (int j = 0; j < be->GetNVertices(); j++)
+         {
+            ibuf[i*bw+2+j] = vert_gid[v[j]];
+         }
+      }
+      GroupByRank(NRanks, dest, pos, cnt);
+      PackRecords(pos, bw, ibuf.data(), sbuf);
+      ExchangeData(MyComm, MPI_INT, ScaleCounts(cnt, bw), sbuf, rcnt,
+                   be_ints);
+   }
+
+   // Record the migration for ParFiniteElementSpace::Update(). The received
+   // elements are ordered by source rank and, within it, by the old local
+   // number.
+   const int ne = el_ints.size()/iw, nbe = be_ints.size()/bw;
+   partition.Copy(rebalance_partition);
+   rebalance_old_index.SetSize(ne);
+   for (int p = 0, i = 0; p < NRanks; p++)
+   {
+      for (int k = 0; k < el_int_cnt[p]/iw; k++, i++)
+      {
+         rebalance_old_index[i] = -1 - p;
+      }
+   }
+   int self_start = 0;
+   for (int p = 0; p < MyRank; p++) { self_start += el_int_cnt[p]/iw; }
+   for (int i = 0, k = self_start; i < NumOfElements; i++)
+   {
+      if (el_rank[i] == MyRank) { rebalance_old_index[k++] = i; }
+   }
+
+   // build the new local mesh; the local vertices follow the global order
+   Array<int> new_gid;
+   new_gid.Reserve(ne*nv_el);
+   for (int i = 0; i < ne; i++)
+   {
+      const int nv = Geometry::NumVerts[el_ints[i*iw]];
+      new_gid.Append(&el_ints[i*iw+3], nv);
+   }
+   new_gid.Sort();
+   new_gid.Unique();
+
+   ParMesh *pmesh2 = new ParMesh;
+   pmesh2->MyComm = MyComm;
+   pmesh2->NRanks = NRanks;
+   pmesh2->MyRank = MyRank;
+   pmesh2->gtopo.SetComm(MyComm);
+   pmesh2->InitMesh(Dim, sdim, new_gid.Size(), ne, nbe);
+   pmesh2->NumOfVertices = new_gid.Size();
+
+   int lv[8];
+   for (int i = 0; i < ne; i++)
+   {
+      const int *rec = &el_ints[i*iw];
+      const Geometry::Type geom = Geometry::Type(rec[0]);
+      const int nv = Geometry::NumVerts[geom];
+      for (int j = 0; j < nv; j++)
+      {
+         lv[j] = new_gid.FindSorted(rec[3+j]);
+         double *x = pmesh2->vertices[lv[j]]();
+         for (int d = 0; d < sdim; d++)
+         {
+            x[d] = el_dbls[i*dw+j*sdim+d];
+         }
+      }
+      Element *el = pmesh2->NewElement(geom);
+      el->SetVertices(lv);
+      el->SetAttribute(rec[1]);
+      if (geom == Geometry::TETRAHEDRON)
+      {
+         static_cast<Tetrahedron*>(el)->SetRefinementFlag(rec[2]);
+      }
+      pmesh2->AddElement(el);
+   }
+   for (int i = 0; i < nbe; i++)
+   {
+      const int *rec = &be_ints[i*bw];
+      const Geometry::Type geom = Geometry::Type(rec[0]);
+      for (int j = 0; j < Geometry::NumVerts[geom]; j++)
+      {
+         lv[j] = new_gid.FindSorted(rec[2+j]);
+      }
+      Element *be = pmesh2->NewElement(geom);
+      be->SetVertices(lv);
+      be->SetAttribute(rec[1]);
+      pmesh2->AddBdrElement(be);
+   }
+
+   pmesh2->FinalizeTopology(false);
+   pmesh2->ReduceMeshGen();
+   pmesh2->BuildSharedEntities(vert_offsets, new_gid);
+
+   // keep the marking of the elements: don't refine (mark) again
+   pmesh2->Finalize(false, false);
+
+   // Mark the shared triangles according to the (already marked) tets, as in
+   // BuildSharedFaceElems(), with the same orientation on all ranks.
+   if (pmesh2->meshgen == 1)
+   {
+      for (int i = 0; i < pmesh2->shared_trias.Size(); i++)
+      {
+         const FaceInfo &fi = pmesh2->faces_info[pmesh2->sface_lface[i]];
+         Tetrahedron *tet =
+            static_cast<Tetrahedron*>(pmesh2->elements[fi.Elem1No]);
+         if (tet->GetRefinementFlag())
+         {
+            int *v = pmesh2->shared_trias[i].v;
+            tet->GetMarkedFace(fi.Elem1Inf/64, v);
+            if (v[0] > v[1]) { std::swap(v[0], v[1]); }
+         }
+      }
+   }
+
+   // the attributes are global, they do not change
+   attributes.Copy(pmesh2->attributes);
+   bdr_attributes.Copy(pmesh2->bdr_attributes);
+
+   Swap(*pmesh2, false);
+   pmesh2->gtopo.Copy(gtopo);
+   mfem::Swap(shared_edges, pmesh2->shared_edges);
+   mfem::Swap(shared_trias, pmesh2->shared_trias);
+   mfem::Swap(shared_quads, pmesh2->shared_quads);
+   group_svert.Swap(pmesh2->group_svert);
+   group_sedge.Swap(pmesh2->group_sedge);
+   group_stria.Swap(pmesh2->group_stria);
+   group_squad.Swap(pmesh2->group_squad);
+   mfem::Swap(svert_lvert, pmesh2->svert_lvert);
+   mfem::Swap(sedge_ledge, pmesh2->sedge_ledge);
+   mfem::Swap(sface_lface, pmesh2->sface_lface);
+   delete pmesh2;
+}
+
 void ParMesh::RefineGroups(const DSTable &v_to_v, int *middle)
 {
    // Refine groups after LocalRefinement in 2D (triangle meshes)
@@ -78,6 +78,10 @@ protected:
    // sface ids: all triangles first, then all quads
    Array<int> sface_lface;
 
+   // Conforming meshes: the data returned by GetRebalancePartition() and
+   // GetRebalanceOldIndex(), set by the last Rebalance().
+   Array<int> rebalance_partition, rebalance_old_index;
+
    IsoparametricTransformation FaceNbrTransformation;
 
    // glob_elem_offset + local element number defines a global element numbering
@@ -150,6 +154,15 @@ protected:
 
    void RebalanceImpl(const Array<int> *partition);
 
+   /// Migrate the elements of a conforming mesh, see RebalanceImpl().
+   void RebalanceConforming(const Array<int> &partition);
+
+   /** Compute a partition with (approximately) equal sums of the element
+       weights, or element counts if @a elem_weights is NULL, on all ranks.
+       See Rebalance(). */
+   void ComputeRebalancePartition(const Vector *elem_weights,
+                                  Array<int> &partition) const;
+
    void DeleteFaceNbrData();
 
    bool WantSkipSharedMaster(const NCMesh::Master &master) const;
@@ -199,6 +212,15 @@ protected:
    void BuildSharedVertMapping(int nvert, const Table* vert_element,
                                const Array<int> &vert_global_local);
 
+   /** Determine the shared vertices, edges and faces of a local mesh built
+       from distributed data and set up the group topology and the group_*,
+       shared_* and svert_lvert members. The array @a vert_gid gives the
+       global numbers of the local vertices, in increasing order, and
+       @a vert_offsets is the partitioning of the global vertices used to
+       route the queries, see ParMesh(MPI_Comm, const double *, int, ...). */
+   void BuildSharedEntities(const Array<int> &vert_offsets,
+                            const Array<int> &vert_gid);
+
    /// Ensure that bdr_attributes and attributes agree across processors
    void DistributeAttributes(Array<int> &attr);
 
@@ -212,6 +234,33 @@ public:
    ParMesh(MPI_Comm comm, Mesh &mesh, int *partitioning_ = NULL,
            int part_method = 1);
 
+   /// Construct a parallel mesh from distributed primary data.
+   /** This constructor never forms the global mesh. Each rank provides a
+       contiguous block of @a num_vertices global vertices (with coordinates
+       ordered byVDIM in @a vertices); the blocks are numbered consecutively
+       by rank. The elements and the boundary elements are given by their
+       global vertex numbers, and each rank may provide any subset of them,
+       e.g. a slice of a mesh file. The arguments follow the primary data
+       constructor of class Mesh; the element and boundary geometries must be
+       the same on all ranks.
+
+       The elements are partitioned along a Hilbert space-filling curve
+       through their centers, with parallel splitter search, and migrated to
+       their new ranks, where they are ordered along the curve. The boundary
+       elements follow the element containing them. The shared entities and
+       the group topology are then determined by querying the ranks owning
+       the (first) vertices of the entities.
+
+       The total number of elements should not be less than the number of
+       ranks. The @a refine parameter is passed to the method
+       Mesh::Finalize(). */
+   ParMesh(MPI_Comm comm, const double *vertices, int num_vertices,
+           const int *element_indices, Geometry::Type element_type,
+           const int *element_attributes, int num_elements,
+           const int *boundary_indices, Geometry::Type boundary_type,
+           const int *boundary_attributes, int num_boundary_elements,
+           int dimension, int space_dimension = -1, bool refine = true);
+
    /// Read a parallel mesh, each MPI rank from its own file/stream.
    /** The @a refine parameter is passed to the method Mesh::Finalize(). */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
@@ -318,14 +367,39 @@ public:
    virtual long ReduceInt(int value) const;
 
    /** Load balance the mesh by equipartitioning the global space-filling
-       sequence of elements. Works for nonconforming meshes only. */
+       sequence of elements. For nonconforming meshes, this is the sequence of
+       the leaf elements of the refinement trees; for conforming meshes, the
+       elements are ordered along a Hilbert curve through their centers.
+
+       Grid functions are migrated by calling ParFiniteElementSpace::Update()
+       and then ParGridFunction::Update(), as after a refinement. */
    void Rebalance();
 
-   /** Load balance a nonconforming mesh using a user-defined partition.
-       Each local element 'i' is migrated to processor rank 'partition[i]',
-       for 0 <= i < GetNE(). */
+   /** Load balance the mesh using a user-defined partition. Each local
+       element 'i' is migrated to processor rank 'partition[i]', for
+       0 <= i < GetNE(). */
    void Rebalance(const Array<int> &partition);
 
+   /** Load balance the mesh such that the sum of the weights @a elem_weights
+       (e.g. measured computational costs) of the elements on each processor is
+       approximately the same. The elements are split into consecutive pieces
+       of the same sequence as in Rebalance(). The weights must be
+       nonnegative, with a positive total. */
+   void Rebalance(const Vector &elem_weights);
+
+   /** After Rebalance() of a conforming mesh, return the processor rank each
+       local element was sent to, indexed by the element numbers before the
+       rebalance. */
+   const Array<int> &GetRebalancePartition() const
+   { return rebalance_partition; }
+
+   /** After Rebalance() of a conforming mesh, return for each local element
+       its number before the rebalance if it stayed on this processor, or
+       -1-r if it came from rank r. The elements from one rank keep their
+       relative order. */
+   const Array<int> &GetRebalanceOldIndex() const
+   { return rebalance_old_index; }
+
    /** Print the part of the mesh in the calling processor adding the interface
        as boundary (for visualization purposes) using the mfem v1.0 format. */
    virtual void Print(std::ostream &out = mfem::out) const;
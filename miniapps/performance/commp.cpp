@@ -0,0 +1,187 @@
+//              MFEM Communication Benchmark - GroupCommunicator Modes
+//
+// Compile with: make commp
+//
+// Sample runs:  mpirun -np 4 commp -m ../../data/fichera.mesh -rs 1 -rp 1 -o 3
+//               mpirun -np 8 commp -m ../../data/beam-hex.mesh -rs 2 -o 2
+//               mpirun -np 4 commp -m ../../data/star.mesh -rs 3 -o 4 -n 1000
+//
+// Description:  This miniapp measures the time of the parallel data exchanges
+//               performed in every iteration of a typical solver, for the three
+//               communication modes of GroupCommunicator: byGroup, byNeighbor
+//               and byNeighborCollective (one MPI-3 neighborhood collective on
+//               a distributed graph communicator).
+//
+//               The timed operations are the action of the conforming
+//               prolongation P of an H1 space and of its transpose, which use
+//               the GroupCommunicator of the space, and the broadcast of
+//               several vectors, one at a time. For reference, the miniapp also
+//               times the aggregated multi-vector broadcast with persistent
+//               requests, GroupCommunicator::BcastVectors, and the exchange
+//               ParGridFunction::ExchangeFaceNbrData for an L2 space. These two
+//               use point-to-point messages, independently of the mode.
+//
+//               The reported times are the maximum over all MPI ranks of the
+//               average time of one operation.
+
+#include "mfem.hpp"
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace mfem;
+
+// Return the maximum over all ranks of the average time of one operation.
+static double MaxTime(StopWatch &sw, int nrep)
+{
+   double t = sw.RealTime()/nrep, max_t;
+   MPI_Allreduce(&t, &max_t, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   return max_t;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Initialize MPI.
+   MPI_Session mpi(argc, argv);
+   const int myid = mpi.WorldRank();
+
+   // 2. Parse command-line options.
+   const char *mesh_file = "../../data/fichera.mesh";
+   int ser_ref_levels = 1;
+   int par_ref_levels = 1;
+   int order = 3;
+   int nvec = 3;
+   int nrep = 100;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use.");
+   args.AddOption(&ser_ref_levels, "-rs", "--refine-serial",
+                  "Number of times to refine the mesh uniformly in serial.");
+   args.AddOption(&par_ref_levels, "-rp", "--refine-parallel",
+                  "Number of times to refine the mesh uniformly in parallel.");
+   args.AddOption(&order, "-o", "--order",
+                  "Finite element order (polynomial degree).");
+   args.AddOption(&nvec, "-nv", "--num-vectors",
+                  "Number of vectors in the multi-vector broadcasts.");
+   args.AddOption(&nrep, "-n", "--repetitions",
+                  "Number of timed repetitions of each operation.");
+   args.Parse();
+   if (!args.Good())
+   {
+      if (myid == 0) { args.PrintUsage(cout); }
+      return 1;
+   }
+   if (myid == 0) { args.PrintOptions(cout); }
+
+   // 3. Read the serial mesh, refine it and construct the parallel mesh.
+   Mesh *mesh = new Mesh(mesh_file, 1, 1);
+   const int dim = mesh->Dimension();
+   for (int l = 0; l < ser_ref_levels; l++)
+   {
+      mesh->UniformRefinement();
+   }
+   ParMesh pmesh(MPI_COMM_WORLD, *mesh);
+   delete mesh;
+   for (int l = 0; l < par_ref_levels; l++)
+   {
+      pmesh.UniformRefinement();
+   }
+
+   // 4. Define the H1 and L2 spaces and the vectors used in the timings.
+   H1_FECollection h1_fec(order, dim);
+   L2_FECollection l2_fec(order, dim);
+   ParFiniteElementSpace h1_fes(&pmesh, &h1_fec);
+   ParFiniteElementSpace l2_fes(&pmesh, &l2_fec);
+   HYPRE_Int h1_size = h1_fes.GlobalTrueVSize();
+   if (myid == 0)
+   {
+      cout << "Number of H1 unknowns: " << h1_size << endl;
+   }
+
+   const Operator *P = h1_fes.GetProlongationMatrix();
+   GroupCommunicator &gc = h1_fes.GroupComm();
+   Vector X(h1_fes.GetTrueVSize()), x(h1_fes.GetVSize());
+   Vector xv(nvec*h1_fes.GetVSize());
+   X.Randomize(myid + 1);
+   xv.Randomize(myid + 1);
+   ParGridFunction u(&l2_fes);
+   u.Randomize(myid + 1);
+
+   // 5. Time the exchanges in the three modes.
+   const char *mode_names[3] = { "byGroup", "byNeighbor",
+                                 "byNeighborCollective"
+                               };
+   const int vsize = h1_fes.GetVSize();
+   double t_mult[3], t_mult_t[3], t_bcast[3];
+   StopWatch sw;
+   for (int m = 0; m < 3; m++)
+   {
+      gc.SetMode((GroupCommunicator::Mode) m);
+
+      P->Mult(X, x); // warm-up
+      MPI_Barrier(MPI_COMM_WORLD);
+      sw.Clear();
+      sw.Start();
+      for (int i = 0; i < nrep; i++) { P->Mult(X, x); }
+      sw.Stop();
+      t_mult[m] = MaxTime(sw, nrep);
+
+      P->MultTranspose(x, X);
+      MPI_Barrier(MPI_COMM_WORLD);
+      sw.Clear();
+      sw.Start();
+      for (int i = 0; i < nrep; i++) { P->MultTranspose(x, X); }
+      sw.Stop();
+      t_mult_t[m] = MaxTime(sw, nrep);
+
+      double *h_xv = xv.HostReadWrite();
+      MPI_Barrier(MPI_COMM_WORLD);
+      sw.Clear();
+      sw.Start();
+      for (int i = 0; i < nrep; i++)
+      {
+         for (int v = 0; v < nvec; v++) { gc.Bcast(h_xv + v*vsize); }
+      }
+      sw.Stop();
+      t_bcast[m] = MaxTime(sw, nrep);
+   }
+   gc.SetMode(GroupCommunicator::byNeighbor);
+
+   double *d_xv = xv.ReadWrite();
+   gc.BcastVectors(d_xv, vsize, nvec); // warm-up
+   MPI_Barrier(MPI_COMM_WORLD);
+   sw.Clear();
+   sw.Start();
+   for (int i = 0; i < nrep; i++) { gc.BcastVectors(d_xv, vsize, nvec); }
+   sw.Stop();
+   const double t_vectors = MaxTime(sw, nrep);
+
+   pmesh.ExchangeFaceNbrData();
+   u.ExchangeFaceNbrData();
+   MPI_Barrier(MPI_COMM_WORLD);
+   sw.Clear();
+   sw.Start();
+   for (int i = 0; i < nrep; i++) { u.ExchangeFaceNbrData(); }
+   sw.Stop();
+   const double t_face_nbr = MaxTime(sw, nrep);
+
+   // 6. Report the results.
+   if (myid == 0)
+   {
+      cout << "\n   " << left << setw(24) << "mode" << right
+           << setw(14) << "P::Mult (s)" << setw(14) << "P::MultT (s)"
+           << setw(18) << "nvec x Bcast (s)" << endl;
+      for (int m = 0; m < 3; m++)
+      {
+         cout << "   " << left << setw(24) << mode_names[m] << right
+              << setprecision(6) << setw(14) << t_mult[m]
+              << setw(14) << t_mult_t[m] << setw(18) << t_bcast[m] << endl;
+      }
+      cout << "\n   GroupCommunicator::BcastVectors (s):      " << t_vectors
+           << "\n   ParGridFunction::ExchangeFaceNbrData (s): " << t_face_nbr
+           << endl;
+   }
+
+   return 0;
+}
@@ -0,0 +1,211 @@
+//                 MFEM Locality Benchmark - Element and DOF Ordering
+//
+// Compile with: make locality
+//
+// Sample runs:  locality -m ../../data/fichera.mesh -r 2 -o 3
+//               locality -m ../../data/star.mesh -r 4 -o 4
+//               locality -m ../../data/beam-tet.mesh -r 2 -o 2 -gecko
+//               locality -m ../../data/escher.mesh -r 1 -o 2 -n 20
+//
+// Description:  This miniapp measures the effect of the element reordering
+//               with Mesh::ReorderElementsForLocality and of the DOF numbering
+//               with FiniteElementSpace::SetLocalityDofNumbering on the memory
+//               access pattern of the element restriction (the gather/scatter
+//               used by partial assembly) and of the sparse matrix-vector
+//               product with an assembled mass matrix.
+//
+//               For both the default and the locality ordering, the miniapp
+//               reports (1) the number of cache misses of the corresponding
+//               access streams in a simulated set-associative LRU cache and (2)
+//               the measured run times of ElementRestriction::Mult,
+//               ElementRestriction::MultTranspose and SparseMatrix::Mult.
+
+#include "mfem.hpp"
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace mfem;
+
+// A set-associative cache with LRU replacement, counting the misses in a
+// stream of memory accesses to entries of a double array.
+class CacheModel
+{
+   const int line_doubles, num_sets, assoc;
+   std::vector<long> tags, ages;
+   long clock, accesses, misses;
+
+public:
+   CacheModel(int cache_kb, int line_bytes = 64, int assoc_ = 8)
+      : line_doubles(line_bytes/sizeof(double)),
+        num_sets(cache_kb*1024/line_bytes/assoc_), assoc(assoc_),
+        tags(num_sets*assoc_, -1), ages(num_sets*assoc_, 0),
+        clock(0), accesses(0), misses(0) { }
+
+   void Access(int index)
+   {
+      const long line = index/line_doubles;
+      long *tag = &tags[(line % num_sets)*assoc];
+      long *age = &ages[(line % num_sets)*assoc];
+      accesses++;
+      clock++;
+      int lru = 0;
+      for (int w = 0; w < assoc; w++)
+      {
+         if (tag[w] == line) { age[w] = clock; return; }
+         if (age[w] < age[lru]) { lru = w; }
+      }
+      misses++;
+      tag[lru] = line;
+      age[lru] = clock;
+   }
+
+   long Accesses() const { return accesses; }
+   long Misses() const { return misses; }
+};
+
+struct Results
+{
+   long restr_misses, spmv_misses, accesses;
+   double restr_time, restr_t_time, spmv_time;
+};
+
+static Results Benchmark(Mesh &mesh, int order, bool locality, int cache_kb,
+                         int nrep)
+{
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   if (locality) { fes.SetLocalityDofNumbering(); }
+
+   Results res;
+
+   // simulated cache misses of the gather x(dof) -> x_e(ldof, e)
+   {
+      CacheModel cache(cache_kb);
+      const Table &elem_dof = fes.GetElementToDofTable();
+      const int *J = elem_dof.GetJ();
+      for (int k = 0; k < elem_dof.Size_of_connections(); k++)
+      {
+         cache.Access(J[k] >= 0 ? J[k] : -1-J[k]);
+      }
+      res.restr_misses = cache.Misses();
+      res.accesses = cache.Accesses();
+   }
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new MassIntegrator);
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+
+   // simulated cache misses of the input vector accesses in y = A x
+   {
+      CacheModel cache(cache_kb);
+      const int *I = A.GetI(), *J = A.GetJ();
+      for (int i = 0; i < A.Height(); i++)
+      {
+         for (int k = I[i]; k < I[i+1]; k++) { cache.Access(J[k]); }
+      }
+      res.spmv_misses = cache.Misses();
+   }
+
+   const Operator *R = fes.GetElementRestriction(
+                          UsesTensorBasis(fes) ? ElementDofOrdering::LEXICOGRAPHIC
+                          : ElementDofOrdering::NATIVE);
+   Vector x(fes.GetVSize()), y(fes.GetVSize()), x_e(R->Height());
+   x.Randomize(1);
+
+   StopWatch sw;
+   R->Mult(x, x_e); // warm-up
+   sw.Start();
+   for (int i = 0; i < nrep; i++) { R->Mult(x, x_e); }
+   sw.Stop();
+   res.restr_time = sw.RealTime()/nrep;
+
+   sw.Clear();
+   R->MultTranspose(x_e, y);
+   sw.Start();
+   for (int i = 0; i < nrep; i++) { R->MultTranspose(x_e, y); }
+   sw.Stop();
+   res.restr_t_time = sw.RealTime()/nrep;
+
+   sw.Clear();
+   A.Mult(x, y);
+   sw.Start();
+   for (int i = 0; i < nrep; i++) { A.Mult(x, y); }
+   sw.Stop();
+   res.spmv_time = sw.RealTime()/nrep;
+
+   return res;
+}
+
+static void Report(const char *name, double before, double after)
+{
+   cout << "   " << left << setw(32) << name << right << setprecision(6)
+        << setw(14) << before << setw(14) << after
+        << setw(10) << setprecision(3) << before/after << endl;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *mesh_file = "../../data/fichera.mesh";
+   int ref_levels = 2;
+   int order = 3;
+   bool use_gecko = false;
+   int cache_kb = 32;
+   int nrep = 10;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&mesh_file, "-m", "--mesh",
+                  "Mesh file to use.");
+   args.AddOption(&ref_levels, "-r", "--refine",
+                  "Number of times to refine the mesh uniformly.");
+   args.AddOption(&order, "-o", "--order",
+                  "Finite element order (polynomial degree).");
+   args.AddOption(&use_gecko, "-gecko", "--gecko", "-hilbert", "--hilbert",
+                  "Element ordering: Gecko or Hilbert curve.");
+   args.AddOption(&cache_kb, "-c", "--cache-size",
+                  "Size of the simulated 8-way LRU cache in KB.");
+   args.AddOption(&nrep, "-n", "--repetitions",
+                  "Number of timed repetitions of each operation.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Read and refine the mesh. Uniform refinement appends the children of
+   //    each element at distant locations, so the resulting element ordering
+   //    is typical of meshes that were not reordered.
+   Mesh mesh(mesh_file, 1, 1);
+   for (int l = 0; l < ref_levels; l++)
+   {
+      mesh.UniformRefinement();
+   }
+   cout << "Number of elements: " << mesh.GetNE() << endl;
+
+   // 3. Measure with the default orderings.
+   Results before = Benchmark(mesh, order, false, cache_kb, nrep);
+   cout << "Number of element dof accesses: " << before.accesses << endl;
+
+   // 4. Reorder the elements, vertices, edges and faces, number the dofs in
+   //    the element order, and measure again.
+   mesh.ReorderElementsForLocality(use_gecko);
+   Results after = Benchmark(mesh, order, true, cache_kb, nrep);
+
+   // 5. Report the results.
+   cout << "\n   " << left << setw(32) << " " << right << setw(14) << "default"
+        << setw(14) << "locality" << setw(10) << "ratio" << endl;
+   Report("restriction cache misses", before.restr_misses, after.restr_misses);
+   Report("SpMV cache misses", before.spmv_misses, after.spmv_misses);
+   Report("ElementRestriction::Mult (s)", before.restr_time, after.restr_time);
+   Report("ElementRestriction::MultT (s)", before.restr_t_time,
+          after.restr_t_time);
+   Report("SparseMatrix::Mult (s)", before.spmv_time, after.spmv_time);
+
+   return 0;
+}
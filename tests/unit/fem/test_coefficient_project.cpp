@@ -0,0 +1,267 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace coefficient_project
+{
+
+static void distort(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*x(1)*x(1);
+   y(1) += 0.05*sin(M_PI*x(0));
+   if (x.Size() == 3) { y(2) += 0.1*x(0)*x(1); }
+}
+
+static double coeffFunction(const Vector &x)
+{
+   return 1.0 + x(0) + 2.0*x(1)*x(1);
+}
+
+static double tdCoeffFunction(const Vector &x, double t)
+{
+   return t*x(0) - x(1);
+}
+
+static void vecCoeffFunction(const Vector &x, Vector &v)
+{
+   v.SetSize(x.Size());
+   for (int d = 0; d < x.Size(); d++) { v(d) = 1.0 + d*x(0) - x(1)*x(1); }
+}
+
+// Pointwise evaluation at all points of all elements, as in the base class
+static void ProjectRef(Coefficient &Q, Mesh &mesh, const IntegrationRule &ir,
+                       Vector &qcoeff)
+{
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   qcoeff.SetSize(NQ*NE);
+   for (int e = 0; e < NE; e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         qcoeff(q+NQ*e) = Q.Eval(T, ip);
+      }
+   }
+}
+
+static void CheckProject(Coefficient &Q, Mesh &mesh, const IntegrationRule &ir)
+{
+   Vector qcoeff, qcoeff_ref;
+   Q.Project(qcoeff, mesh, ir);
+   ProjectRef(Q, mesh, ir, qcoeff_ref);
+   REQUIRE(qcoeff.Size() == qcoeff_ref.Size());
+   qcoeff.HostRead();
+   qcoeff -= qcoeff_ref;
+   REQUIRE(qcoeff.Normlinf() <= 1e-12*qcoeff_ref.Normlinf());
+}
+
+static void CheckProject(VectorCoefficient &VQ, Mesh &mesh,
+                         const IntegrationRule &ir)
+{
+   Vector qcoeff, qcoeff_ref;
+   VQ.Project(qcoeff, mesh, ir);
+   VQ.VectorCoefficient::Project(qcoeff_ref, mesh, ir);
+   REQUIRE(qcoeff.Size() == qcoeff_ref.Size());
+   qcoeff.HostRead();
+   qcoeff -= qcoeff_ref;
+   REQUIRE(qcoeff.Normlinf() <= 1e-10*qcoeff_ref.Normlinf());
+}
+
+TEST_CASE("Batched Coefficient evaluation", "[Coefficient]")
+{
+   const Element::Type types[] = { Element::TRIANGLE,
+                                   Element::QUADRILATERAL,
+                                   Element::HEXAHEDRON
+                                 };
+   for (Element::Type type : types)
+   {
+      const int dim = (type == Element::HEXAHEDRON) ? 3 : 2;
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 2, type, true, 1.0, 1.0) :
+                   new Mesh(2, 2, 2, type, true, 1.0, 1.0, 1.0);
+      for (int e = 0; e < mesh->GetNE(); e++)
+      {
+         mesh->SetAttribute(e, 1 + e%3);
+      }
+      mesh->SetAttributes();
+      mesh->SetCurvature(2);
+      mesh->Transform(distort);
+
+      const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+      const IntegrationRule &ir = IntRules.Get(geom, 5);
+
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec), vfes(mesh, &fec, dim);
+      GridFunction u(&fes), v(&vfes);
+      u.Randomize(1);
+      v.Randomize(2);
+      // INTEGRAL map type: the values are not interpolated in reference space
+      L2_FECollection l2_fec(1, dim, BasisType::GaussLegendre,
+                             FiniteElement::INTEGRAL);
+      FiniteElementSpace l2_fes(mesh, &l2_fec);
+      GridFunction w(&l2_fes);
+      w.Randomize(3);
+
+      ConstantCoefficient c(2.5);
+      Vector pw(3);
+      pw(0) = 1.0; pw(1) = -2.0; pw(2) = 4.0;
+      PWConstCoefficient pwc(pw);
+      FunctionCoefficient f(coeffFunction), tdf(tdCoeffFunction);
+      tdf.SetTime(0.5);
+      GridFunctionCoefficient gf(&u), gf_comp(&v, 2), gf_l2(&w);
+      SumCoefficient sum(f, gf, 2.0, -1.0), sum_c(1.5, pwc, 1.0, 3.0);
+      ProductCoefficient prod(f, gf_comp), prod_c(-2.0, tdf);
+      PowerCoefficient power(f, 1.5);
+
+      for (Coefficient *Q : std::vector<Coefficient*>({ &c, &pwc, &f, &tdf,
+                                                        &gf, &gf_comp, &gf_l2,
+                                                        &sum,
+                                                        &sum_c, &prod, &prod_c,
+                                                        &power
+                                                      }))
+      {
+         CheckProject(*Q, *mesh, ir);
+      }
+
+      Vector cvec(dim);
+      cvec = 1.5;
+      cvec(0) = -0.5;
+      VectorConstantCoefficient vc(cvec);
+      VectorFunctionCoefficient vf(dim, vecCoeffFunction), vf_q(dim,
+                                                               vecCoeffFunction,
+                                                               &f);
+      VectorGridFunctionCoefficient vgf(&v);
+      GradientGridFunctionCoefficient grad(&u);
+      for (VectorCoefficient *VQ : std::vector<VectorCoefficient*>({ &vc, &vf,
+                                                                   &vf_q, &vgf,
+                                                                   &grad
+                                                                 }))
+      {
+         CheckProject(*VQ, *mesh, ir);
+      }
+
+      // QuadratureFunction: evaluation and copy
+      QuadratureSpace qs(mesh, 5);
+      QuadratureFunction qf(&qs);
+      f.Project(qf);
+      Vector qf_ref;
+      ProjectRef(f, *mesh, ir, qf_ref);
+      Vector diff(qf);
+      diff -= qf_ref;
+      REQUIRE(diff.Normlinf() <= 1e-12*qf_ref.Normlinf());
+
+      QuadratureFunctionCoefficient qfc(qf);
+      CheckProject(qfc, *mesh, ir);
+
+      delete mesh;
+   }
+}
+
+// Element-by-element projection, as in GridFunction::ProjectCoefficient
+static void ProjectRef(Coefficient *Q, VectorCoefficient *VQ, GridFunction &u)
+{
+   FiniteElementSpace &fes = *u.FESpace();
+   Array<int> vdofs;
+   Vector vals;
+   for (int e = 0; e < fes.GetNE(); e++)
+   {
+      fes.GetElementVDofs(e, vdofs);
+      vals.SetSize(vdofs.Size());
+      ElementTransformation &T = *fes.GetElementTransformation(e);
+      if (Q) { fes.GetFE(e)->Project(*Q, T, vals); }
+      else { fes.GetFE(e)->Project(*VQ, T, vals); }
+      u.SetSubVector(vdofs, vals);
+   }
+}
+
+static void CheckProjectCoefficient(Coefficient *Q, VectorCoefficient *VQ,
+                                    FiniteElementSpace &fes)
+{
+   GridFunction u(&fes), u_ref(&fes);
+   if (Q) { u.ProjectCoefficient(*Q); }
+   else { u.ProjectCoefficient(*VQ); }
+   ProjectRef(Q, VQ, u_ref);
+   u.HostRead();
+   u -= u_ref;
+   REQUIRE(u.Normlinf() <= 1e-12*std::max(1.0, u_ref.Normlinf()));
+}
+
+TEST_CASE("Batched ProjectCoefficient", "[Coefficient][GridFunction]")
+{
+   const Element::Type types[] = { Element::TRIANGLE,
+                                   Element::QUADRILATERAL,
+                                   Element::TETRAHEDRON,
+                                   Element::HEXAHEDRON
+                                 };
+   for (Element::Type type : types)
+   {
+      for (int curved = 0; curved <= 1; curved++)
+      {
+         const int dim = (type <= Element::QUADRILATERAL) ? 2 : 3;
+         Mesh *mesh = (dim == 2) ?
+                      new Mesh(3, 2, type, true, 1.0, 1.0) :
+                      new Mesh(2, 2, 2, type, true, 1.0, 1.0, 1.0);
+         for (int e = 0; e < mesh->GetNE(); e++)
+         {
+            mesh->SetAttribute(e, 1 + e%3);
+         }
+         mesh->SetAttributes();
+         if (curved) { mesh->SetCurvature(2); }
+         mesh->Transform(distort);
+
+         H1_FECollection h1_fec(3, dim);
+         L2_FECollection l2_fec(2, dim);
+         FiniteElementSpace h1_fes(mesh, &h1_fec), l2_fes(mesh, &l2_fec);
+         FiniteElementSpace vfes_nodes(mesh, &h1_fec, dim, Ordering::byNODES);
+         FiniteElementSpace vfes_vdim(mesh, &h1_fec, dim, Ordering::byVDIM);
+
+         ConstantCoefficient c(2.5);
+         Vector pw(3);
+         pw(0) = 1.0; pw(1) = -2.0; pw(2) = 4.0;
+         PWConstCoefficient pwc(pw);
+         FunctionCoefficient f(coeffFunction);
+         SumCoefficient sum(f, pwc, 2.0, -1.0);
+         for (Coefficient *Q : std::vector<Coefficient*>({ &c, &pwc, &f, &sum }))
+         {
+            CheckProjectCoefficient(Q, NULL, h1_fes);
+            CheckProjectCoefficient(Q, NULL, l2_fes);
+         }
+
+         Vector cvec(dim);
+         cvec = 1.5;
+         cvec(0) = -0.5;
+         VectorConstantCoefficient vc(cvec);
+         VectorFunctionCoefficient vf(dim, vecCoeffFunction), vf_q(dim,
+                                                                  vecCoeffFunction,
+                                                                  &pwc);
+         for (VectorCoefficient *VQ : std::vector<VectorCoefficient*>({ &vc,
+                                                                      &vf,
+                                                                      &vf_q
+                                                                    }))
+         {
+            CheckProjectCoefficient(NULL, VQ, vfes_nodes);
+            CheckProjectCoefficient(NULL, VQ, vfes_vdim);
+         }
+
+         delete mesh;
+      }
+   }
+}
+
+} // namespace coefficient_project
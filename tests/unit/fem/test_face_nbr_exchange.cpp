@@ -0,0 +1,144 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+#ifdef MFEM_USE_MPI
+
+namespace face_nbr_exchange
+{
+
+static double linear(const Vector &x)
+{
+   double f = 1.0;
+   for (int d = 0; d < x.Size(); d++) { f += (d+1)*x(d); }
+   return f;
+}
+
+static ParMesh *MakeParMesh(int dim)
+{
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(5, 4, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                new Mesh(3, 3, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   Array<int> partitioning(mesh->GetNE());
+   for (int i = 0; i < mesh->GetNE(); i++)
+   {
+      partitioning[i] = i*num_procs/mesh->GetNE();
+   }
+   ParMesh *pmesh = new ParMesh(MPI_COMM_WORLD, *mesh, partitioning);
+   delete mesh;
+   return pmesh;
+}
+
+TEST_CASE("Face-neighbor data exchange", "[ParGridFunction][Parallel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      ParMesh *pmesh = MakeParMesh(dim);
+      L2_FECollection fec(2, dim);
+      ParFiniteElementSpace fes(pmesh, &fec);
+      fes.ExchangeFaceNbrData();
+      const HYPRE_Int *glob_dof_map = fes.GetFaceNbrGlobalDofMap();
+      const HYPRE_Int offset = fes.GetMyDofOffset();
+
+      // the value of each dof is a function of its global number
+      const int ngf = 3;
+      ParGridFunction u0(&fes), u1(&fes), u2(&fes);
+      ParGridFunction *u[ngf] = { &u0, &u1, &u2 };
+      Array<ParGridFunction*> gfs(u, ngf);
+      for (int rep = 0; rep < 2; rep++)
+      {
+         for (int k = 0; k < ngf; k++)
+         {
+            for (int i = 0; i < fes.GetVSize(); i++)
+            {
+               (*u[k])(i) = (k+1)*(offset + i) + rep;
+            }
+         }
+
+         if (rep == 0)
+         {
+            ParGridFunction::ExchangeFaceNbrData(gfs);
+         }
+         else
+         {
+            // one vector at a time, with split-phase calls
+            for (int k = 0; k < ngf; k++)
+            {
+               u[k]->ExchangeFaceNbrDataBegin();
+               u[k]->ExchangeFaceNbrDataEnd();
+            }
+         }
+         for (int k = 0; k < ngf; k++)
+         {
+            const Vector &nbr_data = u[k]->FaceNbrData();
+            REQUIRE(nbr_data.Size() == fes.GetFaceNbrVSize());
+            for (int i = 0; i < nbr_data.Size(); i++)
+            {
+               REQUIRE(nbr_data(i) == (k+1)*glob_dof_map[i] + rep);
+            }
+         }
+      }
+
+      delete pmesh;
+   }
+}
+
+TEST_CASE("Parallel L2 face restriction", "[PartialAssembly][Parallel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      ParMesh *pmesh = MakeParMesh(dim);
+      L2_FECollection fec(2, dim, BasisType::GaussLobatto);
+      ParFiniteElementSpace fes(pmesh, &fec);
+      fes.ExchangeFaceNbrData();
+
+      // a continuous function has the same values on both sides of the faces
+      FunctionCoefficient coeff(linear);
+      ParGridFunction u(&fes);
+      u.ProjectCoefficient(coeff);
+      const Operator *R =
+         fes.GetFaceRestriction(ElementDofOrdering::LEXICOGRAPHIC,
+                                FaceType::Interior);
+      Vector y(R->Height());
+      for (int rep = 0; rep < 2; rep++)
+      {
+         y = 0.0;
+         R->Mult(u, y);
+         // y has the layout (face dofs, 2, faces), with 3^(dim-1) face dofs
+         const int face_nd = (dim == 2) ? 3 : 9;
+         double min_y = 1.0, max_diff = 0.0;
+         for (int f = 0; f < y.Size()/(2*face_nd); f++)
+         {
+            for (int d = 0; d < face_nd; d++)
+            {
+               const double y1 = y(d + face_nd*(2*f));
+               const double y2 = y(d + face_nd*(2*f + 1));
+               min_y = std::min(min_y, y1);
+               max_diff = std::max(max_diff, std::abs(y2 - y1));
+            }
+         }
+         REQUIRE(min_y >= 1.0);
+         REQUIRE(max_diff <= 1e-12);
+      }
+
+      delete pmesh;
+   }
+}
+
+} // namespace face_nbr_exchange
+
+#endif // MFEM_USE_MPI
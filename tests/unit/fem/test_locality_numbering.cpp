@@ -0,0 +1,138 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace locality_numbering
+{
+
+static void Field(const Vector &x, Vector &f)
+{
+   f.SetSize(x.Size());
+   for (int d = 0; d < x.Size(); d++)
+   {
+      f(d) = 1.0 + x(d)*x((d+1) % x.Size());
+   }
+}
+
+// Check that the dofs of 'fes' are a signed permutation 'map' of the dofs of
+// 'orig', consistent over all elements and boundary elements.
+static void CheckPermutation(FiniteElementSpace &orig, FiniteElementSpace &fes)
+{
+   REQUIRE(fes.GetNDofs() == orig.GetNDofs());
+   Array<int> map(orig.GetNDofs()), d0, d1;
+   map = -1;
+   for (int i = 0; i < orig.GetNE() + orig.GetNBE(); i++)
+   {
+      if (i < orig.GetNE())
+      {
+         orig.GetElementDofs(i, d0);
+         fes.GetElementDofs(i, d1);
+      }
+      else
+      {
+         orig.GetBdrElementDofs(i - orig.GetNE(), d0);
+         fes.GetBdrElementDofs(i - orig.GetNE(), d1);
+      }
+      REQUIRE(d0.Size() == d1.Size());
+      for (int j = 0; j < d0.Size(); j++)
+      {
+         REQUIRE((d0[j] >= 0) == (d1[j] >= 0));
+         const int k0 = (d0[j] >= 0) ? d0[j] : -1-d0[j];
+         const int k1 = (d1[j] >= 0) ? d1[j] : -1-d1[j];
+         if (map[k0] < 0) { map[k0] = k1; }
+         REQUIRE(map[k0] == k1);
+      }
+   }
+}
+
+TEST_CASE("Locality DOF numbering", "[FiniteElementSpace]")
+{
+   for (int type = (int)Element::TRIANGLE;
+        type <= (int)Element::HEXAHEDRON; type++)
+   {
+      for (int space = 0; space < 3; space++)
+      {
+         SECTION("Element type " + std::to_string(type) +
+                 ", space " + std::to_string(space))
+         {
+            Mesh *mesh = (type < (int)Element::TETRAHEDRON) ?
+                         new Mesh(5, 4, (Element::Type)type, true, 1.0, 2.0) :
+                         new Mesh(3, 2, 3, (Element::Type)type, true,
+                                  1.0, 2.0, 1.0);
+            const int ne = mesh->GetNE();
+            const double vol = mesh->GetElementVolume(0)*ne;
+            mesh->ReorderElementsForLocality();
+            REQUIRE(mesh->GetNE() == ne);
+            double new_vol = 0.0;
+            for (int i = 0; i < ne; i++)
+            {
+               new_vol += mesh->GetElementVolume(i);
+            }
+            REQUIRE(new_vol == Approx(vol));
+            const int dim = mesh->Dimension();
+
+            FiniteElementCollection *fec =
+               (space == 0) ? (FiniteElementCollection*)
+               new H1_FECollection(3, dim) :
+               (space == 1) ? (FiniteElementCollection*)
+               new ND_FECollection(1, dim) :
+               (FiniteElementCollection*) new RT_FECollection(0, dim);
+            const int vdim = (space == 0) ? dim : 1;
+
+            FiniteElementSpace orig(mesh, fec, vdim);
+            FiniteElementSpace fes(mesh, fec, vdim);
+            fes.SetLocalityDofNumbering();
+            REQUIRE(fes.GetLocalityDofNumbering());
+            CheckPermutation(orig, fes);
+
+            // the dofs of the first element come first
+            Array<int> dofs;
+            fes.GetElementDofs(0, dofs);
+            for (int j = 0; j < dofs.Size(); j++)
+            {
+               REQUIRE(((dofs[j] >= 0) ? dofs[j] : -1-dofs[j]) < dofs.Size());
+            }
+
+            Array<int> ess_bdr(mesh->bdr_attributes.Max()), tdofs0, tdofs1;
+            ess_bdr = 1;
+            orig.GetEssentialTrueDofs(ess_bdr, tdofs0);
+            fes.GetEssentialTrueDofs(ess_bdr, tdofs1);
+            REQUIRE(tdofs0.Size() == tdofs1.Size());
+
+            VectorFunctionCoefficient coeff(dim, Field);
+            GridFunction x0(&orig), x1(&fes);
+            x0.ProjectCoefficient(coeff);
+            x1.ProjectCoefficient(coeff);
+            const double err0 = x0.ComputeL2Error(coeff);
+            REQUIRE(x1.ComputeL2Error(coeff) == Approx(err0));
+
+            // the numbering is rebuilt after refinement
+            mesh->UniformRefinement();
+            orig.Update();
+            fes.Update();
+            x0.Update();
+            x1.Update();
+            CheckPermutation(orig, fes);
+            REQUIRE(x1.ComputeL2Error(coeff) ==
+                    Approx(x0.ComputeL2Error(coeff)));
+
+            delete fec;
+            delete mesh;
+         }
+      }
+   }
+}
+
+} // namespace locality_numbering
@@ -0,0 +1,119 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace lp_error
+{
+
+static void distort(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*x(1)*x(1);
+   y(1) += 0.05*sin(M_PI*x(0));
+   if (x.Size() == 3) { y(2) += 0.1*x(0)*x(1); }
+}
+
+static double exSol(const Vector &x)
+{
+   return sin(x(0)) + x(1)*x(1);
+}
+
+static void exGrad(const Vector &x, Vector &g)
+{
+   g.SetSize(x.Size());
+   g = 0.0;
+   g(0) = cos(x(0));
+   g(1) = 2.0*x(1);
+}
+
+static double weightFunction(const Vector &x)
+{
+   return 1.0 + x(0);
+}
+
+static void Check(double val, double ref)
+{
+   REQUIRE(fabs(val - ref) <= 1e-12*std::max(1.0, fabs(ref)));
+}
+
+static void Check(const Vector &val, const Vector &ref)
+{
+   Vector diff(val);
+   diff -= ref;
+   REQUIRE(diff.Normlinf() <= 1e-12*std::max(1.0, ref.Normlinf()));
+}
+
+// The batched error computations are used on meshes with nodes, while the
+// element-by-element loops are used on meshes without nodes: compare the two
+// on the same (bi/tri-linear) geometry.
+TEST_CASE("Batched Lp errors", "[GridFunction]")
+{
+   const Element::Type types[] = { Element::TRIANGLE,
+                                   Element::QUADRILATERAL,
+                                   Element::HEXAHEDRON
+                                 };
+   for (Element::Type type : types)
+   {
+      const int dim = (type == Element::HEXAHEDRON) ? 3 : 2;
+      Mesh *mesh_ptr = (dim == 2) ?
+                       new Mesh(3, 2, type, true, 1.0, 1.0) :
+                       new Mesh(2, 2, 2, type, true, 1.0, 1.0, 1.0);
+      Mesh &mesh = *mesh_ptr;
+      mesh.Transform(distort);
+      REQUIRE(mesh.GetNodes() == NULL);
+      Mesh mesh_nodes(mesh);
+      mesh_nodes.SetCurvature(1);
+
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(&mesh, &fec), fes_nodes(&mesh_nodes, &fec);
+      FiniteElementSpace vfes(&mesh, &fec, dim);
+      FiniteElementSpace vfes_nodes(&mesh_nodes, &fec, dim);
+
+      FunctionCoefficient u_ex(exSol), weight(weightFunction);
+      VectorFunctionCoefficient grad_ex(dim, exGrad);
+      GridFunction u(&fes), u_nodes(&fes_nodes);
+      u.ProjectCoefficient(u_ex);
+      u_nodes = u;
+      GridFunction v(&vfes), v_nodes(&vfes_nodes);
+      v.Randomize(1);
+      v_nodes = v;
+
+      for (double p : { 1.0, 2.0, 3.0, infinity() })
+      {
+         Check(u_nodes.ComputeLpError(p, u_ex), u.ComputeLpError(p, u_ex));
+         Check(u_nodes.ComputeLpError(p, u_ex, &weight),
+               u.ComputeLpError(p, u_ex, &weight));
+         Check(v_nodes.ComputeLpError(p, grad_ex),
+               v.ComputeLpError(p, grad_ex));
+         Check(v_nodes.ComputeLpError(p, grad_ex, &weight, &grad_ex),
+               v.ComputeLpError(p, grad_ex, &weight, &grad_ex));
+
+         Vector err(mesh.GetNE()), err_ref(mesh.GetNE());
+         u_nodes.ComputeElementLpErrors(p, u_ex, err);
+         u.ComputeElementLpErrors(p, u_ex, err_ref);
+         Check(err, err_ref);
+         v_nodes.ComputeElementLpErrors(p, grad_ex, err, &weight);
+         v.ComputeElementLpErrors(p, grad_ex, err_ref, &weight);
+         Check(err, err_ref);
+      }
+      Check(v_nodes.ComputeL2Error(grad_ex), v.ComputeL2Error(grad_ex));
+      Check(u_nodes.ComputeGradError(&grad_ex), u.ComputeGradError(&grad_ex));
+      REQUIRE(u.ComputeGradError(&grad_ex) > 0.0);
+
+      delete mesh_ptr;
+   }
+}
+
+} // namespace lp_error
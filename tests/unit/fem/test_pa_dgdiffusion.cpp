@@ -0,0 +1,116 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pa_dgdiffusion
+{
+
+static void distort(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*x(1)*x(1);
+   y(1) += 0.05*sin(M_PI*x(0));
+   if (x.Size() == 3) { y(2) += 0.1*x(0)*x(1); }
+}
+
+static double coeffFunction(const Vector &x)
+{
+   return 1.0 + x(0) + 2.0*x(1);
+}
+
+static void matrixCoeffFunction(const Vector &x, DenseMatrix &K)
+{
+   const int dim = x.Size();
+   K.SetSize(dim);
+   K = 0.1*x(0);
+   for (int d = 0; d < dim; d++) { K(d,d) = 1.0 + d + x(1); }
+}
+
+enum class CoeffType { None, Scalar, Matrix };
+
+// The transposed integrator is used to check the transposed action.
+static BilinearFormIntegrator *NewIntegrator(CoeffType type, Coefficient &Q,
+                                             MatrixCoefficient &MQ,
+                                             double sigma, double kappa,
+                                             bool transpose)
+{
+   BilinearFormIntegrator *integ;
+   switch (type)
+   {
+      case CoeffType::Scalar:
+         integ = new DGDiffusionIntegrator(Q, sigma, kappa);
+         break;
+      case CoeffType::Matrix:
+         integ = new DGDiffusionIntegrator(MQ, sigma, kappa);
+         break;
+      default:
+         integ = new DGDiffusionIntegrator(sigma, kappa);
+         break;
+   }
+   return transpose ? new TransposeIntegrator(integ) : integ;
+}
+
+TEST_CASE("DG Diffusion PA", "[PartialAssembly][DG]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 2, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                   new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      mesh->Transform(distort);
+      for (int order = 1; order <= 3; order++)
+      {
+         L2_FECollection fec(order, dim, BasisType::GaussLobatto);
+         FiniteElementSpace fes(mesh, &fec);
+         FunctionCoefficient Q(coeffFunction);
+         MatrixFunctionCoefficient MQ(dim, matrixCoeffFunction);
+         const double kappa = (order+1)*(order+1);
+         for (CoeffType type : {CoeffType::None, CoeffType::Scalar,
+                                CoeffType::Matrix
+                               })
+         {
+            for (double sigma : {-1.0, 1.0})
+            {
+               for (bool transpose : {false, true})
+               {
+                  BilinearForm a_ref(&fes), a_pa(&fes);
+                  for (BilinearForm *a : {&a_ref, &a_pa})
+                  {
+                     a->AddInteriorFaceIntegrator(
+                        NewIntegrator(type, Q, MQ, sigma, kappa, transpose));
+                     a->AddBdrFaceIntegrator(
+                        NewIntegrator(type, Q, MQ, sigma, kappa, transpose));
+                  }
+                  a_ref.Assemble();
+                  a_ref.Finalize();
+                  a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+                  a_pa.Assemble();
+
+                  Vector x(fes.GetVSize()), y_ref(fes.GetVSize()),
+                         y_pa(fes.GetVSize());
+                  x.Randomize(1);
+                  a_ref.Mult(x, y_ref);
+                  a_pa.Mult(x, y_pa);
+                  y_pa -= y_ref;
+                  REQUIRE(y_pa.Normlinf() <= 1e-12*y_ref.Normlinf());
+               }
+            }
+         }
+      }
+      delete mesh;
+   }
+}
+
+} // namespace pa_dgdiffusion
@@ -0,0 +1,159 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pa_elasticity
+{
+
+static void distort(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*x(1)*x(1);
+   y(1) += 0.05*sin(M_PI*x(0));
+   if (x.Size() == 3) { y(2) += 0.1*x(0)*x(1); }
+}
+
+static double lambdaFunction(const Vector &x)
+{
+   return 1.0 + x(0) + 2.0*x(1);
+}
+
+static double muFunction(const Vector &x)
+{
+   return 2.0 + sin(M_PI*x(0))*cos(M_PI*x(1));
+}
+
+static Mesh *MakeMesh(int dim)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 2, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   mesh->Transform(distort);
+   return mesh;
+}
+
+// Compare the action and the diagonal of the operator assembled at the given
+// level with the ones of the assembled matrix.
+static void CompareWithAssembled(FiniteElementSpace &fes,
+                                 BilinearFormIntegrator *ref_integ,
+                                 BilinearFormIntegrator *test_integ,
+                                 AssemblyLevel assembly)
+{
+   BilinearForm a_ref(&fes), a_test(&fes);
+   a_ref.AddDomainIntegrator(ref_integ);
+   a_ref.Assemble();
+   a_ref.Finalize();
+   a_test.AddDomainIntegrator(test_integ);
+   a_test.SetAssemblyLevel(assembly);
+   a_test.Assemble();
+
+   Vector x(fes.GetVSize()), y_ref(fes.GetVSize()), y_test(fes.GetVSize());
+   x.Randomize(1);
+   a_ref.Mult(x, y_ref);
+   a_test.Mult(x, y_test);
+   y_test -= y_ref;
+   REQUIRE(y_test.Normlinf() <= 1e-12*y_ref.Normlinf());
+
+   if (assembly == AssemblyLevel::PARTIAL)
+   {
+      Vector diag_ref, diag_test(fes.GetVSize());
+      a_ref.SpMat().GetDiag(diag_ref);
+      a_test.AssembleDiagonal(diag_test);
+      diag_test -= diag_ref;
+      REQUIRE(diag_test.Normlinf() <= 1e-12*diag_ref.Normlinf());
+   }
+}
+
+TEST_CASE("Elasticity PA and EA", "[PartialAssembly][AssemblyLevel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         Mesh *mesh = MakeMesh(dim);
+         H1_FECollection fec(order, dim);
+         for (int ordering : {Ordering::byNODES, Ordering::byVDIM})
+         {
+            FiniteElementSpace fes(mesh, &fec, dim, ordering);
+
+            // the rule used by the integrator
+            const int int_order =
+               2*fes.GetElementTransformation(0)->OrderGrad(fes.GetFE(0));
+            QuadratureSpace qspace(mesh, int_order);
+            QuadratureFunction mu_qf(&qspace);
+            for (int e = 0; e < mesh->GetNE(); e++)
+            {
+               const IntegrationRule &ir = qspace.GetElementIntRule(e);
+               ElementTransformation &T = *mesh->GetElementTransformation(e);
+               Vector values;
+               mu_qf.GetElementValues(e, values);
+               for (int q = 0; q < ir.GetNPoints(); q++)
+               {
+                  Vector x;
+                  T.Transform(ir.IntPoint(q), x);
+                  values(q) = muFunction(x);
+               }
+            }
+
+            ConstantCoefficient lambda_c(2.0), mu_c(1.5);
+            FunctionCoefficient lambda_f(lambdaFunction), mu_f(muFunction);
+            QuadratureFunctionCoefficient mu_q(mu_qf);
+            for (AssemblyLevel assembly : {AssemblyLevel::PARTIAL,
+                                           AssemblyLevel::ELEMENT
+                                          })
+            {
+               CompareWithAssembled(fes,
+                                    new ElasticityIntegrator(lambda_c, mu_c),
+                                    new ElasticityIntegrator(lambda_c, mu_c),
+                                    assembly);
+               CompareWithAssembled(fes,
+                                    new ElasticityIntegrator(lambda_f, mu_f),
+                                    new ElasticityIntegrator(lambda_f, mu_f),
+                                    assembly);
+               CompareWithAssembled(fes,
+                                    new ElasticityIntegrator(lambda_f, mu_q),
+                                    new ElasticityIntegrator(lambda_f, mu_q),
+                                    assembly);
+               CompareWithAssembled(fes,
+                                    new ElasticityIntegrator(mu_f, 1.0, 0.5),
+                                    new ElasticityIntegrator(mu_f, 1.0, 0.5),
+                                    assembly);
+            }
+         }
+         delete mesh;
+      }
+   }
+}
+
+TEST_CASE("Vector Diffusion PA with variable coefficient",
+          "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         Mesh *mesh = MakeMesh(dim);
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec, dim);
+         FunctionCoefficient mu_f(muFunction);
+         CompareWithAssembled(fes, new VectorDiffusionIntegrator(mu_f),
+                              new VectorDiffusionIntegrator(mu_f),
+                              AssemblyLevel::PARTIAL);
+         delete mesh;
+      }
+   }
+}
+
+} // namespace pa_elasticity
@@ -457,4 +457,354 @@ TEST_CASE("PA Convection", "[PartialAssembly]")
    }
 }//test case
 
+double fused_coeff(const Vector &x)
+{
+   double f = 1.0;
+   for (int d = 0; d < x.Size(); d++) { f += 0.5*(d+1)*x(d)*x(d); }
+   return f;
+}
+
+// Add the integrators selected by the bits of 'terms' (1: mass, 2: diffusion,
+// 4: convection) to 'a', all on the quadrature rule 'ir'.
+void AddFusedIntegrators(BilinearForm &a, int terms, const IntegrationRule &ir,
+                         Coefficient &coeff, VectorCoefficient &velocity)
+{
+   if (terms & 1)
+   {
+      a.AddDomainIntegrator(new MassIntegrator(coeff, &ir));
+   }
+   if (terms & 2)
+   {
+      BilinearFormIntegrator *integ = new DiffusionIntegrator(coeff);
+      integ->SetIntRule(&ir);
+      a.AddDomainIntegrator(integ);
+   }
+   if (terms & 4)
+   {
+      BilinearFormIntegrator *integ = new ConvectionIntegrator(velocity, -1.0);
+      integ->SetIntRule(&ir);
+      a.AddDomainIntegrator(integ);
+   }
+}
+
+TEST_CASE("PA Fused Integrators", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         for (int terms : {3, 5, 6, 7})
+         {
+            Mesh *mesh = (dim == 2) ?
+                         new Mesh(4, 3, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                         new Mesh(3, 2, 2, Element::HEXAHEDRON, true,
+                                  1.0, 1.0, 1.0);
+            mesh->EnsureNodes();
+            // perturb the nodes to get non-constant Jacobians
+            GridFunction &nodes = *mesh->GetNodes();
+            for (int i = 0; i < nodes.Size(); i++)
+            {
+               nodes(i) += 0.02*sin(3.0*nodes(i) + i);
+            }
+            H1_FECollection fec(order, dim);
+            FiniteElementSpace fes(mesh, &fec);
+            const IntegrationRule &ir =
+               IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 2);
+
+            FunctionCoefficient coeff(fused_coeff);
+            VectorFunctionCoefficient velocity(dim, velocity_function);
+            BilinearForm a_fa(&fes), a_pa(&fes);
+            AddFusedIntegrators(a_fa, terms, ir, coeff, velocity);
+            AddFusedIntegrators(a_pa, terms, ir, coeff, velocity);
+            a_fa.Assemble();
+            a_fa.Finalize();
+            a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            a_pa.Assemble();
+
+            // all the integrators can be combined in one kernel
+            Array<BilinearFormIntegrator*> &integs = *a_pa.GetDBFI();
+            FusedPAIntegrator fused;
+            for (int i = 0; i < integs.Size(); i++)
+            {
+               REQUIRE(fused.Add(integs[i]));
+            }
+            REQUIRE(fused.GetNumIntegrators() == integs.Size());
+            REQUIRE(!fused.Add(integs[0]));
+
+            Vector x(fes.GetVSize()), y_fa(fes.GetVSize());
+            Vector y_pa(fes.GetVSize());
+            x.Randomize(1);
+
+            a_fa.Mult(x, y_fa);
+            a_pa.Mult(x, y_pa);
+            y_pa -= y_fa;
+            REQUIRE(y_pa.Normlinf() <= 1e-12*y_fa.Normlinf());
+
+            // the BilinearForm has no transposed PA action, use the extension
+            PABilinearFormExtension ext(&a_pa);
+            ext.Assemble();
+            a_fa.SpMat().MultTranspose(x, y_fa);
+            ext.MultTranspose(x, y_pa);
+            y_pa -= y_fa;
+            REQUIRE(y_pa.Normlinf() <= 1e-12*y_fa.Normlinf());
+
+            delete mesh;
+         }
+      }
+   }
+}
+
+TEST_CASE("PA L-vector Kernels", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         for (int terms : {1, 2, 5, 7})
+         {
+            Mesh *mesh = (dim == 2) ?
+                         new Mesh(4, 3, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                         new Mesh(3, 2, 2, Element::HEXAHEDRON, true,
+                                  1.0, 1.0, 1.0);
+            H1_FECollection fec(order, dim);
+            FiniteElementSpace fes(mesh, &fec);
+            const IntegrationRule &ir =
+               IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 2);
+
+            FunctionCoefficient coeff(fused_coeff);
+            VectorFunctionCoefficient velocity(dim, velocity_function);
+            BilinearForm a_fa(&fes), a_pa(&fes);
+            AddFusedIntegrators(a_fa, terms, ir, coeff, velocity);
+            AddFusedIntegrators(a_pa, terms, ir, coeff, velocity);
+            // a second mass integrator is applied with its own kernel
+            a_fa.AddDomainIntegrator(new MassIntegrator(coeff));
+            a_pa.AddDomainIntegrator(new MassIntegrator(coeff));
+            a_fa.Assemble();
+            a_fa.Finalize();
+            a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            a_pa.UseLVectorKernels();
+            a_pa.Assemble();
+
+            Vector x(fes.GetVSize()), y_fa(fes.GetVSize());
+            Vector y_pa(fes.GetVSize());
+            x.Randomize(1);
+
+            a_fa.Mult(x, y_fa);
+            a_pa.Mult(x, y_pa);
+            y_pa -= y_fa;
+            REQUIRE(y_pa.Normlinf() <= 1e-12*y_fa.Normlinf());
+
+            PABilinearFormExtension ext(&a_pa);
+            ext.UseLVectorKernels();
+            ext.Assemble();
+            a_fa.SpMat().MultTranspose(x, y_fa);
+            ext.MultTranspose(x, y_pa);
+            y_pa -= y_fa;
+            REQUIRE(y_pa.Normlinf() <= 1e-12*y_fa.Normlinf());
+
+            // the released E-vectors are allocated again for the diagonal
+            Vector diag_fa(fes.GetVSize()), diag_pa(fes.GetVSize());
+            a_fa.SpMat().GetDiag(diag_fa);
+            if (!(terms & 4))
+            {
+               a_pa.AssembleDiagonal(diag_pa);
+               diag_pa -= diag_fa;
+               REQUIRE(diag_pa.Normlinf() <= 1e-12*diag_fa.Normlinf());
+            }
+
+            delete mesh;
+         }
+      }
+   }
+}
+
+// Sizes (D1D,Q1D) inside and outside of the tables of specialized kernels,
+// covering all the bounds of the generic kernels.
+TEST_CASE("PA Kernel Sizes", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      std::vector<std::pair<int,int>> sizes = (dim == 2) ?
+      std::vector<std::pair<int,int>> {{2,2}, {3,7}, {5,6}, {10,12}, {12,13}} :
+      std::vector<std::pair<int,int>> {{2,3}, {2,4}, {3,7}, {4,6}, {5,8}, {5,9}};
+      for (auto size : sizes)
+      {
+         const int order = size.first - 1, q1d = size.second;
+         Mesh *mesh = (dim == 2) ?
+                      new Mesh(2, 2, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                      new Mesh(2, 1, 1, Element::HEXAHEDRON, true,
+                               1.0, 1.0, 1.0);
+         mesh->EnsureNodes();
+         GridFunction &nodes = *mesh->GetNodes();
+         for (int i = 0; i < nodes.Size(); i++)
+         {
+            nodes(i) += 0.02*sin(3.0*nodes(i) + i);
+         }
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         // Gauss-Legendre rule with q1d points in each direction
+         const IntegrationRule &ir =
+            IntRules.Get(mesh->GetElementBaseGeometry(0), 2*q1d - 1);
+         FunctionCoefficient coeff(fused_coeff);
+
+         for (int terms : {1, 2})
+         {
+            BilinearForm a_fa(&fes), a_pa(&fes);
+            VectorFunctionCoefficient velocity(dim, velocity_function);
+            AddFusedIntegrators(a_fa, terms, ir, coeff, velocity);
+            AddFusedIntegrators(a_pa, terms, ir, coeff, velocity);
+            a_fa.Assemble();
+            a_fa.Finalize();
+            a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            a_pa.Assemble();
+
+            Vector x(fes.GetVSize()), y_fa(fes.GetVSize());
+            Vector y_pa(fes.GetVSize());
+            x.Randomize(1);
+            a_fa.Mult(x, y_fa);
+            a_pa.Mult(x, y_pa);
+            y_pa -= y_fa;
+            REQUIRE(y_pa.Normlinf() <= 1e-12*y_fa.Normlinf());
+
+            Vector diag_fa(fes.GetVSize()), diag_pa(fes.GetVSize());
+            a_fa.SpMat().GetDiag(diag_fa);
+            a_pa.AssembleDiagonal(diag_pa);
+            diag_pa -= diag_fa;
+            REQUIRE(diag_pa.Normlinf() <= 1e-12*diag_fa.Normlinf());
+         }
+         delete mesh;
+      }
+   }
+}
+
+static void affine_map(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.3*x(1);
+   y(1) *= 1.5;
+   if (x.Size() == 3) { y(2) += 0.2*x(0) - 0.1*x(1); }
+}
+
+static void nonlinear_map(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*x(1)*x(1);
+}
+
+// Affine meshes use a single Jacobian per element in the PA setup
+TEST_CASE("PA Affine Meshes", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (bool simplex : {false, true})
+      {
+         for (int mesh_order : {1, 3})
+         {
+            Element::Type type = (dim == 2) ?
+                                 (simplex ? Element::TRIANGLE :
+                                  Element::QUADRILATERAL) :
+                                 (simplex ? Element::TETRAHEDRON :
+                                  Element::HEXAHEDRON);
+            Mesh *mesh = (dim == 2) ?
+                         new Mesh(3, 2, type, true, 1.0, 1.0) :
+                         new Mesh(2, 2, 1, type, true, 1.0, 1.0, 1.0);
+            mesh->SetCurvature(mesh_order);
+            mesh->Transform(affine_map);
+            REQUIRE(mesh->IsAffine());
+            const GeometricFactors *geom =
+               mesh->GetAffineGeometricFactors(GeometricFactors::JACOBIANS);
+            REQUIRE(geom != NULL);
+            REQUIRE(geom->J.Size() == dim*dim*mesh->GetNE());
+
+            const int order = 2;
+            H1_FECollection fec(order, dim);
+            FiniteElementSpace fes(mesh, &fec);
+            const IntegrationRule &ir =
+               IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 2);
+            FunctionCoefficient coeff(fused_coeff);
+            VectorFunctionCoefficient velocity(dim, velocity_function);
+            BilinearForm a_fa(&fes), a_pa(&fes);
+            AddFusedIntegrators(a_fa, 3, ir, coeff, velocity);
+            AddFusedIntegrators(a_pa, 3, ir, coeff, velocity);
+            a_fa.Assemble();
+            a_fa.Finalize();
+            a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            a_pa.Assemble();
+
+            Vector x(fes.GetVSize()), y_fa(fes.GetVSize());
+            Vector y_pa(fes.GetVSize());
+            x.Randomize(1);
+            a_fa.Mult(x, y_fa);
+            a_pa.Mult(x, y_pa);
+            y_pa -= y_fa;
+            REQUIRE(y_pa.Normlinf() <= 1e-12*y_fa.Normlinf());
+
+            if (mesh_order > 1)
+            {
+               mesh->Transform(nonlinear_map);
+               REQUIRE_FALSE(mesh->IsAffine());
+               REQUIRE(mesh->GetAffineGeometricFactors(
+                          GeometricFactors::JACOBIANS) == NULL);
+            }
+            delete mesh;
+         }
+      }
+   }
+}
+
+// The geometric factors and the PA data follow the moving mesh nodes
+TEST_CASE("PA Moving Mesh", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 2, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                   new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      mesh->SetCurvature(2);
+      const int order = 2;
+      H1_FECollection fec(order, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      const IntegrationRule &ir =
+         IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 2);
+      FunctionCoefficient coeff(fused_coeff);
+      VectorFunctionCoefficient velocity(dim, velocity_function);
+      BilinearForm a_pa(&fes);
+      AddFusedIntegrators(a_pa, 7, ir, coeff, velocity);
+      a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_pa.Assemble();
+      const GeometricFactors *geom =
+         mesh->GetGeometricFactors(ir, GeometricFactors::JACOBIANS);
+
+      for (int step = 0; step < 3; step++)
+      {
+         const long nodes_sequence = mesh->GetNodesSequence();
+         if (step == 1) { mesh->Transform(nonlinear_map); }
+         if (step == 2)
+         {
+            // external modification of the nodes
+            *mesh->GetNodes() *= 1.5;
+            mesh->NodesUpdated();
+         }
+         REQUIRE((mesh->GetNodesSequence() != nodes_sequence) == (step > 0));
+         a_pa.UpdateGeometry();
+         REQUIRE(mesh->GetGeometricFactors(ir, GeometricFactors::JACOBIANS) ==
+                 geom);
+
+         BilinearForm a_fa(&fes);
+         AddFusedIntegrators(a_fa, 7, ir, coeff, velocity);
+         a_fa.Assemble();
+         a_fa.Finalize();
+
+         Vector x(fes.GetVSize()), y_fa(fes.GetVSize());
+         Vector y_pa(fes.GetVSize());
+         x.Randomize(1);
+         a_fa.Mult(x, y_fa);
+         a_pa.Mult(x, y_pa);
+         y_pa -= y_fa;
+         REQUIRE(y_pa.Normlinf() <= 1e-12*y_fa.Normlinf());
+      }
+      delete mesh;
+   }
+}
+
 }// namespace pa_kernels
@@ -0,0 +1,178 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pa_overlap
+{
+
+static double Coeff(const Vector &x)
+{
+   double f = 1.0;
+   for (int d = 0; d < x.Size(); d++) { f += 0.5*(d+1)*x(d)*x(d); }
+   return f;
+}
+
+static Mesh *MakeMesh(int dim)
+{
+   return (dim == 2) ?
+          new Mesh(5, 4, Element::QUADRILATERAL, true, 1.0, 1.0) :
+          new Mesh(4, 3, 3, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+}
+
+TEST_CASE("PA element ranges", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         Mesh *mesh = MakeMesh(dim);
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         const ElementRestriction *R =
+            dynamic_cast<const ElementRestriction*>(
+               fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC));
+         REQUIRE(R != NULL);
+
+         FunctionCoefficient coeff(Coeff);
+         MassIntegrator mass(coeff);
+         DiffusionIntegrator diffusion(coeff);
+         mass.AssemblePA(fes);
+         diffusion.AssemblePA(fes);
+         BilinearFormIntegrator *integs[2] = { &mass, &diffusion };
+
+         Vector x(fes.GetVSize()), xe(R->Height()), xe_ranges(R->Height());
+         x.Randomize(1);
+         R->Mult(x, xe);
+
+         // gather in three ranges
+         const int ne = mesh->GetNE(), e1 = ne/3, e2 = (2*ne)/3;
+         xe_ranges = 0.0;
+         R->MultElements(x, xe_ranges, e2, ne);
+         R->MultElements(x, xe_ranges, 0, e1);
+         R->MultElements(x, xe_ranges, e1, e2);
+         xe_ranges -= xe;
+         REQUIRE(xe_ranges.Normlinf() == 0.0);
+
+         for (int i = 0; i < 2; i++)
+         {
+            REQUIRE(integs[i]->SupportsPAElementRange());
+            Vector ye(R->Height()), ye_ranges(R->Height());
+            ye = 0.0;
+            integs[i]->AddMultPA(xe, ye);
+            ye_ranges = 0.0;
+            integs[i]->AddMultPAElements(xe, ye_ranges, e1, ne);
+            integs[i]->AddMultPAElements(xe, ye_ranges, 0, e1);
+            ye_ranges -= ye;
+            REQUIRE(ye_ranges.Normlinf() == 0.0);
+            ye_ranges = 0.0;
+            integs[i]->AddMultTransposePAElements(xe, ye_ranges, 0, ne);
+            ye_ranges -= ye;
+            REQUIRE(ye_ranges.Normlinf() == 0.0);
+
+            // scatter the even and the odd dofs separately
+            Array<int> even, odd;
+            for (int j = 0; j < fes.GetNDofs(); j++)
+            {
+               ((j % 2) ? odd : even).Append(j);
+            }
+            Vector y(fes.GetVSize()), y_dofs(fes.GetVSize());
+            R->MultTranspose(ye, y);
+            R->MultTransposeDofs(odd, ye, y_dofs);
+            R->MultTransposeDofs(even, ye, y_dofs);
+            y_dofs -= y;
+            REQUIRE(y_dofs.Normlinf() == 0.0);
+         }
+
+         delete mesh;
+      }
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel PA communication overlap", "[PartialAssembly][Parallel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         int num_procs;
+         MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+         Mesh *mesh = MakeMesh(dim);
+         Array<int> partitioning(mesh->GetNE());
+         for (int i = 0; i < mesh->GetNE(); i++)
+         {
+            partitioning[i] = i*num_procs/mesh->GetNE();
+         }
+         ParMesh pmesh(MPI_COMM_WORLD, *mesh, partitioning);
+         delete mesh;
+
+         H1_FECollection fec(order, dim);
+         ParFiniteElementSpace fes(&pmesh, &fec);
+
+         FunctionCoefficient coeff(Coeff);
+         ParBilinearForm a(&fes);
+         a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         a.AddDomainIntegrator(new MassIntegrator(coeff));
+         a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+         a.Assemble();
+
+         // the system operator overlaps the communication in P and P^T with
+         // the element work, compare with P^T A_L P
+         Array<int> ess_tdof_list;
+         OperatorHandle A;
+         a.FormSystemMatrix(ess_tdof_list, A);
+
+         const Operator *P = fes.GetProlongationMatrix();
+         Vector X(fes.GetTrueVSize()), Y(fes.GetTrueVSize());
+         Vector Y_ref(fes.GetTrueVSize());
+         Vector xL(fes.GetVSize()), yL(fes.GetVSize());
+         X.Randomize(fes.GetMyRank() + 1);
+         P->Mult(X, xL);
+         a.Mult(xL, yL);
+         P->MultTranspose(yL, Y_ref);
+
+         A->Mult(X, Y);
+         Y -= Y_ref;
+         REQUIRE(Y.Normlinf() <= 1e-12*Y_ref.Normlinf());
+
+         const ConformingProlongationOperator *cP =
+            dynamic_cast<const ConformingProlongationOperator*>(P);
+         REQUIRE((cP != NULL) == (num_procs > 1));
+         if (cP)
+         {
+            PABilinearFormExtension ext(&a);
+            ext.Assemble();
+            ParPAOverlapOperator op(ext, *cP);
+            // only the ranks with external dofs have boundary elements
+            int num_bdr = op.GetNumBoundaryElements(), glob_num_bdr;
+            REQUIRE(num_bdr <= pmesh.GetNE());
+            MPI_Allreduce(&num_bdr, &glob_num_bdr, 1, MPI_INT, MPI_SUM,
+                          MPI_COMM_WORLD);
+            REQUIRE(glob_num_bdr > 0);
+            op.Mult(X, Y);
+            Y -= Y_ref;
+            REQUIRE(Y.Normlinf() <= 1e-12*Y_ref.Normlinf());
+            op.MultTranspose(X, Y);
+            Y -= Y_ref;
+            REQUIRE(Y.Normlinf() <= 1e-12*Y_ref.Normlinf());
+         }
+      }
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace pa_overlap
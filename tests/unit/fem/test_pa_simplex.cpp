@@ -0,0 +1,109 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pa_simplex
+{
+
+static void distort(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*x(1)*x(1);
+   y(1) += 0.05*sin(M_PI*x(0));
+   if (x.Size() == 3) { y(2) += 0.1*x(0)*x(1); }
+}
+
+static double coeffFunction(const Vector &x)
+{
+   return 1.0 + x(0) + 2.0*x(1);
+}
+
+static void velocityFunction(const Vector &x, Vector &v)
+{
+   v = 1.0;
+   v(0) = 1.0 + x(1);
+   v(1) = -0.5 + x(0)*x(0);
+}
+
+static Mesh *MakeMesh(int dim)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 2, Element::TRIANGLE, true, 1.0, 1.0) :
+                new Mesh(2, 2, 2, Element::TETRAHEDRON, true, 1.0, 1.0, 1.0);
+   mesh->Transform(distort);
+   return mesh;
+}
+
+// Compare the partially assembled action and diagonal with the ones of the
+// assembled matrix.
+static void CompareWithAssembled(FiniteElementSpace &fes,
+                                 BilinearFormIntegrator *ref_integ,
+                                 BilinearFormIntegrator *pa_integ,
+                                 bool diagonal)
+{
+   BilinearForm a_ref(&fes), a_pa(&fes);
+   a_ref.AddDomainIntegrator(ref_integ);
+   a_ref.Assemble();
+   a_ref.Finalize();
+   a_pa.AddDomainIntegrator(pa_integ);
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_pa.Assemble();
+
+   Vector x(fes.GetVSize()), y_ref(fes.GetVSize()), y_pa(fes.GetVSize());
+   x.Randomize(1);
+   a_ref.Mult(x, y_ref);
+   a_pa.Mult(x, y_pa);
+   y_pa -= y_ref;
+   REQUIRE(y_pa.Normlinf() <= 1e-12*y_ref.Normlinf());
+
+   if (diagonal)
+   {
+      Vector diag_ref, diag_pa(fes.GetVSize());
+      a_ref.SpMat().GetDiag(diag_ref);
+      a_pa.AssembleDiagonal(diag_pa);
+      diag_pa -= diag_ref;
+      REQUIRE(diag_pa.Normlinf() <= 1e-12*diag_ref.Normlinf());
+   }
+}
+
+TEST_CASE("PA on simplices", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = MakeMesh(dim);
+      for (int order = 1; order <= 4; order++)
+      {
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         ConstantCoefficient one(1.0);
+         FunctionCoefficient Q(coeffFunction);
+         VectorFunctionCoefficient vel(dim, velocityFunction);
+
+         CompareWithAssembled(fes, new MassIntegrator,
+                              new MassIntegrator, true);
+         CompareWithAssembled(fes, new MassIntegrator(Q),
+                              new MassIntegrator(Q), true);
+         CompareWithAssembled(fes, new DiffusionIntegrator(one),
+                              new DiffusionIntegrator(one), true);
+         CompareWithAssembled(fes, new DiffusionIntegrator(Q),
+                              new DiffusionIntegrator(Q), true);
+         CompareWithAssembled(fes, new ConvectionIntegrator(vel, -1.0),
+                              new ConvectionIntegrator(vel, -1.0), false);
+      }
+      delete mesh;
+   }
+}
+
+} // namespace pa_simplex
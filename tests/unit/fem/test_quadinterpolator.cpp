@@ -0,0 +1,212 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace quadinterpolator
+{
+
+static void distort(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*x(1)*x(1);
+   y(1) += 0.05*sin(M_PI*x(0));
+   if (x.Size() == 3) { y(2) += 0.1*x(0)*x(1); }
+}
+
+static Mesh *MakeMesh(int dim, int order)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 2, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   mesh->SetCurvature(order);
+   mesh->Transform(distort);
+   return mesh;
+}
+
+static double Diff(const Vector &x, const Vector &y)
+{
+   Vector d(x);
+   d -= y;
+   return d.Normlinf();
+}
+
+// Compare the tensor product evaluation, in both layouts, with the evaluation
+// using the full (non-tensor) maps.
+static void CompareWithFull(const FiniteElementSpace &fes,
+                            const IntegrationRule &ir,
+                            const GridFunction &u)
+{
+   const int dim = fes.GetMesh()->Dimension();
+   const int vdim = fes.GetVDim();
+   const int NE = fes.GetNE();
+   const int NQ = ir.GetNPoints();
+   const int ND = fes.GetFE(0)->GetDof();
+
+   unsigned flags = QuadratureInterpolator::VALUES |
+                    QuadratureInterpolator::DERIVATIVES;
+   if (vdim == dim) { flags |= QuadratureInterpolator::DETERMINANTS; }
+
+   QuadratureInterpolator qi_full(fes, ir), qi(fes, ir);
+   qi_full.DisableTensorProducts();
+   REQUIRE_FALSE(qi_full.UsesTensorProducts());
+   REQUIRE(qi.UsesTensorProducts());
+
+   Vector e_nat(vdim*ND*NE), e_lex(vdim*ND*NE);
+   fes.GetElementRestriction(ElementDofOrdering::NATIVE)->Mult(u, e_nat);
+   fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC)->Mult(u, e_lex);
+
+   Vector val_ref(vdim*NQ*NE), der_ref(vdim*dim*NQ*NE), det_ref(NQ*NE);
+   qi_full.Mult(e_nat, flags, val_ref, der_ref, det_ref);
+
+   Vector val(vdim*NQ*NE), der(vdim*dim*NQ*NE), det(NQ*NE);
+   qi.Mult(e_lex, flags, val, der, det);
+   REQUIRE(Diff(val, val_ref) <= 1e-12*val_ref.Normlinf());
+   REQUIRE(Diff(der, der_ref) <= 1e-12*der_ref.Normlinf());
+   if (vdim == dim)
+   {
+      REQUIRE(Diff(det, det_ref) <= 1e-12*det_ref.Normlinf());
+
+      // determinants only, without the derivatives
+      Vector empty;
+      det = 0.0;
+      qi.Mult(e_lex, QuadratureInterpolator::DETERMINANTS, empty, empty, det);
+      REQUIRE(Diff(det, det_ref) <= 1e-12*det_ref.Normlinf());
+   }
+
+   qi.SetOutputLayout(QVectorLayout::byVDIM);
+   qi.Mult(e_lex, flags, val, der, det);
+   Vector val_vdim(val.Size()), der_vdim(der.Size());
+   for (int e = 0; e < NE; e++)
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         for (int c = 0; c < vdim; c++)
+         {
+            val_vdim(q+NQ*(c+vdim*e)) = val(c+vdim*(q+NQ*e));
+            for (int d = 0; d < dim; d++)
+            {
+               der_vdim(q+NQ*(c+vdim*(d+dim*e))) =
+                  der(c+vdim*(d+dim*(q+NQ*e)));
+            }
+         }
+      }
+   }
+   REQUIRE(Diff(val_vdim, val_ref) <= 1e-12*val_ref.Normlinf());
+   REQUIRE(Diff(der_vdim, der_ref) <= 1e-12*der_ref.Normlinf());
+   if (vdim == dim)
+   {
+      REQUIRE(Diff(det, det_ref) <= 1e-12*det_ref.Normlinf());
+   }
+}
+
+TEST_CASE("QuadratureInterpolator tensor products", "[QuadratureInterpolator]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         Mesh *mesh = MakeMesh(dim, order);
+         const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+         const IntegrationRule &ir = IntRules.Get(geom, 2*order + 1);
+
+         // vector space: the mesh nodes
+         const GridFunction &nodes = *mesh->GetNodes();
+         CompareWithFull(*nodes.FESpace(), ir, nodes);
+
+         // scalar space
+         H1_FECollection fec(order + 1, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         GridFunction u(&fes);
+         u.Randomize(1);
+         CompareWithFull(fes, ir, u);
+
+         delete mesh;
+      }
+   }
+}
+
+TEST_CASE("GeometricFactors and physical derivatives",
+          "[QuadratureInterpolator]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         Mesh *mesh = MakeMesh(dim, order);
+         const int NE = mesh->GetNE();
+         const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+         const IntegrationRule &ir = IntRules.Get(geom, 2*order + 1);
+         const int NQ = ir.GetNPoints();
+         const int flags = GeometricFactors::COORDINATES |
+                           GeometricFactors::JACOBIANS |
+                           GeometricFactors::DETERMINANTS;
+         const GeometricFactors *gf = mesh->GetGeometricFactors(ir, flags);
+
+         H1_FECollection fec(order + 1, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         GridFunction u(&fes);
+         u.Randomize(1);
+         Vector e_lex(fes.GetFE(0)->GetDof()*NE);
+         fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC)->
+         Mult(u, e_lex);
+         QuadratureInterpolator qi(fes, ir);
+         Vector grad_nodes(dim*NQ*NE), grad_vdim(dim*NQ*NE);
+         qi.PhysDerivatives(e_lex, grad_nodes);
+         qi.SetOutputLayout(QVectorLayout::byVDIM);
+         qi.PhysDerivatives(e_lex, grad_vdim);
+
+         double err_x = 0.0, err_J = 0.0, err_det = 0.0, err_grad = 0.0;
+         Vector x, grad;
+         for (int e = 0; e < NE; e++)
+         {
+            ElementTransformation &T = *mesh->GetElementTransformation(e);
+            for (int q = 0; q < NQ; q++)
+            {
+               const IntegrationPoint &ip = ir.IntPoint(q);
+               T.SetIntPoint(&ip);
+               T.Transform(ip, x);
+               const DenseMatrix &J = T.Jacobian();
+               u.GetGradient(T, grad);
+               for (int i = 0; i < dim; i++)
+               {
+                  err_x = std::max(err_x,
+                                   fabs(gf->X(q+NQ*(i+dim*e)) - x(i)));
+                  err_grad = std::max(err_grad,
+                                      fabs(grad_nodes(q+NQ*(i+dim*e)) -
+                                           grad(i)));
+                  err_grad = std::max(err_grad,
+                                      fabs(grad_vdim(i+dim*(q+NQ*e)) -
+                                           grad(i)));
+                  for (int j = 0; j < dim; j++)
+                  {
+                     err_J = std::max(err_J,
+                                      fabs(gf->J(q+NQ*(i+dim*(j+dim*e))) -
+                                           J(i,j)));
+                  }
+               }
+               err_det = std::max(err_det, fabs(gf->detJ(q+NQ*e) - J.Det()));
+            }
+         }
+         REQUIRE(err_x <= 1e-12);
+         REQUIRE(err_J <= 1e-12);
+         REQUIRE(err_det <= 1e-12);
+         REQUIRE(err_grad <= 1e-10);
+
+         delete mesh;
+      }
+   }
+}
+
+} // namespace quadinterpolator
@@ -0,0 +1,204 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace tabulated_assembly
+{
+
+static void distort(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*x(1)*x(1);
+   y(1) += 0.05*sin(M_PI*x(0));
+   if (x.Size() == 3) { y(2) += 0.1*x(0)*x(1); }
+}
+
+static double coeffFunction(const Vector &x)
+{
+   return 1.0 + x(0) + 2.0*x(1);
+}
+
+static void vecCoeffFunction(const Vector &x, Vector &v)
+{
+   v.SetSize(x.Size());
+   for (int d = 0; d < x.Size(); d++) { v(d) = 1.0 + d*x(0) - x(1); }
+}
+
+static void matrixCoeffFunction(const Vector &x, DenseMatrix &K)
+{
+   const int dim = x.Size();
+   K.SetSize(dim);
+   K = 0.1*x(0);
+   for (int d = 0; d < dim; d++) { K(d,d) = 1.0 + d + x(1); }
+}
+
+// Element matrices and vectors computed point by point with the physical
+// shape functions, independently of the tabulated element assembly.
+static void RefMass(const FiniteElement &el, ElementTransformation &T,
+                    const IntegrationRule &ir, Coefficient &Q, DenseMatrix &M)
+{
+   const int nd = el.GetDof();
+   Vector shape(nd);
+   M.SetSize(nd);
+   M = 0.0;
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      T.SetIntPoint(&ip);
+      el.CalcPhysShape(T, shape);
+      AddMult_a_VVt(ip.weight*T.Weight()*Q.Eval(T, ip), shape, M);
+   }
+}
+
+static void RefDiffusion(const FiniteElement &el, ElementTransformation &T,
+                         const IntegrationRule &ir, Coefficient *Q,
+                         MatrixCoefficient *MQ, DenseMatrix &K)
+{
+   const int nd = el.GetDof();
+   const int sdim = T.GetSpaceDim();
+   DenseMatrix dshape(nd, sdim), kdshape(nd, sdim), mq(sdim);
+   K.SetSize(nd);
+   K = 0.0;
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      T.SetIntPoint(&ip);
+      el.CalcPhysDShape(T, dshape);
+      if (MQ) { MQ->Eval(mq, T, ip); }
+      else
+      {
+         mq = 0.0;
+         for (int d = 0; d < sdim; d++) { mq(d,d) = Q ? Q->Eval(T, ip) : 1.0; }
+      }
+      mq *= ip.weight*T.Weight();
+      MultABt(dshape, mq, kdshape);
+      AddMultABt(kdshape, dshape, K);
+   }
+}
+
+static void RefDomainLF(const FiniteElement &el, ElementTransformation &T,
+                        const IntegrationRule &ir, Coefficient &Q,
+                        VectorCoefficient &VQ, Vector &b, Vector &bgrad)
+{
+   const int nd = el.GetDof();
+   Vector shape(nd), vq;
+   DenseMatrix dshape(nd, T.GetSpaceDim());
+   b.SetSize(nd);
+   bgrad.SetSize(nd);
+   b = 0.0;
+   bgrad = 0.0;
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      T.SetIntPoint(&ip);
+      const double w = ip.weight*T.Weight();
+      el.CalcPhysShape(T, shape);
+      b.Add(w*Q.Eval(T, ip), shape);
+      el.CalcPhysDShape(T, dshape);
+      VQ.Eval(vq, T, ip);
+      vq *= w;
+      dshape.AddMult(vq, bgrad);
+   }
+}
+
+static double RelDiff(const DenseMatrix &A, const DenseMatrix &B)
+{
+   DenseMatrix D(A);
+   D -= B;
+   return D.MaxMaxNorm()/B.MaxMaxNorm();
+}
+
+static double RelDiff(const Vector &a, const Vector &b)
+{
+   Vector d(a);
+   d -= b;
+   return d.Normlinf()/b.Normlinf();
+}
+
+TEST_CASE("Tabulated element assembly", "[BilinearFormIntegrator]")
+{
+   const Element::Type types[] = { Element::TRIANGLE,
+                                   Element::QUADRILATERAL,
+                                   Element::TETRAHEDRON,
+                                   Element::HEXAHEDRON
+                                 };
+   for (Element::Type type : types)
+   {
+      const int dim = (type <= Element::QUADRILATERAL) ? 2 : 3;
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 2, type, true, 1.0, 1.0) :
+                   new Mesh(2, 2, 2, type, true, 1.0, 1.0, 1.0);
+      mesh->SetCurvature(2);
+      mesh->Transform(distort);
+
+      FunctionCoefficient Q(coeffFunction);
+      VectorFunctionCoefficient VQ(dim, vecCoeffFunction);
+      MatrixFunctionCoefficient MQ(dim, matrixCoeffFunction);
+
+      for (int order = 1; order <= 3; order++)
+      {
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         const FiniteElement &el = *fes.GetFE(0);
+         const Geometry::Type geom = el.GetGeomType();
+         const IntegrationRule &ir = IntRules.Get(geom, 2*order + 3);
+#ifndef MFEM_THREAD_SAFE
+         REQUIRE(el.GetShapeTable(ir) != NULL);
+#endif
+
+         MassIntegrator mass(Q, &ir);
+         DiffusionIntegrator diff(MQ), diff_1;
+         DiffusionIntegrator diff_q(Q);
+         diff.SetIntRule(&ir);
+         diff_1.SetIntRule(&ir);
+         diff_q.SetIntRule(&ir);
+         DomainLFIntegrator lf(Q, &ir);
+         DomainLFGradIntegrator lf_grad(VQ);
+         lf_grad.SetIntRule(&ir);
+
+         for (int e = 0; e < mesh->GetNE(); e++)
+         {
+            ElementTransformation &T = *mesh->GetElementTransformation(e);
+            DenseMatrix elmat, ref;
+
+            mass.AssembleElementMatrix(el, T, elmat);
+            RefMass(el, T, ir, Q, ref);
+            REQUIRE(RelDiff(elmat, ref) <= 1e-12);
+
+            diff.AssembleElementMatrix(el, T, elmat);
+            RefDiffusion(el, T, ir, NULL, &MQ, ref);
+            REQUIRE(RelDiff(elmat, ref) <= 1e-12);
+
+            diff_1.AssembleElementMatrix(el, T, elmat);
+            RefDiffusion(el, T, ir, NULL, NULL, ref);
+            REQUIRE(RelDiff(elmat, ref) <= 1e-12);
+
+            diff_q.AssembleElementMatrix(el, T, elmat);
+            RefDiffusion(el, T, ir, &Q, NULL, ref);
+            REQUIRE(RelDiff(elmat, ref) <= 1e-12);
+
+            Vector b, bgrad, b_ref, bgrad_ref;
+            lf.AssembleRHSElementVect(el, T, b);
+            lf_grad.AssembleRHSElementVect(el, T, bgrad);
+            RefDomainLF(el, T, ir, Q, VQ, b_ref, bgrad_ref);
+            REQUIRE(RelDiff(b, b_ref) <= 1e-12);
+            REQUIRE(RelDiff(bgrad, bgrad_ref) <= 1e-12);
+         }
+      }
+      delete mesh;
+   }
+}
+
+} // namespace tabulated_assembly
@@ -0,0 +1,126 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+#ifdef MFEM_USE_MPI
+
+namespace communication
+{
+
+TEST_CASE("GroupCommunicator multi-vector operations",
+          "[GroupCommunicator][Parallel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int mode = 0; mode < 2; mode++)
+      {
+         int num_procs, myid;
+         MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+         MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+         Mesh *mesh = (dim == 2) ?
+                      new Mesh(5, 4, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                      new Mesh(3, 3, 2, Element::HEXAHEDRON, true,
+                               1.0, 1.0, 1.0);
+         Array<int> partitioning(mesh->GetNE());
+         for (int i = 0; i < mesh->GetNE(); i++)
+         {
+            partitioning[i] = i*num_procs/mesh->GetNE();
+         }
+         ParMesh pmesh(MPI_COMM_WORLD, *mesh, partitioning);
+         delete mesh;
+
+         H1_FECollection fec(2, dim);
+         ParFiniteElementSpace fes(&pmesh, &fec, 2);
+         GroupCommunicator gc(pmesh.gtopo, mode ? GroupCommunicator::byNeighbor
+                              : GroupCommunicator::byGroup);
+         gc.GroupLDofTable() = fes.GroupComm().GroupLDofTable();
+         gc.Finalize();
+
+         const int vsize = fes.GetVSize(), nvec = 3;
+         Vector x(nvec*vsize), x_ref(nvec*vsize);
+         x.Randomize(myid + 1);
+
+         // compare with the single vector operations, twice to reuse the
+         // persistent requests, then with a different number of vectors
+         for (int rep = 0; rep < 3; rep++)
+         {
+            const int nv = (rep < 2) ? nvec : 1;
+            x_ref = x;
+            for (int v = 0; v < nv; v++)
+            {
+               gc.Reduce<double>(x_ref.GetData() + v*vsize,
+                                 GroupCommunicator::Sum);
+               gc.Bcast(x_ref.GetData() + v*vsize);
+            }
+            gc.ReduceVectors(x.ReadWrite(), vsize, nv);
+            gc.BcastVectors(x.ReadWrite(), vsize, nv);
+            x.HostRead();
+            x_ref -= x;
+            REQUIRE(x_ref.Normlinf() <= 1e-12*x.Normlinf());
+         }
+      }
+   }
+}
+
+TEST_CASE("GroupCommunicator neighborhood collective mode",
+          "[GroupCommunicator][Parallel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      int num_procs, myid;
+      MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+      MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(5, 4, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                   new Mesh(3, 3, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      Array<int> partitioning(mesh->GetNE());
+      for (int i = 0; i < mesh->GetNE(); i++)
+      {
+         partitioning[i] = i*num_procs/mesh->GetNE();
+      }
+      ParMesh pmesh(MPI_COMM_WORLD, *mesh, partitioning);
+      delete mesh;
+
+      H1_FECollection fec(3, dim);
+      ParFiniteElementSpace fes(&pmesh, &fec);
+      const Operator *P = fes.GetProlongationMatrix();
+      Vector X(fes.GetTrueVSize()), Y(fes.GetTrueVSize());
+      Vector x(fes.GetVSize()), y(fes.GetVSize());
+      Vector x_ref(fes.GetVSize()), Y_ref(fes.GetTrueVSize());
+      X.Randomize(myid + 1);
+      y.Randomize(myid + 1);
+
+      // the prolongation uses layouts 2 and 0 in Bcast and in Reduce
+      GroupCommunicator &gc = fes.GroupComm();
+      REQUIRE(gc.GetMode() == GroupCommunicator::byNeighbor);
+      P->Mult(X, x_ref);
+      P->MultTranspose(y, Y_ref);
+      gc.SetMode(GroupCommunicator::byNeighborCollective);
+      for (int rep = 0; rep < 2; rep++)
+      {
+         P->Mult(X, x);
+         P->MultTranspose(y, Y);
+         x -= x_ref;
+         Y -= Y_ref;
+         REQUIRE(x.Normlinf() == 0.0);
+         REQUIRE(Y.Normlinf() <= 1e-12*Y_ref.Normlinf());
+      }
+      gc.SetMode(GroupCommunicator::byNeighbor);
+   }
+}
+
+} // namespace communication
+
+#endif // MFEM_USE_MPI
@@ -14,6 +14,9 @@ using namespace mfem;
 
 #include "catch.hpp"
 
+#include <memory>
+#include <sstream>
+
 TEST_CASE("Gecko integration in MFEM", "[Mesh]")
 {
    Array<int> perm;
@@ -91,3 +94,92 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
       }
    }
 }
+
+static double Smooth(const Vector &x)
+{
+   double f = 1.0;
+   for (int d = 0; d < x.Size(); d++) { f += x(d)*x(d)*(d+1); }
+   return f;
+}
+
+TEST_CASE("Releasing mesh topology tables", "[Mesh]")
+{
+   for (int type = (int)Element::TRIANGLE;
+        type <= (int)Element::HEXAHEDRON; type++)
+   {
+      SECTION("Element type " + std::to_string(type))
+      {
+         std::unique_ptr<Mesh> mesh_ptr(
+            (type < (int)Element::TETRAHEDRON) ?
+            new Mesh(4, 3, (Element::Type)type, true) :
+            new Mesh(3, 2, 2, (Element::Type)type, true));
+         Mesh &mesh = *mesh_ptr;
+         const int dim = mesh.Dimension();
+         Mesh orig(mesh);
+         mesh.ElementToElementTable();
+
+         H1_FECollection fec(2, dim);
+         FiniteElementSpace fes0(&orig, &fec);
+
+         const long mem = mesh.MemoryUsage();
+         mesh.ReleaseElementToEdgeTable();
+         mesh.ReleaseElementToFaceTable();
+         mesh.ReleaseElementToElementTable();
+         mesh.ReleaseFaceToEdgeTable();
+         REQUIRE(mesh.MemoryUsage() < mem);
+         std::stringstream report;
+         mesh.PrintMemoryUsage(report);
+         REQUIRE(report.str().size() > 0);
+
+         // the tables are rebuilt on demand with the same numbering
+         Array<int> e0, e1, o0, o1;
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            orig.GetElementEdges(i, e0, o0);
+            mesh.GetElementEdges(i, e1, o1);
+            REQUIRE(e0 == e1);
+            REQUIRE(o0 == o1);
+            if (dim == 3)
+            {
+               orig.GetElementFaces(i, e0, o0);
+               mesh.GetElementFaces(i, e1, o1);
+               REQUIRE(e0 == e1);
+               REQUIRE(o0 == o1);
+            }
+         }
+         for (int i = 0; i < mesh.GetNBE(); i++)
+         {
+            orig.GetBdrElementEdges(i, e0, o0);
+            mesh.GetBdrElementEdges(i, e1, o1);
+            REQUIRE(e0 == e1);
+         }
+
+         // spaces and refinement work on a mesh with released tables
+         mesh.ReleaseElementToEdgeTable();
+         mesh.ReleaseElementToFaceTable();
+         FiniteElementSpace fes1(&mesh, &fec);
+         REQUIRE(fes1.GetNDofs() == fes0.GetNDofs());
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            fes0.GetElementDofs(i, e0);
+            fes1.GetElementDofs(i, e1);
+            REQUIRE(e0 == e1);
+         }
+
+         mesh.ReleaseElementToEdgeTable();
+         mesh.ReleaseElementToFaceTable();
+         orig.UniformRefinement();
+         mesh.UniformRefinement();
+         fes0.Update();
+         fes1.Update();
+         REQUIRE(mesh.GetNE() == orig.GetNE());
+         REQUIRE(mesh.GetNEdges() == orig.GetNEdges());
+         REQUIRE(mesh.GetNFaces() == orig.GetNFaces());
+
+         FunctionCoefficient coeff(Smooth);
+         GridFunction x(&fes1);
+         x.ProjectCoefficient(coeff);
+         REQUIRE(x.ComputeL2Error(coeff) < 1e-10);
+      }
+   }
+}
@@ -0,0 +1,198 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <sstream>
+
+using namespace mfem;
+
+namespace mesh_readers
+{
+
+static double MeshVolume(Mesh &mesh)
+{
+   double volume = 0.0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      volume += mesh.GetElementVolume(i);
+   }
+   return volume;
+}
+
+// The unit square split into two triangles, with the four sides as boundary
+// elements in the physical groups 1-4 and the surface in physical group 7.
+static void CheckUnitSquare(Mesh &mesh)
+{
+   REQUIRE(mesh.Dimension() == 2);
+   REQUIRE(mesh.GetNV() == 4);
+   REQUIRE(mesh.GetNE() == 2);
+   REQUIRE(mesh.GetNBE() == 4);
+   REQUIRE(mesh.attributes.Size() == 1);
+   REQUIRE(mesh.attributes[0] == 7);
+   REQUIRE(mesh.bdr_attributes.Size() == 4);
+   REQUIRE(mesh.bdr_attributes.Min() == 1);
+   REQUIRE(mesh.bdr_attributes.Max() == 4);
+   REQUIRE(MeshVolume(mesh) == Approx(1.0));
+}
+
+template <typename T>
+static void Write(std::ostream &out, T val)
+{
+   out.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+TEST_CASE("Gmsh 4.1 mesh reader", "[Mesh]")
+{
+   SECTION("ASCII")
+   {
+      std::stringstream msh;
+      msh << "$MeshFormat\n4.1 0 8\n$EndMeshFormat\n"
+          << "$Entities\n4 4 1 0\n"
+          << "1 0 0 0 0\n2 1 0 0 0\n3 1 1 0 0\n4 0 1 0 0\n"
+          << "1 0 0 0 1 0 0 1 1 2 1 -2\n"
+          << "2 1 0 0 1 1 0 1 2 2 2 -3\n"
+          << "3 0 1 0 1 1 0 1 3 2 3 -4\n"
+          << "4 0 0 0 0 1 0 1 4 2 4 -1\n"
+          << "1 0 0 0 1 1 0 1 7 4 1 2 3 4\n"
+          << "$EndEntities\n"
+          << "$Nodes\n1 4 1 4\n2 1 0 4\n1\n2\n3\n4\n"
+          << "0 0 0\n1 0 0\n1 1 0\n0 1 0\n$EndNodes\n"
+          << "$Elements\n5 6 1 6\n"
+          << "1 1 1 1\n1 1 2\n"
+          << "1 2 1 1\n2 2 3\n"
+          << "1 3 1 1\n3 3 4\n"
+          << "1 4 1 1\n4 4 1\n"
+          << "2 1 2 2\n5 1 2 3\n6 1 3 4\n"
+          << "$EndElements\n";
+      Mesh mesh(msh);
+      CheckUnitSquare(mesh);
+   }
+
+   SECTION("Binary with sparse node tags")
+   {
+      const size_t tags[4] = { 100, 200000, 300, 4000000 };
+      const double coords[4][3] = { {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0} };
+
+      std::stringstream msh;
+      msh << "$MeshFormat\n4.1 1 8\n";
+      Write<int>(msh, 1);
+      msh << "\n$EndMeshFormat\n";
+
+      // one point (no physical tags), four curves, and one surface
+      msh << "$Entities\n";
+      Write<size_t>(msh, 1); Write<size_t>(msh, 4);
+      Write<size_t>(msh, 1); Write<size_t>(msh, 0);
+      Write<int>(msh, 1);
+      for (int d = 0; d < 3; d++) { Write<double>(msh, 0.0); }
+      Write<size_t>(msh, 0);
+      for (int c = 1; c <= 4; c++)
+      {
+         Write<int>(msh, c);
+         for (int d = 0; d < 6; d++) { Write<double>(msh, 0.0); }
+         Write<size_t>(msh, 1); Write<int>(msh, c);
+         Write<size_t>(msh, 2); Write<int>(msh, 1); Write<int>(msh, -1);
+      }
+      Write<int>(msh, 1);
+      for (int d = 0; d < 6; d++) { Write<double>(msh, 0.0); }
+      Write<size_t>(msh, 1); Write<int>(msh, 7);
+      Write<size_t>(msh, 4);
+      for (int c = 1; c <= 4; c++) { Write<int>(msh, c); }
+      msh << "\n$EndEntities\n";
+
+      msh << "$Nodes\n";
+      Write<size_t>(msh, 1); Write<size_t>(msh, 4);
+      Write<size_t>(msh, 100); Write<size_t>(msh, 4000000);
+      Write<int>(msh, 2); Write<int>(msh, 1); Write<int>(msh, 0);
+      Write<size_t>(msh, 4);
+      for (int i = 0; i < 4; i++) { Write<size_t>(msh, tags[i]); }
+      for (int i = 0; i < 4; i++)
+      {
+         for (int d = 0; d < 3; d++) { Write<double>(msh, coords[i][d]); }
+      }
+      msh << "\n$EndNodes\n";
+
+      msh << "$Elements\n";
+      Write<size_t>(msh, 5); Write<size_t>(msh, 6);
+      Write<size_t>(msh, 1); Write<size_t>(msh, 6);
+      for (int c = 0; c < 4; c++)
+      {
+         Write<int>(msh, 1); Write<int>(msh, c+1); Write<int>(msh, 1);
+         Write<size_t>(msh, 1);
+         Write<size_t>(msh, c+1);
+         Write<size_t>(msh, tags[c]); Write<size_t>(msh, tags[(c+1)%4]);
+      }
+      Write<int>(msh, 2); Write<int>(msh, 1); Write<int>(msh, 2);
+      Write<size_t>(msh, 2);
+      Write<size_t>(msh, 5);
+      Write<size_t>(msh, tags[0]); Write<size_t>(msh, tags[1]);
+      Write<size_t>(msh, tags[2]);
+      Write<size_t>(msh, 6);
+      Write<size_t>(msh, tags[0]); Write<size_t>(msh, tags[2]);
+      Write<size_t>(msh, tags[3]);
+      msh << "\n$EndElements\n";
+
+      Mesh mesh(msh);
+      CheckUnitSquare(mesh);
+   }
+}
+
+TEST_CASE("VTU mesh reader", "[Mesh]")
+{
+   Mesh orig(3, 2, 2, Element::HEXAHEDRON, false, 3.0, 2.0, 1.0);
+   for (int i = 0; i < orig.GetNE(); i++)
+   {
+      orig.SetAttribute(i, 1 + i%3);
+   }
+   orig.SetAttributes();
+
+   std::vector<VTKFormat> formats;
+   formats.push_back(VTKFormat::ASCII);
+   formats.push_back(VTKFormat::BINARY);
+   formats.push_back(VTKFormat::BINARY32);
+   std::vector<int> compression_levels;
+   compression_levels.push_back(0);
+#ifdef MFEM_USE_ZLIB
+   compression_levels.push_back(6);
+#endif
+
+   for (size_t f = 0; f < formats.size(); f++)
+   {
+      for (size_t c = 0; c < compression_levels.size(); c++)
+      {
+         const int compression = compression_levels[c];
+         if (formats[f] == VTKFormat::ASCII && compression != 0) { continue; }
+
+         std::stringstream vtu;
+         vtu << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\"";
+         if (compression != 0)
+         {
+            vtu << " compressor=\"vtkZLibDataCompressor\"";
+         }
+         vtu << " byte_order=\"" << VTKByteOrder() << "\">\n"
+             << "<UnstructuredGrid>\n";
+         orig.PrintVTU(vtu, 1, formats[f], false, compression);
+         vtu << "</Piece>\n</UnstructuredGrid>\n</VTKFile>\n";
+
+         Mesh mesh(vtu);
+         REQUIRE(mesh.Dimension() == 3);
+         REQUIRE(mesh.GetNE() == orig.GetNE());
+         REQUIRE(MeshVolume(mesh) == Approx(MeshVolume(orig)));
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            REQUIRE(mesh.GetAttribute(i) == orig.GetAttribute(i));
+         }
+      }
+   }
+}
+
+} // namespace mesh_readers
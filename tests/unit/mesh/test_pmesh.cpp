@@ -0,0 +1,238 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pmesh_distributed
+{
+
+#ifdef MFEM_USE_MPI
+
+// Construct a ParMesh from contiguous slices of the vertices, elements and
+// boundary elements of 'mesh', as if each rank had read its own part of a
+// mesh file.
+static ParMesh *DistributeSlices(Mesh &mesh)
+{
+   int num_procs, my_rank;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+   const int sdim = mesh.SpaceDimension();
+   const int e0 = mesh.GetNE()*my_rank/num_procs;
+   const int e1 = mesh.GetNE()*(my_rank+1)/num_procs;
+   const int b0 = mesh.GetNBE()*my_rank/num_procs;
+   const int b1 = mesh.GetNBE()*(my_rank+1)/num_procs;
+   const int v0 = mesh.GetNV()*my_rank/num_procs;
+   const int v1 = mesh.GetNV()*(my_rank+1)/num_procs;
+
+   Array<int> el_vert, el_attr, be_vert, be_attr, v;
+   Array<double> coords;
+   for (int i = e0; i < e1; i++)
+   {
+      mesh.GetElementVertices(i, v);
+      el_vert.Append(v);
+      el_attr.Append(mesh.GetAttribute(i));
+   }
+   for (int i = b0; i < b1; i++)
+   {
+      mesh.GetBdrElementVertices(i, v);
+      be_vert.Append(v);
+      be_attr.Append(mesh.GetBdrAttribute(i));
+   }
+   for (int i = v0; i < v1; i++)
+   {
+      for (int d = 0; d < sdim; d++) { coords.Append(mesh.GetVertex(i)[d]); }
+   }
+
+   return new ParMesh(MPI_COMM_WORLD, coords.GetData(), v1-v0,
+                      el_vert.GetData(), mesh.GetElementBaseGeometry(0),
+                      el_attr.GetData(), e1-e0,
+                      be_vert.GetData(), mesh.GetBdrElementBaseGeometry(0),
+                      be_attr.GetData(), b1-b0,
+                      mesh.Dimension(), sdim);
+}
+
+static double GlobalVolume(ParMesh &pmesh)
+{
+   double vol = 0.0, glob_vol;
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      vol += pmesh.GetElementVolume(i);
+   }
+   MPI_Allreduce(&vol, &glob_vol, 1, MPI_DOUBLE, MPI_SUM, pmesh.GetComm());
+   return glob_vol;
+}
+
+// Return the number of shared vertex coordinates that differ from the ones on
+// the master rank of their group. The coordinates of refined vertices may be
+// computed in a different order on each rank, hence the tolerance.
+static int SharedVertexMismatches(ParMesh &pmesh)
+{
+   const int sdim = pmesh.SpaceDimension();
+   GroupCommunicator gcomm(pmesh.gtopo);
+   Table &group_ldof = gcomm.GroupLDofTable();
+   group_ldof.MakeI(pmesh.GetNGroups());
+   for (int gr = 1; gr < pmesh.GetNGroups(); gr++)
+   {
+      group_ldof.AddColumnsInRow(gr, sdim*pmesh.GroupNVertices(gr));
+   }
+   group_ldof.MakeJ();
+   Array<double> coords;
+   for (int gr = 1; gr < pmesh.GetNGroups(); gr++)
+   {
+      for (int i = 0; i < pmesh.GroupNVertices(gr); i++)
+      {
+         const double *x = pmesh.GetVertex(pmesh.GroupVertex(gr, i));
+         for (int d = 0; d < sdim; d++)
+         {
+            group_ldof.AddConnection(gr, coords.Size());
+            coords.Append(x[d]);
+         }
+      }
+   }
+   group_ldof.ShiftUpI();
+   gcomm.Finalize();
+
+   Array<double> master_coords(coords);
+   gcomm.Bcast(master_coords);
+   int mismatches = 0, glob_mismatches;
+   for (int i = 0; i < coords.Size(); i++)
+   {
+      if (std::abs(coords[i] - master_coords[i]) > 1e-12) { mismatches++; }
+   }
+   MPI_Allreduce(&mismatches, &glob_mismatches, 1, MPI_INT, MPI_SUM,
+                 pmesh.GetComm());
+   return glob_mismatches;
+}
+
+TEST_CASE("ParMesh from distributed data", "[ParMesh][Parallel]")
+{
+   for (int type = (int)Element::TRIANGLE;
+        type <= (int)Element::HEXAHEDRON; type++)
+   {
+      SECTION("Element type " + std::to_string(type))
+      {
+         Mesh *mesh = (type < (int)Element::TETRAHEDRON) ?
+                      new Mesh(7, 6, (Element::Type)type, true, 1.0, 2.0) :
+                      new Mesh(4, 3, 5, (Element::Type)type, true,
+                               1.0, 1.0, 2.0);
+         ParMesh *pmesh = DistributeSlices(*mesh);
+
+         REQUIRE(pmesh->GetGlobalNE() == mesh->GetNE());
+         REQUIRE(pmesh->ReduceInt(pmesh->GetNBE()) == mesh->GetNBE());
+         REQUIRE(GlobalVolume(*pmesh) == Approx(2.0));
+         REQUIRE(SharedVertexMismatches(*pmesh) == 0);
+
+         pmesh->UniformRefinement();
+         REQUIRE(pmesh->GetGlobalNE() ==
+                 (1 << mesh->Dimension())*mesh->GetNE());
+         REQUIRE(GlobalVolume(*pmesh) == Approx(2.0));
+         REQUIRE(SharedVertexMismatches(*pmesh) == 0);
+
+         delete pmesh;
+         delete mesh;
+      }
+   }
+}
+
+static double CenterX(ParMesh &pmesh, int i)
+{
+   Array<int> v;
+   pmesh.GetElementVertices(i, v);
+   double x = 0.0;
+   for (int j = 0; j < v.Size(); j++) { x += pmesh.GetVertex(v[j])[0]; }
+   return x/v.Size();
+}
+
+static double Quadratic(const Vector &x)
+{
+   double f = 1.0;
+   for (int d = 0; d < x.Size(); d++) { f += (d+1)*x(d)*(1.0 - 0.5*x(d)); }
+   return f;
+}
+
+TEST_CASE("ParMesh weighted rebalance", "[ParMesh][Parallel]")
+{
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+   for (int type = (int)Element::TRIANGLE;
+        type <= (int)Element::HEXAHEDRON; type++)
+   {
+      for (int nc = 0; nc <= 1; nc++)
+      {
+         SECTION("Element type " + std::to_string(type) +
+                 (nc ? ", nonconforming" : ", conforming"))
+         {
+            Mesh *mesh = (type < (int)Element::TETRAHEDRON) ?
+                         new Mesh(8, 6, (Element::Type)type, true, 1.0, 2.0) :
+                         new Mesh(4, 3, 5, (Element::Type)type, true,
+                                  1.0, 1.0, 2.0);
+            if (nc) { mesh->EnsureNCMesh(); }
+            const int global_ne = mesh->GetNE();
+            Array<int> partitioning(global_ne);
+            for (int i = 0; i < global_ne; i++)
+            {
+               partitioning[i] = i*num_procs/global_ne;
+            }
+            ParMesh pmesh(MPI_COMM_WORLD, *mesh, partitioning);
+            delete mesh;
+
+            H1_FECollection fec(2, pmesh.Dimension());
+            ParFiniteElementSpace fes(&pmesh, &fec);
+            ParGridFunction gf(&fes);
+            FunctionCoefficient coeff(Quadratic);
+            gf.ProjectCoefficient(coeff);
+
+            // the elements with x < 0.5 are ten times more expensive
+            Vector weights(pmesh.GetNE());
+            for (int i = 0; i < pmesh.GetNE(); i++)
+            {
+               weights(i) = (CenterX(pmesh, i) < 0.5) ? 10.0 : 1.0;
+            }
+            pmesh.Rebalance(weights);
+            fes.Update();
+            gf.Update();
+
+            REQUIRE(pmesh.GetGlobalNE() == global_ne);
+            REQUIRE(GlobalVolume(pmesh) == Approx(2.0));
+            REQUIRE(SharedVertexMismatches(pmesh) == 0);
+            REQUIRE(gf.ComputeL2Error(coeff) < 1e-10);
+
+            double my_weight = 0.0, max_weight, total_weight;
+            for (int i = 0; i < pmesh.GetNE(); i++)
+            {
+               my_weight += (CenterX(pmesh, i) < 0.5) ? 10.0 : 1.0;
+            }
+            MPI_Allreduce(&my_weight, &max_weight, 1, MPI_DOUBLE, MPI_MAX,
+                          MPI_COMM_WORLD);
+            MPI_Allreduce(&my_weight, &total_weight, 1, MPI_DOUBLE, MPI_SUM,
+                          MPI_COMM_WORLD);
+            REQUIRE(max_weight <= total_weight/num_procs + 10.0);
+
+            // the rebalanced mesh can be refined further
+            pmesh.UniformRefinement();
+            fes.Update();
+            gf.Update();
+            REQUIRE(GlobalVolume(pmesh) == Approx(2.0));
+            REQUIRE(SharedVertexMismatches(pmesh) == 0);
+            REQUIRE(gf.ComputeL2Error(coeff) < 1e-10);
+         }
+      }
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace pmesh_distributed